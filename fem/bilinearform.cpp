@@ -15,9 +15,21 @@
 #include "../general/device.hpp"
 #include <cmath>
 
+#if defined(MFEM_USE_LEGACY_OPENMP) || \
+    (defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE))
+#define MFEM_THREADED_ASSEMBLY
+#endif
+
 namespace mfem
 {
 
+// Full assembly runs on the host, so it is supported when the device is
+// disabled or when only the native CPU and OpenMP backends are allowed.
+static bool HostOnlyDevice()
+{
+   return !Device::Allows(~(unsigned long)(Backend::CPU | Backend::OMP));
+}
+
 void BilinearForm::AllocMat()
 {
    if (static_cond) { return; }
@@ -122,7 +134,7 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
    switch (assembly)
    {
       case AssemblyLevel::FULL:
-         if (Device::IsEnabled())
+         if (!HostOnlyDevice())
          {
             mfem_error("Full assembly not supported yet in device mode!");
             // ext = new FABilinearFormExtension(this);
@@ -148,6 +160,12 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
 void BilinearForm::EnableStaticCondensation()
 {
    delete static_cond;
+   if (ext)
+   {
+      static_cond = NULL;
+      ext->EnableStaticCondensation();
+      return;
+   }
    if (assembly != AssemblyLevel::FULL)
    {
       static_cond = NULL;
@@ -344,7 +362,7 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble(int skip_zeros)
 {
-   if (Device::IsEnabled() && (assembly != AssemblyLevel::PARTIAL))
+   if (!HostOnlyDevice() && (assembly != AssemblyLevel::PARTIAL))
    {
       mfem_error("Chosen assembly level not supported yet in device mode!");
    }
@@ -364,16 +382,21 @@ void BilinearForm::Assemble(int skip_zeros)
       AllocMat();
    }
 
-#ifdef MFEM_USE_LEGACY_OPENMP
+#ifdef MFEM_THREADED_ASSEMBLY
    int free_element_matrices = 0;
-   if (!element_matrices)
+   if (!element_matrices && ThreadedElementMatrices())
    {
       ComputeElementMatrices();
       free_element_matrices = 1;
    }
 #endif
 
-   if (dbfi.Size())
+   if (dbfi.Size() && element_matrices && static_cond)
+   {
+      // Eliminate the elements in parallel, see AssembleMatrices()
+      static_cond->AssembleMatrices(*element_matrices);
+   }
+   else if (dbfi.Size())
    {
       for (int i = 0; i < fes -> GetNE(); i++)
       {
@@ -541,7 +564,7 @@ void BilinearForm::Assemble(int skip_zeros)
       }
    }
 
-#ifdef MFEM_USE_LEGACY_OPENMP
+#ifdef MFEM_THREADED_ASSEMBLY
    if (free_element_matrices)
    {
       FreeElementMatrices();
@@ -756,6 +779,21 @@ void BilinearForm::RecoverFEMSolution(const Vector &X,
    }
 }
 
+bool BilinearForm::ThreadedElementMatrices() const
+{
+#if defined(MFEM_USE_LEGACY_OPENMP)
+   return true;
+#elif defined(MFEM_THREADED_ASSEMBLY)
+   // The element matrices are stored in a DenseTensor, so all elements must
+   // have the same number of dofs.
+   const Mesh *mesh = fes->GetMesh();
+   return (Device::Allows(Backend::OMP) && !fes->GetNURBSext() &&
+           mesh->GetNumGeometries(mesh->Dimension()) <= 1);
+#else
+   return false;
+#endif
+}
+
 void BilinearForm::ComputeElementMatrices()
 {
    if (element_matrices || dbfi.Size() == 0 || fes->GetNE() == 0)
@@ -772,8 +810,8 @@ void BilinearForm::ComputeElementMatrices()
    DenseMatrix tmp;
    IsoparametricTransformation eltrans;
 
-#ifdef MFEM_USE_LEGACY_OPENMP
-   #pragma omp parallel for private(tmp,eltrans)
+#ifdef MFEM_THREADED_ASSEMBLY
+   #pragma omp parallel for private(tmp,eltrans) if (ThreadedElementMatrices())
 #endif
    for (int i = 0; i < num_elements; i++)
    {
@@ -109,6 +109,12 @@ protected:
 
    void ConformingAssemble();
 
+   /** Whether Assemble() computes the element matrices with multiple threads,
+       see ComputeElementMatrices(): always with MFEM_USE_LEGACY_OPENMP, and
+       with MFEM_USE_OPENMP and MFEM_THREAD_SAFE when an OpenMP backend is
+       enabled and all elements have the same geometry. */
+   bool ThreadedElementMatrices() const;
+
    // may be used in the construction of derived classes
    BilinearForm() : Matrix (0)
    {
@@ -157,11 +163,15 @@ public:
        for class StaticCondensation in fem/staticcond.hpp This method should be
        called before assembly. If the number of unknowns after static
        condensation is not reduced, it is not enabled. */
+   /** With AssemblyLevel::PARTIAL, set before calling this method, the
+       condensed operator and the element interior solves are applied
+       matrix-free, see PAStaticCondensation. */
    void EnableStaticCondensation();
 
    /** Check if static condensation was actually enabled by a previous call to
        EnableStaticCondensation(). */
-   bool StaticCondensationIsEnabled() const { return static_cond; }
+   bool StaticCondensationIsEnabled() const
+   { return static_cond || (ext && ext->StaticCondensationIsEnabled()); }
 
    /// Return the trace FE space associated with static condensation.
    FiniteElementSpace *SCFESpace() const
@@ -406,7 +416,8 @@ public:
    */
    virtual void RecoverFEMSolution(const Vector &X, const Vector &b, Vector &x);
 
-   /// Compute and store internally all element matrices.
+   /** @brief Compute and store internally all element matrices, using
+       multiple threads with thread-safe integrators and OpenMP. */
    void ComputeElementMatrices();
 
    /// Free the memory used by the element matrices.
@@ -14,6 +14,9 @@
 
 #include "../general/forall.hpp"
 #include "bilinearform.hpp"
+#ifdef MFEM_USE_MPI
+#include "pfespace.hpp"
+#endif
 
 namespace mfem
 {
@@ -41,10 +44,12 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form) :
    trialFes(a->FESpace()), testFes(a->FESpace()),
    localX(trialFes->GetNE() * trialFes->GetFE(0)->GetDof() * trialFes->GetVDim()),
    localY( testFes->GetNE() * testFes->GetFE(0)->GetDof() * testFes->GetVDim()),
-   elem_restrict(new ElemRestriction(*a->FESpace())) { }
+   elem_restrict(new ElemRestriction(*a->FESpace())),
+   static_cond(NULL) { }
 
 PABilinearFormExtension::~PABilinearFormExtension()
 {
+   delete static_cond;
    delete elem_restrict;
 }
 
@@ -56,6 +61,18 @@ void PABilinearFormExtension::Assemble()
    {
       integrators[i]->Assemble(*a->FESpace());
    }
+   if (static_cond) { static_cond->Assemble(); }
+}
+
+void PABilinearFormExtension::EnableStaticCondensation()
+{
+   delete static_cond;
+   static_cond = new PAStaticCondensation(a, *elem_restrict);
+   if (!static_cond->ReducesTrueVSize())
+   {
+      delete static_cond;
+      static_cond = NULL;
+   }
 }
 
 void PABilinearFormExtension::Update()
@@ -70,15 +87,35 @@ void PABilinearFormExtension::Update()
                   testFes->GetVDim());
    delete elem_restrict;
    elem_restrict = new ElemRestriction(*fes);
+   if (static_cond) { EnableStaticCondensation(); }
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                                OperatorHandle &A)
 {
+   if (static_cond)
+   {
+      static_cond->SetEssentialTrueDofs(ess_tdof_list);
+      A.Reset(new ConstrainedOperator(
+                 static_cond, static_cond->GetEssentialReducedTrueDofs()));
+      return;
+   }
    const Operator* trialP = trialFes->GetProlongationMatrix();
    const Operator* testP  = testFes->GetProlongationMatrix();
    Operator *rap = this;
-   if (trialP) { rap = new RAPOperator(*testP, *this, *trialP); }
+   if (trialP)
+   {
+#ifdef MFEM_USE_MPI
+      // Overlap the communication with the element computations, if possible
+      const ConformingProlongationOperator *cP =
+         dynamic_cast<const ConformingProlongationOperator*>(trialP);
+      if (cP && testP == trialP && PAOverlapOperator::Supports(*a))
+      {
+         rap = new PAOverlapOperator(a, *elem_restrict, *cP);
+      }
+#endif
+      if (rap == this) { rap = new RAPOperator(*testP, *this, *trialP); }
+   }
    const bool own_A = (rap!=this);
    A.Reset(new ConstrainedOperator(rap, ess_tdof_list, own_A));
 }
@@ -89,11 +126,37 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
                                                Vector &X, Vector &B,
                                                int copy_interior)
 {
+   if (static_cond)
+   {
+      // Schur complement reduction to the skeleton dofs
+      FormSystemMatrix(ess_tdof_list, A);
+      static_cond->ReduceRHS(b, B);
+      static_cond->ReduceSolution(x, X);
+      if (!copy_interior)
+      {
+         X.SetSubVectorComplement(
+            static_cond->GetEssentialReducedTrueDofs(), 0.0);
+      }
+      A.As<ConstrainedOperator>()->EliminateRHS(X, B);
+      return;
+   }
    Operator *oper;
    Operator::FormLinearSystem(ess_tdof_list, x, b, oper, X, B, copy_interior);
    A.Reset(oper); // A will own oper
 }
 
+void PABilinearFormExtension::RecoverFEMSolution(const Vector &X,
+                                                 const Vector &b, Vector &x)
+{
+   if (static_cond)
+   {
+      // Element interior dofs back solve
+      static_cond->ComputeSolution(b, X, x);
+      return;
+   }
+   Operator::RecoverFEMSolution(X, b, x);
+}
+
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -121,6 +184,693 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 }
 
 
+// The interior solves are part of the Schur complement operator, which the
+// outer Krylov method assumes to be linear and fixed, so the iterative ones
+// are converged close to round-off rather than to the outer tolerance. With
+// the fast diagonalization preconditioner this takes only a few iterations.
+static const double interior_rel_tol = 1e-12;
+static const int interior_max_iter = 1000;
+// Relative residual below which the fast diagonalization of an element is
+// considered exact
+static const double fdm_exact_tol = 1e-10;
+
+// Eigenvalues and eigenvectors of the small symmetric matrix A, computed with
+// the cyclic Jacobi method. A is overwritten.
+static void SymmetricEigensystem(DenseMatrix &A, Vector &ev, DenseMatrix &V)
+{
+   const int n = A.Height();
+   V.Diag(1.0, n);
+   const double norm2 = A.FNorm2();
+   for (int sweep = 0; sweep < 100; sweep++)
+   {
+      double off2 = 0.0;
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = 0; i < j; i++) { off2 += A(i,j)*A(i,j); }
+      }
+      if (off2 <= 1e-32*norm2) { break; }
+      for (int p = 0; p < n; p++)
+      {
+         for (int q = p+1; q < n; q++)
+         {
+            if (A(p,q) == 0.0) { continue; }
+            // the rotation in the (p,q) plane that zeroes A(p,q)
+            const double theta = (A(q,q) - A(p,p))/(2.0*A(p,q));
+            const double t = ((theta >= 0.0) ? 1.0 : -1.0)/
+                             (fabs(theta) + sqrt(theta*theta + 1.0));
+            const double c = 1.0/sqrt(t*t + 1.0), sn = t*c;
+            for (int k = 0; k < n; k++)
+            {
+               const double akp = A(k,p), akq = A(k,q);
+               A(k,p) = c*akp - sn*akq;
+               A(k,q) = sn*akp + c*akq;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const double apk = A(p,k), aqk = A(q,k);
+               A(p,k) = c*apk - sn*aqk;
+               A(q,k) = sn*apk + c*aqk;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const double vkp = V(k,p), vkq = V(k,q);
+               V(k,p) = c*vkp - sn*vkq;
+               V(k,q) = sn*vkp + c*vkq;
+            }
+         }
+      }
+   }
+   ev.SetSize(n);
+   for (int i = 0; i < n; i++) { ev(i) = A(i,i); }
+}
+
+// y = A x along the direction dir of the n^dim tensor x (the first direction
+// is the fastest), A is n x n.
+static void TensorMult1D(const DenseMatrix &A, int dim, int dir,
+                         const double *x, double *y)
+{
+   const int n = A.Height();
+   int stride = 1, outer = 1;
+   for (int d = 0; d < dir; d++) { stride *= n; }
+   for (int d = dir+1; d < dim; d++) { outer *= n; }
+   for (int o = 0; o < outer; o++)
+   {
+      for (int i = 0; i < n; i++)
+      {
+         for (int a = 0; a < stride; a++)
+         {
+            double s = 0.0;
+            for (int j = 0; j < n; j++)
+            {
+               s += A(i,j)*x[a + stride*(j + n*o)];
+            }
+            y[a + stride*(i + n*o)] = s;
+         }
+      }
+   }
+}
+
+PAStaticCondensation::PAStaticCondensation(BilinearForm *form,
+                                           const ElemRestriction &er)
+   : a(form), elem_restrict(er), ne(er.ne), nd(er.dof), ni(0), dim(0),
+     ranges(true)
+{
+   const FiniteElementSpace &fes = *a->FESpace();
+   MFEM_VERIFY(fes.GetVDim() == 1, "only scalar spaces are supported");
+   MFEM_VERIFY(fes.GetProlongationMatrix() == NULL,
+               "only conforming serial spaces are supported");
+   MFEM_VERIFY(!Device::IsEnabled(), "device mode is not supported");
+   if (ne == 0) { return; }
+
+   // The interior dofs are the last ones in the native element ordering
+   ni = fes.GetNumElementInteriorDofs(0);
+   const TensorBasisElement *el =
+      dynamic_cast<const TensorBasisElement*>(fes.GetFE(0));
+   MFEM_VERIFY(el, "only tensor product elements are supported");
+   const Array<int> &dof_map = el->GetDofMap();
+   for (int d = 0; d < nd; d++)
+   {
+      const int native = dof_map.Size() ? dof_map[d] : d;
+      if (native >= nd - ni) { int_lex.Append(d); }
+   }
+   MFEM_ASSERT(int_lex.Size() == ni, "");
+
+   const int ndofs = fes.GetNDofs();
+   const int *elementMap = fes.GetElementToDofTable().GetJ();
+   int_ldof.SetSize(ni*ne);
+   ldof_sk.SetSize(ndofs);
+   ldof_sk = 0;
+   for (int e = 0; e < ne; e++)
+   {
+      MFEM_VERIFY(fes.GetNumElementInteriorDofs(e) == ni,
+                  "all elements must have the same number of interior dofs");
+      for (int k = 0; k < ni; k++)
+      {
+         const int d = int_lex[k];
+         const int ldof = elementMap[nd*e + (dof_map.Size() ? dof_map[d] : d)];
+         int_ldof[k + ni*e] = ldof;
+         ldof_sk[ldof] = -1;
+      }
+   }
+   for (int i = 0; i < ndofs; i++)
+   {
+      if (ldof_sk[i] == 0)
+      {
+         ldof_sk[i] = sk_ldof.Size();
+         sk_ldof.Append(i);
+      }
+   }
+   height = width = sk_ldof.Size();
+
+   // The 1D interior mass and stiffness matrices on [0,1] and their
+   // generalized eigenvectors, S^T M S = I and S^T K S = diag(lambda). The
+   // interior dofs are the 1D interior dofs in lexicographic order, so the
+   // interior blocks have the tensor structure of the class description.
+   dim = fes.GetFE(0)->GetDim();
+   const int p = fes.GetFE(0)->GetOrder();
+   const int n1 = p - 1;
+   if (n1 > 0)
+   {
+      const Poly_1D::Basis &basis1d = el->GetBasis1D();
+      const IntegrationRule &ir = IntRules.Get(Geometry::SEGMENT, 2*p);
+      DenseMatrix M(n1), K(n1);
+      M = 0.0;
+      K = 0.0;
+      Vector u(p+1), du(p+1);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         basis1d.Eval(ip.x, u, du);
+         for (int j = 0; j < n1; j++)
+         {
+            for (int i = 0; i < n1; i++)
+            {
+               M(i,j) += ip.weight*u(i+1)*u(j+1);
+               K(i,j) += ip.weight*du(i+1)*du(j+1);
+            }
+         }
+      }
+      // W = Q mu^{-1/2} with M = Q mu Q^T, so W^T M W = I, then
+      // W^T K W = V diag(lambda) V^T and S = W V
+      Vector mu;
+      DenseMatrix Q, W(n1), C(n1), V;
+      SymmetricEigensystem(M, mu, Q);
+      for (int j = 0; j < n1; j++)
+      {
+         for (int i = 0; i < n1; i++) { W(i,j) = Q(i,j)/sqrt(mu(j)); }
+      }
+      DenseMatrix KW(n1);
+      mfem::Mult(K, W, KW);
+      MultAtB(W, KW, C);
+      SymmetricEigensystem(C, fdm_lambda, V);
+      fdm_S.SetSize(n1);
+      mfem::Mult(W, V, fdm_S);
+      fdm_St.Transpose(fdm_S);
+   }
+
+   x_l.SetSize(ndofs);
+   y_l.SetSize(ndofs);
+   x_e.SetSize(nd*ne);
+   y_e.SetSize(nd*ne);
+   z_i.SetSize(ni*ne);
+   r_i.SetSize(ni*ne);
+   d_i.SetSize(ni*ne);
+   p_i.SetSize(ni*ne);
+   rho.SetSize(ne);
+   rho0.SetSize(ne);
+   p_e.SetSize(nd*ne);
+   ap_e.SetSize(nd*ne);
+   fdm_u.SetSize(ni);
+   fdm_v.SetSize(ni);
+   active.SetSize(ne);
+   solver.SetSize(ne);
+   solver = JACOBI_PCG;
+   fdm_inv_eig.SetSize(ni*ne);
+   inv_diag.SetSize(ni*ne);
+}
+
+void PAStaticCondensation::MultElements(Vector &x_e, Vector &y_e) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); i++)
+   {
+      integrators[i]->MultAssembled(x_e, y_e);
+   }
+}
+
+void PAStaticCondensation::MultActiveElements(Vector &x_e, Vector &y_e) const
+{
+   if (!ranges) { MultElements(x_e, y_e); return; }
+   active_ranges.SetSize(0);
+   for (int e = 0; e < ne; e++)
+   {
+      if (!active[e]) { continue; }
+      if (active_ranges.Size() && active_ranges.Last() == e)
+      {
+         active_ranges.Last() = e+1;
+      }
+      else
+      {
+         active_ranges.Append(e);
+         active_ranges.Append(e+1);
+      }
+   }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); i++)
+   {
+      for (int r = 0; r < active_ranges.Size(); r += 2)
+      {
+         integrators[i]->MultAssembled(x_e, y_e, active_ranges[r],
+                                       active_ranges[r+1]);
+      }
+   }
+}
+
+void PAStaticCondensation::SetInteriors(const Vector &z_i, double s,
+                                        Vector &x_e) const
+{
+   x_e = 0.0;
+   for (int e = 0; e < ne; e++)
+   {
+      for (int k = 0; k < ni; k++)
+      {
+         x_e(int_lex[k] + nd*e) = s*z_i(k + ni*e);
+      }
+   }
+}
+
+void PAStaticCondensation::SkeletonToElements(const Vector &x_s,
+                                              Vector &x_e) const
+{
+   x_l = 0.0;
+   x_l.SetSubVector(sk_ldof, x_s);
+   elem_restrict.Mult(x_l, x_e);
+}
+
+void PAStaticCondensation::ApplyFDM(int e, const double *r, double *d) const
+{
+   // d = (S x S x S) D^{-1} (S^T x S^T x S^T) r
+   double *u = fdm_u.GetData(), *v = fdm_v.GetData();
+   const double *x = r;
+   for (int dir = 0; dir < dim; dir++)
+   {
+      TensorMult1D(fdm_St, dim, dir, x, u);
+      x = u;
+      std::swap(u, v);
+   }
+   // the result is in v after the swap
+   const double *inv_eig = fdm_inv_eig.GetData() + ni*e;
+   for (int k = 0; k < ni; k++) { v[k] *= inv_eig[k]; }
+   x = v;
+   for (int dir = 0; dir < dim; dir++)
+   {
+      double *y = (dir == dim-1) ? d : u;
+      TensorMult1D(fdm_S, dim, dir, x, y);
+      x = y;
+      std::swap(u, v);
+   }
+}
+
+void PAStaticCondensation::Precondition(int e, const double *r,
+                                        double *d) const
+{
+   if (solver[e] == JACOBI_PCG)
+   {
+      const double *id = inv_diag.GetData() + ni*e;
+      for (int k = 0; k < ni; k++) { d[k] = id[k]*r[k]; }
+   }
+   else
+   {
+      ApplyFDM(e, r, d);
+   }
+}
+
+void PAStaticCondensation::SolveInteriors(Vector &z_i) const
+{
+   // Preconditioned CG for each element, the element operators are applied
+   // to the search directions of the active elements together. The elements
+   // solved exactly by the fast diagonalization are done after the first
+   // preconditioner application, the others stop separately when their
+   // preconditioned residual norm is reduced by interior_rel_tol.
+   r_i = z_i;
+   z_i = 0.0;
+   int num_active = 0;
+   for (int e = 0; e < ne; e++)
+   {
+      const double *r = r_i.GetData() + ni*e;
+      double *d = d_i.GetData() + ni*e;
+      if (solver[e] == FDM)
+      {
+         ApplyFDM(e, r, z_i.GetData() + ni*e);
+         active[e] = false;
+         continue;
+      }
+      Precondition(e, r, d);
+      double r_d = 0.0;
+      for (int k = 0; k < ni; k++)
+      {
+         p_i(k + ni*e) = d[k];
+         r_d += r[k]*d[k];
+      }
+      rho(e) = rho0(e) = r_d;
+      active[e] = (r_d > 0.0);
+      num_active += active[e];
+   }
+
+   for (int it = 0; num_active > 0; it++)
+   {
+      if (it == interior_max_iter)
+      {
+         MFEM_WARNING("the interior solves did not converge in "
+                      << interior_max_iter << " iterations");
+         return;
+      }
+
+      // A_e p, the interior part is A_ii p
+      SetInteriors(p_i, 1.0, p_e);
+      ap_e = 0.0;
+      MultActiveElements(p_e, ap_e);
+
+      num_active = 0;
+      for (int e = 0; e < ne; e++)
+      {
+         if (!active[e]) { continue; }
+         const int *lex = int_lex.GetData();
+         const double *Ap = ap_e.GetData() + nd*e;
+         double p_Ap = 0.0;
+         for (int k = 0; k < ni; k++) { p_Ap += p_i(k + ni*e)*Ap[lex[k]]; }
+         const double alpha = rho(e)/p_Ap;
+         for (int k = 0; k < ni; k++)
+         {
+            const int i = k + ni*e;
+            z_i(i) += alpha*p_i(i);
+            r_i(i) -= alpha*Ap[lex[k]];
+         }
+         const double *r = r_i.GetData() + ni*e;
+         double *d = d_i.GetData() + ni*e;
+         Precondition(e, r, d);
+         double r_d = 0.0;
+         for (int k = 0; k < ni; k++) { r_d += r[k]*d[k]; }
+         if (r_d <= interior_rel_tol*interior_rel_tol*rho0(e))
+         {
+            active[e] = false;
+            continue;
+         }
+         num_active++;
+         const double beta = r_d/rho(e);
+         rho(e) = r_d;
+         for (int k = 0; k < ni; k++)
+         {
+            const int i = k + ni*e;
+            p_i(i) = d[k] + beta*p_i(i);
+         }
+      }
+   }
+}
+
+void PAStaticCondensation::Assemble()
+{
+   if (ni == 0) { return; }
+
+   // The diagonals of the element operators, restricted to the interiors
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   bool diag = true;
+   ranges = true;
+   for (int i = 0; i < integrators.Size(); i++)
+   {
+      diag = diag && integrators[i]->SupportsDiagonalPA();
+      ranges = ranges && integrators[i]->SupportsElementRanges();
+   }
+   if (diag)
+   {
+      y_e = 0.0;
+      for (int i = 0; i < integrators.Size(); i++)
+      {
+         integrators[i]->AssembleDiagonalPA(y_e);
+      }
+      for (int e = 0; e < ne; e++)
+      {
+         for (int k = 0; k < ni; k++)
+         {
+            inv_diag(k + ni*e) = 1.0/y_e(int_lex[k] + nd*e);
+         }
+      }
+   }
+   else
+   {
+      inv_diag = 1.0;
+   }
+
+   // Measure D = (S x S x S)^T A_ii (S x S x S) at the tensor product of the
+   // first eigenvectors, s_0 x s_0 x s_0, and where one factor is replaced by
+   // s_1. These are the interior parts of A_ii v, v = sum of these vectors,
+   // because the columns of S x S x S diagonalize A_ii.
+   const int n1 = fdm_S.Height();
+   const int probe[4] = { 0, 1, n1, n1*n1 };
+   const int nprobe = (n1 > 1) ? dim+1 : 1;
+   DenseMatrix V(ni, nprobe);
+   for (int j = 0; j < nprobe; j++)
+   {
+      for (int k = 0; k < ni; k++)
+      {
+         // k is the lexicographic index of the interior tensor (k0, k1, k2)
+         double v = 1.0;
+         for (int dir = 0, kk = k, pp = probe[j]; dir < dim; dir++)
+         {
+            v *= fdm_S(kk % n1, pp % n1);
+            kk /= n1;
+            pp /= n1;
+         }
+         V(k,j) = v;
+      }
+   }
+   for (int e = 0; e < ne; e++)
+   {
+      for (int k = 0; k < ni; k++)
+      {
+         double v = 0.0;
+         for (int j = 0; j < nprobe; j++) { v += V(k,j); }
+         p_i(k + ni*e) = v;
+      }
+   }
+   SetInteriors(p_i, 1.0, p_e);
+   ap_e = 0.0;
+   MultElements(p_e, ap_e);
+
+   double D[4], c[4];
+   for (int e = 0; e < ne; e++)
+   {
+      const double *Ap = ap_e.GetData() + nd*e;
+      for (int j = 0; j < nprobe; j++)
+      {
+         D[j] = 0.0;
+         for (int k = 0; k < ni; k++) { D[j] += V(k,j)*Ap[int_lex[k]]; }
+      }
+      // D(k0,k1,k2) = c_0 + c_1 lambda_k0 + c_2 lambda_k1 + c_3 lambda_k2
+      c[0] = D[0];
+      for (int dir = 1; dir < nprobe; dir++)
+      {
+         c[dir] = (D[dir] - D[0])/(fdm_lambda(1) - fdm_lambda(0));
+         c[0] -= c[dir]*fdm_lambda(0);
+      }
+      bool positive = true;
+      for (int k = 0; k < ni; k++)
+      {
+         double d = c[0];
+         for (int dir = 0, kk = k; dir < nprobe-1; dir++)
+         {
+            d += c[dir+1]*fdm_lambda(kk % n1);
+            kk /= n1;
+         }
+         positive = positive && (d > 0.0);
+         fdm_inv_eig(k + ni*e) = 1.0/d;
+      }
+      solver[e] = positive ? FDM_PCG : JACOBI_PCG;
+   }
+
+   // Check the fast diagonalization with a random right-hand side: the
+   // elements where it inverts A_ii are solved directly by it.
+   r_i.Randomize(1);
+   for (int e = 0; e < ne; e++)
+   {
+      if (solver[e] == FDM_PCG)
+      {
+         ApplyFDM(e, r_i.GetData() + ni*e, z_i.GetData() + ni*e);
+      }
+   }
+   SetInteriors(z_i, 1.0, p_e);
+   ap_e = 0.0;
+   MultElements(p_e, ap_e);
+   for (int e = 0; e < ne; e++)
+   {
+      if (solver[e] != FDM_PCG) { continue; }
+      const double *Az = ap_e.GetData() + nd*e;
+      const double *r = r_i.GetData() + ni*e;
+      double res = 0.0, norm = 0.0;
+      for (int k = 0; k < ni; k++)
+      {
+         res = std::max(res, fabs(Az[int_lex[k]] - r[k]));
+         norm = std::max(norm, fabs(r[k]));
+      }
+      if (res <= fdm_exact_tol*norm) { solver[e] = FDM; }
+   }
+}
+
+void PAStaticCondensation::Mult(const Vector &x, Vector &y) const
+{
+   // y_e = A_e x_b, i.e. [A_ib x_b, A_bb x_b]
+   SkeletonToElements(x, x_e);
+   y_e = 0.0;
+   MultElements(x_e, y_e);
+   // z_i = A_ii^{-1} A_ib x_b
+   for (int e = 0; e < ne; e++)
+   {
+      for (int k = 0; k < ni; k++)
+      {
+         z_i(k + ni*e) = y_e(int_lex[k] + nd*e);
+      }
+   }
+   SolveInteriors(z_i);
+   // y_e -= A_e z_i, the skeleton part is A_bb x_b - A_bi z_i
+   SetInteriors(z_i, -1.0, x_e);
+   MultElements(x_e, y_e);
+   elem_restrict.MultTranspose(y_e, y_l);
+   y_l.GetSubVector(sk_ldof, y);
+}
+
+void PAStaticCondensation::ReduceRHS(const Vector &b, Vector &sc_b) const
+{
+   b.GetSubVector(int_ldof, z_i);
+   SolveInteriors(z_i);
+   SetInteriors(z_i, 1.0, x_e);
+   y_e = 0.0;
+   MultElements(x_e, y_e);
+   elem_restrict.MultTranspose(y_e, y_l);
+   sc_b.SetSize(height);
+   for (int i = 0; i < height; i++)
+   {
+      sc_b(i) = b(sk_ldof[i]) - y_l(sk_ldof[i]);
+   }
+}
+
+void PAStaticCondensation::ReduceSolution(const Vector &sol,
+                                          Vector &sc_sol) const
+{
+   sc_sol.SetSize(height);
+   sol.GetSubVector(sk_ldof, sc_sol);
+}
+
+void PAStaticCondensation::SetEssentialTrueDofs(
+   const Array<int> &ess_tdof_list)
+{
+   ess_rtdof_list.SetSize(ess_tdof_list.Size());
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      const int rdof = ldof_sk[ess_tdof_list[i]];
+      MFEM_VERIFY(rdof >= 0, "essential dof " << ess_tdof_list[i]
+                  << " is an element interior dof");
+      ess_rtdof_list[i] = rdof;
+   }
+}
+
+void PAStaticCondensation::ComputeSolution(const Vector &b,
+                                           const Vector &sc_sol,
+                                           Vector &sol) const
+{
+   // sol_i = A_ii^{-1} (b_i - A_ib sc_sol)
+   SkeletonToElements(sc_sol, x_e);
+   y_e = 0.0;
+   MultElements(x_e, y_e);
+   for (int e = 0; e < ne; e++)
+   {
+      for (int k = 0; k < ni; k++)
+      {
+         z_i(k + ni*e) = b(int_ldof[k + ni*e]) - y_e(int_lex[k] + nd*e);
+      }
+   }
+   SolveInteriors(z_i);
+   sol.SetSize(x_l.Size());
+   sol.SetSubVector(sk_ldof, sc_sol);
+   sol.SetSubVector(int_ldof, z_i);
+}
+
+#ifdef MFEM_USE_MPI
+PAOverlapOperator::PAOverlapOperator(BilinearForm *form,
+                                     const ElemRestriction &er,
+                                     const ConformingProlongationOperator &cP)
+   : Operator(cP.Width()), a(form), elem_restrict(er), P(cP),
+     x_l(cP.Height()), y_l(cP.Height()), x_e(er.nedofs*er.vdim),
+     y_e(er.nedofs*er.vdim)
+{
+   const FiniteElementSpace &fes = *a->FESpace();
+   const Array<int> &ext_ldofs = P.GetExternalLDofs();
+   Array<bool> is_ext(fes.GetNDofs());
+   is_ext = false;
+   for (int i = 0; i < ext_ldofs.Size(); i++)
+   {
+      is_ext[fes.VDofToDof(ext_ldofs[i])] = true;
+   }
+   for (int i = 0; i < is_ext.Size(); i++)
+   {
+      if (is_ext[i]) { ext_dofs.Append(i); }
+   }
+
+   // Split the elements into contiguous ranges of interior and boundary
+   // elements
+   const Table &elem_dof = fes.GetElementToDofTable();
+   const int ne = fes.GetNE();
+   for (int e = 0; e < ne; e++)
+   {
+      const int *dofs = elem_dof.GetRow(e);
+      bool bdr = false;
+      for (int j = 0; j < elem_dof.RowSize(e) && !bdr; j++)
+      {
+         bdr = is_ext[dofs[j]];
+      }
+      Array<int> &ranges = bdr ? bdr_ranges : int_ranges;
+      const int n = ranges.Size();
+      if (n && ranges[n-1] == e) { ranges[n-1] = e+1; }
+      else { ranges.Append(e); ranges.Append(e+1); }
+   }
+   // The external entries of x_l are used before they are received
+   x_l = 0.0;
+}
+
+bool PAOverlapOperator::Supports(BilinearForm &form)
+{
+   if (Device::IsEnabled()) { return false; }
+   Array<BilinearFormIntegrator*> &integrators = *form.GetDBFI();
+   for (int i = 0; i < integrators.Size(); i++)
+   {
+      if (!integrators[i]->SupportsElementRanges()) { return false; }
+   }
+   return true;
+}
+
+int PAOverlapOperator::GetNumInteriorElements() const
+{
+   int n = 0;
+   for (int i = 0; i < int_ranges.Size(); i += 2)
+   {
+      n += int_ranges[i+1] - int_ranges[i];
+   }
+   return n;
+}
+
+void PAOverlapOperator::MultElements(const Array<int> &ranges) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); i++)
+   {
+      for (int r = 0; r < ranges.Size(); r += 2)
+      {
+         integrators[i]->MultAssembled(x_e, y_e, ranges[r], ranges[r+1]);
+      }
+   }
+}
+
+void PAOverlapOperator::Mult(const Vector &x, Vector &y) const
+{
+   // Interior elements, while the shared dofs are exchanged
+   P.MultBegin(x, x_l);
+   elem_restrict.Mult(x_l, x_e);
+   y_e = 0.0;
+   MultElements(int_ranges);
+   P.MultEnd(x_l);
+
+   // Boundary elements, then send their contributions to the external dofs
+   elem_restrict.MultDofs(ext_dofs, x_l, x_e);
+   MultElements(bdr_ranges);
+   elem_restrict.MultTransposeDofs(ext_dofs, y_e, y_l);
+   P.MultTransposeBegin(y_l);
+
+   // Gather the owned dofs while the contributions are reduced
+   elem_restrict.MultTranspose(y_e, y_l);
+   P.MultTransposeEnd(y_l, y);
+}
+#endif
+
+
 ElemRestriction::ElemRestriction(const FiniteElementSpace &f)
    : fes(f),
      ne(fes.GetNE()),
@@ -233,4 +983,45 @@ void ElemRestriction::MultTranspose(const Vector& x, Vector& y) const
    });
 }
 
+void ElemRestriction::MultDofs(const Array<int> &dofs, const Vector &x,
+                               Vector &y) const
+{
+   const int vd = vdim;
+   const bool t = byvdim;
+   for (int k = 0; k < dofs.Size(); k++)
+   {
+      const int i = dofs[k];
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = x(t ? c+vd*i : i+ndofs*c);
+         for (int j = offsets[i]; j < offsets[i+1]; ++j)
+         {
+            const int idx_j = indices[j];
+            y(t ? c+vd*idx_j : idx_j+nedofs*c) = dofValue;
+         }
+      }
+   }
+}
+
+void ElemRestriction::MultTransposeDofs(const Array<int> &dofs,
+                                        const Vector &x, Vector &y) const
+{
+   const int vd = vdim;
+   const bool t = byvdim;
+   for (int k = 0; k < dofs.Size(); k++)
+   {
+      const int i = dofs[k];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offsets[i]; j < offsets[i+1]; ++j)
+         {
+            const int idx_j = indices[j];
+            dofValue += x(t ? c+vd*idx_j : idx_j+nedofs*c);
+         }
+         y(t ? c+vd*i : i+ndofs*c) = dofValue;
+      }
+   }
+}
+
 } // namespace mfem
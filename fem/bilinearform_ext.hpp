@@ -19,6 +19,9 @@ namespace mfem
 {
 
 class BilinearForm;
+#ifdef MFEM_USE_MPI
+class ConformingProlongationOperator;
+#endif
 
 /// Element restriction operator
 class ElemRestriction: public Operator
@@ -37,6 +40,16 @@ public:
    ElemRestriction(const FiniteElementSpace&);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** Same as Mult(), restricted to the (scalar) dofs in the list @a dofs: only
+       the E-vector entries associated with them are set. Host only. */
+   void MultDofs(const Array<int> &dofs, const Vector &x, Vector &y) const;
+
+   /** Same as MultTranspose(), restricted to the (scalar) dofs in the list
+       @a dofs: only the L-vector entries associated with them are set. Host
+       only. */
+   void MultTransposeDofs(const Array<int> &dofs, const Vector &x,
+                          Vector &y) const;
 };
 
 
@@ -62,6 +75,13 @@ public:
                                  OperatorHandle &A, Vector &X, Vector &B,
                                  int copy_interior = 0) = 0;
    virtual void Update() = 0;
+
+   /// Enable static condensation, if supported by the extension.
+   virtual void EnableStaticCondensation()
+   { MFEM_WARNING("Static condensation not supported for this assembly level"); }
+
+   /// Return true if static condensation is enabled in the extension.
+   virtual bool StaticCondensationIsEnabled() const { return false; }
 };
 
 /// Data and methods for fully-assembled bilinear forms
@@ -102,6 +122,170 @@ public:
    ~EABilinearFormExtension() {}
 };
 
+/** @brief Matrix-free static condensation of a partially assembled
+    BilinearForm. */
+/** The element interior dofs are eliminated as in class StaticCondensation,
+    but the Schur complement S = A_bb - A_bi A_ii^{-1} A_ib, acting on the
+    skeleton (non-interior) dofs, is not assembled: its action uses two
+    applications of the partially assembled element operators and solves with
+    the element interior blocks A_ii.
+
+    The interior blocks are not formed either. They are inverted by fast
+    diagonalization: with the 1D interior mass and stiffness matrices M and K,
+    and the generalized eigenvectors S of K s = lambda M s, the block of a
+    rectangular element with constant coefficients is, in 3D,
+
+        A_ii = (S^-T x S^-T x S^-T) D (S^-1 x S^-1 x S^-1),
+        D = a_0 I + a_1 L x I x I + a_2 I x L x I + a_3 I x I x L,
+
+    where x is the Kronecker product and L = diag(lambda). The scalars a_k of
+    each element are measured with one application of the PA kernels in
+    Assemble(), so A_ii^{-1} = (S x S x S) D^{-1} (S^T x S^T x S^T) costs
+    O(p^(d+1)) operations per element and stores ni = (p-1)^d values. A second
+    application checks this inverse on every element. The elements where it is
+    not exact, e.g. curved or skewed ones, or with variable coefficients, are
+    solved by a batched conjugate gradient method preconditioned with it (or
+    with the diagonals of A_ii, if D is not positive), which applies the PA
+    kernels only to the elements that have not converged yet.
+
+    The reduced dofs are the skeleton dofs of the space, in increasing order.
+    The space must be scalar, conforming and not parallel, and use tensor
+    product elements (as required by partial assembly). The operator is
+    applied on the host. */
+class PAStaticCondensation : public Operator
+{
+protected:
+   BilinearForm *a;                     ///< Not owned
+   const ElemRestriction &elem_restrict; ///< Not owned
+   int ne, nd, ni; ///< Number of elements, element dofs and interior dofs
+
+   Array<int> int_lex;  ///< E-vector (lexicographic) indices of the interior
+   Array<int> int_ldof; ///< L-dofs of the element interiors, (ni, ne)
+   Array<int> sk_ldof;  ///< L-dofs of the skeleton, i.e. the reduced dofs
+   Array<int> ldof_sk;  ///< Map from L-dofs to reduced dofs, or -1
+   Array<int> ess_rtdof_list;
+
+   /// How the interior block of an element is solved
+   enum InteriorSolver { JACOBI_PCG, FDM_PCG, FDM };
+
+   int dim;            ///< Reference dimension of the elements
+   DenseMatrix fdm_S;  ///< 1D generalized eigenvectors, (p-1, p-1)
+   DenseMatrix fdm_St; ///< Transpose of fdm_S
+   Vector fdm_lambda;  ///< 1D generalized eigenvalues
+   Vector fdm_inv_eig; ///< Inverse eigenvalues D^{-1} of the interiors, (ni, ne)
+   Vector inv_diag;    ///< Inverse diagonals of the interior blocks, (ni, ne)
+   Array<int> solver;  ///< InteriorSolver of each element
+   bool ranges;        ///< The integrators support element ranges
+
+   mutable Vector x_l, y_l, x_e, y_e, z_i;
+   /// Work vectors of the interior solves
+   mutable Vector r_i, d_i, p_i, rho, rho0, p_e, ap_e, fdm_u, fdm_v;
+   mutable Array<bool> active;
+   mutable Array<int> active_ranges;
+
+   /// y_e += A_e x_e, with the domain integrators of the form.
+   void MultElements(Vector &x_e, Vector &y_e) const;
+
+   /** y_e += A_e x_e on the elements e where active[e] is true, or on all
+       elements if the integrators do not support element ranges. */
+   void MultActiveElements(Vector &x_e, Vector &y_e) const;
+
+   /// Set @a d to the inverse of the interior block of element @a e times @a r.
+   void ApplyFDM(int e, const double *r, double *d) const;
+
+   /// Apply the preconditioner of the interior solve of element @a e.
+   void Precondition(int e, const double *r, double *d) const;
+
+   /** Set x_e to zero except in the element interiors, where it is set to
+       @a s times z_i. */
+   void SetInteriors(const Vector &z_i, double s, Vector &x_e) const;
+
+   /// Set x_e to the E-vector of the skeleton vector @a x_s.
+   void SkeletonToElements(const Vector &x_s, Vector &x_e) const;
+
+   /** Replace @a z_i with A_ii^{-1} z_i in all element interiors, see the
+       class description. */
+   void SolveInteriors(Vector &z_i) const;
+
+public:
+   PAStaticCondensation(BilinearForm *form, const ElemRestriction &er);
+
+   /// Return the number of private (element interior) dofs.
+   int GetNPrDofs() const { return ne*ni; }
+   /// Return the number of reduced (skeleton) dofs.
+   int GetNExDofs() const { return sk_ldof.Size(); }
+   /// Return true if the elements have interior dofs.
+   bool ReducesTrueVSize() const { return (ni > 0); }
+
+   /** Set up the interior solves, i.e. the fast diagonalization of A_ii and
+       the diagonals of A_ii. The integrators of the form must be assembled. */
+   void Assemble();
+
+   /// Apply the Schur complement operator.
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// Set @a sc_b = b_s - A_bi A_ii^{-1} b_i.
+   void ReduceRHS(const Vector &b, Vector &sc_b) const;
+
+   /// Restrict the L-vector @a sol to the skeleton dofs, @a sc_sol.
+   void ReduceSolution(const Vector &sol, Vector &sc_sol) const;
+
+   /** Set the essential true dofs, stored as a list of essential reduced
+       dofs. The essential dofs cannot be element interior dofs. */
+   void SetEssentialTrueDofs(const Array<int> &ess_tdof_list);
+
+   /// Return the list of essential reduced dofs.
+   const Array<int> &GetEssentialReducedTrueDofs() const
+   { return ess_rtdof_list; }
+
+   /** Given the skeleton solution @a sc_sol, compute the full solution @a sol
+       with sol_i = A_ii^{-1} (b_i - A_ib sc_sol). */
+   void ComputeSolution(const Vector &b, const Vector &sc_sol,
+                        Vector &sol) const;
+};
+
+#ifdef MFEM_USE_MPI
+/** @brief The true dof action P^T A P of a partially assembled BilinearForm on
+    a conforming parallel space, overlapping the communication of P and P^T
+    with the element computations. */
+/** The elements are split into interior elements, all of whose dofs are
+    available locally, and boundary elements, which use dofs owned by other
+    processors. The interior elements are computed while the shared dofs are
+    being exchanged, and the contributions of the boundary elements to the
+    external dofs are sent before the interior contributions are gathered.
+
+    The domain integrators must support element ranges, see
+    BilinearFormIntegrator::SupportsElementRanges(). The operator is applied
+    on the host. */
+class PAOverlapOperator : public Operator
+{
+protected:
+   BilinearForm *a;                      ///< Not owned
+   const ElemRestriction &elem_restrict; ///< Not owned
+   const ConformingProlongationOperator &P;
+   Array<int> int_ranges; ///< Interior element ranges, [begin, end) pairs
+   Array<int> bdr_ranges; ///< Boundary element ranges, [begin, end) pairs
+   Array<int> ext_dofs;   ///< Dofs owned by other processors
+   mutable Vector x_l, y_l, x_e, y_e;
+
+   /// y_e += A_e x_e on the elements in the given ranges.
+   void MultElements(const Array<int> &ranges) const;
+
+public:
+   PAOverlapOperator(BilinearForm *form, const ElemRestriction &er,
+                     const ConformingProlongationOperator &P);
+
+   /** Return true if the domain integrators of @a form support element ranges
+       and the operator is applied on the host. */
+   static bool Supports(BilinearForm &form);
+
+   /// Return the number of interior elements.
+   int GetNumInteriorElements() const;
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+#endif
+
 /// Data and methods for partially-assembled bilinear forms
 class PABilinearFormExtension : public BilinearFormExtension
 {
@@ -109,6 +293,7 @@ protected:
    const FiniteElementSpace *trialFes, *testFes;
    mutable Vector localX, localY;
    ElemRestriction *elem_restrict;
+   PAStaticCondensation *static_cond; ///< Owned
 
 public:
    PABilinearFormExtension(BilinearForm*);
@@ -119,11 +304,19 @@ public:
                          Vector &x, Vector &b,
                          OperatorHandle &A, Vector &X, Vector &B,
                          int copy_interior = 0);
+   virtual void RecoverFEMSolution(const Vector &X, const Vector &b,
+                                   Vector &x);
 
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
    void Update();
 
+   /** With static condensation, FormSystemMatrix() and FormLinearSystem()
+       return the PAStaticCondensation operator on the skeleton dofs and
+       RecoverFEMSolution() computes the element interior dofs. */
+   virtual void EnableStaticCondensation();
+   virtual bool StaticCondensationIsEnabled() const { return static_cond; }
+
    ~PABilinearFormExtension();
 };
 
@@ -37,6 +37,18 @@ void BilinearFormIntegrator::MultAssembledTranspose(Vector&, Vector&)
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::MultAssembled(Vector&, Vector&, int, int)
+{
+   mfem_error ("BilinearFormIntegrator::MultAssembled (element range)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AssembleDiagonalPA(Vector&)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleDiagonalPA (...)\n"
+               "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans,
    DenseMatrix &elmat )
@@ -421,18 +433,25 @@ void DiffusionIntegrator::AssembleElementMatrix
       }
    }
 
+   // The reference gradients are the same for all elements of this type
+   const ShapeTable *table = el.GetShapeTable(*ir);
+
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
-      el.CalcDShape(ip, dshape);
+      if (!table) { el.CalcDShape(ip, dshape); }
+      // Read-only view of the shared table
+      const DenseMatrix dshape_i(const_cast<double*>(
+                                    table ? table->GetDShape(i) :
+                                    dshape.Data()), nd, dim);
 
       Trans.SetIntPoint(&ip);
       w = Trans.Weight();
       w = ip.weight / (square ? w : w*w*w);
       // AdjugateJacobian = / adj(J),         if J is square
       //                    \ adj(J^t.J).J^t, otherwise
-      Mult(dshape, Trans.AdjugateJacobian(), dshapedxt);
+      Mult(dshape_i, Trans.AdjugateJacobian(), dshapedxt);
       if (!MQ)
       {
          if (Q)
@@ -506,11 +525,10 @@ void DiffusionIntegrator::AssembleElementMatrix2(
       test_fe.CalcDShape(ip, te_dshape);
 
       Trans.SetIntPoint(&ip);
-      CalcAdjugate(Trans.Jacobian(), invdfdx);
       w = Trans.Weight();
       w = ip.weight / (square ? w : w*w*w);
-      Mult(dshape, invdfdx, dshapedxt);
-      Mult(te_dshape, invdfdx, te_dshapedxt);
+      Mult(dshape, Trans.AdjugateJacobian(), dshapedxt);
+      Mult(te_dshape, Trans.AdjugateJacobian(), te_dshapedxt);
       // invdfdx, dshape, and te_dshape no longer needed
       if (!MQ)
       {
@@ -582,7 +600,7 @@ void DiffusionIntegrator::AssembleElementVector(
       el.CalcDShape(ip, dshape);
 
       Tr.SetIntPoint(&ip);
-      CalcAdjugate(Tr.Jacobian(), invdfdx); // invdfdx = adj(J)
+      invdfdx = Tr.AdjugateJacobian(); // invdfdx = adj(J)
       w = ip.weight / Tr.Weight();
 
       if (!MQ)
@@ -638,8 +656,7 @@ void DiffusionIntegrator::ComputeElementFlux
       dshape.MultTranspose(u, vec);
 
       Trans.SetIntPoint (&ip);
-      CalcInverse(Trans.Jacobian(), invdfdx);
-      invdfdx.MultTranspose(vec, pointflux);
+      Trans.InverseJacobian().MultTranspose(vec, pointflux);
 
       if (!MQ)
       {
@@ -764,11 +781,17 @@ void MassIntegrator::AssembleElementMatrix
       }
    }
 
+   // The shape functions are the same for all elements of this type
+   const ShapeTable *table = el.GetShapeTable(*ir);
+
    elmat = 0.0;
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
-      el.CalcShape(ip, shape);
+      if (!table) { el.CalcShape(ip, shape); }
+      // Read-only view of the shared table
+      const Vector shape_i(const_cast<double*>(table ? table->GetShape(i) :
+                                               shape.GetData()), nd);
 
       Trans.SetIntPoint (&ip);
       w = Trans.Weight() * ip.weight;
@@ -777,7 +800,7 @@ void MassIntegrator::AssembleElementMatrix
          w *= Q -> Eval(Trans, ip);
       }
 
-      AddMult_a_VVt(w, shape, elmat);
+      AddMult_a_VVt(w, shape_i, elmat);
    }
 }
 
@@ -876,12 +899,11 @@ void ConvectionIntegrator::AssembleElementMatrix(
    int dim = el.GetDim();
 
 #ifdef MFEM_THREAD_SAFE
-   DenseMatrix dshape, adjJ, Q_ir;
+   DenseMatrix dshape, Q_ir;
    Vector shape, vec2, BdFidxT;
 #endif
    elmat.SetSize(nd);
    dshape.SetSize(nd,dim);
-   adjJ.SetSize(dim);
    shape.SetSize(nd);
    vec2.SetSize(dim);
    BdFidxT.SetSize(nd);
@@ -905,11 +927,10 @@ void ConvectionIntegrator::AssembleElementMatrix(
       el.CalcShape(ip, shape);
 
       Trans.SetIntPoint(&ip);
-      CalcAdjugate(Trans.Jacobian(), adjJ);
       Q_ir.GetColumnReference(i, vec1);
       vec1 *= alpha * ip.weight;
 
-      adjJ.Mult(vec1, vec2);
+      Trans.AdjugateJacobian().Mult(vec1, vec2);
       dshape.Mult(vec2, BdFidxT);
 
       AddMultVWt(shape, BdFidxT, elmat);
@@ -925,7 +946,6 @@ void GroupConvectionIntegrator::AssembleElementMatrix(
 
    elmat.SetSize(nd);
    dshape.SetSize(nd,dim);
-   adjJ.SetSize(dim);
    shape.SetSize(nd);
    grad.SetSize(nd,dim);
 
@@ -946,9 +966,7 @@ void GroupConvectionIntegrator::AssembleElementMatrix(
       el.CalcShape(ip, shape);
 
       Trans.SetIntPoint(&ip);
-      CalcAdjugate(Trans.Jacobian(), adjJ);
-
-      Mult(dshape, adjJ, grad);
+      Mult(dshape, Trans.AdjugateJacobian(), grad);
 
       double w = alpha * ip.weight;
 
@@ -1192,12 +1210,10 @@ void VectorFEWeakDivergenceIntegrator::AssembleElementMatrix2(
    DenseMatrix dshape(test_nd, dim);
    DenseMatrix dshapedxt(test_nd, dim);
    DenseMatrix vshape(trial_nd, dim);
-   DenseMatrix invdfdx(dim);
 #else
    dshape.SetSize(test_nd, dim);
    dshapedxt.SetSize(test_nd, dim);
    vshape.SetSize(trial_nd, dim);
-   invdfdx.SetSize(dim);
 #endif
 
    elmat.SetSize(test_nd, trial_nd);
@@ -1241,8 +1257,7 @@ void VectorFEWeakDivergenceIntegrator::AssembleElementMatrix2(
       test_fe.CalcDShape(ip, dshape);
 
       Trans.SetIntPoint(&ip);
-      CalcAdjugate(Trans.Jacobian(), invdfdx);
-      Mult(dshape, invdfdx, dshapedxt);
+      Mult(dshape, Trans.AdjugateJacobian(), dshapedxt);
 
       trial_fe.CalcVShape(Trans, vshape);
 
@@ -1625,12 +1640,11 @@ void VectorCurlCurlIntegrator::AssembleElementMatrix(
 
 #ifdef MFEM_THREAD_SAFE
    DenseMatrix dshape_hat(dof, dim), dshape(dof, dim);
-   DenseMatrix curlshape(dim*dof, cld), Jadj(dim);
+   DenseMatrix curlshape(dim*dof, cld);
 #else
    dshape_hat.SetSize(dof, dim);
    dshape.SetSize(dof, dim);
    curlshape.SetSize(dim*dof, cld);
-   Jadj.SetSize(dim);
 #endif
 
    const IntegrationRule *ir = IntRule;
@@ -1649,10 +1663,9 @@ void VectorCurlCurlIntegrator::AssembleElementMatrix(
       el.CalcDShape(ip, dshape_hat);
 
       Trans.SetIntPoint(&ip);
-      CalcAdjugate(Trans.Jacobian(), Jadj);
       double w = ip.weight / Trans.Weight();
 
-      Mult(dshape_hat, Jadj, dshape);
+      Mult(dshape_hat, Trans.AdjugateJacobian(), dshape);
       dshape.GradToCurl(curlshape);
 
       if (Q)
@@ -1671,11 +1684,10 @@ double VectorCurlCurlIntegrator::GetElementEnergy(
    int dof = el.GetDof();
 
 #ifdef MFEM_THREAD_SAFE
-   DenseMatrix dshape_hat(dof, dim), Jadj(dim), grad_hat(dim), grad(dim);
+   DenseMatrix dshape_hat(dof, dim), grad_hat(dim), grad(dim);
 #else
    dshape_hat.SetSize(dof, dim);
 
-   Jadj.SetSize(dim);
    grad_hat.SetSize(dim);
    grad.SetSize(dim);
 #endif
@@ -1698,10 +1710,9 @@ double VectorCurlCurlIntegrator::GetElementEnergy(
       MultAtB(elfun_mat, dshape_hat, grad_hat);
 
       Tr.SetIntPoint(&ip);
-      CalcAdjugate(Tr.Jacobian(), Jadj);
       double w = ip.weight / Tr.Weight();
 
-      Mult(grad_hat, Jadj, grad);
+      Mult(grad_hat, Tr.AdjugateJacobian(), grad);
 
       if (dim == 2)
       {
@@ -1985,7 +1996,6 @@ void VectorDivergenceIntegrator::AssembleElementMatrix2(
 
    dshape.SetSize (trial_dof, dim);
    gshape.SetSize (trial_dof, dim);
-   Jadj.SetSize (dim);
    divshape.SetSize (dim*trial_dof);
    shape.SetSize (test_dof);
 
@@ -2008,9 +2018,7 @@ void VectorDivergenceIntegrator::AssembleElementMatrix2(
       test_fe.CalcShape (ip, shape);
 
       Trans.SetIntPoint (&ip);
-      CalcAdjugate(Trans.Jacobian(), Jadj);
-
-      Mult (dshape, Jadj, gshape);
+      Mult (dshape, Trans.AdjugateJacobian(), gshape);
 
       gshape.GradToDiv (divshape);
 
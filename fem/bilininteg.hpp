@@ -37,6 +37,23 @@ public:
    /// Method for partially assembled transposed action.
    virtual void MultAssembledTranspose(Vector&, Vector&);
 
+   /** @brief Method for partially assembled action restricted to the elements
+       with indices in [e_begin, e_end). */
+   /** The vectors are E-vectors for all elements. Only supported on the host,
+       when SupportsElementRanges() returns true. */
+   virtual void MultAssembled(Vector&, Vector&, int e_begin, int e_end);
+
+   /// Return true if MultAssembled() on element ranges is implemented.
+   virtual bool SupportsElementRanges() const { return false; }
+
+   /** @brief Add the diagonals of the partially assembled element matrices to
+       the E-vector @a diag. */
+   /** Only supported when SupportsDiagonalPA() returns true. */
+   virtual void AssembleDiagonalPA(Vector &diag);
+
+   /// Return true if AssembleDiagonalPA() is implemented.
+   virtual bool SupportsDiagonalPA() const { return false; }
+
    /// Given a particular Finite Element computes the element matrix elmat.
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
@@ -1688,6 +1705,10 @@ public:
    /// PA extension
    virtual void Assemble(const FiniteElementSpace&);
    virtual void MultAssembled(Vector&, Vector&);
+   virtual void MultAssembled(Vector&, Vector&, int e_begin, int e_end);
+   virtual bool SupportsElementRanges() const { return true; }
+   virtual void AssembleDiagonalPA(Vector &diag);
+   virtual bool SupportsDiagonalPA() const { return true; }
 
    virtual ~DiffusionIntegrator();
 };
@@ -1724,6 +1745,10 @@ public:
    /// PA extension
    virtual void Assemble(const FiniteElementSpace&);
    virtual void MultAssembled(Vector&, Vector&);
+   virtual void MultAssembled(Vector&, Vector&, int e_begin, int e_end);
+   virtual bool SupportsElementRanges() const { return true; }
+   virtual void AssembleDiagonalPA(Vector &diag);
+   virtual bool SupportsDiagonalPA() const { return true; }
 
    virtual ~MassIntegrator();
 };
@@ -1746,7 +1771,7 @@ class ConvectionIntegrator : public BilinearFormIntegrator
 {
 private:
 #ifndef MFEM_THREAD_SAFE
-   DenseMatrix dshape, adjJ, Q_ir;
+   DenseMatrix dshape, Q_ir;
    Vector shape, vec2, BdFidxT;
 #endif
    VectorCoefficient &Q;
@@ -1764,7 +1789,7 @@ public:
 class GroupConvectionIntegrator : public BilinearFormIntegrator
 {
 private:
-   DenseMatrix dshape, adjJ, Q_nodal, grad;
+   DenseMatrix dshape, Q_nodal, grad;
    Vector shape;
    VectorCoefficient &Q;
    double alpha;
@@ -1863,7 +1888,6 @@ private:
    DenseMatrix dshape;
    DenseMatrix dshapedxt;
    DenseMatrix vshape;
-   DenseMatrix invdfdx;
 #endif
 public:
    VectorFEWeakDivergenceIntegrator() { Q = NULL; }
@@ -1961,7 +1985,7 @@ class VectorCurlCurlIntegrator: public BilinearFormIntegrator
 {
 private:
 #ifndef MFEM_THREAD_SAFE
-   DenseMatrix dshape_hat, dshape, curlshape, Jadj, grad_hat, grad;
+   DenseMatrix dshape_hat, dshape, curlshape, grad_hat, grad;
 #endif
    Coefficient *Q;
 
@@ -2027,7 +2051,6 @@ private:
    Vector divshape;
    DenseMatrix dshape;
    DenseMatrix gshape;
-   DenseMatrix Jadj;
 
 public:
    VectorDivergenceIntegrator() { Q = NULL; }
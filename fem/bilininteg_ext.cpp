@@ -252,8 +252,35 @@ void DiffusionIntegrator::Assemble(const FiniteElementSpace &fes)
    geom = GeometryExtension::Get(fes,*ir);
    maps = DofToQuad::Get(fes, fes, *ir);
    vec.SetSize(symmDims * nq * ne);
-   const double coeff = static_cast<ConstantCoefficient*>(Q)->constant;
-   PADiffusionSetup(dim, dofs1D, quad1D, ne, maps->W, geom->J, coeff, vec);
+   MFEM_VERIFY(MQ == NULL, "matrix coefficients are not supported");
+   ConstantCoefficient *const_coeff = dynamic_cast<ConstantCoefficient*>(Q);
+   if (Q == NULL || const_coeff)
+   {
+      const double coeff = const_coeff ? const_coeff->constant : 1.0;
+      PADiffusionSetup(dim, dofs1D, quad1D, ne, maps->W, geom->J, coeff, vec);
+      return;
+   }
+   // Variable coefficient: evaluate it at all quadrature points and scale the
+   // geometric factors computed with a unit coefficient
+   Vector qcoeff;
+   Q->Eval(qcoeff, *fes.GetMesh(), *ir);
+   qcoeff.Push();
+   PADiffusionSetup(dim, dofs1D, quad1D, ne, maps->W, geom->J, 1.0, vec);
+   const int NE = ne;
+   const int NQ = nq;
+   const int SD = symmDims;
+   const DeviceMatrix C(qcoeff.GetData(), NQ, NE);
+   DeviceTensor<3> y(vec.GetData(), SD, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         for (int s = 0; s < SD; ++s)
+         {
+            y(s,q,e) *= C(q,e);
+         }
+      }
+   });
 }
 
 #ifdef MFEM_USE_OCCA
@@ -736,10 +763,171 @@ void DiffusionIntegrator::MultAssembled(Vector &x, Vector &y)
                     vec, x, y);
 }
 
+void DiffusionIntegrator::MultAssembled(Vector &x, Vector &y,
+                                        int e_begin, int e_end)
+{
+   MFEM_ASSERT(0 <= e_begin && e_begin <= e_end && e_end <= ne, "");
+   if (e_begin == e_end) { return; }
+   // The kernels are applied to the slices of the element data
+   const int nd = x.Size()/ne, nqd = vec.Size()/ne;
+   PADiffusionApply(dim, dofs1D, quad1D, e_end - e_begin,
+                    maps->B, maps->G, maps->Bt, maps->Gt,
+                    vec.GetData() + nqd*e_begin, x.GetData() + nd*e_begin,
+                    y.GetData() + nd*e_begin);
+}
+
+// PA Diffusion Diagonal 2D kernel
+static void PADiffusionDiagonal2D(const int NE,
+                                  const double* b,
+                                  const double* g,
+                                  const double* _op,
+                                  double* _y,
+                                  const int D1D,
+                                  const int Q1D)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const DeviceMatrix B(b, Q1D, D1D);
+   const DeviceMatrix G(g, Q1D, D1D);
+   const DeviceTensor<3> op(_op, 3, Q1D*Q1D, NE);
+   DeviceTensor<3> y(_y, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      // Contract the x direction: the products of the basis functions of
+      // (Dx)^2, Dx*Dy and (Dy)^2 times the quadrature data
+      double QD[3][MAX_Q1D][MAX_D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            QD[0][qy][dx] = QD[1][qy][dx] = QD[2][qy][dx] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = QUAD_2D_ID(qx, qy);
+               const double bx = B(qx,dx), gx = G(qx,dx);
+               QD[0][qy][dx] += gx * gx * op(0,q,e);
+               QD[1][qy][dx] += gx * bx * op(1,q,e);
+               QD[2][qy][dx] += bx * bx * op(2,q,e);
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double by = B(qy,dy), gy = G(qy,dy);
+               s += QD[0][qy][dx] * by * by + 2.0 * QD[1][qy][dx] * by * gy +
+                    QD[2][qy][dx] * gy * gy;
+            }
+            y(dx,dy,e) += s;
+         }
+      }
+   });
+}
+
+// PA Diffusion Diagonal 3D kernel
+static void PADiffusionDiagonal3D(const int NE,
+                                  const double* b,
+                                  const double* g,
+                                  const double* _op,
+                                  double* _y,
+                                  const int D1D,
+                                  const int Q1D)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const DeviceMatrix B(b, Q1D, D1D);
+   const DeviceMatrix G(g, Q1D, D1D);
+   const DeviceTensor<3> op(_op, 6, Q1D*Q1D*Q1D, NE);
+   DeviceTensor<4> y(_y, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      // The symmetric entries (i,j) of op, i <= j, stored as 11, 12, 13, 22,
+      // 23, 33. The derivative direction i uses G in direction i, B otherwise.
+      const int I[6] = { 0, 0, 0, 1, 1, 2 };
+      const int J[6] = { 0, 1, 2, 1, 2, 2 };
+      double QQD[MAX_Q1D][MAX_Q1D][MAX_D1D];
+      double QDD[MAX_Q1D][MAX_D1D][MAX_D1D];
+      for (int k = 0; k < 6; ++k)
+      {
+         const int i = I[k], j = J[k];
+         const double s = (i == j) ? 1.0 : 2.0;
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const int q = QUAD_3D_ID(qx, qy, qz);
+                     const double fi = (i == 0) ? G(qx,dx) : B(qx,dx);
+                     const double fj = (j == 0) ? G(qx,dx) : B(qx,dx);
+                     u += fi * fj * op(k,q,e);
+                  }
+                  QQD[qz][qy][dx] = u;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     const double fi = (i == 1) ? G(qy,dy) : B(qy,dy);
+                     const double fj = (j == 1) ? G(qy,dy) : B(qy,dy);
+                     u += fi * fj * QQD[qz][qy][dx];
+                  }
+                  QDD[qz][dy][dx] = u;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     const double fi = (i == 2) ? G(qz,dz) : B(qz,dz);
+                     const double fj = (j == 2) ? G(qz,dz) : B(qz,dz);
+                     u += fi * fj * QDD[qz][dy][dx];
+                  }
+                  y(dx,dy,dz,e) += s * u;
+               }
+            }
+         }
+      }
+   });
+}
+
+void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
+{
+   if (dim == 2)
+   {
+      PADiffusionDiagonal2D(ne, maps->B, maps->G, vec, diag, dofs1D, quad1D);
+   }
+   else if (dim == 3)
+   {
+      PADiffusionDiagonal3D(ne, maps->B, maps->G, vec, diag, dofs1D, quad1D);
+   }
+   else { MFEM_ABORT("Unknown kernel."); }
+}
+
 DiffusionIntegrator::~DiffusionIntegrator()
 {
-   delete geom;
-   delete maps;
+   // geom and maps are cached and owned by GeometryExtension::Get() and
+   // DofToQuad::Get(), other integrators may be using them
 }
 
 // PA Mass Assemble kernel
@@ -759,26 +947,30 @@ void MassIntegrator::Assemble(const FiniteElementSpace &fes)
    vec.SetSize(ne*nq);
    ConstantCoefficient *const_coeff = dynamic_cast<ConstantCoefficient*>(Q);
    FunctionCoefficient *function_coeff = dynamic_cast<FunctionCoefficient*>(Q);
-   // TODO: other types of coefficients ...
+   // Other coefficients are evaluated on the host at all quadrature points
+   Vector qcoeff;
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
    {
-      double constant = 0.0;
+      double constant = 1.0;
       double (*function)(const Vector3&) = NULL;
       if (const_coeff)
       {
          constant = const_coeff->constant;
       }
-      else if (function_coeff)
+      else if (function_coeff && function_coeff->GetDeviceFunction())
       {
          function = function_coeff->GetDeviceFunction();
       }
-      else
+      else if (Q)
       {
-         MFEM_ABORT("Coefficient type not supported");
+         Q->Eval(qcoeff, *fes.GetMesh(), *ir);
+         qcoeff.Push();
       }
+      const bool use_qcoeff = (qcoeff.Size() > 0);
       const int NE = ne;
       const int NQ = nq;
+      const DeviceMatrix C(qcoeff.GetData(), NQ, NE);
       const DeviceVector w(maps->W.GetData(), NQ);
       const DeviceTensor<3> x(geom->X.GetData(), 2,NQ,NE);
       const DeviceTensor<4> J(geom->J.GetData(), 2,2,NQ,NE);
@@ -794,31 +986,34 @@ void MassIntegrator::Assemble(const FiniteElementSpace &fes)
             const double detJ = (J11*J22)-(J21*J12);
             const Vector3 Xq(x(0,q,e), x(1,q,e));
             const double coeff =
-            const_coeff ? constant
-            : function_coeff ? function(Xq)
-            : 0.0;
+            function ? function(Xq)
+            : use_qcoeff ? C(q,e)
+            : constant;
             v(q,e) =  w[q] * coeff * detJ;
          }
       });
    }
    if (dim==3)
    {
-      double constant = 0.0;
+      double constant = 1.0;
       double (*function)(const Vector3&) = NULL;
       if (const_coeff)
       {
          constant = const_coeff->constant;
       }
-      else if (function_coeff)
+      else if (function_coeff && function_coeff->GetDeviceFunction())
       {
          function = function_coeff->GetDeviceFunction();
       }
-      else
+      else if (Q)
       {
-         MFEM_ABORT("Coefficient type not supported");
+         Q->Eval(qcoeff, *fes.GetMesh(), *ir);
+         qcoeff.Push();
       }
+      const bool use_qcoeff = (qcoeff.Size() > 0);
       const int NE = ne;
       const int NQ = nq;
+      const DeviceMatrix C(qcoeff.GetData(), NQ, NE);
       const DeviceVector W(maps->W.GetData(), NQ);
       const DeviceTensor<3> x(geom->X.GetData(), 3,NQ,NE);
       const DeviceTensor<4> J(geom->J.GetData(), 3,3,NQ,NE);
@@ -835,9 +1030,9 @@ void MassIntegrator::Assemble(const FiniteElementSpace &fes)
             (J13 * J22 * J31) - (J12 * J21 * J33) - (J11 * J23 * J32));
             const Vector3 Xq(x(0,q,e), x(1,q,e), x(2,q,e));
             const double coeff =
-            const_coeff ? constant
-            : function_coeff ? function(Xq)
-            : 0.0;
+            function ? function(Xq)
+            : use_qcoeff ? C(q,e)
+            : constant;
             v(q,e) = W(q) * coeff * detJ;
          }
       });
@@ -1238,10 +1433,138 @@ void MassIntegrator::MultAssembled(Vector &x, Vector &y)
    PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, vec, x, y);
 }
 
+void MassIntegrator::MultAssembled(Vector &x, Vector &y, int e_begin, int e_end)
+{
+   MFEM_ASSERT(0 <= e_begin && e_begin <= e_end && e_end <= ne, "");
+   if (e_begin == e_end) { return; }
+   const int nd = x.Size()/ne;
+   PAMassApply(dim, dofs1D, quad1D, e_end - e_begin, maps->B, maps->Bt,
+               vec.GetData() + nq*e_begin, x.GetData() + nd*e_begin,
+               y.GetData() + nd*e_begin);
+}
+
+// PA Mass Diagonal 2D kernel
+static void PAMassDiagonal2D(const int NE,
+                             const double* b,
+                             const double* _op,
+                             double* _y,
+                             const int D1D,
+                             const int Q1D)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const DeviceMatrix B(b, Q1D, D1D);
+   const DeviceTensor<3> op(_op, Q1D, Q1D, NE);
+   DeviceTensor<3> y(_y, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      double QD[MAX_Q1D][MAX_D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            QD[qy][dx] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               QD[qy][dx] += B(qx,dx) * B(qx,dx) * op(qx,qy,e);
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double s = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               s += QD[qy][dx] * B(qy,dy) * B(qy,dy);
+            }
+            y(dx,dy,e) += s;
+         }
+      }
+   });
+}
+
+// PA Mass Diagonal 3D kernel
+static void PAMassDiagonal3D(const int NE,
+                             const double* b,
+                             const double* _op,
+                             double* _y,
+                             const int D1D,
+                             const int Q1D)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const DeviceMatrix B(b, Q1D, D1D);
+   const DeviceTensor<4> op(_op, Q1D, Q1D, Q1D, NE);
+   DeviceTensor<4> y(_y, D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      double QQD[MAX_Q1D][MAX_Q1D][MAX_D1D];
+      double QDD[MAX_Q1D][MAX_D1D][MAX_D1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               QQD[qz][qy][dx] = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QQD[qz][qy][dx] += B(qx,dx) * B(qx,dx) * op(qx,qy,qz,e);
+               }
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               QDD[qz][dy][dx] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  QDD[qz][dy][dx] += B(qy,dy) * B(qy,dy) * QQD[qz][qy][dx];
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double s = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  s += B(qz,dz) * B(qz,dz) * QDD[qz][dy][dx];
+               }
+               y(dx,dy,dz,e) += s;
+            }
+         }
+      }
+   });
+}
+
+void MassIntegrator::AssembleDiagonalPA(Vector &diag)
+{
+   if (dim == 2)
+   {
+      PAMassDiagonal2D(ne, maps->B, vec, diag, dofs1D, quad1D);
+   }
+   else if (dim == 3)
+   {
+      PAMassDiagonal3D(ne, maps->B, vec, diag, dofs1D, quad1D);
+   }
+   else { MFEM_ABORT("Unknown kernel."); }
+}
+
 MassIntegrator::~MassIntegrator()
 {
-   delete geom;
-   delete maps;
+   // geom and maps are cached and owned by GeometryExtension::Get() and
+   // DofToQuad::Get(), other integrators may be using them
 }
 
 // DofToQuad
@@ -1678,6 +2001,7 @@ void PAGeom3D(const int NE,
       }
       for (int q = 0; q < NQ; ++q)
       {
+         double X0  = 0; double X1  = 0; double X2  = 0;
          double J11 = 0; double J12 = 0; double J13 = 0;
          double J21 = 0; double J22 = 0; double J23 = 0;
          double J31 = 0; double J32 = 0; double J33 = 0;
@@ -1693,8 +2017,9 @@ void PAGeom3D(const int NE,
             J11 += (wx * x); J12 += (wx * y); J13 += (wx * z);
             J21 += (wy * x); J22 += (wy * y); J23 += (wy * z);
             J31 += (wz * x); J32 += (wz * y); J33 += (wz * z);
-            Xq(0,q,e) = b*x; Xq(1,q,e) = b*y; Xq(2,q,e) = b*z;
+            X0 += b*x; X1 += b*y; X2 += b*z;
          }
+         Xq(0,q,e) = X0; Xq(1,q,e) = X1; Xq(2,q,e) = X2;
          const double r_detJ = ((J11 * J22 * J33) + (J12 * J23 * J31) +
                                 (J13 * J21 * J32) - (J13 * J22 * J31) -
                                 (J12 * J21 * J33) - (J11 * J23 * J32));
@@ -1843,13 +2168,11 @@ GeometryExtension* GeometryExtension::Get(const FiniteElementSpace& fes,
    geom->eMap = eMap;
    // Reorder the original gf back
    if (orderedByNODES) { ReorderByNodes(nodes); }
-   if (geom_to_allocate)
-   {
-      geom->X.SetSize(dims*numQuad*elements);
-      geom->J.SetSize(dims*dims*numQuad*elements);
-      geom->invJ.SetSize(dims*dims*numQuad*elements);
-      geom->detJ.SetSize(numQuad*elements);
-   }
+   // The integration rule may differ from the previous call
+   geom->X.SetSize(dims*numQuad*elements);
+   geom->J.SetSize(dims*dims*numQuad*elements);
+   geom->invJ.SetSize(dims*dims*numQuad*elements);
+   geom->detJ.SetSize(numQuad*elements);
    const DofToQuad* maps = DofToQuad::GetSimplexMaps(*fe, ir);
    PAGeom(dims, D1D, Q1D, elements,
           maps->B, maps->G, geom->nodes,
@@ -21,6 +21,47 @@ namespace mfem
 
 using namespace std;
 
+void Coefficient::Eval(Vector &V, ElementTransformation &T,
+                       const IntegrationRule &ir)
+{
+   V.SetSize(ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      T.SetIntPoint(&ip);
+      V(i) = Eval(T, ip);
+   }
+}
+
+void Coefficient::Eval(QuadratureFunction &qf)
+{
+   MFEM_VERIFY(qf.GetVDim() == 1, "the QuadratureFunction must be scalar");
+   QuadratureSpace *qspace = qf.GetSpace();
+   Mesh *mesh = qspace->GetMesh();
+   IsoparametricTransformation T;
+   Vector values;
+   for (int e = 0; e < mesh->GetNE(); e++)
+   {
+      qf.GetElementValues(e, values);
+      mesh->GetElementTransformation(e, &T);
+      Eval(values, T, qspace->GetElementIntRule(e));
+   }
+}
+
+void Coefficient::Eval(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir)
+{
+   const int nq = ir.GetNPoints();
+   IsoparametricTransformation T;
+   Vector values;
+   qcoeff.SetSize(nq*mesh.GetNE());
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      values.SetDataAndSize(qcoeff.GetData() + e*nq, nq);
+      mesh.GetElementTransformation(e, &T);
+      Eval(values, T, ir);
+   }
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -55,12 +96,71 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
+                               const IntegrationRule &ir)
+{
+   DenseMatrix pts;
+   T.Transform(ir, pts);
+
+   double x[3] = { 0.0, 0.0, 0.0 };
+   Vector transip(x, pts.Height());
+   V.SetSize(ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      for (int d = 0; d < pts.Height(); d++) { x[d] = pts(d,i); }
+      if (Function)
+      {
+         V(i) = (*Function)(transip);
+      }
+      else if (DeviceFunction)
+      {
+         V(i) = (*DeviceFunction)(Vector3(x));
+      }
+      else
+      {
+         V(i) = (*TDFunction)(transip, GetTime());
+      }
+   }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T.ElementNo, ip, Component);
 }
 
+void GridFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
+                                   const IntegrationRule &ir)
+{
+   GridF->GetValues(T.ElementNo, ir, V, Component);
+}
+
+void GridFunctionCoefficient::Eval(Vector &qcoeff, Mesh &mesh,
+                                   const IntegrationRule &ir)
+{
+   const FiniteElementSpace *fes = GridF->FESpace();
+   if (fes->GetMesh() != &mesh || !QuadratureInterpolator::Supports(*fes))
+   {
+      Coefficient::Eval(qcoeff, mesh, ir);
+      return;
+   }
+   QuadratureInterpolator qi(*fes, ir);
+   const int vdim = fes->GetVDim();
+   if (vdim == 1)
+   {
+      qi.Values(*GridF, qcoeff);
+      return;
+   }
+   // The values of all components are interleaved: (vdim, nq, ne)
+   Vector values;
+   qi.Values(*GridF, values);
+   qcoeff.SetSize(values.Size()/vdim);
+   for (int i = 0; i < qcoeff.Size(); i++)
+   {
+      qcoeff(i) = values(Component-1 + vdim*i);
+   }
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
@@ -21,6 +21,7 @@ namespace mfem
 {
 
 class Mesh;
+class QuadratureFunction;
 
 #ifdef MFEM_USE_MPI
 class ParMesh;
@@ -59,6 +60,31 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient in the element described by @a T at all
+       points of @a ir, storing the values in the Vector @a V. */
+   /** The Vector @a V is resized to ir.GetNPoints(). The default implementation
+       calls Eval(T, ip) for every point; derived classes override this method
+       with batched versions that avoid the per-point virtual calls.
+
+       @note The IntegrationPoint associated with @a T is not used, and this
+       method will generally modify this IntegrationPoint associated with @a T.
+   */
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir);
+
+   /** @brief Evaluate the coefficient at all quadrature points of the scalar
+       QuadratureFunction @a qf, element by element, using the batched method
+       above. */
+   void Eval(QuadratureFunction &qf);
+
+   /** @brief Evaluate the coefficient at the points of @a ir in all elements
+       of @a mesh, which must all have the geometry of @a ir. */
+   /** The Vector @a qcoeff is resized to ir.GetNPoints()*mesh.GetNE(), and the
+       value at point q of element e is stored at index q + e*ir.GetNPoints().
+       This is the layout of the quadrature data of the partially assembled
+       integrators. */
+   virtual void Eval(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~Coefficient() { }
 };
 
@@ -76,6 +102,11 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   using Coefficient::Eval;
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir)
+   { V.SetSize(ir.GetNPoints()); V = constant; }
 };
 
 /// class for piecewise constant coefficient
@@ -110,6 +141,11 @@ public:
    /// Evaluate the coefficient function
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   using Coefficient::Eval;
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir)
+   { V.SetSize(ir.GetNPoints()); V = constants(T.Attribute-1); }
 };
 
 typedef double (*DeviceFunctionCoefficientPtr)(const Vector3&);
@@ -172,6 +208,12 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
 
+   using Coefficient::Eval;
+   /** Transforms all points of @a ir at once and calls the C-function for
+       each of them. */
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir);
+
    /// Return the coefficient's C-function that uses Vector3.
    /// Warning: for now, the returned function can only be used on the
    /// host inside a MFEM_FORALL.
@@ -199,6 +241,16 @@ public:
 
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   using Coefficient::Eval;
+   /** Uses the element degrees of freedom of the GridFunction once for all
+       points of @a ir, see GridFunction::GetValues(). */
+   virtual void Eval(Vector &V, ElementTransformation &T,
+                     const IntegrationRule &ir);
+
+   /** When possible, evaluates the GridFunction in all elements at once, see
+       QuadratureInterpolator. */
+   virtual void Eval(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 class TransformedCoefficient : public Coefficient
@@ -12,6 +12,7 @@
 #include "fem.hpp"
 #include "../mesh/nurbs.hpp"
 #include "../general/text.hpp"
+#include "../general/fpcompress.hpp"
 #include "picojson.h"
 
 #include <fstream>
@@ -108,6 +109,8 @@ DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
    precision = precision_default;
    pad_digits_cycle = pad_digits_rank = pad_digits_default;
    format = SERIAL_FORMAT; // use serial mesh format
+   compression = FPCompression::NONE;
+   compression_tol = 0.0;
    error = NO_ERROR;
 }
 
@@ -161,6 +164,16 @@ void DataCollection::SetFormat(int fmt)
    format = fmt;
 }
 
+void DataCollection::SetCompression(int codec, double tol)
+{
+   MFEM_VERIFY(codec >= FPCompression::NONE && codec <= FPCompression::LOSSY,
+               "unknown codec: " << codec);
+   MFEM_VERIFY(codec != FPCompression::LOSSY || tol > 0.0,
+               "the lossy codec requires a positive tolerance");
+   compression = codec;
+   compression_tol = tol;
+}
+
 void DataCollection::SetPrefixPath(const std::string& prefix)
 {
    if (!prefix.empty())
@@ -267,9 +280,19 @@ const
 
 void DataCollection::SaveOneField(const FieldMapIterator &it)
 {
-   std::ofstream field_file(GetFieldFileName(it->first).c_str());
-   field_file.precision(precision);
-   (it->second)->Save(field_file);
+   const bool compress = (compression != FPCompression::NONE);
+   std::ofstream field_file(GetFieldFileName(it->first).c_str(),
+                            compress ? std::ios::out | std::ios::binary :
+                            std::ios::out);
+   if (compress)
+   {
+      (it->second)->SaveCompressed(field_file, compression, compression_tol);
+   }
+   else
+   {
+      field_file.precision(precision);
+      (it->second)->Save(field_file);
+   }
    if (!field_file)
    {
       error = WRITE_ERROR;
@@ -576,7 +599,8 @@ void VisItDataCollection::LoadFields()
         it != field_info_map.end(); ++it)
    {
       std::string fname = path_left + it->first + path_right;
-      std::ifstream file(fname.c_str());
+      // binary mode for fields saved with compression, see SetCompression()
+      std::ifstream file(fname.c_str(), std::ios::binary);
       // TODO: in parallel, check for errors on all processors
       if (!file)
       {
@@ -206,6 +206,11 @@ protected:
    /// Output mesh format: see the #Format enumeration
    int format;
 
+   /// Field data compression: see FPCompression::Codec
+   int compression;
+   /// Absolute error bound for the lossy field data compression
+   double compression_tol;
+
    /// Should the collection delete its mesh and fields
    bool own_data;
 
@@ -346,6 +351,16 @@ public:
        validation. */
    virtual void SetFormat(int fmt);
 
+   /// Set the compression of the field data written by Save() and SaveField().
+   /** The parameter @a codec is one of the FPCompression::Codec constants; with
+       FPCompression::NONE (the default) the fields are written in ASCII format
+       with the precision set by SetPrecision(). With the other codecs, the
+       field data is written in compressed binary form, see
+       GridFunction::SaveCompressed(), and @a tol is the absolute error bound
+       of the FPCompression::LOSSY codec. Compressed fields are read back by
+       Load() without further settings. Quadrature fields are not compressed. */
+   void SetCompression(int codec, double tol = 0.0);
+
    /// Set the path where the DataCollection will be saved.
    void SetPrefixPath(const std::string &prefix);
 
@@ -19,6 +19,7 @@ namespace mfem
 ElementTransformation::ElementTransformation()
    : IntPoint(static_cast<IntegrationPoint *>(NULL)),
      EvalState(0),
+     affine(false),
      Attribute(-1),
      ElementNo(-1)
 { }
@@ -392,6 +393,8 @@ void IsoparametricTransformation::SetIdentityTransformation(
    }
    geom = GeomType;
    space_dim = dim;
+   affine = false;
+   EvalState = 0;
 }
 
 const DenseMatrix &IsoparametricTransformation::EvalJacobian()
@@ -27,6 +27,9 @@ protected:
    DenseMatrix dFdx, adjJ, invJ;
    double Wght;
    int EvalState;
+   /* If true, the Jacobian is constant and the quantities in EvalState are
+      kept when the IntegrationPoint changes. */
+   bool affine;
    enum StateMasks
    {
       JACOBIAN_MASK = 1,
@@ -50,8 +53,13 @@ public:
 
    ElementTransformation();
 
+   /** @brief Set the IntegrationPoint at which the Jacobian, the weight, etc.
+       are evaluated. */
+   /** For affine transformations, see IsAffine(), the Jacobian and the
+       quantities derived from it are evaluated at the first point only and
+       reused at all subsequent points. */
    void SetIntPoint(const IntegrationPoint *ip)
-   { IntPoint = ip; EvalState = 0; }
+   { IntPoint = ip; if (!affine) { EvalState = 0; } }
    const IntegrationPoint &GetIntPoint() { return *IntPoint; }
 
    virtual void Transform(const IntegrationPoint &, Vector &) = 0;
@@ -82,6 +90,15 @@ public:
    /// Order of adj(J)^t.grad(fi)
    virtual int OrderGrad(const FiniteElement *fe) = 0;
 
+   /// Return true if the Jacobian of the transformation is constant.
+   bool IsAffine() const { return affine; }
+
+   /** @brief Mark the transformation as affine, i.e. with a constant
+       Jacobian, or not. */
+   /** This is set by Mesh::GetElementTransformation(). The flag must be set
+       again (or reset) whenever the transformation is redefined. */
+   void SetAffine(bool is_affine) { affine = is_affine; EvalState = 0; }
+
    /// Return the Geometry::Type of the reference element.
    Geometry::Type GetGeometryType() const { return geom; }
 
@@ -296,7 +313,9 @@ private:
    virtual const DenseMatrix &EvalJacobian();
 
 public:
-   void SetFE(const FiniteElement *FE) { FElem = FE; geom = FE->GetGeomType(); }
+   /// Set the FiniteElement defining the transformation; resets IsAffine().
+   void SetFE(const FiniteElement *FE)
+   { FElem = FE; geom = FE->GetGeomType(); affine = false; EvalState = 0; }
    const FiniteElement* GetFE() const { return FElem; }
 
    /** @brief Read and write access to the underlying point matrix describing
@@ -311,7 +330,10 @@ public:
        basis functions evaluated at xh. The columns of P represent the control
        points in physical space defining the transformation. */
    DenseMatrix &GetPointMat() { return PointMat; }
-   void FinalizeTransformation() { space_dim = PointMat.Height(); }
+   /** @brief Update the transformation after a change of the point matrix;
+       resets IsAffine(). */
+   void FinalizeTransformation()
+   { space_dim = PointMat.Height(); affine = false; EvalState = 0; }
 
    void SetIdentityTransformation(Geometry::Type GeomType);
 
@@ -16,6 +16,7 @@
 #include "../mesh/nurbs.hpp"
 #include "bilininteg.hpp"
 #include <cmath>
+#include <functional>
 
 namespace mfem
 {
@@ -37,6 +38,112 @@ FiniteElement::FiniteElement(int D, Geometry::Type G, int Do, int O, int F)
 #endif
 }
 
+ShapeTable::ShapeTable(const FiniteElement &fe, const IntegrationRule &ir)
+   : dof(fe.GetDof()), dim(fe.GetDim()), key(Key(ir))
+{
+   MFEM_VERIFY(fe.GetRangeType() == FiniteElement::SCALAR,
+               "ShapeTable requires a scalar FiniteElement");
+   const int nip = ir.GetNPoints();
+   ir.Copy(IntRule);
+   IntRule.SetOrder(ir.GetOrder());
+
+   Vector s;
+   DenseMatrix ds;
+   shape.SetSize(dof, nip);
+   const bool grad = (fe.GetDerivType() == FiniteElement::GRAD);
+   if (grad) { dshape.SetSize(dof*dim*nip); }
+   for (int i = 0; i < nip; i++)
+   {
+      shape.GetColumnReference(i, s);
+      fe.CalcShape(ir.IntPoint(i), s);
+      if (grad)
+      {
+         ds.Reset(dshape.GetData() + i*dof*dim, dof, dim);
+         fe.CalcDShape(ir.IntPoint(i), ds);
+      }
+   }
+}
+
+bool ShapeTable::Matches(const IntegrationRule &ir) const
+{
+   if (ir.GetNPoints() != IntRule.GetNPoints()) { return false; }
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &a = ir.IntPoint(i), &b = IntRule.IntPoint(i);
+      if (a.x != b.x || a.y != b.y || a.z != b.z) { return false; }
+   }
+   return true;
+}
+
+std::size_t ShapeTable::Key(const IntegrationRule &ir)
+{
+   std::hash<double> h;
+   std::size_t seed = ir.GetNPoints();
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      const double c[3] = { ip.x, ip.y, ip.z };
+      for (int j = 0; j < 3; j++)
+      {
+         seed ^= h(c[j]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      }
+   }
+   return seed;
+}
+
+const ShapeTable *ShapeTableCache::Find(const Array<ShapeTable*> &tables,
+                                        std::size_t key,
+                                        const IntegrationRule &ir)
+{
+   // binary search for the first table with the key
+   int lo = 0, hi = tables.Size();
+   while (lo < hi)
+   {
+      const int mid = (lo + hi)/2;
+      if (tables[mid]->GetKey() < key) { lo = mid + 1; }
+      else { hi = mid; }
+   }
+   for (int i = lo; i < tables.Size() && tables[i]->GetKey() == key; i++)
+   {
+      if (tables[i]->Matches(ir)) { return tables[i]; }
+   }
+   return NULL;
+}
+
+const ShapeTable *ShapeTableCache::Get(const FiniteElement &fe,
+                                       const IntegrationRule &ir)
+{
+   const std::size_t key = ShapeTable::Key(ir);
+
+   // Tables that have been published are found without locking
+   const Array<ShapeTable*> *snapshot = published.GetArray();
+   const ShapeTable *table = snapshot ? Find(*snapshot, key, ir) : NULL;
+   if (table) { return table; }
+
+   std::lock_guard<std::mutex> guard(mutex);
+   table = Find(tables, key, ir);
+   if (table || tables.Size() >= MaxTables) { return table; }
+
+   ShapeTable *new_table = new ShapeTable(fe, ir);
+   int pos = tables.Size();
+   tables.Append(new_table);
+   for ( ; pos > 0 && tables[pos-1]->GetKey() > key; pos--)
+   {
+      tables[pos] = tables[pos-1];
+   }
+   tables[pos] = new_table;
+   published.Publish(tables);
+   return new_table;
+}
+
+ShapeTableCache::~ShapeTableCache()
+{
+   for (int i = 0; i < tables.Size(); i++)
+   {
+      delete tables[i];
+   }
+}
+
 void FiniteElement::CalcVShape (
    const IntegrationPoint &ip, DenseMatrix &shape) const
 {
@@ -452,7 +559,7 @@ void NodalFiniteElement::ProjectGrad(
    MFEM_ASSERT(fe.GetMapType() == VALUE, "");
    MFEM_ASSERT(Trans.GetSpaceDim() == Dim, "")
 
-   DenseMatrix dshape(fe.GetDof(), Dim), grad_k(fe.GetDof(), Dim), Jinv(Dim);
+   DenseMatrix dshape(fe.GetDof(), Dim), grad_k(fe.GetDof(), Dim);
 
    grad.SetSize(Dim*Dof, fe.GetDof());
    for (int k = 0; k < Dof; k++)
@@ -460,8 +567,7 @@ void NodalFiniteElement::ProjectGrad(
       const IntegrationPoint &ip = Nodes.IntPoint(k);
       fe.CalcDShape(ip, dshape);
       Trans.SetIntPoint(&ip);
-      CalcInverse(Trans.Jacobian(), Jinv);
-      Mult(dshape, Jinv, grad_k);
+      Mult(dshape, Trans.InverseJacobian(), grad_k);
       if (MapType == INTEGRAL)
       {
          grad_k *= Trans.Weight();
@@ -6538,21 +6644,40 @@ void Poly_1D::Basis::Eval(const double y, Vector &u, Vector &d) const
    }
 }
 
+// Rows of the Pascal triangle, see Poly_1D::Binom()
+class BinomTable
+{
+public:
+   Array<int*> rows;
+   ArraySnapshot<int> published;
+   std::mutex mutex;
+
+   ~BinomTable()
+   {
+      for (int i = 0; i < rows.Size(); i++) { delete [] rows[i]; }
+   }
+};
+
+static BinomTable binom;
+
 const int *Poly_1D::Binom(const int p)
 {
-   if (binom.NumCols() <= p)
+   const int *row = binom.published.Get(p);
+   if (row) { return row; }
+
+   std::lock_guard<std::mutex> guard(binom.mutex);
+   for (int i = binom.rows.Size(); i <= p; i++)
    {
-      binom.SetSize(p + 1, p + 1);
-      for (int i = 0; i <= p; i++)
+      int *r = new int[i + 1];
+      r[0] = r[i] = 1;
+      for (int j = 1; j < i; j++)
       {
-         binom(i,0) = binom(i,i) = 1;
-         for (int j = 1; j < i; j++)
-         {
-            binom(i,j) = binom(i-1,j) + binom(i-1,j-1);
-         }
+         r[j] = binom.rows[i-1][j] + binom.rows[i-1][j-1];
       }
+      binom.rows.Append(r);
    }
-   return binom[p];
+   binom.published.Publish(binom.rows);
+   return binom.rows[p];
 }
 
 void Poly_1D::ChebyshevPoints(const int p, double *x)
@@ -6787,6 +6912,10 @@ const double *Poly_1D::GetPoints(const int p, const int btype)
 
    if (qtype == Quadrature1D::Invalid) { return NULL; }
 
+   const double *published = published_points[btype].Get(p);
+   if (published) { return published; }
+
+   std::lock_guard<std::recursive_mutex> guard(mutex);
    if (points_container.find(btype) == points_container.end())
    {
       points_container[btype] = new Array<double*>;
@@ -6801,6 +6930,7 @@ const double *Poly_1D::GetPoints(const int p, const int btype)
       pts[p] = new double[p + 1];
       quad_func.GivePolyPoints(p+1, pts[p], qtype);
    }
+   published_points[btype].Publish(pts);
    return pts[p];
 }
 
@@ -6808,6 +6938,10 @@ Poly_1D::Basis &Poly_1D::GetBasis(const int p, const int btype)
 {
    BasisType::Check(btype);
 
+   Basis *published = published_bases[btype].Get(p);
+   if (published) { return *published; }
+
+   std::lock_guard<std::recursive_mutex> guard(mutex);
    if ( bases_container.find(btype) == bases_container.end() )
    {
       // we haven't been asked for basis or points of this type yet
@@ -6823,9 +6957,25 @@ Poly_1D::Basis &Poly_1D::GetBasis(const int p, const int btype)
       EvalType etype = (btype == BasisType::Positive) ? Positive : Barycentric;
       bases[p] = new Basis(p, GetPoints(p, btype), etype);
    }
+   published_bases[btype].Publish(bases);
    return *bases[p];
 }
 
+void Poly_1D::Prewarm(int max_order)
+{
+   for (int btype = 0; btype < BasisType::NumBasisTypes; btype++)
+   {
+      // closed point sets require at least two points
+      const int qtype = BasisType::GetQuadrature1D(btype);
+      const int p0 = (Quadrature1D::CheckClosed(qtype) != Quadrature1D::Invalid);
+      for (int p = p0; p <= max_order; p++)
+      {
+         GetBasis(p, btype);
+      }
+   }
+   Binom(max_order);
+}
+
 Poly_1D::~Poly_1D()
 {
    for (PointsMap::iterator it = points_container.begin();
@@ -6851,7 +7001,6 @@ Poly_1D::~Poly_1D()
    }
 }
 
-Array2D<int> Poly_1D::binom;
 Poly_1D poly1d;
 
 
@@ -19,6 +19,7 @@
 #include "geom.hpp"
 
 #include <map>
+#include <mutex>
 
 namespace mfem
 {
@@ -135,6 +136,84 @@ class Coefficient;
 class VectorCoefficient;
 class MatrixCoefficient;
 class KnotVector;
+class FiniteElement;
+
+/** @brief Values and reference gradients of the shape functions of a scalar
+    FiniteElement at all points of an IntegrationRule. */
+/** The tables are computed by FiniteElement::GetShapeTable() once per
+    IntegrationRule and are shared by all elements using the FiniteElement. */
+class ShapeTable
+{
+protected:
+   int dof, dim;
+   std::size_t key;
+
+public:
+   /// Copy of the points of the IntegrationRule used for the tables.
+   IntegrationRule IntRule;
+   /// Shape function values: column i is CalcShape() at point i.
+   DenseMatrix shape;
+   /** @brief Reference gradients: the (Dof x Dim) result of CalcDShape() at
+       point i starts at offset i*Dof*Dim. Empty if the FiniteElement does not
+       implement CalcDShape(). */
+   Vector dshape;
+
+   ShapeTable(const FiniteElement &fe, const IntegrationRule &ir);
+
+   /// Return true if the points of @a ir are the points of #IntRule.
+   bool Matches(const IntegrationRule &ir) const;
+
+   /** @brief Return a hash of the points of @a ir: rules with the same points
+       have the same key. */
+   static std::size_t Key(const IntegrationRule &ir);
+
+   /// Return the Key() of #IntRule.
+   std::size_t GetKey() const { return key; }
+
+   /// Return the @a Dof shape function values at point @a i.
+   const double *GetShape(int i) const { return shape.GetColumn(i); }
+
+   /** @brief Return the reference gradients at point @a i, a (Dof x Dim)
+       matrix in column-major order. */
+   const double *GetDShape(int i) const
+   { return dshape.GetData() + i*dof*dim; }
+};
+
+/** @brief Collection of the ShapeTable%s of a FiniteElement. Copies of the
+    collection are empty. */
+class ShapeTableCache
+{
+private:
+   /// The tables sorted by ShapeTable::GetKey(), modified under #mutex.
+   Array<ShapeTable*> tables;
+   /// Copy of #tables read without locks.
+   ArraySnapshot<ShapeTable> published;
+   std::mutex mutex;
+
+   static const ShapeTable *Find(const Array<ShapeTable*> &tables,
+                                 std::size_t key, const IntegrationRule &ir);
+
+public:
+   /// Maximum number of tables stored by a collection.
+   static const int MaxTables = 32;
+
+   ShapeTableCache() { }
+   ShapeTableCache(const ShapeTableCache &) { }
+   ShapeTableCache &operator=(const ShapeTableCache &) { return *this; }
+
+   /** @brief Return the ShapeTable of @a fe for the points of @a ir, computing
+       it if needed. Returns NULL if the collection has #MaxTables tables and
+       none of them matches @a ir. */
+   /** The tables are identified by the points of the rules, not by the rule
+       objects, so temporary rules and rules with the same points share the
+       tables. Tables are never removed before the destruction of the
+       collection, so the returned pointer remains valid. This method can be
+       called from multiple threads: the lookup of an existing table does not
+       lock. */
+   const ShapeTable *Get(const FiniteElement &fe, const IntegrationRule &ir);
+
+   ~ShapeTableCache();
+};
 
 /// Abstract class for Finite Elements
 class FiniteElement
@@ -152,6 +231,7 @@ protected:
 #ifndef MFEM_THREAD_SAFE
    mutable DenseMatrix vshape; // Dof x Dim
 #endif
+   mutable ShapeTableCache shape_tables;
 
 public:
    /// Enumeration for RangeType and DerivRangeType
@@ -247,6 +327,15 @@ public:
    virtual void CalcShape(const IntegrationPoint &ip,
                           Vector &shape) const = 0;
 
+   /** @brief Return the values and reference gradients of the shape
+       functions of a scalar finite element at all points of @a ir. */
+   /** The tables are computed on the first call with an IntegrationRule, and
+       reused by the following calls with a rule with the same points. Returns
+       NULL if the shape functions depend on the element, e.g. for NURBS
+       elements, or if the ShapeTableCache of the element is full. */
+   virtual const ShapeTable *GetShapeTable(const IntegrationRule &ir) const
+   { return shape_tables.Get(*this, ir); }
+
    /** @brief Evaluate the values of all shape functions of a scalar finite
        element in physical space at the point described by @a Trans. */
    /** The size (#Dof) of the result Vector @a shape must be set in advance. */
@@ -1590,7 +1679,11 @@ private:
    PointsMap points_container;
    BasisMap  bases_container;
 
-   static Array2D<int> binom;
+   /// Copies of the containers, indexed by BasisType, read without locks.
+   ArraySnapshot<double> published_points[BasisType::NumBasisTypes];
+   ArraySnapshot<Basis>  published_bases[BasisType::NumBasisTypes];
+   /// Serializes the updates of the containers.
+   std::recursive_mutex mutex;
 
    static void CalcMono(const int p, const double x, double *u);
    static void CalcMono(const int p, const double x, double *u, double *d);
@@ -1610,8 +1703,16 @@ public:
 
    /** @brief Get a pointer to an array containing the binomial coefficients "p
        choose k" for k=0,...,p for the given p. */
+   /** This method, as well as GetPoints() and GetBasis(), is thread-safe:
+       the entries that have already been computed are returned without
+       locking. */
    static const int *Binom(const int p);
 
+   /** @brief Compute the points and the bases of all BasisType%s, and the
+       binomial coefficients, for the degrees up to @a max_order, e.g. before a
+       threaded assembly. */
+   void Prewarm(int max_order);
+
    /** @brief Get the coordinates of the points of the given BasisType,
        @a btype.
 
@@ -2750,6 +2851,10 @@ public:
    Vector              &Weights    ()         const { return weights; }
    /// Update the NURBSFiniteElement according to the currently set knot vectors
    virtual void         SetOrder   ()         const { }
+
+   /// The shape functions depend on the element: returns NULL.
+   virtual const ShapeTable *GetShapeTable(const IntegrationRule &ir) const
+   { return NULL; }
 };
 
 class NURBS1DFiniteElement : public NURBSFiniteElement
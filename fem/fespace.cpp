@@ -259,6 +259,54 @@ void FiniteElementSpace::ReorderElementToDofTable()
    }
 }
 
+void FiniteElementSpace::ReorderElementToDofTableRCM()
+{
+   // the DOF adjacency graph: (DOF-to-element) * (element-to-DOF)
+   Table el_dof(*elem_dof);
+   int *J = el_dof.GetJ(), nnz = el_dof.Size_of_connections();
+   for (int k = 0; k < nnz; k++)
+   {
+      if (J[k] < 0) { J[k] = -1-J[k]; }
+   }
+
+   Table dof_el, dof_dof;
+   Transpose(el_dof, dof_el, ndofs);
+   Mult(dof_el, el_dof, dof_dof);
+
+   Array<int> dof_ordering;
+   ReverseCuthillMcKee(dof_dof, dof_ordering);
+
+   J = elem_dof->GetJ();
+   for (int k = 0; k < nnz; k++)
+   {
+      const int sdof = J[k]; // signed dof
+      const int new_dof = dof_ordering[(sdof < 0) ? -1-sdof : sdof];
+      J[k] = (sdof < 0) ? -1-new_dof : new_dof; // preserve the sign of sdof
+   }
+}
+
+void FiniteElementSpace::GetDofOrderingStats(int &bandwidth,
+                                             long &cache_misses) const
+{
+   BuildElementToDofTable();
+
+   bandwidth = 0;
+   for (int i = 0; i < elem_dof->Size(); i++)
+   {
+      const int *row = elem_dof->GetRow(i), n = elem_dof->RowSize(i);
+      int min_dof = std::numeric_limits<int>::max(), max_dof = -1;
+      for (int j = 0; j < n; j++)
+      {
+         const int dof = (row[j] < 0) ? -1-row[j] : row[j];
+         min_dof = std::min(min_dof, dof);
+         max_dof = std::max(max_dof, dof);
+      }
+      if (n) { bandwidth = std::max(bandwidth, max_dof - min_dof); }
+   }
+
+   cache_misses = CountCacheMisses(*elem_dof, sizeof(double));
+}
+
 void FiniteElementSpace::BuildDofToArrays()
 {
    if (dof_elem_array.Size()) { return; }
@@ -599,11 +647,14 @@ void FiniteElementSpace::BuildConformingInterpolation() const
                                    /*        */ : mesh->ncmesh->GetEdgeList();
       if (!list.masters.size()) { continue; }
 
+      Geometry::Type geom = (entity > 1) ? mesh->ncmesh->GetFaceGeometry()
+                            /*          */ : Geometry::SEGMENT;
+
       IsoparametricTransformation T;
-      if (entity > 1) { T.SetFE(&QuadrilateralFE); }
+      if (geom == Geometry::TRIANGLE) { T.SetFE(&TriangleFE); }
+      else if (geom == Geometry::SQUARE) { T.SetFE(&QuadrilateralFE); }
       else { T.SetFE(&SegmentFE); }
 
-      Geometry::Type geom = (entity > 1) ? Geometry::SQUARE : Geometry::SEGMENT;
       const FiniteElement* fe = fec->FiniteElementForGeometry(geom);
       if (!fe) { continue; }
 
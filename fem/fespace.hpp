@@ -409,6 +409,17 @@ public:
        is preserved. */
    void ReorderElementToDofTable();
 
+   /** @brief Reorder the scalar DOFs with the reverse Cuthill-McKee algorithm
+       applied to the DOF adjacency graph (DOFs sharing an element are
+       adjacent). As in ReorderElementToDofTable(), only the element-to-dof
+       table is changed. */
+   void ReorderElementToDofTableRCM();
+
+   /** @brief Return the bandwidth of the DOF adjacency graph and an estimate
+       of the number of cache misses when the DOF values are gathered element
+       by element (see CountCacheMisses). */
+   void GetDofOrderingStats(int &bandwidth, long &cache_misses) const;
+
    void BuildDofToArrays();
 
    const Table &GetElementToDofTable() const { return *elem_dof; }
@@ -589,6 +600,9 @@ public:
    /// Return the total number of quadrature points.
    int GetSize() const { return size; }
 
+   /// Returns the mesh
+   inline Mesh *GetMesh() const { return mesh; }
+
    /// Get the IntegrationRule associated with mesh element @a idx.
    const IntegrationRule &GetElementIntRule(int idx) const
    { return *int_rule[mesh->GetElementBaseGeometry(idx)]; }
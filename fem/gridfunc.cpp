@@ -12,8 +12,10 @@
 // Implementation of GridFunction
 
 #include "gridfunc.hpp"
+#include "quadinterpolator.hpp"
 #include "../mesh/nurbs.hpp"
 #include "../general/text.hpp"
+#include "../general/fpcompress.hpp"
 
 #include <limits>
 #include <cstring>
@@ -35,7 +37,8 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
 
    skip_comment_lines(input, '#');
    istream::int_type next_char = input.peek();
-   if (next_char == 'N') // First letter of "NURBS_patches"
+   if (next_char == 'N' || // First letter of "NURBS_patches"
+       next_char == 'C')   // First letter of "Compressed_data"
    {
       string buff;
       getline(input, buff);
@@ -46,6 +49,11 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
                      "NURBS_patches requires NURBS FE space");
          fes->GetNURBSext()->LoadSolution(input, *this);
       }
+      else if (buff == "Compressed_data")
+      {
+         SetSize(fes->GetVSize());
+         FPCompression::Read(input, GetData(), Size());
+      }
       else
       {
          MFEM_ABORT("unknown section: " << buff);
@@ -2290,51 +2298,87 @@ double GridFunction::ComputeW11Error(
    return error;
 }
 
+const IntegrationRule *GridFunction::GetErrorQuadValues(
+   const IntegrationRule *irs[], Vector &q_vals) const
+{
+   if (!QuadratureInterpolator::Supports(*fes)) { return NULL; }
+   const FiniteElement *fe = fes->GetFE(0);
+   const IntegrationRule *ir;
+   if (irs)
+   {
+      ir = irs[fe->GetGeomType()];
+   }
+   else
+   {
+      int intorder = 2*fe->GetOrder() + 1; // <----------
+      ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+   }
+   QuadratureInterpolator(*fes, *ir).Values(*this, q_vals);
+   return ir;
+}
+
 double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
                                     Coefficient *weight,
                                     const IntegrationRule *irs[]) const
 {
-   double error = 0.0;
-   const FiniteElement *fe;
-   ElementTransformation *T;
-   Vector vals;
-
+   double error = 0.0, max_error = 0.0;
+   IsoparametricTransformation T;
+   Vector vals, q_vals;
+   const IntegrationRule *q_ir =
+      (fes->GetVDim() == 1) ? GetErrorQuadValues(irs, q_vals) : NULL;
+
+   // The element transformation is owned by this method (and is private to
+   // each thread), so the loop can run in parallel if the coefficients are
+   // thread-safe.
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for private(T,vals) \
+   reduction(+:error) reduction(max:max_error)
+#endif
    for (int i = 0; i < fes->GetNE(); i++)
    {
-      fe = fes->GetFE(i);
+      const FiniteElement *fe = fes->GetFE(i);
       const IntegrationRule *ir;
-      if (irs)
+      if (q_ir)
       {
-         ir = irs[fe->GetGeomType()];
+         ir = q_ir;
+         vals.NewDataAndSize(q_vals.GetData() + i*ir->GetNPoints(),
+                             ir->GetNPoints());
       }
       else
       {
-         int intorder = 2*fe->GetOrder() + 1; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         if (irs)
+         {
+            ir = irs[fe->GetGeomType()];
+         }
+         else
+         {
+            int intorder = 2*fe->GetOrder() + 1; // <----------
+            ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         }
+         GetValues(i, *ir, vals);
       }
-      GetValues(i, *ir, vals);
-      T = fes->GetElementTransformation(i);
+      fes->GetElementTransformation(i, &T);
       for (int j = 0; j < ir->GetNPoints(); j++)
       {
          const IntegrationPoint &ip = ir->IntPoint(j);
-         T->SetIntPoint(&ip);
-         double err = fabs(vals(j) - exsol.Eval(*T, ip));
+         T.SetIntPoint(&ip);
+         double err = fabs(vals(j) - exsol.Eval(T, ip));
          if (p < infinity())
          {
             err = pow(err, p);
             if (weight)
             {
-               err *= weight->Eval(*T, ip);
+               err *= weight->Eval(T, ip);
             }
-            error += ip.weight * T->Weight() * err;
+            error += ip.weight * T.Weight() * err;
          }
          else
          {
             if (weight)
             {
-               err *= weight->Eval(*T, ip);
+               err *= weight->Eval(T, ip);
             }
-            error = std::max(error, err);
+            max_error = std::max(max_error, err);
          }
       }
    }
@@ -2351,6 +2395,10 @@ double GridFunction::ComputeLpError(const double p, Coefficient &exsol,
          error = pow(error, 1./p);
       }
    }
+   else
+   {
+      error = max_error;
+   }
 
    return error;
 }
@@ -2363,22 +2411,33 @@ void GridFunction::ComputeElementLpErrors(const double p, Coefficient &exsol,
    error = 0.0;
    const FiniteElement *fe;
    ElementTransformation *T;
-   Vector vals;
+   Vector vals, q_vals;
+   const IntegrationRule *q_ir =
+      (fes->GetVDim() == 1) ? GetErrorQuadValues(irs, q_vals) : NULL;
 
    for (int i = 0; i < fes->GetNE(); i++)
    {
       fe = fes->GetFE(i);
       const IntegrationRule *ir;
-      if (irs)
+      if (q_ir)
       {
-         ir = irs[fe->GetGeomType()];
+         ir = q_ir;
+         vals.NewDataAndSize(q_vals.GetData() + i*ir->GetNPoints(),
+                             ir->GetNPoints());
       }
       else
       {
-         int intorder = 2*fe->GetOrder() + 1; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         if (irs)
+         {
+            ir = irs[fe->GetGeomType()];
+         }
+         else
+         {
+            int intorder = 2*fe->GetOrder() + 1; // <----------
+            ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         }
+         GetValues(i, *ir, vals);
       }
-      GetValues(i, *ir, vals);
       T = fes->GetElementTransformation(i);
       for (int j = 0; j < ir->GetNPoints(); j++)
       {
@@ -2427,23 +2486,34 @@ double GridFunction::ComputeLpError(const double p, VectorCoefficient &exsol,
    const FiniteElement *fe;
    ElementTransformation *T;
    DenseMatrix vals, exact_vals;
-   Vector loc_errs;
+   Vector loc_errs, q_vals;
+   const IntegrationRule *q_ir = GetErrorQuadValues(irs, q_vals);
 
    for (int i = 0; i < fes->GetNE(); i++)
    {
       fe = fes->GetFE(i);
       const IntegrationRule *ir;
-      if (irs)
+      T = fes->GetElementTransformation(i);
+      if (q_ir)
       {
-         ir = irs[fe->GetGeomType()];
+         // The values of element i are stored as a (vdim x nq) matrix
+         const int vdim = fes->GetVDim(), nq = q_ir->GetNPoints();
+         ir = q_ir;
+         vals.Reset(q_vals.GetData() + i*vdim*nq, vdim, nq);
       }
       else
       {
-         int intorder = 2*fe->GetOrder() + 1; // <----------
-         ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         if (irs)
+         {
+            ir = irs[fe->GetGeomType()];
+         }
+         else
+         {
+            int intorder = 2*fe->GetOrder() + 1; // <----------
+            ir = &(IntRules.Get(fe->GetGeomType(), intorder));
+         }
+         GetVectorValues(*T, *ir, vals);
       }
-      T = fes->GetElementTransformation(i);
-      GetVectorValues(*T, *ir, vals);
       exsol.Eval(exact_vals, *T, *ir);
       vals -= exact_vals;
       loc_errs.SetSize(vals.Width());
@@ -2637,6 +2707,15 @@ void GridFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+void GridFunction::SaveCompressed(std::ostream &out, int codec,
+                                  double tol) const
+{
+   fes->Save(out);
+   out << "\nCompressed_data\n";
+   FPCompression::Write(out, GetData(), Size(), codec, tol);
+   out.flush();
+}
+
 void GridFunction::SaveVTK(std::ostream &out, const std::string &field_name,
                            int ref)
 {
@@ -64,6 +64,14 @@ protected:
        degree of freedom. */
    void ProjectDiscCoefficient(VectorCoefficient &coeff, Array<int> &dof_attr);
 
+   /** Evaluate the GridFunction in all elements at once, at the points of the
+       rule used by the error computations with the rules @a irs, see
+       QuadratureInterpolator. The values are stored in @a q_vals with the
+       layout (vdim, nq, ne). Returns the rule, or NULL if the space is not
+       supported by the QuadratureInterpolator. */
+   const IntegrationRule *GetErrorQuadValues(const IntegrationRule *irs[],
+                                             Vector &q_vals) const;
+
    void Destroy();
 
 public:
@@ -89,8 +97,8 @@ public:
 
    /// Construct a GridFunction on the given Mesh, using the data from @a input.
    /** The content of @a input should be in the format created by the method
-       Save(). The reconstructed FiniteElementSpace and FiniteElementCollection
-       are owned by the GridFunction. */
+       Save() or SaveCompressed(). The reconstructed FiniteElementSpace and
+       FiniteElementCollection are owned by the GridFunction. */
    GridFunction(Mesh *m, std::istream &input);
 
    GridFunction(Mesh *m, GridFunction *gf_array[], int num_pieces);
@@ -469,6 +477,16 @@ public:
    /// Save the GridFunction to an output stream.
    virtual void Save(std::ostream &out) const;
 
+   /** @brief Save the GridFunction to an output stream, with the data written
+       in binary form compressed with FPCompression::Write().
+
+       The @a codec is one of the FPCompression::Codec constants and @a tol is
+       the absolute error bound of the lossy codec. The output can be read
+       with the constructor GridFunction(Mesh*, std::istream&); the stream
+       should be opened in binary mode. */
+   virtual void SaveCompressed(std::ostream &out, int codec,
+                               double tol = 0.0) const;
+
    /** Write the GridFunction in VTK format. Note that Mesh::PrintVTK must be
        called first. The parameter ref > 0 must match the one used in
        Mesh::PrintVTK. */
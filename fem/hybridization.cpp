@@ -570,9 +570,8 @@ void Hybridization::ComputeH()
 {
    const int skip_zeros = 1;
    Array<int> c_dof_marker(Ct->Width());
-   Array<int> b_dofs, c_dofs;
+   Array<int> b_dofs;
    const int NE = fes->GetNE();
-   DenseMatrix Cb_t, Sb_inv_Cb_t, Hb;
 #ifndef MFEM_USE_MPI
    H = new SparseMatrix(Ct->Width());
 #else
@@ -581,78 +580,147 @@ void Hybridization::ComputeH()
    SparseMatrix *V = pC ? new SparseMatrix(Ct->Height(), Ct->Width()) : NULL;
 #endif
 
+   // Factor the blocks A_ii of all elements, then the Schur complements
+   // S_bb = A_bb - A_bi A_ii^{-1} A_ib
+   {
+      Array<int> ii_size(NE), bb_size(NE);
+      Array<double*> ii_data(NE), bb_data(NE);
+      Array<int*> ii_ipiv(NE), bb_ipiv(NE);
+      for (int el = 0; el < NE; el++)
+      {
+         GetBDofs(el, ii_size[el], b_dofs);
+         bb_size[el] = b_dofs.Size();
+         ii_data[el] = Af_data + Af_offsets[el];
+         ii_ipiv[el] = Af_ipiv + Af_f_offsets[el];
+         bb_data[el] = ii_data[el] + ii_size[el]*(ii_size[el]+2*bb_size[el]);
+         bb_ipiv[el] = ii_ipiv[el] + ii_size[el];
+      }
+      BatchLUFactor(ii_size, ii_data, ii_ipiv);
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int el = 0; el < NE; el++)
+      {
+         const int i_dofs_size = ii_size[el];
+         LUFactors LU_ii(ii_data[el], ii_ipiv[el]);
+         double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
+         double *A_bi_data = A_ib_data + i_dofs_size*bb_size[el];
+         LU_ii.BlockFactor(i_dofs_size, bb_size[el],
+                           A_ib_data, A_bi_data, bb_data[el]);
+      }
+      BatchLUFactor(bb_size, bb_data, bb_ipiv);
+   }
+
+   // Define the c_dofs of every element, in the order in which they appear in
+   // the rows of Ct for its b_dofs, and the local column index of every entry
+   // of Ct (every row of Ct belongs to exactly one element).
+   const int *Ct_I = Ct->GetI(), *Ct_J = Ct->GetJ();
+   const double *Ct_A = Ct->GetData();
+   Array<int> c_offsets(NE+1), c_dofs_all, Ct_J_loc(Ct_I[Ct->Height()]);
    c_dof_marker = -1;
    int c_mark_start = 0;
+   c_offsets[0] = 0;
    for (int el = 0; el < NE; el++)
    {
       int i_dofs_size;
       GetBDofs(el, i_dofs_size, b_dofs);
-
-      LUFactors LU_ii(Af_data + Af_offsets[el], Af_ipiv + Af_f_offsets[el]);
-      double *A_ib_data = LU_ii.data + i_dofs_size*i_dofs_size;
-      double *A_bi_data = A_ib_data + i_dofs_size*b_dofs.Size();
-      LUFactors LU_bb(A_bi_data + i_dofs_size*b_dofs.Size(),
-                      LU_ii.ipiv + i_dofs_size);
-
-      LU_ii.Factor(i_dofs_size);
-      LU_ii.BlockFactor(i_dofs_size, b_dofs.Size(),
-                        A_ib_data, A_bi_data, LU_bb.data);
-      LU_bb.Factor(b_dofs.Size());
-
-      // Extract Cb_t from Ct, define c_dofs
-      c_dofs.SetSize(0);
       for (int i = 0; i < b_dofs.Size(); i++)
       {
          const int row = b_dofs[i];
-         const int ncols = Ct->RowSize(row);
-         const int *cols = Ct->GetRowColumns(row);
-         for (int j = 0; j < ncols; j++)
+         for (int j = Ct_I[row]; j < Ct_I[row+1]; j++)
          {
-            const int c_dof = cols[j];
+            const int c_dof = Ct_J[j];
             if (c_dof_marker[c_dof] < c_mark_start)
             {
-               c_dof_marker[c_dof] = c_mark_start + c_dofs.Size();
-               c_dofs.Append(c_dof);
+               c_dof_marker[c_dof] =
+                  c_mark_start + c_dofs_all.Size() - c_offsets[el];
+               c_dofs_all.Append(c_dof);
             }
+            Ct_J_loc[j] = c_dof_marker[c_dof] - c_mark_start;
          }
       }
-      Cb_t.SetSize(b_dofs.Size(), c_dofs.Size());
+      c_offsets[el+1] = c_dofs_all.Size();
+      c_mark_start += c_offsets[el+1] - c_offsets[el];
+      MFEM_VERIFY(c_mark_start >= 0, "overflow"); // check for overflow
+   }
+
+   // Compute the element matrices Hb = Cb Sb^{-1} Cb^t or, when V is used,
+   // Sb^{-1} Cb^t, in parallel.
+   const bool use_V = (H == NULL);
+   Array<int> Hb_offsets(NE+1);
+   Hb_offsets[0] = 0;
+   for (int el = 0; el < NE; el++)
+   {
+      const int nc = c_offsets[el+1] - c_offsets[el];
+      int i_dofs_size;
+      GetBDofs(el, i_dofs_size, b_dofs);
+      Hb_offsets[el+1] = Hb_offsets[el] + (use_V ? b_dofs.Size() : nc)*nc;
+   }
+   Vector Hb_data(Hb_offsets[NE]);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int el = 0; el < NE; el++)
+   {
+      Array<int> el_b_dofs;
+      int i_dofs_size;
+      GetBDofs(el, i_dofs_size, el_b_dofs);
+      const int nb = el_b_dofs.Size();
+      const int nc = c_offsets[el+1] - c_offsets[el];
+
+      LUFactors LU_bb(Af_data + Af_offsets[el] +
+                      i_dofs_size*(i_dofs_size + 2*nb),
+                      Af_ipiv + Af_f_offsets[el] + i_dofs_size);
+
+      // Extract Cb_t from Ct
+      DenseMatrix Cb_t(nb, nc);
       Cb_t = 0.0;
-      for (int i = 0; i < b_dofs.Size(); i++)
+      for (int i = 0; i < nb; i++)
       {
-         const int row = b_dofs[i];
-         const int ncols = Ct->RowSize(row);
-         const int *cols = Ct->GetRowColumns(row);
-         const double *vals = Ct->GetRowEntries(row);
-         for (int j = 0; j < ncols; j++)
+         const int row = el_b_dofs[i];
+         for (int j = Ct_I[row]; j < Ct_I[row+1]; j++)
          {
-            const int loc_j = c_dof_marker[cols[j]] - c_mark_start;
-            Cb_t(i,loc_j) = vals[j];
+            Cb_t(i,Ct_J_loc[j]) = Ct_A[j];
          }
       }
 
       // Compute Hb = Cb Sb^{-1} Cb^t
-      Sb_inv_Cb_t = Cb_t;
-      LU_bb.Solve(Cb_t.Height(), Cb_t.Width(), Sb_inv_Cb_t.Data());
-#ifdef MFEM_USE_MPI
-      if (!pC)
-#endif
+      if (!use_V)
       {
-         Hb.SetSize(Cb_t.Width());
+         DenseMatrix Sb_inv_Cb_t(Cb_t);
+         LU_bb.Solve(nb, nc, Sb_inv_Cb_t.Data());
+         DenseMatrix Hb(Hb_data.GetData() + Hb_offsets[el], nc, nc);
          MultAtB(Cb_t, Sb_inv_Cb_t, Hb);
+      }
+      else
+      {
+         DenseMatrix Sb_inv_Cb_t(Hb_data.GetData() + Hb_offsets[el], nb, nc);
+         Sb_inv_Cb_t = Cb_t;
+         LU_bb.Solve(nb, nc, Sb_inv_Cb_t.Data());
+      }
+   }
 
-         // Assemble Hb into H
+   // Assemble Hb into H (or Sb^{-1} Cb^t into V). The sparsity pattern of H
+   // is not known in advance, so this loop is serial.
+   for (int el = 0; el < NE; el++)
+   {
+      const int nc = c_offsets[el+1] - c_offsets[el];
+      Array<int> c_dofs(c_dofs_all.GetData() + c_offsets[el], nc);
+      if (!use_V)
+      {
+         DenseMatrix Hb(Hb_data.GetData() + Hb_offsets[el], nc, nc);
          H->AddSubMatrix(c_dofs, c_dofs, Hb, skip_zeros);
       }
 #ifdef MFEM_USE_MPI
       else
       {
+         int i_dofs_size;
+         GetBDofs(el, i_dofs_size, b_dofs);
+         DenseMatrix Sb_inv_Cb_t(Hb_data.GetData() + Hb_offsets[el],
+                                 b_dofs.Size(), nc);
          V->AddSubMatrix(b_dofs, c_dofs, Sb_inv_Cb_t, skip_zeros);
       }
 #endif
-
-      c_mark_start += c_dofs.Size();
-      MFEM_VERIFY(c_mark_start >= 0, "overflow"); // check for overflow
    }
    const bool fix_empty_rows = true;
 #ifndef MFEM_USE_MPI
@@ -739,8 +807,8 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
    }
 
    const int NE = fes->GetMesh()->GetNE();
-   Array<int> vdofs, i_dofs, b_dofs;
-   Vector el_vals, bf_i, i_vals, b_vals;
+   Array<int> vdofs;
+   Vector el_vals, bf_i;
    bf.SetSize(hat_offsets[NE]);
    if (mode == 1)
    {
@@ -761,7 +829,8 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
       Ct->Mult(lambda, bf);
 #endif
    }
-   // Apply Af^{-1}
+   // Gather the element values of b1 (minus the ones of bf, if mode == 1);
+   // every vdof is counted only in the first element that contains it.
    Array<bool> vdof_marker(b1.Size());
    vdof_marker = false;
    for (int i = 0; i < NE; i++)
@@ -780,6 +849,17 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
       {
          el_vals -= bf_i;
       }
+      bf_i = el_vals;
+   }
+   // Apply Af^{-1}, element by element
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NE; i++)
+   {
+      Array<int> i_dofs, b_dofs;
+      Vector i_vals, b_vals;
+      Vector el_vals(&bf[hat_offsets[i]], hat_offsets[i+1] - hat_offsets[i]);
       GetIBDofs(i, i_dofs, b_dofs);
       el_vals.GetSubVector(i_dofs, i_vals);
       el_vals.GetSubVector(b_dofs, b_vals);
@@ -792,14 +872,14 @@ void Hybridization::MultAfInv(const Vector &b, const Vector &lambda, Vector &bf,
       LU_ii.BlockForwSolve(i_dofs.Size(), b_dofs.Size(), 1, L_bi,
                            i_vals.GetData(), b_vals.GetData());
       LU_bb.Solve(b_dofs.Size(), 1, b_vals.GetData());
-      bf_i = 0.0;
+      el_vals = 0.0;
       if (mode == 1)
       {
          LU_ii.BlockBackSolve(i_dofs.Size(), b_dofs.Size(), 1, U_ib,
                               b_vals.GetData(), i_vals.GetData());
-         bf_i.SetSubVector(i_dofs, i_vals);
+         el_vals.SetSubVector(i_dofs, i_vals);
       }
-      bf_i.SetSubVector(b_dofs, b_vals);
+      el_vals.SetSubVector(b_dofs, b_vals);
    }
 }
 
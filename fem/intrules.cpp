@@ -861,70 +861,60 @@ IntegrationRules::IntegrationRules(int Ref, int _type):
    CubeIntRules = NULL;
 }
 
-const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
+Array<IntegrationRule *> *IntegrationRules::GetIntRuleArray(int GeomType)
 {
-   Array<IntegrationRule *> *ir_array;
-
    switch (GeomType)
    {
-      case Geometry::POINT:       ir_array = &PointIntRules; Order = 0; break;
-      case Geometry::SEGMENT:     ir_array = &SegmentIntRules; break;
-      case Geometry::TRIANGLE:    ir_array = &TriangleIntRules; break;
-      case Geometry::SQUARE:      ir_array = &SquareIntRules; break;
-      case Geometry::TETRAHEDRON: ir_array = &TetrahedronIntRules; break;
-      case Geometry::CUBE:        ir_array = &CubeIntRules; break;
-      case Geometry::PRISM:       ir_array = &PrismIntRules; break;
+      case Geometry::POINT:       return &PointIntRules;
+      case Geometry::SEGMENT:     return &SegmentIntRules;
+      case Geometry::TRIANGLE:    return &TriangleIntRules;
+      case Geometry::SQUARE:      return &SquareIntRules;
+      case Geometry::TETRAHEDRON: return &TetrahedronIntRules;
+      case Geometry::CUBE:        return &CubeIntRules;
+      case Geometry::PRISM:       return &PrismIntRules;
       default:
-         mfem_error("IntegrationRules::Get(...) : Unknown geometry type!");
-         ir_array = NULL;
+         mfem_error("IntegrationRules: Unknown geometry type!");
+         return NULL;
    }
+}
+
+const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
+{
+   static_assert(NumGeom == Geometry::NumGeom, "invalid NumGeom");
+
+   Array<IntegrationRule *> *ir_array = GetIntRuleArray(GeomType);
 
-   if (Order < 0)
+   if (GeomType == Geometry::POINT || Order < 0)
    {
       Order = 0;
    }
 
+   // Rules that have been published are read without locking
+   const IntegrationRule *published = PublishedIntRules[GeomType].Get(Order);
+   if (published) { return *published; }
+
+   std::lock_guard<std::recursive_mutex> guard(mutex);
    if (!HaveIntRule(*ir_array, Order))
    {
-#ifdef MFEM_USE_LEGACY_OPENMP
-      #pragma omp critical
-#endif
+      IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
+      int RealOrder = Order;
+      while (RealOrder+1 < ir_array->Size() &&
+      /*  */ (*ir_array)[RealOrder+1] == ir)
       {
-         if (!HaveIntRule(*ir_array, Order))
-         {
-            IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
-            int RealOrder = Order;
-            while (RealOrder+1 < ir_array->Size() &&
-            /*  */ (*ir_array)[RealOrder+1] == ir)
-            {
-               RealOrder++;
-            }
-            ir->SetOrder(RealOrder);
-         }
+         RealOrder++;
       }
+      ir->SetOrder(RealOrder);
    }
+   PublishedIntRules[GeomType].Publish(*ir_array);
 
    return *(*ir_array)[Order];
 }
 
 void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
 {
-   Array<IntegrationRule *> *ir_array;
-
-   switch (GeomType)
-   {
-      case Geometry::POINT:       ir_array = &PointIntRules; break;
-      case Geometry::SEGMENT:     ir_array = &SegmentIntRules; break;
-      case Geometry::TRIANGLE:    ir_array = &TriangleIntRules; break;
-      case Geometry::SQUARE:      ir_array = &SquareIntRules; break;
-      case Geometry::TETRAHEDRON: ir_array = &TetrahedronIntRules; break;
-      case Geometry::CUBE:        ir_array = &CubeIntRules; break;
-      case Geometry::PRISM:       ir_array = &PrismIntRules; break;
-      default:
-         mfem_error("IntegrationRules::Set(...) : Unknown geometry type!");
-         ir_array = NULL;
-   }
+   Array<IntegrationRule *> *ir_array = GetIntRuleArray(GeomType);
 
+   std::lock_guard<std::recursive_mutex> guard(mutex);
    if (HaveIntRule(*ir_array, Order))
    {
       MFEM_ABORT("Overwriting set rules is not supported!");
@@ -933,6 +923,19 @@ void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
    AllocIntRule(*ir_array, Order);
 
    (*ir_array)[Order] = &IntRule;
+   PublishedIntRules[GeomType].Publish(*ir_array);
+}
+
+void IntegrationRules::Prewarm(int max_order)
+{
+   for (int g = 0; g < NumGeom; g++)
+   {
+      for (int order = 0; order <= max_order; order++)
+      {
+         Get(g, order);
+         if (g == Geometry::POINT) { break; }
+      }
+   }
 }
 
 void IntegrationRules::DeleteIntRuleArray(Array<IntegrationRule *> &ir_array)
@@ -1017,8 +1020,9 @@ IntegrationRule *IntegrationRules::SegmentIntegrationRule(int Order)
    // Order is one of {RealOrder-1,RealOrder}
    AllocIntRule(SegmentIntRules, RealOrder);
 
-   IntegrationRule tmp, *ir;
-   ir = refined ? &tmp : new IntegrationRule;
+   // The 1D rule is computed in 'tmp' and then copied, or split in two halves
+   // if 'refined', to the rule stored in SegmentIntRules
+   IntegrationRule tmp;
 
    int n = 0;
    // n is the number of points to achieve the exact integral of a
@@ -1029,35 +1033,35 @@ IntegrationRule *IntegrationRules::SegmentIntegrationRule(int Order)
       {
          // Gauss-Legendre is exact for 2*n-1
          n = Order/2 + 1;
-         quad_func.GaussLegendre(n, ir);
+         quad_func.GaussLegendre(n, &tmp);
          break;
       }
       case Quadrature1D::GaussLobatto:
       {
          // Gauss-Lobatto is exact for 2*n-3
          n = Order/2 + 2;
-         quad_func.GaussLobatto(n, ir);
+         quad_func.GaussLobatto(n, &tmp);
          break;
       }
       case Quadrature1D::OpenUniform:
       {
          // Open Newton Cotes is exact for n-(n+1)%2 = n-1+n%2
          n = Order | 1; // n is always odd
-         quad_func.OpenUniform(n, ir);
+         quad_func.OpenUniform(n, &tmp);
          break;
       }
       case Quadrature1D::ClosedUniform:
       {
          // Closed Newton Cotes is exact for n-(n+1)%2 = n-1+n%2
          n = Order | 1; // n is always odd
-         quad_func.ClosedUniform(n, ir);
+         quad_func.ClosedUniform(n, &tmp);
          break;
       }
       case Quadrature1D::OpenHalfUniform:
       {
          // Open half Newton Cotes is exact for n-(n+1)%2 = n-1+n%2
          n = Order | 1; // n is always odd
-         quad_func.OpenHalfUniform(n, ir);
+         quad_func.OpenHalfUniform(n, &tmp);
          break;
       }
       default:
@@ -1065,9 +1069,15 @@ IntegrationRule *IntegrationRules::SegmentIntegrationRule(int Order)
          MFEM_ABORT("unknown Quadrature1D type: " << quad_type);
       }
    }
-   if (refined)
+   // Effectively passing memory management to SegmentIntegrationRules
+   IntegrationRule *ir;
+   if (!refined)
+   {
+      ir = new IntegrationRule;
+      tmp.Copy(*ir);
+   }
+   else
    {
-      // Effectively passing memory management to SegmentIntegrationRules
       ir = new IntegrationRule(2*n);
       for (int j = 0; j < n; j++)
       {
@@ -15,6 +15,8 @@
 #include "../config/config.hpp"
 #include "../general/array.hpp"
 
+#include <mutex>
+
 namespace mfem
 {
 
@@ -309,6 +311,15 @@ private:
    Array<IntegrationRule *> PrismIntRules;
    Array<IntegrationRule *> CubeIntRules;
 
+   /// Number of geometry types, equal to Geometry::NumGeom.
+   static const int NumGeom = 7;
+   /// Copies of the rule arrays, indexed by Geometry::Type, read without locks.
+   ArraySnapshot<IntegrationRule> PublishedIntRules[NumGeom];
+   /// Serializes the generation of rules and the calls to Set().
+   std::recursive_mutex mutex;
+
+   Array<IntegrationRule *> *GetIntRuleArray(int GeomType);
+
    void AllocIntRule(Array<IntegrationRule *> &ir_array, int Order)
    {
       if (ir_array.Size() <= Order)
@@ -346,10 +357,16 @@ public:
                              int type = Quadrature1D::GaussLegendre);
 
    /// Returns an integration rule for given GeomType and Order.
+   /** Rules are generated on the first request. This method is thread-safe:
+       rules that have already been generated are returned without locking. */
    const IntegrationRule &Get(int GeomType, int Order);
 
    void Set(int GeomType, int Order, IntegrationRule &IntRule);
 
+   /** @brief Generate the rules of all geometries for the orders
+       0,...,@a max_order, e.g. before a threaded assembly. */
+   void Prewarm(int max_order);
+
    void SetOwnRules(int o) { own_rules = o; }
 
    /// Destroys an IntegrationRules object
@@ -13,14 +13,26 @@
 
 #include "fem.hpp"
 
+#ifdef MFEM_USE_LEGACY_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
+LinearForm::LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
+{
+   fes = f;
+   extern_lfs = 0;
+   assembly = AssemblyLevel::FULL;
+}
+
 LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
    : Vector(f->GetVSize())
 {
    fes = f;
    extern_lfs = 1;
+   assembly = lf->assembly;
 
    // Copy the pointers to the integrators
    dlfi = lf->dlfi;
@@ -33,6 +45,21 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
    flfi_marker = lf->flfi_marker;
 }
 
+LinearForm::LinearForm()
+{
+   fes = NULL;
+   extern_lfs = 0;
+   assembly = AssemblyLevel::FULL;
+}
+
+void LinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
+{
+   MFEM_VERIFY(assembly_level == AssemblyLevel::FULL ||
+               assembly_level == AssemblyLevel::PARTIAL,
+               "unsupported assembly level for LinearForm");
+   assembly = assembly_level;
+}
+
 void LinearForm::AddDomainIntegrator(LinearFormIntegrator *lfi)
 {
    DeltaLFIntegrator *maybe_delta =
@@ -85,15 +112,13 @@ void LinearForm::Assemble()
 
    if (dlfi.Size())
    {
-      for (i = 0; i < fes -> GetNE(); i++)
+      if (assembly == AssemblyLevel::PARTIAL)
       {
-         fes -> GetElementVDofs (i, vdofs);
-         eltrans = fes -> GetElementTransformation (i);
-         for (int k=0; k < dlfi.Size(); k++)
-         {
-            dlfi[k]->AssembleRHSElementVect(*fes->GetFE(i), *eltrans, elemvect);
-            AddElementVector (vdofs, elemvect);
-         }
+         AssembleDomainPA();
+      }
+      else
+      {
+         AssembleDomain();
       }
    }
    AssembleDelta();
@@ -185,6 +210,77 @@ void LinearForm::Assemble()
    }
 }
 
+void LinearForm::AssembleDomain()
+{
+#ifndef MFEM_USE_LEGACY_OPENMP
+   Array<int> vdofs;
+   ElementTransformation *eltrans;
+   Vector elemvect;
+
+   for (int i = 0; i < fes->GetNE(); i++)
+   {
+      fes->GetElementVDofs(i, vdofs);
+      eltrans = fes->GetElementTransformation(i);
+      for (int k = 0; k < dlfi.Size(); k++)
+      {
+         dlfi[k]->AssembleRHSElementVect(*fes->GetFE(i), *eltrans, elemvect);
+         AddElementVector(vdofs, elemvect);
+      }
+   }
+#else
+   // Each thread assembles into its own copy of the vector, the copies are
+   // then summed in the order of the threads.
+   const int size = Size();
+   const int nthreads = omp_get_max_threads();
+   Vector partial(nthreads*size);
+   partial = 0.0;
+
+   #pragma omp parallel
+   {
+      Array<int> vdofs;
+      IsoparametricTransformation eltrans;
+      Vector elemvect;
+      Vector my_partial(partial.GetData() + omp_get_thread_num()*size, size);
+
+      #pragma omp for
+      for (int i = 0; i < fes->GetNE(); i++)
+      {
+         fes->GetElementVDofs(i, vdofs);
+         fes->GetElementTransformation(i, &eltrans);
+         for (int k = 0; k < dlfi.Size(); k++)
+         {
+            dlfi[k]->AssembleRHSElementVect(*fes->GetFE(i), eltrans, elemvect);
+            my_partial.AddElementVector(vdofs, elemvect);
+         }
+      }
+
+      #pragma omp for
+      for (int j = 0; j < size; j++)
+      {
+         double sum = 0.0;
+         for (int t = 0; t < nthreads; t++)
+         {
+            sum += partial(t*size + j);
+         }
+         data[j] += sum;
+      }
+   }
+#endif
+}
+
+void LinearForm::AssembleDomainPA()
+{
+   ElemRestriction elem_restrict(*fes);
+   Vector ye(elem_restrict.vdim*elem_restrict.nedofs), ye_k;
+   ye = 0.0;
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      dlfi[k]->AssemblePA(*fes, ye_k);
+      ye += ye_k;
+   }
+   elem_restrict.MultTranspose(ye, *this);
+}
+
 void LinearForm::Update(FiniteElementSpace *f, Vector &v, int v_offset)
 {
    fes = f;
@@ -19,6 +19,9 @@
 namespace mfem
 {
 
+// Defined in bilinearform.hpp.
+enum class AssemblyLevel;
+
 /// Class for linear form - Vector with associated FE space and LFIntegrators.
 class LinearForm : public Vector
 {
@@ -30,6 +33,9 @@ protected:
        #blfi, and #flfi are owned by another LinearForm. */
    int extern_lfs;
 
+   /// The assembly level of the domain integrators, see SetAssemblyLevel().
+   AssemblyLevel assembly;
+
    /// Set of Domain Integrators to be applied.
    Array<LinearFormIntegrator*> dlfi;
 
@@ -56,6 +62,12 @@ protected:
    /// Force (re)computation of delta locations.
    void ResetDeltaLocations() { dlfi_delta_elem_id.SetSize(0); }
 
+   /// Assemble the domain integrators #dlfi element by element.
+   void AssembleDomain();
+
+   /// Assemble the domain integrators #dlfi with partial assembly.
+   void AssembleDomainPA();
+
 private:
    /// Copy construction is not supported; body is undefined.
    LinearForm(const LinearForm &);
@@ -63,8 +75,7 @@ private:
 public:
    /// Creates linear form associated with FE space @a *f.
    /** The pointer @a f is not owned by the newly constructed object. */
-   LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; extern_lfs = 0; }
+   LinearForm(FiniteElementSpace *f);
 
    /** @brief Create a LinearForm on the FiniteElementSpace @a f, using the
        same integrators as the LinearForm @a lf.
@@ -79,7 +90,7 @@ public:
    /** The associated FiniteElementSpace can be set later using one of the
        methods: Update(FiniteElementSpace *) or
        Update(FiniteElementSpace *, Vector &, int). */
-   LinearForm() { fes = NULL; extern_lfs = 0; }
+   LinearForm();
 
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use FiniteElementSpace%s that
@@ -99,6 +110,21 @@ public:
    /// Read-only access to the associated FiniteElementSpace.
    const FiniteElementSpace *FESpace() const { return fes; }
 
+   /// Set the desired assembly level. The default is AssemblyLevel::FULL.
+   /** With AssemblyLevel::PARTIAL, the domain integrators are evaluated at the
+       quadrature points of all elements at once, see
+       LinearFormIntegrator::AssemblePA(), and the element vectors are summed
+       into the LinearForm with the transpose of the ElemRestriction. This is
+       supported for tensor product elements by DomainLFIntegrator. The
+       boundary, boundary face and delta integrators are always assembled
+       element by element.
+
+       With AssemblyLevel::FULL and MFEM_USE_LEGACY_OPENMP = YES, the element
+       loop of the domain integrators runs in parallel: each thread sums its
+       element vectors into a private vector and the private vectors are added
+       in a fixed order, so the result does not depend on the scheduling. */
+   void SetAssemblyLevel(AssemblyLevel assembly_level);
+
    /// Adds new Domain Integrator. Assumes ownership of @a lfi.
    void AddDomainIntegrator(LinearFormIntegrator *lfi);
 
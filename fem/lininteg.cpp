@@ -22,11 +22,20 @@ void LinearFormIntegrator::AssembleRHSElementVect(
    mfem_error("LinearFormIntegrator::AssembleRHSElementVect(...)");
 }
 
+void LinearFormIntegrator::AssemblePA(const FiniteElementSpace &fes,
+                                      Vector &ye)
+{
+   MFEM_ABORT("partial assembly is not supported by this integrator");
+}
+
 
 void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
                                                 ElementTransformation &Tr,
                                                 Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape;
+#endif
    int dof = el.GetDof();
 
    shape.SetSize(dof);       // vector of size dof
@@ -41,6 +50,9 @@ void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
       ir = &IntRules.Get(el.GetGeomType(), oa * el.GetOrder() + ob);
    }
 
+   // The shape functions are the same for all elements of this type
+   const ShapeTable *table = el.GetShapeTable(*ir);
+
    for (int i = 0; i < ir->GetNPoints(); i++)
    {
       const IntegrationPoint &ip = ir->IntPoint(i);
@@ -48,9 +60,12 @@ void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
       Tr.SetIntPoint (&ip);
       double val = Tr.Weight() * Q.Eval(Tr, ip);
 
-      el.CalcShape(ip, shape);
+      if (!table) { el.CalcShape(ip, shape); }
+      // Read-only view of the shared table
+      const Vector shape_i(const_cast<double*>(table ? table->GetShape(i) :
+                                               shape.GetData()), dof);
 
-      add(elvect, ip.weight * val, shape, elvect);
+      add(elvect, ip.weight * val, shape_i, elvect);
    }
 }
 
@@ -67,6 +82,9 @@ void DomainLFIntegrator::AssembleDeltaElementVect(
 void BoundaryLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, ElementTransformation &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape;
+#endif
    int dof = el.GetDof();
 
    shape.SetSize(dof);        // vector of size dof
@@ -96,6 +114,9 @@ void BoundaryLFIntegrator::AssembleRHSElementVect(
 void BoundaryNormalLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, ElementTransformation &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape;
+#endif
    int dim = el.GetDim()+1;
    int dof = el.GetDof();
    Vector nor(dim), Qvec;
@@ -128,6 +149,9 @@ void BoundaryNormalLFIntegrator::AssembleRHSElementVect(
 void BoundaryTangentialLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, ElementTransformation &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape;
+#endif
    int dim = el.GetDim()+1;
    int dof = el.GetDof();
    Vector tangent(dim), Qvec;
@@ -168,6 +192,9 @@ void BoundaryTangentialLFIntegrator::AssembleRHSElementVect(
 void VectorDomainLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, ElementTransformation &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, Qvec;
+#endif
    int vdim = Q.GetVDim();
    int dof  = el.GetDof();
 
@@ -210,6 +237,9 @@ void VectorDomainLFIntegrator::AssembleRHSElementVect(
 void VectorDomainLFIntegrator::AssembleDeltaElementVect(
    const FiniteElement &fe, ElementTransformation &Trans, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, Qvec;
+#endif
    MFEM_ASSERT(vec_delta != NULL, "coefficient must be VectorDeltaCoefficient");
    int vdim = Q.GetVDim();
    int dof  = fe.GetDof();
@@ -228,6 +258,9 @@ void VectorDomainLFIntegrator::AssembleDeltaElementVect(
 void VectorBoundaryLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, ElementTransformation &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, vec;
+#endif
    int vdim = Q.GetVDim();
    int dof  = el.GetDof();
 
@@ -263,6 +296,9 @@ void VectorBoundaryLFIntegrator::AssembleRHSElementVect(
 void VectorBoundaryLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, FaceElementTransformations &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, vec;
+#endif
    int vdim = Q.GetVDim();
    int dof  = el.GetDof();
 
@@ -303,6 +339,10 @@ void VectorBoundaryLFIntegrator::AssembleRHSElementVect(
 void VectorFEDomainLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, ElementTransformation &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix vshape;
+   Vector vec;
+#endif
    int dof = el.GetDof();
    int spaceDim = Tr.GetSpaceDim();
 
@@ -337,6 +377,10 @@ void VectorFEDomainLFIntegrator::AssembleRHSElementVect(
 void VectorFEDomainLFIntegrator::AssembleDeltaElementVect(
    const FiniteElement &fe, ElementTransformation &Trans, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   DenseMatrix vshape;
+   Vector vec;
+#endif
    MFEM_ASSERT(vec_delta != NULL, "coefficient must be VectorDeltaCoefficient");
    int dof = fe.GetDof();
    int spaceDim = Trans.GetSpaceDim();
@@ -354,6 +398,9 @@ void VectorFEDomainLFIntegrator::AssembleDeltaElementVect(
 void VectorBoundaryFluxLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, ElementTransformation &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, nor;
+#endif
    int dim = el.GetDim()+1;
    int dof = el.GetDof();
 
@@ -387,6 +434,9 @@ void VectorBoundaryFluxLFIntegrator::AssembleRHSElementVect(
 void VectorFEBoundaryFluxLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, ElementTransformation &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape;
+#endif
    int dof = el.GetDof();
 
    shape.SetSize(dof);
@@ -461,6 +511,9 @@ void BoundaryFlowIntegrator::AssembleRHSElementVect(
 void BoundaryFlowIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, FaceElementTransformations &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape;
+#endif
    int dim, ndof, order;
    double un, w, vu_data[3], nor_data[3];
 
@@ -521,6 +574,10 @@ void DGDirichletLFIntegrator::AssembleRHSElementVect(
 void DGDirichletLFIntegrator::AssembleRHSElementVect(
    const FiniteElement &el, FaceElementTransformations &Tr, Vector &elvect)
 {
+#ifdef MFEM_THREAD_SAFE
+   Vector shape, dshape_dn, nor, nh, ni;
+   DenseMatrix dshape, mq, adjJ;
+#endif
    int dim, ndof;
    bool kappa_is_nonzero = (kappa != 0.);
    double w;
@@ -18,6 +18,8 @@
 namespace mfem
 {
 
+class FiniteElementSpace;
+
 /// Abstract base class LinearFormIntegrator
 class LinearFormIntegrator
 {
@@ -36,6 +38,15 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   /** @brief Partially assembled version of AssembleRHSElementVect(): compute
+       the element vectors of all elements of @a fes and store them in the
+       E-vector @a ye, see ElemRestriction.
+
+       The element vectors are evaluated at the quadrature points and
+       transformed with sum factorization, without forming any element
+       transformations. The default implementation aborts. */
+   virtual void AssemblePA(const FiniteElementSpace &fes, Vector &ye);
+
    void SetIntRule(const IntegrationRule *ir) { IntRule = ir; }
    const IntegrationRule* GetIntRule() { return IntRule; }
 
@@ -92,7 +103,9 @@ public:
 /// Class for domain integration L(v) := (f, v)
 class DomainLFIntegrator : public DeltaLFIntegrator
 {
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
+#endif
    Coefficient &Q;
    int oa, ob;
 public:
@@ -116,13 +129,18 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   /** Supported for tensor product elements in 2D and 3D. */
+   virtual void AssemblePA(const FiniteElementSpace &fes, Vector &ye);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
 /// Class for boundary integration L(v) := (g, v)
 class BoundaryLFIntegrator : public LinearFormIntegrator
 {
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
+#endif
    Coefficient &Q;
    int oa, ob;
 public:
@@ -142,7 +160,9 @@ public:
 /// Class for boundary integration \f$ L(v) = (g \cdot n, v) \f$
 class BoundaryNormalLFIntegrator : public LinearFormIntegrator
 {
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
+#endif
    VectorCoefficient &Q;
    int oa, ob;
 public:
@@ -160,7 +180,9 @@ public:
 /// Class for boundary integration \f$ L(v) = (g \cdot \tau, v) \f$ in 2D
 class BoundaryTangentialLFIntegrator : public LinearFormIntegrator
 {
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
+#endif
    VectorCoefficient &Q;
    int oa, ob;
 public:
@@ -180,7 +202,9 @@ public:
 class VectorDomainLFIntegrator : public DeltaLFIntegrator
 {
 private:
+#ifndef MFEM_THREAD_SAFE
    Vector shape, Qvec;
+#endif
    VectorCoefficient &Q;
 
 public:
@@ -206,7 +230,9 @@ public:
 class VectorBoundaryLFIntegrator : public LinearFormIntegrator
 {
 private:
+#ifndef MFEM_THREAD_SAFE
    Vector shape, vec;
+#endif
    VectorCoefficient &Q;
 
 public:
@@ -232,8 +258,10 @@ class VectorFEDomainLFIntegrator : public DeltaLFIntegrator
 {
 private:
    VectorCoefficient &QF;
+#ifndef MFEM_THREAD_SAFE
    DenseMatrix vshape;
    Vector vec;
+#endif
 
 public:
    VectorFEDomainLFIntegrator(VectorCoefficient &F)
@@ -259,7 +287,9 @@ class VectorBoundaryFluxLFIntegrator : public LinearFormIntegrator
 private:
    double Sign;
    Coefficient *F;
+#ifndef MFEM_THREAD_SAFE
    Vector shape, nor;
+#endif
 
 public:
    VectorBoundaryFluxLFIntegrator(Coefficient &f, double s = 1.0,
@@ -280,7 +310,9 @@ class VectorFEBoundaryFluxLFIntegrator : public LinearFormIntegrator
 {
 private:
    Coefficient &F;
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
+#endif
 
 public:
    VectorFEBoundaryFluxLFIntegrator(Coefficient &f) : F(f) { }
@@ -320,7 +352,9 @@ private:
    VectorCoefficient *u;
    double alpha, beta;
 
+#ifndef MFEM_THREAD_SAFE
    Vector shape;
+#endif
 
 public:
    BoundaryFlowIntegrator(Coefficient &_f, VectorCoefficient &_u,
@@ -352,9 +386,10 @@ protected:
    MatrixCoefficient *MQ;
    double sigma, kappa;
 
-   // these are not thread-safe!
+#ifndef MFEM_THREAD_SAFE
    Vector shape, dshape_dn, nor, nh, ni;
    DenseMatrix dshape, mq, adjJ;
+#endif
 
 public:
    DGDirichletLFIntegrator(Coefficient &u, const double s, const double k)
@@ -0,0 +1,271 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "../general/forall.hpp"
+#include "lininteg.hpp"
+#include "bilininteg.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+const int MAX_Q1D = 10;
+const int MAX_D1D = 10;
+
+// PA Domain LF Apply 2D kernel: ye = Bt (x) Bt op
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADomainLFApply2D(const int NE,
+                       const double* _Bt,
+                       const double* _op,
+                       double* _y,
+                       const int d1d = 0,
+                       const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+
+   const DeviceMatrix Bt(_Bt, D1D, Q1D);
+   const DeviceTensor<3> op(_op, Q1D, Q1D, NE);
+   DeviceTensor<3> y(_y, D1D, D1D, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            y(dx,dy,e) = 0.0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double sol_x[MAX_D1D];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            sol_x[dx] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double s = op(qx,qy,e);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] += Bt(dx,qx) * s;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double q2d = Bt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               y(dx,dy,e) += q2d * sol_x[dx];
+            }
+         }
+      }
+   });
+}
+
+// PA Domain LF Apply 3D kernel: ye = Bt (x) Bt (x) Bt op
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADomainLFApply3D(const int NE,
+                       const double* _Bt,
+                       const double* _op,
+                       double* _y,
+                       const int d1d = 0,
+                       const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+
+   const DeviceMatrix Bt(_Bt, D1D, Q1D);
+   const DeviceTensor<4> op(_op, Q1D, Q1D, Q1D, NE);
+   DeviceTensor<4> y(_y, D1D, D1D, D1D, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               y(dx,dy,dz,e) = 0.0;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double sol_xy[MAX_D1D][MAX_D1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_xy[dy][dx] = 0.0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double sol_x[MAX_D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double s = op(qx,qy,qz,e);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += Bt(dx,qx) * s;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy = Bt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] += wy * sol_x[dx];
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz = Bt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,dz,e) += wz * sol_xy[dy][dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+static void PADomainLFApply(const int dim,
+                            const int D1D,
+                            const int Q1D,
+                            const int NE,
+                            const double* Bt,
+                            const double* op,
+                            double* y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PADomainLFApply2D<2,2>(NE, Bt, op, y);
+         case 0x23: return PADomainLFApply2D<2,3>(NE, Bt, op, y);
+         case 0x33: return PADomainLFApply2D<3,3>(NE, Bt, op, y);
+         case 0x34: return PADomainLFApply2D<3,4>(NE, Bt, op, y);
+         case 0x44: return PADomainLFApply2D<4,4>(NE, Bt, op, y);
+         case 0x45: return PADomainLFApply2D<4,5>(NE, Bt, op, y);
+         case 0x55: return PADomainLFApply2D<5,5>(NE, Bt, op, y);
+         default:   return PADomainLFApply2D(NE, Bt, op, y, D1D, Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PADomainLFApply3D<2,2>(NE, Bt, op, y);
+         case 0x23: return PADomainLFApply3D<2,3>(NE, Bt, op, y);
+         case 0x33: return PADomainLFApply3D<3,3>(NE, Bt, op, y);
+         case 0x34: return PADomainLFApply3D<3,4>(NE, Bt, op, y);
+         case 0x44: return PADomainLFApply3D<4,4>(NE, Bt, op, y);
+         case 0x45: return PADomainLFApply3D<4,5>(NE, Bt, op, y);
+         default:   return PADomainLFApply3D(NE, Bt, op, y, D1D, Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// PA Domain LF Assemble kernel
+void DomainLFIntegrator::AssemblePA(const FiniteElementSpace &fes, Vector &ye)
+{
+   const Mesh *mesh = fes.GetMesh();
+   const FiniteElement &el = *fes.GetFE(0);
+   MFEM_VERIFY(dynamic_cast<const TensorBasisElement*>(&el) != NULL,
+               "partial assembly requires tensor product elements");
+   MFEM_VERIFY(fes.GetVDim() == 1, "vector spaces are not supported");
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             oa * el.GetOrder() + ob);
+   const int dim = mesh->Dimension();
+   const int ne = mesh->GetNE();
+   const int nq = ir->GetNPoints();
+   const int dofs1D = el.GetOrder() + 1;
+   const int quad1D =
+      IntRules.Get(Geometry::SEGMENT, ir->GetOrder()).GetNPoints();
+   // geom and maps are cached and owned by GeometryExtension::Get() and
+   // DofToQuad::Get()
+   const GeometryExtension *geom = GeometryExtension::Get(fes, *ir);
+   const DofToQuad *maps = DofToQuad::Get(fes, fes, *ir);
+
+   ConstantCoefficient *const_coeff = dynamic_cast<ConstantCoefficient*>(&Q);
+   FunctionCoefficient *function_coeff = dynamic_cast<FunctionCoefficient*>(&Q);
+   double constant = 0.0;
+   double (*function)(const Vector3&) = NULL;
+   // Other coefficients are evaluated on the host at all quadrature points
+   Vector qcoeff;
+   if (const_coeff)
+   {
+      constant = const_coeff->constant;
+   }
+   else if (function_coeff && function_coeff->GetDeviceFunction())
+   {
+      function = function_coeff->GetDeviceFunction();
+   }
+   else
+   {
+      Q.Eval(qcoeff, *fes.GetMesh(), *ir);
+      qcoeff.Push();
+   }
+   if (dim == 1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
+
+   Vector vec(ne*nq);
+   const int NE = ne;
+   const int NQ = nq;
+   const int DIM = dim;
+   const bool use_qcoeff = (qcoeff.Size() > 0);
+   const DeviceMatrix C(qcoeff.GetData(), NQ, NE);
+   const DeviceVector w(maps->W.GetData(), NQ);
+   const DeviceTensor<3> x(geom->X.GetData(), DIM,NQ,NE);
+   const DeviceMatrix detJ(geom->detJ.GetData(), NQ, NE);
+   DeviceMatrix v(vec.GetData(), NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         const Vector3 Xq(x(0,q,e), x(1,q,e), DIM == 3 ? x(2,q,e) : 0.0);
+         const double coeff =
+         function ? function(Xq)
+         : use_qcoeff ? C(q,e)
+         : constant;
+         v(q,e) = w[q] * coeff * detJ(q,e);
+      }
+   });
+
+   ye.SetSize(ne*el.GetDof());
+   PADomainLFApply(dim, dofs1D, quad1D, ne, maps->Bt, vec, ye);
+}
+
+} // namespace mfem
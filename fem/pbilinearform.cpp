@@ -187,6 +187,206 @@ HypreParMatrix *ParBilinearForm::ParallelAssemble(SparseMatrix *m)
    return Mh.As<HypreParMatrix>();
 }
 
+ParSparseMatrix *ParBilinearForm::ParallelAssembleSparse(SparseMatrix *m)
+{
+   MFEM_VERIFY(m != NULL && m->Finalized(),
+               "the local matrix must be assembled and finalized");
+   MFEM_VERIFY(pfes->Conforming(), "nonconforming spaces are not supported");
+   MFEM_VERIFY(m->Height() == height && m->Width() == width,
+               "face-neighbor couplings are not supported");
+
+   const int lsize = height, tsize = pfes->GetTrueVSize();
+   const long my_offset = pfes->GetMyTDofOffset();
+   const GroupCommunicator &gc = pfes->GroupComm();
+   const GroupTopology &gtopo = gc.GetGroupTopology();
+   const Table &group_ldof = gc.GroupLDofTable();
+   const int num_nbrs = gtopo.GetNumNeighbors();
+
+   // The neighbor (group master) owning each ldof, 0 for this processor
+   Array<int> ldof_owner(lsize);
+   ldof_owner = 0;
+   for (int gr = 1; gr < group_ldof.Size(); gr++)
+   {
+      if (gtopo.IAmMaster(gr)) { continue; }
+      const int *ldofs = group_ldof.GetRow(gr);
+      for (int j = 0; j < group_ldof.RowSize(gr); j++)
+      {
+         ldof_owner[ldofs[j]] = gtopo.GetGroupMaster(gr);
+      }
+   }
+
+   Array<long> glob_tdof(lsize);
+   for (int i = 0; i < lsize; i++)
+   {
+      glob_tdof[i] = pfes->GetGlobalTDofNumber(i);
+   }
+
+   // Send the rows of the ldofs owned by other processors to their owners as
+   // (global row, row size, global columns) and the row values
+   const int *I = m->GetI(), *J = m->GetJ();
+   const double *A = m->GetData();
+   Array<long> *send_idx = new Array<long>[num_nbrs];
+   Array<double> *send_val = new Array<double>[num_nbrs];
+   for (int i = 0; i < lsize; i++)
+   {
+      const int nbr = ldof_owner[i];
+      if (nbr == 0) { continue; }
+      send_idx[nbr].Append(glob_tdof[i]);
+      send_idx[nbr].Append(I[i+1] - I[i]);
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         send_idx[nbr].Append(glob_tdof[J[k]]);
+         send_val[nbr].Append(A[k]);
+      }
+   }
+
+   MPI_Comm comm = pfes->GetComm();
+   const int nbr_tag = 44821, idx_tag = 44822, val_tag = 44823;
+
+   // A row of the assembled matrix can couple the dofs of two processors that
+   // share dofs with the processor owning the element, so the neighbors of
+   // the matrix are within the neighbors of the neighbors in gtopo.
+   Array<int> my_nbrs(num_nbrs), mat_nbrs;
+   for (int nbr = 0; nbr < num_nbrs; nbr++)
+   {
+      my_nbrs[nbr] = gtopo.GetNeighborRank(nbr);
+   }
+   my_nbrs.Copy(mat_nbrs);
+   Array<MPI_Request> nbr_requests(num_nbrs-1);
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      MPI_Isend(my_nbrs.GetData(), num_nbrs, MPI_INT,
+                gtopo.GetNeighborRank(nbr), nbr_tag, comm,
+                &nbr_requests[nbr-1]);
+   }
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      const int rank = gtopo.GetNeighborRank(nbr);
+      MPI_Status status;
+      int count;
+      MPI_Probe(rank, nbr_tag, comm, &status);
+      MPI_Get_count(&status, MPI_INT, &count);
+      const int size = mat_nbrs.Size();
+      mat_nbrs.SetSize(size + count);
+      MPI_Recv(mat_nbrs.GetData() + size, count, MPI_INT, rank, nbr_tag, comm,
+               MPI_STATUS_IGNORE);
+   }
+   MPI_Waitall(nbr_requests.Size(), nbr_requests.GetData(),
+               MPI_STATUSES_IGNORE);
+
+   Array<MPI_Request> requests(2*(num_nbrs-1));
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      const int rank = gtopo.GetNeighborRank(nbr);
+      MPI_Isend(send_idx[nbr].GetData(), send_idx[nbr].Size(), MPI_LONG,
+                rank, idx_tag, comm, &requests[2*(nbr-1)]);
+      MPI_Isend(send_val[nbr].GetData(), send_val[nbr].Size(), MPI_DOUBLE,
+                rank, val_tag, comm, &requests[2*(nbr-1)+1]);
+   }
+
+   Array<long> *recv_idx = new Array<long>[num_nbrs];
+   Array<double> *recv_val = new Array<double>[num_nbrs];
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      const int rank = gtopo.GetNeighborRank(nbr);
+      MPI_Status status;
+      int count;
+      MPI_Probe(rank, idx_tag, comm, &status);
+      MPI_Get_count(&status, MPI_LONG, &count);
+      recv_idx[nbr].SetSize(count);
+      MPI_Recv(recv_idx[nbr].GetData(), count, MPI_LONG, rank, idx_tag, comm,
+               MPI_STATUS_IGNORE);
+      MPI_Probe(rank, val_tag, comm, &status);
+      MPI_Get_count(&status, MPI_DOUBLE, &count);
+      recv_val[nbr].SetSize(count);
+      MPI_Recv(recv_val[nbr].GetData(), count, MPI_DOUBLE, rank, val_tag, comm,
+               MPI_STATUS_IGNORE);
+   }
+
+   // Count the entries of the owned rows, including repeated columns
+   Array<int> row_ptr(tsize+1);
+   row_ptr = 0;
+   for (int i = 0; i < lsize; i++)
+   {
+      if (ldof_owner[i] == 0)
+      {
+         row_ptr[pfes->GetLocalTDofNumber(i)+1] += I[i+1] - I[i];
+      }
+   }
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      const Array<long> &idx = recv_idx[nbr];
+      for (int p = 0; p < idx.Size(); p += 2 + idx[p+1])
+      {
+         const int row = idx[p] - my_offset;
+         MFEM_ASSERT(0 <= row && row < tsize, "invalid received row");
+         row_ptr[row+1] += idx[p+1];
+      }
+   }
+   row_ptr.PartialSum();
+
+   // Fill the entries as (global column, value) pairs and sort each row
+   Array<Pair<long,double> > entries(row_ptr[tsize]);
+   Array<int> pos(tsize);
+   for (int r = 0; r < tsize; r++) { pos[r] = row_ptr[r]; }
+   for (int i = 0; i < lsize; i++)
+   {
+      if (ldof_owner[i] != 0) { continue; }
+      int &p = pos[pfes->GetLocalTDofNumber(i)];
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         entries[p++] = Pair<long,double>(glob_tdof[J[k]], A[k]);
+      }
+   }
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      const Array<long> &idx = recv_idx[nbr];
+      const double *val = recv_val[nbr].GetData();
+      for (int q = 0; q < idx.Size(); q += 2 + idx[q+1])
+      {
+         int &p = pos[(int)(idx[q] - my_offset)];
+         for (int k = 0; k < idx[q+1]; k++)
+         {
+            entries[p++] = Pair<long,double>(idx[q+2+k], *(val++));
+         }
+      }
+   }
+
+   MPI_Waitall(requests.Size(), requests.GetData(), MPI_STATUSES_IGNORE);
+   delete [] recv_val;
+   delete [] recv_idx;
+   delete [] send_val;
+   delete [] send_idx;
+
+   // Merge the repeated columns of each row
+   Array<int> A_I(tsize+1);
+   Array<long> A_J(row_ptr[tsize]);
+   Array<double> A_data(row_ptr[tsize]);
+   int nnz = 0;
+   A_I[0] = 0;
+   for (int r = 0; r < tsize; r++)
+   {
+      SortPairs<long,double>(entries.GetData() + row_ptr[r],
+                             row_ptr[r+1] - row_ptr[r]);
+      for (int k = row_ptr[r]; k < row_ptr[r+1]; k++)
+      {
+         if (nnz > A_I[r] && A_J[nnz-1] == entries[k].one)
+         {
+            A_data[nnz-1] += entries[k].two;
+         }
+         else
+         {
+            A_J[nnz] = entries[k].one;
+            A_data[nnz++] = entries[k].two;
+         }
+      }
+      A_I[r+1] = nnz;
+   }
+
+   return new ParSparseMatrix(comm, tsize, A_I.GetData(), A_J.GetData(),
+                              A_data.GetData(), mat_nbrs);
+}
+
 void ParBilinearForm::AssembleSharedFaces(int skip_zeros)
 {
    ParMesh *pmesh = pfes->GetParMesh();
@@ -266,9 +466,6 @@ ParallelEliminateEssentialBC(const Array<int> &bdr_attr_is_ess,
 void ParBilinearForm::TrueAddMult(const Vector &x, Vector &y, const double a)
 const
 {
-   MFEM_VERIFY(fbfi.Size() == 0, "the case of interior face integrators is not"
-               " implemented");
-
    if (X.ParFESpace() != pfes)
    {
       X.SetSpace(pfes);
@@ -276,7 +473,50 @@ const
    }
 
    X.Distribute(&x);
-   mat->Mult(X, Y);
+   if (fbfi.Size() == 0)
+   {
+      mat->Mult(X, Y);
+   }
+   else
+   {
+      MFEM_VERIFY(mat->Finalized(), "the local matrix must be finalized");
+
+      // The columns of mat starting at 'height' correspond to the dofs of the
+      // face-neighbor elements. Multiply by the columns of the local dofs while
+      // the face-neighbor values of X are being exchanged, and keep track of
+      // the rows coupled to the face-neighbor dofs.
+      X.ExchangeFaceNbrDataBegin();
+
+      const int *I = mat->GetI(), *J = mat->GetJ();
+      const double *A = mat->GetData();
+      shared_rows.SetSize(0);
+      for (int i = 0; i < height; i++)
+      {
+         double d = 0.0;
+         bool shared = false;
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            if (J[k] < height) { d += A[k]*X(J[k]); }
+            else { shared = true; }
+         }
+         Y(i) = d;
+         if (shared) { shared_rows.Append(i); }
+      }
+
+      X.ExchangeFaceNbrDataEnd();
+
+      const Vector &X_nbr = X.FaceNbrData();
+      for (int r = 0; r < shared_rows.Size(); r++)
+      {
+         const int i = shared_rows[r];
+         double d = 0.0;
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            if (J[k] >= height) { d += A[k]*X_nbr(J[k] - height); }
+         }
+         Y(i) += d;
+      }
+   }
    pfes->Dof_TrueDof_Matrix()->MultTranspose(a, Y, 1.0, y);
 }
 
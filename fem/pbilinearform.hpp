@@ -32,6 +32,9 @@ protected:
 
    /// Auxiliary objects used in TrueAddMult().
    mutable ParGridFunction X, Y;
+   /** @brief Rows of #mat coupled to face-neighbor dofs, recomputed in
+       TrueAddMult() when interior face integrators are present. */
+   mutable Array<int> shared_rows;
 
    OperatorHandle p_mat, p_mat_e;
 
@@ -115,6 +118,23 @@ public:
        @a A = P^t A_local P in the format (type id) specified by @a A. */
    void ParallelAssemble(OperatorHandle &A, SparseMatrix *A_local);
 
+   /** @brief Returns the matrix assembled on the true dofs, i.e. P^t A P, as a
+       ParSparseMatrix, without using hypre. */
+   /** The returned matrix has to be deleted by the caller. */
+   ParSparseMatrix *ParallelAssembleSparse()
+   { return ParallelAssembleSparse(mat); }
+
+   /** @brief Return the matrix @a m assembled on the true dofs, i.e. P^t A P,
+       as a ParSparseMatrix. */
+   /** The triple product is computed directly from the rows of @a m: the rows
+       of the dofs owned by this processor are accumulated locally, the other
+       rows are sent to the processors owning them, and the columns are mapped
+       to global true dofs. All messages are exchanged with the neighbors in
+       the group topology of the space and their neighbors. Only conforming
+       spaces without face-neighbor couplings are supported. The returned
+       matrix has to be deleted by the caller. */
+   ParSparseMatrix *ParallelAssembleSparse(SparseMatrix *m);
+
    /// Eliminate essential boundary DOFs from a parallel assembled system.
    /** The array @a bdr_attr_is_ess marks boundary attributes that constitute
        the essential part of the boundary. */
@@ -148,6 +168,10 @@ public:
 
    /** @brief Compute @a y += @a a (P^t A P) @a x, where @a x and @a y are
        vectors on the true dofs. */
+   /** With interior face integrators, e.g. for DG discretizations, the
+       exchange of the face-neighbor data is overlapped with the
+       multiplication by the part of the local matrix that does not involve
+       the face-neighbor dofs. The local matrix must be finalized. */
    void TrueAddMult(const Vector &x, Vector &y, const double a = 1.0) const;
 
    /// Return the parallel FE space associated with the ParBilinearForm.
@@ -17,6 +17,7 @@
 #include "../general/sort_pairs.hpp"
 #include "../mesh/mesh_headers.hpp"
 #include "../general/binaryio.hpp"
+#include "../general/forall.hpp"
 
 #include <climits> // INT_MAX
 #include <limits>
@@ -571,7 +572,50 @@ void ParFiniteElementSpace::GenerateGlobalOffsets() const
    ldof[0] = GetVSize();
    ldof[1] = TrueVSize();
 
-   pmesh->GenerateOffsets(2, ldof, offsets);
+   if (HYPRE_AssumedPartitionCheck() && !NURBSext)
+   {
+      // The numbers of (true) dofs are sums over the local (owned) entities,
+      // so the offsets follow from the entity offsets of the mesh. These are
+      // updated locally by uniform refinement, avoiding the global exchange.
+      const Array<long> &ent_offsets = pmesh->GetEntityOffsets();
+      long off[4] = { 0, 0, 0, 0 };
+      for (int g = 0; g < Geometry::NumGeom; g++)
+      {
+         if (ent_offsets[4*g+1] == 0) { continue; } // geometry not present
+         const int nd = vdim*fec->DofForGeometry(Geometry::Type(g));
+         for (int k = 0; k < 4; k++)
+         {
+            off[k] += nd*ent_offsets[4*g+k];
+         }
+      }
+      for (int i = 0; i < 2; i++)
+      {
+         offsets[i]->SetSize(3);
+         (*offsets[i])[0] = off[2*i];
+         (*offsets[i])[1] = off[2*i] + ldof[i];
+         (*offsets[i])[2] = off[2*i+1];
+         // check for overflow
+         MFEM_VERIFY((*offsets[i])[0] == off[2*i] &&
+                     (*offsets[i])[2] == off[2*i+1], "overflow in offsets");
+      }
+#ifdef MFEM_DEBUG
+      Array<HYPRE_Int> dof_offs, tdof_offs;
+      Array<HYPRE_Int> *check[2] = { &dof_offs, &tdof_offs };
+      pmesh->GenerateOffsets(2, ldof, check);
+      for (int i = 0; i < 2; i++)
+      {
+         for (int j = 0; j < 3; j++)
+         {
+            MFEM_VERIFY((*check[i])[j] == (*offsets[i])[j],
+                        "inconsistent offsets");
+         }
+      }
+#endif
+   }
+   else
+   {
+      pmesh->GenerateOffsets(2, ldof, offsets);
+   }
 
    if (HYPRE_AssumedPartitionCheck())
    {
@@ -854,7 +898,17 @@ const Operator *ParFiniteElementSpace::GetProlongationMatrix() const
 {
    if (Conforming())
    {
-      if (!Pconf) { Pconf = new ConformingProlongationOperator(*this); }
+      if (!Pconf)
+      {
+         if (Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK))
+         {
+            Pconf = new DeviceConformingProlongationOperator(*this);
+         }
+         else
+         {
+            Pconf = new ConformingProlongationOperator(*this);
+         }
+      }
       return Pconf;
    }
    else
@@ -1135,7 +1189,7 @@ const FiniteElement *ParFiniteElementSpace::GetFaceNbrFaceFE(int i) const
    // Works in tandem with GetFaceNbrFaceVDofs() defined above.
    MFEM_ASSERT(Nonconforming() && !NURBSext, "");
    Geometry::Type geom = (pmesh->Dimension() == 2) ?
-                         Geometry::SEGMENT : Geometry::SQUARE;
+                         Geometry::SEGMENT : pncmesh->GetFaceGeometry();
    return fec->FiniteElementForGeometry(geom);
 }
 
@@ -1287,19 +1341,19 @@ void ParFiniteElementSpace::GetGhostFaceDofs(const MeshId &face_id,
                                              Array<int> &dofs) const
 {
    const int ghost_face_index = face_id.index - pncmesh->GetNFaces();
-   MFEM_ASSERT(pncmesh->GetGhostFaceGeometry(ghost_face_index)
-               == Geometry::SQUARE, "");
+   Geometry::Type geom = pncmesh->GetGhostFaceGeometry(ghost_face_index);
+   const int nfv = Geometry::NumVerts[geom];
 
    int nv = fec->DofForGeometry(Geometry::POINT);
    int ne = fec->DofForGeometry(Geometry::SEGMENT);
-   int nf = fec->DofForGeometry(Geometry::SQUARE);
-   dofs.SetSize(4*nv + 4*ne + nf);
+   int nf = fec->DofForGeometry(geom);
+   dofs.SetSize(nfv*nv + nfv*ne + nf);
 
    int V[4], E[4], Eo[4];
    pmesh->pncmesh->GetFaceVerticesEdges(face_id, V, E, Eo);
 
    int offset = 0;
-   for (int i = 0; i < 4; i++)
+   for (int i = 0; i < nfv; i++)
    {
       int ghost = pncmesh->GetNVertices();
       int first = (V[i] < ghost) ? V[i]*nv : (ndofs + (V[i] - ghost)*nv);
@@ -1309,7 +1363,7 @@ void ParFiniteElementSpace::GetGhostFaceDofs(const MeshId &face_id,
       }
    }
 
-   for (int i = 0; i < 4; i++)
+   for (int i = 0; i < nfv; i++)
    {
       int ghost = pncmesh->GetNEdges();
       int first = (E[i] < ghost) ? nvdofs + E[i]*ne
@@ -1365,8 +1419,7 @@ void ParFiniteElementSpace::GetBareDofs(int entity, int index,
          break;
 
       default:
-         MFEM_ASSERT(!pmesh->HasGeometry(Geometry::TRIANGLE), "");
-         ned = fec->DofForGeometry(Geometry::SQUARE);
+         ned = fec->DofForGeometry(pncmesh->GetFaceGeometry());
          ghost = pncmesh->GetNFaces();
          first = (index < ghost)
                  ? nvdofs + nedofs + index*ned // regular face
@@ -1406,9 +1459,8 @@ int ParFiniteElementSpace::PackDof(int entity, int index, int edof) const
                 : ndofs + ngvdofs + (index - ghost)*ned + edof; // ghost edge
 
       default:
-         MFEM_ASSERT(!pmesh->HasGeometry(Geometry::TRIANGLE), "");
          ghost = pncmesh->GetNFaces();
-         ned = fec->DofForGeometry(Geometry::SQUARE);
+         ned = fec->DofForGeometry(pncmesh->GetFaceGeometry());
 
          return (index < ghost)
                 ? nvdofs + nedofs + index*ned + edof // regular face
@@ -1441,8 +1493,7 @@ void ParFiniteElementSpace::UnpackDof(int dof,
       dof -= nedofs;
       if (dof < nfdofs) // regular face
       {
-         MFEM_ASSERT(!pmesh->HasGeometry(Geometry::TRIANGLE), "");
-         int nf = fec->DofForGeometry(Geometry::SQUARE);
+         int nf = fec->DofForGeometry(pncmesh->GetFaceGeometry());
          entity = 2, index = dof / nf, edof = dof % nf;
          return;
       }
@@ -1885,12 +1936,14 @@ int ParFiniteElementSpace
          const NCMesh::NCList &list = pncmesh->GetNCList(entity);
          if (!list.masters.size()) { continue; }
 
+         Geometry::Type geom = (entity > 1) ? pncmesh->GetFaceGeometry()
+                               /*        */ : Geometry::SEGMENT;
+
          IsoparametricTransformation T;
-         if (entity > 1) { T.SetFE(&QuadrilateralFE); }
+         if (geom == Geometry::TRIANGLE) { T.SetFE(&TriangleFE); }
+         else if (geom == Geometry::SQUARE) { T.SetFE(&QuadrilateralFE); }
          else { T.SetFE(&SegmentFE); }
 
-         Geometry::Type geom = (entity > 1) ?
-                               Geometry::SQUARE : Geometry::SEGMENT;
          const FiniteElement* fe = fec->FiniteElementForGeometry(geom);
          if (!fe) { continue; }
 
@@ -2859,6 +2912,13 @@ ConformingProlongationOperator::ConformingProlongationOperator(
 }
 
 void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
+{
+   MultBegin(x, y);
+   MultEnd(y);
+}
+
+void ConformingProlongationOperator::MultBegin(const Vector &x,
+                                               Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Width(), "");
    MFEM_ASSERT(y.Size() == Height(), "");
@@ -2879,14 +2939,32 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
       j = end+1;
    }
    std::copy(xdata+j-m, xdata+Width(), ydata+j);
+}
 
+void ConformingProlongationOperator::MultEnd(Vector &y) const
+{
    const int out_layout = 0; // 0 - output is ldofs array
-   gc.BcastEnd(ydata, out_layout);
+   gc.BcastEnd(y.GetData(), out_layout);
    y.Push();
 }
 
 void ConformingProlongationOperator::MultTranspose(
    const Vector &x, Vector &y) const
+{
+   MultTransposeBegin(x);
+   MultTransposeEnd(x, y);
+}
+
+void ConformingProlongationOperator::MultTransposeBegin(const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+
+   x.Pull();
+   gc.ReduceBegin(x.GetData());
+}
+
+void ConformingProlongationOperator::MultTransposeEnd(const Vector &x,
+                                                      Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Height(), "");
    MFEM_ASSERT(y.Size() == Width(), "");
@@ -2896,8 +2974,6 @@ void ConformingProlongationOperator::MultTranspose(
    x.Pull();
    const int m = external_ldofs.Size();
 
-   gc.ReduceBegin(xdata);
-
    int j = 0;
    for (int i = 0; i < m; i++)
    {
@@ -2912,6 +2988,175 @@ void ConformingProlongationOperator::MultTranspose(
    y.Push();
 }
 
+DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
+   const ParFiniteElementSpace &pfes)
+   : ConformingProlongationOperator(pfes),
+     comm(pfes.GetComm()),
+     num_requests(0)
+{
+   const int m = external_ldofs.Size();
+   ltdof_ldof.SetSize(Width());
+   int j = 0;
+   for (int i = 0; i < m; i++)
+   {
+      const int end = external_ldofs[i];
+      for ( ; j < end; j++)
+      {
+         ltdof_ldof[j-i] = j;
+      }
+      j = end+1;
+   }
+   for ( ; j < Height(); j++)
+   {
+      ltdof_ldof[j-m] = j;
+   }
+
+   const GroupTopology &gtopo = gc.GetGroupTopology();
+   const int num_nbrs = gtopo.GetNumNeighbors();
+   nbr_ranks.SetSize(num_nbrs);
+   for (int nbr = 0; nbr < num_nbrs; nbr++)
+   {
+      nbr_ranks[nbr] = gtopo.GetNeighborRank(nbr);
+   }
+
+   const Table &nbr_ltdof = gc.GetNbrSendLTDofs();
+   const Table &nbr_ldof = gc.GetNbrRecvLDofs();
+   MFEM_VERIFY(nbr_ltdof.Size() == num_nbrs && nbr_ldof.Size() == num_nbrs,
+               "the neighbor lists of the GroupCommunicator are not set");
+   shr_ltdof.Append(nbr_ltdof.GetJ(), nbr_ltdof.Size_of_connections());
+   shr_offsets.Append(nbr_ltdof.GetI(), num_nbrs+1);
+   ext_ldof.Append(nbr_ldof.GetJ(), nbr_ldof.Size_of_connections());
+   ext_offsets.Append(nbr_ldof.GetI(), num_nbrs+1);
+   MFEM_ASSERT(ext_ldof.Size() == m, "");
+
+   // Group the contributions received in MultTranspose() by ltdof
+   const int ns = shr_ltdof.Size();
+   Array<Pair<int,int> > ltdof_pos(ns);
+   for (int k = 0; k < ns; k++)
+   {
+      ltdof_pos[k].one = shr_ltdof[k];
+      ltdof_pos[k].two = k;
+   }
+   SortPairs<int,int>(ltdof_pos, ns);
+   for (int k = 0; k < ns; k++)
+   {
+      if (k == 0 || ltdof_pos[k].one != ltdof_pos[k-1].one)
+      {
+         unq_ltdof.Append(ltdof_pos[k].one);
+         unq_shr_i.Append(k);
+      }
+      unq_shr_j.Append(ltdof_pos[k].two);
+   }
+   unq_shr_i.Append(ns);
+
+   shr_buf.SetSize(ns);
+   ext_buf.SetSize(m);
+   requests.SetSize(2*num_nbrs);
+}
+
+void DeviceConformingProlongationOperator::PostMessages(
+   const Vector &sbuf, const Array<int> &soffsets, Vector &rbuf,
+   const Array<int> &roffsets, int tag) const
+{
+   num_requests = 0;
+   for (int nbr = 1; nbr < nbr_ranks.Size(); nbr++)
+   {
+      const int size = roffsets[nbr+1] - roffsets[nbr];
+      if (size == 0) { continue; }
+      MPI_Irecv(rbuf.GetData() + roffsets[nbr], size, MPI_DOUBLE,
+                nbr_ranks[nbr], tag, comm, &requests[num_requests++]);
+   }
+   for (int nbr = 1; nbr < nbr_ranks.Size(); nbr++)
+   {
+      const int size = soffsets[nbr+1] - soffsets[nbr];
+      if (size == 0) { continue; }
+      MPI_Isend(sbuf.GetData() + soffsets[nbr], size, MPI_DOUBLE,
+                nbr_ranks[nbr], tag, comm, &requests[num_requests++]);
+   }
+}
+
+void DeviceConformingProlongationOperator::MultBegin(const Vector &x,
+                                                     Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == Width(), "");
+   MFEM_ASSERT(y.Size() == Height(), "");
+
+   // Pack the shared true dofs and send them to the other group members
+   const int ns = shr_ltdof.Size();
+   const DeviceArray d_shr_ltdof(shr_ltdof, ns);
+   const DeviceVector d_x(x, Width());
+   DeviceVector d_shr_buf(shr_buf, ns);
+   MFEM_FORALL(i, ns, d_shr_buf[i] = d_x[d_shr_ltdof[i]];);
+   shr_buf.Pull();
+   PostMessages(shr_buf, shr_offsets, ext_buf, ext_offsets, 48822);
+
+   // Copy the owned dofs
+   const int n = Width();
+   const DeviceArray d_ltdof_ldof(ltdof_ldof, n);
+   DeviceVector d_y(y, Height());
+   MFEM_FORALL(i, n, d_y[d_ltdof_ldof[i]] = d_x[i];);
+}
+
+void DeviceConformingProlongationOperator::MultEnd(Vector &y) const
+{
+   MPI_Waitall(num_requests, requests.GetData(), MPI_STATUSES_IGNORE);
+   ext_buf.Push();
+
+   // Unpack the external dofs
+   const int ne = ext_ldof.Size();
+   const DeviceArray d_ext_ldof(ext_ldof, ne);
+   const DeviceVector d_ext_buf(ext_buf, ne);
+   DeviceVector d_y(y, Height());
+   MFEM_FORALL(i, ne, d_y[d_ext_ldof[i]] = d_ext_buf[i];);
+}
+
+void DeviceConformingProlongationOperator::MultTransposeBegin(
+   const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+
+   // Pack the external dofs and send them to the masters of their groups
+   const int ne = ext_ldof.Size();
+   const DeviceArray d_ext_ldof(ext_ldof, ne);
+   const DeviceVector d_x(x, Height());
+   DeviceVector d_ext_buf(ext_buf, ne);
+   MFEM_FORALL(i, ne, d_ext_buf[i] = d_x[d_ext_ldof[i]];);
+   ext_buf.Pull();
+   PostMessages(ext_buf, ext_offsets, shr_buf, shr_offsets, 49822);
+}
+
+void DeviceConformingProlongationOperator::MultTransposeEnd(
+   const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+   MFEM_ASSERT(y.Size() == Width(), "");
+
+   // Copy the owned dofs
+   const int n = Width();
+   const DeviceArray d_ltdof_ldof(ltdof_ldof, n);
+   const DeviceVector d_x(x, Height());
+   DeviceVector d_y(y, n);
+   MFEM_FORALL(i, n, d_y[i] = d_x[d_ltdof_ldof[i]];);
+
+   // Add the contributions from the other processors
+   MPI_Waitall(num_requests, requests.GetData(), MPI_STATUSES_IGNORE);
+   shr_buf.Push();
+   const int nu = unq_ltdof.Size();
+   const DeviceArray d_unq_ltdof(unq_ltdof, nu);
+   const DeviceArray d_unq_shr_i(unq_shr_i, nu+1);
+   const DeviceArray d_unq_shr_j(unq_shr_j, unq_shr_j.Size());
+   const DeviceVector d_shr_buf(shr_buf, shr_buf.Size());
+   MFEM_FORALL(i, nu,
+   {
+      double sum = 0.0;
+      for (int k = d_unq_shr_i[i]; k < d_unq_shr_i[i+1]; k++)
+      {
+         sum += d_shr_buf[d_unq_shr_j[k]];
+      }
+      d_y[d_unq_ltdof[i]] += sum;
+   });
+}
+
 } // namespace mfem
 
 #endif
@@ -382,9 +382,81 @@ protected:
 public:
    ConformingProlongationOperator(const ParFiniteElementSpace &pfes);
 
+   /// Return the sorted list of ldofs owned by other processors.
+   const Array<int> &GetExternalLDofs() const { return external_ldofs; }
+
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /** @brief Begin Mult(): post the communication of the shared true dofs and
+       copy the owned dofs of @a x to @a y. */
+   /** The external ldofs of @a y are set by MultEnd(). The data of @a x must
+       not be modified before that. */
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   /// Finalize the operation started with MultBegin().
+   virtual void MultEnd(Vector &y) const;
+
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** @brief Begin MultTranspose(): post the communication of the external
+       ldofs of @a x. */
+   /** Only the external ldofs of @a x are used, so the rest of @a x can be
+       computed before calling MultTransposeEnd(). */
+   virtual void MultTransposeBegin(const Vector &x) const;
+
+   /** @brief Finalize the operation started with MultTransposeBegin(): copy the
+       owned dofs of @a x to @a y and add the contributions from the other
+       processors. */
+   virtual void MultTransposeEnd(const Vector &x, Vector &y) const;
+
+   virtual ~ConformingProlongationOperator() { }
+};
+
+/** @brief Version of ConformingProlongationOperator for the device and OpenMP
+    backends. */
+/** The copies between the true dofs and the local dofs, and the packing and
+    unpacking of the MPI buffers, are MFEM_FORALL kernels on the vectors in the
+    memory space of the backend. Only the contiguous buffers with the shared
+    entries are moved between the device and the host for MPI. */
+class DeviceConformingProlongationOperator
+   : public ConformingProlongationOperator
+{
+protected:
+   MPI_Comm comm;
+   Array<int> nbr_ranks;   ///< The ranks of the neighbors (nbr 0 = me).
+   Array<int> ltdof_ldof;  ///< The ldof of each ltdof.
+   /** The shared ltdofs sent to the neighbors in a Mult(), in message order,
+       and the offsets of the messages, see
+       GroupCommunicator::GetNbrSendLTDofs(). MultTranspose() receives the
+       contributions to these ltdofs in the same order. */
+   Array<int> shr_ltdof, shr_offsets;
+   /** The external ldofs received from the neighbors in a Mult(), in message
+       order, and the offsets of the messages, see
+       GroupCommunicator::GetNbrRecvLDofs(). */
+   Array<int> ext_ldof, ext_offsets;
+   /** The distinct entries of shr_ltdof and, in CSR format, the positions in
+       shr_buf of their contributions, used to assemble MultTranspose()
+       without write conflicts. */
+   Array<int> unq_ltdof, unq_shr_i, unq_shr_j;
+
+   mutable Vector shr_buf, ext_buf;
+   mutable Array<MPI_Request> requests;
+   mutable int num_requests;
+
+   /// Post the receives into @a rbuf and the sends of @a sbuf.
+   void PostMessages(const Vector &sbuf, const Array<int> &soffsets,
+                     Vector &rbuf, const Array<int> &roffsets, int tag) const;
+
+public:
+   DeviceConformingProlongationOperator(const ParFiniteElementSpace &pfes);
+
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   virtual void MultEnd(Vector &y) const;
+
+   virtual void MultTransposeBegin(const Vector &x) const;
+
+   virtual void MultTransposeEnd(const Vector &x, Vector &y) const;
 };
 
 }
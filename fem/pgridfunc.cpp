@@ -200,7 +200,7 @@ HypreParVector *ParGridFunction::ParallelAssemble() const
    return tv;
 }
 
-void ParGridFunction::ExchangeFaceNbrData()
+void ParGridFunction::ExchangeFaceNbrDataBegin()
 {
    pfes->ExchangeFaceNbrData();
 
@@ -212,7 +212,8 @@ void ParGridFunction::ExchangeFaceNbrData()
    ParMesh *pmesh = pfes->GetParMesh();
 
    face_nbr_data.SetSize(pfes->GetFaceNbrVSize());
-   Vector send_data(pfes->send_face_nbr_ldof.Size_of_connections());
+   Vector &send_data = send_face_nbr_data;
+   send_data.SetSize(pfes->send_face_nbr_ldof.Size_of_connections());
 
    int *send_offset = pfes->send_face_nbr_ldof.GetI();
    int *send_ldof = pfes->send_face_nbr_ldof.GetJ();
@@ -220,10 +221,9 @@ void ParGridFunction::ExchangeFaceNbrData()
    MPI_Comm MyComm = pfes->GetComm();
 
    int num_face_nbrs = pmesh->GetNFaceNeighbors();
-   MPI_Request *requests = new MPI_Request[2*num_face_nbrs];
-   MPI_Request *send_requests = requests;
-   MPI_Request *recv_requests = requests + num_face_nbrs;
-   MPI_Status  *statuses = new MPI_Status[num_face_nbrs];
+   face_nbr_requests.SetSize(2*num_face_nbrs);
+   MPI_Request *send_requests = face_nbr_requests.GetData();
+   MPI_Request *recv_requests = send_requests + num_face_nbrs;
 
    for (int i = 0; i < send_data.Size(); i++)
    {
@@ -244,11 +244,21 @@ void ParGridFunction::ExchangeFaceNbrData()
                 MPI_DOUBLE, nbr_rank, tag, MyComm, &recv_requests[fn]);
    }
 
-   MPI_Waitall(num_face_nbrs, send_requests, statuses);
-   MPI_Waitall(num_face_nbrs, recv_requests, statuses);
+}
+
+void ParGridFunction::ExchangeFaceNbrDataEnd()
+{
+   if (pfes->GetFaceNbrVSize() <= 0)
+   {
+      return;
+   }
 
-   delete [] statuses;
-   delete [] requests;
+   // Wait for the receives first, the sends are usually complete by then
+   int num_face_nbrs = pfes->GetParMesh()->GetNFaceNeighbors();
+   MPI_Request *send_requests = face_nbr_requests.GetData();
+   MPI_Request *recv_requests = send_requests + num_face_nbrs;
+   MPI_Waitall(num_face_nbrs, recv_requests, MPI_STATUSES_IGNORE);
+   MPI_Waitall(num_face_nbrs, send_requests, MPI_STATUSES_IGNORE);
 }
 
 double ParGridFunction::GetValue(int i, const IntegrationPoint &ip, int vdim)
@@ -500,6 +510,22 @@ void ParGridFunction::Save(std::ostream &out) const
    }
 }
 
+void ParGridFunction::SaveCompressed(std::ostream &out, int codec,
+                                     double tol) const
+{
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data[i] = -data[i]; }
+   }
+
+   GridFunction::SaveCompressed(out, codec, tol);
+
+   for (int i = 0; i < size; i++)
+   {
+      if (pfes->GetDofSign(i) < 0) { data[i] = -data[i]; }
+   }
+}
+
 void ParGridFunction::SaveAsOne(std::ostream &out)
 {
    int i, p;
@@ -35,9 +35,14 @@ protected:
    ParFiniteElementSpace *pfes; ///< Points to the same object as #fes
 
    /** @brief Vector used to store data from face-neighbor processors,
-       initialized by ExchangeFaceNbrData(). */
+       initialized by ExchangeFaceNbrData() or ExchangeFaceNbrDataEnd(). */
    Vector face_nbr_data;
 
+   /** @brief Send buffer and requests of ExchangeFaceNbrDataBegin(), reused
+       across calls. */
+   Vector send_face_nbr_data;
+   Array<MPI_Request> face_nbr_requests;
+
    void ProjectBdrCoefficient(Coefficient *coeff[], VectorCoefficient *vcoeff,
                               Array<int> &attr);
 
@@ -192,7 +197,22 @@ public:
    /// Returns a new vector assembled on the true dofs.
    HypreParVector *ParallelAssemble() const;
 
-   void ExchangeFaceNbrData();
+   /** @brief Copy the values of the dofs on the face-neighbor elements into
+       FaceNbrData(), see also ExchangeFaceNbrDataBegin(). */
+   void ExchangeFaceNbrData()
+   { ExchangeFaceNbrDataBegin(); ExchangeFaceNbrDataEnd(); }
+
+   /** @brief Start the exchange of the face-neighbor data: the values sent to
+       the face-neighbor processors are copied into an internal buffer and the
+       non-blocking messages are posted. */
+   /** The data of the ParGridFunction can be modified after this call, while
+       FaceNbrData() must not be accessed until ExchangeFaceNbrDataEnd() is
+       called. Work that does not involve the face-neighbor data, e.g. the
+       interior part of a DG operator, can be performed in between. */
+   void ExchangeFaceNbrDataBegin();
+   /// Complete the exchange started by ExchangeFaceNbrDataBegin().
+   void ExchangeFaceNbrDataEnd();
+
    Vector &FaceNbrData() { return face_nbr_data; }
    const Vector &FaceNbrData() const { return face_nbr_data; }
 
@@ -313,6 +333,11 @@ public:
        the local dofs. */
    virtual void Save(std::ostream &out) const;
 
+   /** Save the local portion of the ParGridFunction in compressed binary form,
+       taking into account the signs of the local dofs, see Save(). */
+   virtual void SaveCompressed(std::ostream &out, int codec,
+                               double tol = 0.0) const;
+
    /// Merge the local grid functions
    void SaveAsOne(std::ostream &out = mfem::out);
 
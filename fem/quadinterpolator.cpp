@@ -0,0 +1,707 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "quadinterpolator.hpp"
+#include "../general/forall.hpp"
+#include "gridfunc.hpp"
+#include <cmath>
+
+namespace mfem
+{
+
+static const int MAX_QI_D1D = 10;
+static const int MAX_QI_Q1D = 10;
+
+// Check that all elements of @a fes use the same FiniteElement
+static bool SingleElementSpace(const FiniteElementSpace &fes)
+{
+   if (fes.GetNURBSext() || fes.GetNE() == 0) { return false; }
+   const FiniteElement *fe = fes.GetFE(0);
+   if (fe->GetMapType() != FiniteElement::VALUE) { return false; }
+   for (int e = 1; e < fes.GetNE(); e++)
+   {
+      if (fes.GetFE(e) != fe) { return false; }
+   }
+   return true;
+}
+
+// Lexicographic-to-native dof map of @a fe, or NULL if it is the identity
+static const int *LexicographicMap(const FiniteElement &fe, bool tensor)
+{
+   if (!tensor) { return NULL; }
+   const Array<int> &dof_map =
+      dynamic_cast<const TensorBasisElement&>(fe).GetDofMap();
+   return dof_map.Size() ? dof_map.GetData() : NULL;
+}
+
+// Gather the dofs of all elements of @a fes: the E-vector layout is
+// (ND, VDIM, NE) and the dofs of the tensor product elements are ordered
+// lexicographically.
+static void GetElementIndices(const FiniteElementSpace &fes, bool tensor,
+                              Array<int> &indices)
+{
+   const int ne = fes.GetNE();
+   const int vdim = fes.GetVDim();
+   const int nd = fes.GetFE(0)->GetDof();
+   const int *dof_map = LexicographicMap(*fes.GetFE(0), tensor);
+   Array<int> vdofs;
+   indices.SetSize(nd*vdim*ne);
+   for (int e = 0; e < ne; e++)
+   {
+      fes.GetElementVDofs(e, vdofs);
+      for (int c = 0; c < vdim; c++)
+      {
+         for (int d = 0; d < nd; d++)
+         {
+            const int ld = dof_map ? dof_map[d] : d;
+            indices[d + nd*(c + vdim*e)] = vdofs[ld + nd*c];
+         }
+      }
+   }
+}
+
+static void GatherElementDofs(const Array<int> &indices, const Vector &l_vec,
+                              Vector &e_vec)
+{
+   const int N = indices.Size();
+   e_vec.SetSize(N);
+   const DeviceArray d_indices(indices, N);
+   const DeviceVector d_l(l_vec, l_vec.Size());
+   DeviceVector d_e(e_vec, N);
+   MFEM_FORALL(i, N,
+   {
+      const int j = d_indices[i];
+      d_e[i] = (j >= 0) ? d_l[j] : -d_l[-1-j];
+   });
+}
+
+// Values at the points of a general rule: v(c,q,e) = sum_d B(q,d) x(d,c,e)
+static void InterpValues(const int NE, const int VD, const int ND,
+                         const int NQ, const double *_B, const double *_x,
+                         double *_v)
+{
+   const DeviceMatrix B(_B, NQ, ND);
+   const DeviceTensor<3> x(_x, ND, VD, NE);
+   DeviceTensor<3> v(_v, VD, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VD; c++)
+      {
+         for (int q = 0; q < NQ; q++)
+         {
+            double s = 0.0;
+            for (int d = 0; d < ND; d++)
+            {
+               s += B(q,d) * x(d,c,e);
+            }
+            v(c,q,e) = s;
+         }
+      }
+   });
+}
+
+// Reference derivatives at the points of a general rule:
+// g(c,k,q,e) = sum_d G(q,k,d) x(d,c,e)
+static void InterpDerivatives(const int NE, const int VD, const int DIM,
+                              const int ND, const int NQ, const double *_G,
+                              const double *_x, double *_g)
+{
+   const DeviceTensor<3> G(_G, NQ, DIM, ND);
+   const DeviceTensor<3> x(_x, ND, VD, NE);
+   DeviceTensor<4> g(_g, VD, DIM, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VD; c++)
+      {
+         for (int q = 0; q < NQ; q++)
+         {
+            for (int k = 0; k < DIM; k++)
+            {
+               double s = 0.0;
+               for (int d = 0; d < ND; d++)
+               {
+                  s += G(q,k,d) * x(d,c,e);
+               }
+               g(c,k,q,e) = s;
+            }
+         }
+      }
+   });
+}
+
+// Sum factorized values, 2D
+static void TensorValues2D(const int NE, const int VD, const int D1D,
+                           const int Q1D, const double *_B, const double *_x,
+                           double *_v)
+{
+   const DeviceMatrix B(_B, Q1D, D1D);
+   const DeviceTensor<4> x(_x, D1D, D1D, VD, NE);
+   DeviceTensor<4> v(_v, VD, Q1D, Q1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VD; c++)
+      {
+         double u[MAX_QI_Q1D][MAX_QI_Q1D];
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int qx = 0; qx < Q1D; qx++) { u[qy][qx] = 0.0; }
+         }
+         for (int dy = 0; dy < D1D; dy++)
+         {
+            double bx[MAX_QI_Q1D];
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               double s = 0.0;
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  s += B(qx,dx) * x(dx,dy,c,e);
+               }
+               bx[qx] = s;
+            }
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               const double wy = B(qy,dy);
+               for (int qx = 0; qx < Q1D; qx++) { u[qy][qx] += wy * bx[qx]; }
+            }
+         }
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int qx = 0; qx < Q1D; qx++) { v(c,qx,qy,e) = u[qy][qx]; }
+         }
+      }
+   });
+}
+
+// Sum factorized reference derivatives, 2D
+static void TensorDerivatives2D(const int NE, const int VD, const int D1D,
+                                const int Q1D, const double *_B,
+                                const double *_G, const double *_x,
+                                double *_g)
+{
+   const DeviceMatrix B(_B, Q1D, D1D);
+   const DeviceMatrix G(_G, Q1D, D1D);
+   const DeviceTensor<4> x(_x, D1D, D1D, VD, NE);
+   DeviceTensor<5> g(_g, VD, 2, Q1D, Q1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VD; c++)
+      {
+         double du0[MAX_QI_Q1D][MAX_QI_Q1D], du1[MAX_QI_Q1D][MAX_QI_Q1D];
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               du0[qy][qx] = du1[qy][qx] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; dy++)
+         {
+            double bx[MAX_QI_Q1D], gx[MAX_QI_Q1D];
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               double sb = 0.0, sg = 0.0;
+               for (int dx = 0; dx < D1D; dx++)
+               {
+                  const double xd = x(dx,dy,c,e);
+                  sb += B(qx,dx) * xd;
+                  sg += G(qx,dx) * xd;
+               }
+               bx[qx] = sb;
+               gx[qx] = sg;
+            }
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               const double by = B(qy,dy), gy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  du0[qy][qx] += by * gx[qx];
+                  du1[qy][qx] += gy * bx[qx];
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; qy++)
+         {
+            for (int qx = 0; qx < Q1D; qx++)
+            {
+               g(c,0,qx,qy,e) = du0[qy][qx];
+               g(c,1,qx,qy,e) = du1[qy][qx];
+            }
+         }
+      }
+   });
+}
+
+// Sum factorized values, 3D
+static void TensorValues3D(const int NE, const int VD, const int D1D,
+                           const int Q1D, const double *_B, const double *_x,
+                           double *_v)
+{
+   const DeviceMatrix B(_B, Q1D, D1D);
+   const DeviceTensor<5> x(_x, D1D, D1D, D1D, VD, NE);
+   DeviceTensor<5> v(_v, VD, Q1D, Q1D, Q1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VD; c++)
+      {
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               for (int qx = 0; qx < Q1D; qx++) { v(c,qx,qy,qz,e) = 0.0; }
+            }
+         }
+         for (int dz = 0; dz < D1D; dz++)
+         {
+            double bxy[MAX_QI_Q1D][MAX_QI_Q1D];
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               for (int qx = 0; qx < Q1D; qx++) { bxy[qy][qx] = 0.0; }
+            }
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               double bx[MAX_QI_Q1D];
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  double s = 0.0;
+                  for (int dx = 0; dx < D1D; dx++)
+                  {
+                     s += B(qx,dx) * x(dx,dy,dz,c,e);
+                  }
+                  bx[qx] = s;
+               }
+               for (int qy = 0; qy < Q1D; qy++)
+               {
+                  const double wy = B(qy,dy);
+                  for (int qx = 0; qx < Q1D; qx++)
+                  {
+                     bxy[qy][qx] += wy * bx[qx];
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; qz++)
+            {
+               const double wz = B(qz,dz);
+               for (int qy = 0; qy < Q1D; qy++)
+               {
+                  for (int qx = 0; qx < Q1D; qx++)
+                  {
+                     v(c,qx,qy,qz,e) += wz * bxy[qy][qx];
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// Sum factorized reference derivatives, 3D
+static void TensorDerivatives3D(const int NE, const int VD, const int D1D,
+                                const int Q1D, const double *_B,
+                                const double *_G, const double *_x,
+                                double *_g)
+{
+   const DeviceMatrix B(_B, Q1D, D1D);
+   const DeviceMatrix G(_G, Q1D, D1D);
+   const DeviceTensor<5> x(_x, D1D, D1D, D1D, VD, NE);
+   DeviceTensor<6> g(_g, VD, 3, Q1D, Q1D, Q1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VD; c++)
+      {
+         for (int qz = 0; qz < Q1D; qz++)
+         {
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  g(c,0,qx,qy,qz,e) = 0.0;
+                  g(c,1,qx,qy,qz,e) = 0.0;
+                  g(c,2,qx,qy,qz,e) = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; dz++)
+         {
+            // B_y B_x x, B_y G_x x and G_y B_x x for the current dz
+            double bxy[MAX_QI_Q1D][MAX_QI_Q1D];
+            double gxy[MAX_QI_Q1D][MAX_QI_Q1D];
+            double bgxy[MAX_QI_Q1D][MAX_QI_Q1D];
+            for (int qy = 0; qy < Q1D; qy++)
+            {
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  bxy[qy][qx] = gxy[qy][qx] = bgxy[qy][qx] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; dy++)
+            {
+               double bx[MAX_QI_Q1D], gx[MAX_QI_Q1D];
+               for (int qx = 0; qx < Q1D; qx++)
+               {
+                  double sb = 0.0, sg = 0.0;
+                  for (int dx = 0; dx < D1D; dx++)
+                  {
+                     const double xd = x(dx,dy,dz,c,e);
+                     sb += B(qx,dx) * xd;
+                     sg += G(qx,dx) * xd;
+                  }
+                  bx[qx] = sb;
+                  gx[qx] = sg;
+               }
+               for (int qy = 0; qy < Q1D; qy++)
+               {
+                  const double by = B(qy,dy), gy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; qx++)
+                  {
+                     bxy[qy][qx] += by * bx[qx];
+                     gxy[qy][qx] += by * gx[qx];
+                     bgxy[qy][qx] += gy * bx[qx];
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; qz++)
+            {
+               const double bz = B(qz,dz), gz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; qy++)
+               {
+                  for (int qx = 0; qx < Q1D; qx++)
+                  {
+                     g(c,0,qx,qy,qz,e) += bz * gxy[qy][qx];
+                     g(c,1,qx,qy,qz,e) += bz * bgxy[qy][qx];
+                     g(c,2,qx,qy,qz,e) += gz * bxy[qy][qx];
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// Physical derivatives: d(c,j,q,e) = sum_i g(c,i,q,e) invJ(i,j), where
+// J(i,j,q,e) = dx_i/dxi_j
+static void PhysDerivativesKernel(const int NE, const int VD, const int DIM,
+                                  const int NQ, const double *_J,
+                                  const double *_g, double *_d)
+{
+   const DeviceTensor<4> J(_J, DIM, DIM, NQ, NE);
+   const DeviceTensor<4> g(_g, VD, DIM, NQ, NE);
+   DeviceTensor<4> d(_d, VD, DIM, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         double invJ[3][3];
+         if (DIM == 1)
+         {
+            invJ[0][0] = 1.0 / J(0,0,q,e);
+         }
+         else if (DIM == 2)
+         {
+            const double J00 = J(0,0,q,e), J01 = J(0,1,q,e);
+            const double J10 = J(1,0,q,e), J11 = J(1,1,q,e);
+            const double id = 1.0 / (J00*J11 - J01*J10);
+            invJ[0][0] =  J11*id; invJ[0][1] = -J01*id;
+            invJ[1][0] = -J10*id; invJ[1][1] =  J00*id;
+         }
+         else
+         {
+            const double J00 = J(0,0,q,e), J01 = J(0,1,q,e), J02 = J(0,2,q,e);
+            const double J10 = J(1,0,q,e), J11 = J(1,1,q,e), J12 = J(1,2,q,e);
+            const double J20 = J(2,0,q,e), J21 = J(2,1,q,e), J22 = J(2,2,q,e);
+            invJ[0][0] = J11*J22 - J12*J21;
+            invJ[0][1] = J02*J21 - J01*J22;
+            invJ[0][2] = J01*J12 - J02*J11;
+            invJ[1][0] = J12*J20 - J10*J22;
+            invJ[1][1] = J00*J22 - J02*J20;
+            invJ[1][2] = J02*J10 - J00*J12;
+            invJ[2][0] = J10*J21 - J11*J20;
+            invJ[2][1] = J01*J20 - J00*J21;
+            invJ[2][2] = J00*J11 - J01*J10;
+            const double id =
+               1.0 / (J00*invJ[0][0] + J01*invJ[1][0] + J02*invJ[2][0]);
+            for (int i = 0; i < 3; i++)
+            {
+               for (int j = 0; j < 3; j++) { invJ[i][j] *= id; }
+            }
+         }
+         for (int c = 0; c < VD; c++)
+         {
+            for (int j = 0; j < DIM; j++)
+            {
+               double s = 0.0;
+               for (int i = 0; i < DIM; i++)
+               {
+                  s += g(c,i,q,e) * invJ[i][j];
+               }
+               d(c,j,q,e) = s;
+            }
+         }
+      }
+   });
+}
+
+static void DeterminantsKernel(const int NE, const int DIM, const int NQ,
+                               const double *_J, double *_det)
+{
+   const DeviceTensor<4> J(_J, DIM, DIM, NQ, NE);
+   DeviceMatrix det(_det, NQ, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; q++)
+      {
+         if (DIM == 1)
+         {
+            det(q,e) = J(0,0,q,e);
+         }
+         else if (DIM == 2)
+         {
+            det(q,e) = J(0,0,q,e)*J(1,1,q,e) - J(0,1,q,e)*J(1,0,q,e);
+         }
+         else
+         {
+            det(q,e) =
+               J(0,0,q,e)*(J(1,1,q,e)*J(2,2,q,e) - J(1,2,q,e)*J(2,1,q,e)) -
+               J(0,1,q,e)*(J(1,0,q,e)*J(2,2,q,e) - J(1,2,q,e)*J(2,0,q,e)) +
+               J(0,2,q,e)*(J(1,0,q,e)*J(2,1,q,e) - J(1,1,q,e)*J(2,0,q,e));
+         }
+      }
+   });
+}
+
+
+QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
+                                               const IntegrationRule &ir)
+   : fespace(&fes), IntRule(&ir)
+{
+   MFEM_VERIFY(Supports(fes), "the FiniteElementSpace is not supported");
+   const FiniteElement &fe = *fes.GetFE(0);
+   dim = fe.GetDim();
+   vdim = fes.GetVDim();
+   sdim = fes.GetMesh()->SpaceDimension();
+   ne = fes.GetNE();
+   nd = fe.GetDof();
+   nq = ir.GetNPoints();
+
+   InitBasis(fe, basis);
+   GetElementIndices(fes, basis.tensor, indices);
+}
+
+bool QuadratureInterpolator::Supports(const FiniteElementSpace &fes)
+{
+   if (!SingleElementSpace(fes)) { return false; }
+   const GridFunction *nodes = fes.GetMesh()->GetNodes();
+   return (!nodes || SingleElementSpace(*nodes->FESpace()));
+}
+
+void QuadratureInterpolator::InitBasis(const FiniteElement &fe,
+                                       Basis &b) const
+{
+   const TensorBasisElement *tfe =
+      dynamic_cast<const TensorBasisElement*>(&fe);
+
+   // Use sum factorization if the rule is the tensor product of the 1D rule
+   // of the same order
+   b.tensor = false;
+   if (tfe && (dim == 2 || dim == 3))
+   {
+      const IntegrationRule &ir1D =
+         IntRules.Get(Geometry::SEGMENT, IntRule->GetOrder());
+      const int q1d = ir1D.GetNPoints();
+      const int d1d = fe.GetOrder() + 1;
+      b.tensor = (d1d <= MAX_QI_D1D && q1d <= MAX_QI_Q1D &&
+                  nq == (dim == 2 ? q1d*q1d : q1d*q1d*q1d));
+      for (int q = 0; b.tensor && q < nq; q++)
+      {
+         const IntegrationPoint &ip = IntRule->IntPoint(q);
+         b.tensor = (ip.x == ir1D.IntPoint(q % q1d).x &&
+                     ip.y == ir1D.IntPoint((q / q1d) % q1d).x &&
+                     (dim == 2 || ip.z == ir1D.IntPoint(q / (q1d*q1d)).x));
+      }
+      if (b.tensor)
+      {
+         b.nd = d1d;
+         b.nq = q1d;
+         b.B.SetSize(q1d*d1d);
+         b.G.SetSize(q1d*d1d);
+         const Poly_1D::Basis &basis1d = tfe->GetBasis1D();
+         Vector shape(d1d), dshape(d1d);
+         for (int q = 0; q < q1d; q++)
+         {
+            basis1d.Eval(ir1D.IntPoint(q).x, shape, dshape);
+            for (int d = 0; d < d1d; d++)
+            {
+               b.B(q + q1d*d) = shape(d);
+               b.G(q + q1d*d) = dshape(d);
+            }
+         }
+         return;
+      }
+   }
+
+   const int fe_nd = fe.GetDof();
+   b.nd = fe_nd;
+   b.nq = nq;
+   b.B.SetSize(nq*fe_nd);
+   b.G.SetSize(nq*dim*fe_nd);
+   Vector shape(fe_nd);
+   DenseMatrix dshape(fe_nd, dim);
+   for (int q = 0; q < nq; q++)
+   {
+      const IntegrationPoint &ip = IntRule->IntPoint(q);
+      fe.CalcShape(ip, shape);
+      fe.CalcDShape(ip, dshape);
+      for (int d = 0; d < fe_nd; d++)
+      {
+         b.B(q + nq*d) = shape(d);
+         for (int k = 0; k < dim; k++)
+         {
+            b.G(q + nq*(k + dim*d)) = dshape(d,k);
+         }
+      }
+   }
+}
+
+void QuadratureInterpolator::Interpolate(const Basis &b, const int vd,
+                                         const Vector &e_vec, Vector *q_val,
+                                         Vector *q_der) const
+{
+   if (q_val)
+   {
+      q_val->SetSize(vd*nq*ne);
+      if (!b.tensor)
+      {
+         InterpValues(ne, vd, b.nd, nq, b.B, e_vec, *q_val);
+      }
+      else if (dim == 2)
+      {
+         TensorValues2D(ne, vd, b.nd, b.nq, b.B, e_vec, *q_val);
+      }
+      else
+      {
+         TensorValues3D(ne, vd, b.nd, b.nq, b.B, e_vec, *q_val);
+      }
+   }
+   if (q_der)
+   {
+      q_der->SetSize(vd*dim*nq*ne);
+      if (!b.tensor)
+      {
+         InterpDerivatives(ne, vd, dim, b.nd, nq, b.G, e_vec, *q_der);
+      }
+      else if (dim == 2)
+      {
+         TensorDerivatives2D(ne, vd, b.nd, b.nq, b.B, b.G, e_vec, *q_der);
+      }
+      else
+      {
+         TensorDerivatives3D(ne, vd, b.nd, b.nq, b.B, b.G, e_vec, *q_der);
+      }
+   }
+}
+
+const Vector &QuadratureInterpolator::GetJacobians() const
+{
+   if (geom_J.Size() > 0) { return geom_J; }
+
+   MFEM_VERIFY(dim == sdim, "the mesh dimension must be equal to the space "
+               "dimension");
+   Mesh *mesh = fespace->GetMesh();
+   const GridFunction *nodes = mesh->GetNodes();
+   Basis geom_basis;
+   Vector geom_nodes;
+   if (nodes)
+   {
+      const FiniteElementSpace &nfes = *nodes->FESpace();
+      Array<int> geom_indices;
+      InitBasis(*nfes.GetFE(0), geom_basis);
+      GetElementIndices(nfes, geom_basis.tensor, geom_indices);
+      GatherElementDofs(geom_indices, *nodes, geom_nodes);
+   }
+   else
+   {
+      const FiniteElement &gfe =
+         *Mesh::GetTransformationFEforElementType(mesh->GetElementType(0));
+      InitBasis(gfe, geom_basis);
+      const int gnd = gfe.GetDof();
+      const int *dof_map = LexicographicMap(gfe, geom_basis.tensor);
+      Array<int> v;
+      geom_nodes.SetSize(gnd*sdim*ne);
+      for (int e = 0; e < ne; e++)
+      {
+         mesh->GetElementVertices(e, v);
+         for (int c = 0; c < sdim; c++)
+         {
+            for (int d = 0; d < gnd; d++)
+            {
+               const int ld = dof_map ? dof_map[d] : d;
+               geom_nodes(d + gnd*(c + sdim*e)) = mesh->GetVertex(v[ld])[c];
+            }
+         }
+      }
+   }
+   Interpolate(geom_basis, sdim, geom_nodes, NULL, &geom_J);
+   return geom_J;
+}
+
+void QuadratureInterpolator::ElementDofs(const Vector &l_vec,
+                                         Vector &e_vec) const
+{
+   GatherElementDofs(indices, l_vec, e_vec);
+}
+
+void QuadratureInterpolator::Mult(const Vector &e_vec, unsigned eval_flags,
+                                  Vector &q_val, Vector &q_der,
+                                  Vector &q_det) const
+{
+   MFEM_VERIFY(e_vec.Size() == indices.Size(), "invalid E-vector size");
+   if (eval_flags & VALUES)
+   {
+      Interpolate(basis, vdim, e_vec, &q_val, NULL);
+   }
+   if (eval_flags & PHYSICAL_DERIVATIVES)
+   {
+      Vector ref_der;
+      Interpolate(basis, vdim, e_vec, NULL, &ref_der);
+      q_der.SetSize(ref_der.Size());
+      PhysDerivativesKernel(ne, vdim, dim, nq, GetJacobians(), ref_der, q_der);
+   }
+   else if (eval_flags & DERIVATIVES)
+   {
+      Interpolate(basis, vdim, e_vec, NULL, &q_der);
+   }
+   if (eval_flags & DETERMINANTS)
+   {
+      Determinants(q_det);
+   }
+}
+
+void QuadratureInterpolator::Values(const Vector &l_vec, Vector &q_val) const
+{
+   Vector e_vec, empty;
+   ElementDofs(l_vec, e_vec);
+   Mult(e_vec, VALUES, q_val, empty, empty);
+}
+
+void QuadratureInterpolator::PhysDerivatives(const Vector &l_vec,
+                                             Vector &q_der) const
+{
+   Vector e_vec, empty;
+   ElementDofs(l_vec, e_vec);
+   Mult(e_vec, PHYSICAL_DERIVATIVES, empty, q_der, empty);
+}
+
+void QuadratureInterpolator::Determinants(Vector &q_det) const
+{
+   q_det.SetSize(nq*ne);
+   DeterminantsKernel(ne, dim, nq, GetJacobians(), q_det);
+}
+
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_QUADINTERPOLATOR
+#define MFEM_QUADINTERPOLATOR
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+/** @brief Evaluation of the functions of a FiniteElementSpace, and of their
+    derivatives, at the points of an IntegrationRule in all mesh elements. */
+/** All elements of the space must use the same FiniteElement (see
+    Supports()). When the element is a TensorBasisElement and the rule is the
+    tensor product of a 1D rule (e.g. the rules returned by IntRules for
+    quadrilaterals and hexahedra), the evaluation uses sum factorization with
+    the 1D basis matrices B and G, with a cost of O(p^{d+1}) per element
+    instead of O(p^{2d}). Otherwise, the shape functions and their reference
+    gradients are tabulated once at all points of the rule.
+
+    The element loops are MFEM_FORALL kernels, i.e. they run with the
+    configured Device backend (e.g. on the host with OpenMP, or on the GPU).
+
+    The results use the following layouts, with NQ = number of points in the
+    rule and NE = number of elements:
+    - E-vector: (ND, VDIM, NE), ND = number of element dofs. Tensor product
+      elements use the lexicographic ordering of their dofs.
+    - values: (VDIM, NQ, NE),
+    - derivatives: (VDIM, DIM, NQ, NE), either with respect to the reference
+      coordinates or to the physical coordinates,
+    - determinants: (NQ, NE), the determinants of the Jacobians of the element
+      transformations. */
+class QuadratureInterpolator
+{
+public:
+   enum EvalFlags
+   {
+      VALUES       = 1 << 0, ///< Evaluate the values at the points
+      DERIVATIVES  = 1 << 1, ///< Evaluate the reference derivatives
+      PHYSICAL_DERIVATIVES = 1 << 2, ///< Evaluate the physical derivatives
+      DETERMINANTS = 1 << 3  ///< Evaluate the Jacobian determinants
+   };
+
+protected:
+   /// Tabulated basis of one FiniteElement at the points of #IntRule.
+   struct Basis
+   {
+      bool tensor;  ///< Use the 1D matrices and sum factorization
+      int nd, nq;   ///< Number of dofs and points (in 1D, if #tensor)
+      Vector B, G;  ///< B(nq,nd), G(nq,dim,nd) or, if #tensor, G(nq,nd)
+   };
+
+   const FiniteElementSpace *fespace; ///< Not owned
+   const IntegrationRule *IntRule;    ///< Not owned
+   int dim, vdim, sdim, ne, nd, nq;
+
+   Basis basis;
+   /// E-vector gather map; negative entries, -1-i, flip the sign of dof i.
+   Array<int> indices;
+
+   /// Jacobians (SDIM, DIM, NQ, NE) of the mesh, computed on first use.
+   mutable Vector geom_J;
+
+   void InitBasis(const FiniteElement &fe, Basis &b) const;
+   void Interpolate(const Basis &b, const int vd, const Vector &e_vec,
+                    Vector *q_val, Vector *q_der) const;
+   const Vector &GetJacobians() const;
+
+public:
+   /// The space @a fes must satisfy Supports().
+   QuadratureInterpolator(const FiniteElementSpace &fes,
+                          const IntegrationRule &ir);
+
+   /** @brief Return true if all elements of @a fes use the same FiniteElement
+       and it has map type VALUE. NURBS spaces are not supported. */
+   static bool Supports(const FiniteElementSpace &fes);
+
+   /// Return true if sum factorization is used.
+   bool UsesTensorProducts() const { return basis.tensor; }
+
+   const FiniteElementSpace *GetFESpace() const { return fespace; }
+   const IntegrationRule &GetIntRule() const { return *IntRule; }
+
+   /** @brief Gather the element dofs of the L-vector @a l_vec (e.g. a
+       GridFunction) into the E-vector @a e_vec. */
+   void ElementDofs(const Vector &l_vec, Vector &e_vec) const;
+
+   /** @brief Evaluate the E-vector @a e_vec, or the Jacobian determinants, at
+       all quadrature points, as specified by the EvalFlags in @a eval_flags.
+       Outputs that are not requested are not resized. */
+   /** PHYSICAL_DERIVATIVES and DETERMINANTS require the mesh dimension to be
+       equal to the space dimension. If both DERIVATIVES and
+       PHYSICAL_DERIVATIVES are given, @a q_der holds the physical
+       derivatives. */
+   void Mult(const Vector &e_vec, unsigned eval_flags,
+             Vector &q_val, Vector &q_der, Vector &q_det) const;
+
+   /// Evaluate the L-vector @a l_vec at all quadrature points.
+   void Values(const Vector &l_vec, Vector &q_val) const;
+
+   /// Evaluate the physical gradients of the L-vector @a l_vec.
+   void PhysDerivatives(const Vector &l_vec, Vector &q_der) const;
+
+   /// Evaluate the Jacobian determinants at all quadrature points.
+   void Determinants(Vector &q_det) const;
+};
+
+}
+
+#endif
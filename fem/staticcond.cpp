@@ -135,14 +135,27 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
 {
    const int NE = fes->GetNE();
    // symm = symmetric; // TODO: handle the symmetric case
+   Array<int> rvdofs;
+   elem_rvdof.MakeI(NE);
+   for (int i = 0; i < NE; i++)
+   {
+      tr_fes->GetElementVDofs(i, rvdofs);
+      elem_rvdof.AddColumnsInRow(i, rvdofs.Size());
+   }
+   elem_rvdof.MakeJ();
+   for (int i = 0; i < NE; i++)
+   {
+      tr_fes->GetElementVDofs(i, rvdofs);
+      elem_rvdof.AddConnections(i, rvdofs.GetData(), rvdofs.Size());
+   }
+   elem_rvdof.ShiftUpI();
+
    A_offsets.SetSize(NE+1);
    A_ipiv_offsets.SetSize(NE+1);
    A_offsets[0] = A_ipiv_offsets[0] = 0;
-   Array<int> rvdofs;
    for (int i = 0; i < NE; i++)
    {
-      tr_fes->GetElementVDofs(i, rvdofs);
-      const int ned = rvdofs.Size();
+      const int ned = elem_rvdof.RowSize(i);
       const int npd = elem_pdof.RowSize(i);
       A_offsets[i+1] = A_offsets[i] + npd*(npd + (symm ? 1 : 2)*ned);
       A_ipiv_offsets[i+1] = A_ipiv_offsets[i] + npd;
@@ -155,21 +168,12 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
       // The sparsity pattern of S is given by the map rdof->elem->rdof
       Table rdof_rdof;
       {
-         Table elem_rdof, rdof_elem;
-         elem_rdof.MakeI(NE);
-         for (int i = 0; i < NE; i++)
+         Table elem_rdof(elem_rvdof), rdof_elem;
+         int *J = elem_rdof.GetJ();
+         for (int k = 0; k < elem_rdof.Size_of_connections(); k++)
          {
-            tr_fes->GetElementVDofs(i, rvdofs);
-            elem_rdof.AddColumnsInRow(i, rvdofs.Size());
+            if (J[k] < 0) { J[k] = -1-J[k]; }
          }
-         elem_rdof.MakeJ();
-         for (int i = 0; i < NE; i++)
-         {
-            tr_fes->GetElementVDofs(i, rvdofs);
-            FiniteElementSpace::AdjustVDofs(rvdofs);
-            elem_rdof.AddConnections(i, rvdofs.GetData(), rvdofs.Size());
-         }
-         elem_rdof.ShiftUpI();
          Transpose(elem_rdof, rdof_elem, nedofs);
          mfem::Mult(rdof_elem, elem_rdof, rdof_rdof);
       }
@@ -186,19 +190,17 @@ void StaticCondensation::Init(bool symmetric, bool block_diagonal)
    }
 }
 
-void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
+void StaticCondensation::CopyElementBlocks(int el, const DenseMatrix &elmat,
+                                           DenseMatrix &A_ep, double *A_ee_data)
 {
-   Array<int> rvdofs;
-   tr_fes->GetElementVDofs(el, rvdofs);
    const int vdim = fes->GetVDim();
    const int nvpd = elem_pdof.RowSize(el);
-   const int nved = rvdofs.Size();
+   const int nved = elem_rvdof.RowSize(el);
    DenseMatrix A_pp(A_data + A_offsets[el], nvpd, nvpd);
    DenseMatrix A_pe(A_pp.Data() + nvpd*nvpd, nvpd, nved);
-   DenseMatrix A_ep;
    if (symm) { A_ep.SetSize(nved, nvpd); }
    else      { A_ep.UseExternalData(A_pe.Data() + nvpd*nved, nved, nvpd); }
-   DenseMatrix A_ee(nved, nved);
+   DenseMatrix A_ee(A_ee_data, nved, nved);
 
    const int npd = nvpd/vdim;
    const int ned = nved/vdim;
@@ -214,16 +216,112 @@ void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
          A_ee.CopyMN(elmat, ned, ned, i*nd,     j*nd,     i*ned, j*ned);
       }
    }
+}
+
+void StaticCondensation::EliminateElement(int el, const DenseMatrix &elmat,
+                                          double *A_ee_data, bool factored)
+{
+   const int nvpd = elem_pdof.RowSize(el);
+   const int nved = elem_rvdof.RowSize(el);
+   double *A_pp_data = A_data + A_offsets[el];
+   DenseMatrix A_ep;
+   if (!factored) { CopyElementBlocks(el, elmat, A_ep, A_ee_data); }
+   else { A_ep.UseExternalData(A_pp_data + nvpd*(nvpd+nved), nved, nvpd); }
+
    // Compute the Schur complement
-   LUFactors lu(A_pp.Data(), A_ipiv + A_ipiv_offsets[el]);
-   lu.Factor(nvpd);
-   lu.BlockFactor(nvpd, nved, A_pe.Data(), A_ep.Data(), A_ee.Data());
+   LUFactors lu(A_pp_data, A_ipiv + A_ipiv_offsets[el]);
+   if (!factored) { lu.Factor(nvpd); }
+   lu.BlockFactor(nvpd, nved, A_pp_data + nvpd*nvpd, A_ep.Data(), A_ee_data);
+}
+
+void StaticCondensation::AssembleMatrix(int el, const DenseMatrix &elmat)
+{
+   Array<int> rvdofs;
+   elem_rvdof.GetRow(el, rvdofs);
+   DenseMatrix A_ee(rvdofs.Size());
+   EliminateElement(el, elmat, A_ee.Data());
 
    // Assemble the Schur complement
    const int skip_zeros = 0;
    S->AddSubMatrix(rvdofs, rvdofs, A_ee, skip_zeros);
 }
 
+void StaticCondensation::AssembleMatrices(const DenseTensor &elmats)
+{
+   const int NE = fes->GetNE();
+   const int elmat_size = elmats.SizeI()*elmats.SizeJ();
+   MFEM_VERIFY(elmats.SizeK() == NE, "invalid number of element matrices");
+
+   // Offsets of the element Schur complements
+   Array<int> S_offsets(NE+1);
+   S_offsets[0] = 0;
+   for (int i = 0; i < NE; i++)
+   {
+      const int nved = elem_rvdof.RowSize(i);
+      S_offsets[i+1] = S_offsets[i] + nved*nved;
+   }
+   Vector S_data(S_offsets[NE]);
+
+   // The blocks A_ep are stored only in the non-symmetric case, where the
+   // blocks A_pp of all elements are copied and then factored together with
+   // BatchLUFactor()
+   bool factored = false;
+   if (!symm)
+   {
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < NE; i++)
+      {
+         const DenseMatrix elmat(const_cast<double*>(elmats.Data()) +
+                                 i*elmat_size, elmats.SizeI(), elmats.SizeJ());
+         DenseMatrix A_ep;
+         CopyElementBlocks(i, elmat, A_ep, S_data.GetData() + S_offsets[i]);
+      }
+
+      Array<int> pp_size(NE);
+      Array<double*> pp_data(NE);
+      Array<int*> pp_ipiv(NE);
+      for (int i = 0; i < NE; i++)
+      {
+         pp_size[i] = elem_pdof.RowSize(i);
+         pp_data[i] = A_data + A_offsets[i];
+         pp_ipiv[i] = A_ipiv + A_ipiv_offsets[i];
+      }
+      BatchLUFactor(pp_size, pp_data, pp_ipiv);
+      factored = true;
+   }
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NE; i++)
+   {
+      const DenseMatrix elmat(const_cast<double*>(elmats.Data()) +
+                              i*elmat_size, elmats.SizeI(), elmats.SizeJ());
+      EliminateElement(i, elmat, S_data.GetData() + S_offsets[i], factored);
+   }
+
+   // Assemble the Schur complement
+   if (S->Finalized())
+   {
+      S->AddSubMatrices(elem_rvdof, S_data.GetData(), S_offsets.GetData());
+   }
+   else
+   {
+      const int skip_zeros = 0;
+      Array<int> rvdofs;
+      DenseMatrix A_ee;
+      for (int i = 0; i < NE; i++)
+      {
+         elem_rvdof.GetRow(i, rvdofs);
+         A_ee.UseExternalData(S_data.GetData() + S_offsets[i],
+                              rvdofs.Size(), rvdofs.Size());
+         S->AddSubMatrix(rvdofs, rvdofs, A_ee, skip_zeros);
+      }
+   }
+}
+
 void StaticCondensation::AssembleBdrMatrix(int el, const DenseMatrix &elmat)
 {
    Array<int> rvdofs;
@@ -332,18 +430,20 @@ void StaticCondensation::ReduceRHS(const Vector &b, Vector &sc_b) const
       b_r(i) = b(rdof_edof[i]);
    }
 
-   DenseMatrix U_pe, L_ep;
-   Vector b_p, b_ep;
-   Array<int> rvdofs;
+   // Compute the element contributions b_ep = A_ep A_pp_inv b_p in parallel,
+   // then add them to b_r in the element order.
+   const int *rv_I = elem_rvdof.GetI(), *rv_J = elem_rvdof.GetJ();
+   Vector b_ep_all(rv_I[NE]);
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < NE; i++)
    {
-      tr_fes->GetElementVDofs(i, rvdofs);
-      const int ned = rvdofs.Size();
-      const int *rd = rvdofs.GetData();
+      DenseMatrix U_pe, L_ep;
+      const int ned = elem_rvdof.RowSize(i);
       const int npd = elem_pdof.RowSize(i);
       const int *pd = elem_pdof.GetRow(i);
-      b_p.SetSize(npd);
-      b_ep.SetSize(ned);
+      Vector b_p(npd), b_ep(b_ep_all.GetData() + rv_I[i], ned);
       for (int j = 0; j < npd; j++)
       {
          b_p(j) = b(pd[j]);
@@ -363,11 +463,11 @@ void StaticCondensation::ReduceRHS(const Vector &b, Vector &sc_b) const
          L_ep.UseExternalData(lu.data + npd*(npd+ned), ned, npd);
          L_ep.Mult(b_p, b_ep);
       }
-      for (int j = 0; j < ned; j++)
-      {
-         if (rd[j] >= 0) { b_r(rd[j]) -= b_ep(j); }
-         else            { b_r(-1-rd[j]) += b_ep(j); }
-      }
+   }
+   for (int k = 0; k < rv_I[NE]; k++)
+   {
+      if (rv_J[k] >= 0) { b_r(rv_J[k]) -= b_ep_all(k); }
+      else              { b_r(-1-rv_J[k]) += b_ep_all(k); }
    }
    if (!Parallel())
    {
@@ -510,15 +610,19 @@ void StaticCondensation::ComputeSolution(
       sol(rdof_edof[i]) = sol_r(i);
    }
    const int NE = fes->GetNE();
-   Vector b_p, s_e;
-   Array<int> rvdofs;
+   // Every element writes only its own private dofs
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < NE; i++)
    {
-      tr_fes->GetElementVDofs(i, rvdofs);
+      Array<int> rvdofs;
+      Vector s_e;
+      elem_rvdof.GetRow(i, rvdofs);
       const int ned = rvdofs.Size();
       const int npd = elem_pdof.RowSize(i);
       const int *pd = elem_pdof.GetRow(i);
-      b_p.SetSize(npd);
+      Vector b_p(npd);
 
       for (int j = 0; j < npd; j++)
       {
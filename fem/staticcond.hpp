@@ -69,6 +69,7 @@ class StaticCondensation
    Table elem_pdof;           // Element to private dof
    int npdofs;                // Number of private dofs
    Array<int> rdof_edof;      // Map from reduced dofs to exposed dofs
+   Table elem_rvdof;          // Element to reduced vdof (signed), see Init()
 
    // Schur complement: S = A_ee - A_ep (A_pp)^{-1} A_pe.
    SparseMatrix *S, *S_e;
@@ -87,6 +88,19 @@ class StaticCondensation
 
    Array<int> ess_rtdof_list;
 
+   /** Copy the blocks A_pp, A_pe, A_ep and A_ee of the element matrix @a
+       elmat of element @a el; A_ep is a view of the saved block, or a
+       temporary matrix in the symmetric case. */
+   void CopyElementBlocks(int el, const DenseMatrix &elmat, DenseMatrix &A_ep,
+                          double *A_ee_data);
+
+   /** Save the factored A_pp and the blocks A_pe, A_ep of element @a el, and
+       compute its Schur complement, @a A_ee_data, of size nved x nved. If @a
+       factored is true, the blocks are already saved by CopyElementBlocks(),
+       with A_pp factored, and @a A_ee_data contains the block A_ee. */
+   void EliminateElement(int el, const DenseMatrix &elmat, double *A_ee_data,
+                         bool factored = false);
+
 public:
    /// Construct a StaticCondensation object.
    StaticCondensation(FiniteElementSpace *fespace);
@@ -115,8 +129,21 @@ public:
    /** Assemble the contribution to the Schur complement from the given
        element matrix 'elmat'; save the other blocks internally: A_pp_inv, A_pe,
        and A_ep. */
+   /** The interior block of the element is factored on its own; when the
+       element matrices of all elements are available, AssembleMatrices()
+       factors them together. */
    void AssembleMatrix(int el, const DenseMatrix &elmat);
 
+   /** @brief Equivalent to calling AssembleMatrix() for all elements with the
+       element matrices @a elmats, e.g. from
+       BilinearForm::ComputeElementMatrices(). */
+   /** The interior blocks of all elements are factored together with
+       BatchLUFactor(). With MFEM_USE_LEGACY_OPENMP, the elements are
+       eliminated in parallel and, when the Schur complement has a precomputed
+       sparsity pattern (the case vdim = 1), the element contributions are
+       also added in parallel, see SparseMatrix::AddSubMatrices(). */
+   void AssembleMatrices(const DenseTensor &elmats);
+
    /** Assemble the contribution to the Schur complement from the given boundary
        element matrix 'elmat'. */
    void AssembleBdrMatrix(int el, const DenseMatrix &elmat);
@@ -21,6 +21,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 
 namespace mfem
 {
@@ -403,6 +404,55 @@ public:
 };
 
 
+/** @brief Read-only copy of an Array of pointers that can be read without
+    locks while a newer copy is being published. */
+/** This is used by lazily populated registries (e.g. IntegrationRules): the
+    owner modifies its Array under a lock and then calls Publish(); readers use
+    Get() without locking. The copies replaced by Publish() are kept until the
+    destruction of the ArraySnapshot, so readers never access freed memory. */
+template <class T>
+class ArraySnapshot
+{
+private:
+   std::atomic<const Array<T*> *> current;
+   Array<const Array<T*> *> retired;
+
+   ArraySnapshot(const ArraySnapshot &);
+   ArraySnapshot &operator=(const ArraySnapshot &);
+
+public:
+   ArraySnapshot() : current(NULL) { }
+
+   /** @brief Return entry @a i of the last published copy, or NULL if @a i is
+       out of range. */
+   inline T *Get(int i) const
+   {
+      const Array<T*> *a = current.load(std::memory_order_acquire);
+      return (a && 0 <= i && i < a->Size()) ? (*a)[i] : NULL;
+   }
+
+   /// Return the last published copy, or NULL if nothing was published.
+   inline const Array<T*> *GetArray() const
+   { return current.load(std::memory_order_acquire); }
+
+   /// Publish a copy of @a a. Calls must be serialized by the caller.
+   void Publish(const Array<T*> &a)
+   {
+      Array<T*> *copy = new Array<T*>;
+      a.Copy(*copy);
+      const Array<T*> *old =
+         current.exchange(copy, std::memory_order_acq_rel);
+      if (old) { retired.Append(old); }
+   }
+
+   ~ArraySnapshot()
+   {
+      delete current.load();
+      for (int i = 0; i < retired.Size(); i++) { delete retired[i]; }
+   }
+};
+
+
 /** A container for items of type T. Dynamically grows as items are added.
  *  Each item is accessible by its index. Items are allocated in larger chunks
  *  (blocks), so the 'Append' method is very fast on average.
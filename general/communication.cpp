@@ -25,6 +25,7 @@
 #include "text.hpp"
 #include "sort_pairs.hpp"
 #include "globals.hpp"
+#include "device.hpp"
 
 #include <iostream>
 #include <map>
@@ -34,6 +35,18 @@ using namespace std;
 namespace mfem
 {
 
+void MPI_Session::Init(int *argc, char ***argv)
+{
+#ifdef MFEM_USE_OPENMP
+   // Only the master thread makes MPI calls, outside of the parallel regions
+   MPI_Init_thread(argc, argv, MPI_THREAD_FUNNELED, &thread_support);
+#else
+   MPI_Init(argc, argv);
+   thread_support = MPI_THREAD_SINGLE;
+#endif
+   GetRankAndSize();
+}
+
 void MPI_Session::GetRankAndSize()
 {
    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
@@ -348,6 +361,9 @@ GroupCommunicator::GroupCommunicator(GroupTopology &gt, Mode m)
    num_requests = 0;
    request_marker = NULL;
    buf_offsets = NULL;
+   bcast_preqs = reduce_preqs = NULL;
+   num_nbr_requests = 0;
+   nbr_comm = MPI_COMM_NULL;
 }
 
 void GroupCommunicator::Create(const Array<int> &ldof_group)
@@ -402,6 +418,9 @@ void GroupCommunicator::Finalize()
       }
    }
 
+   // At least one request is used by the neighborhood collective, which is
+   // called also by the processors without shared groups
+   request_counter = max(request_counter, 1);
    requests = new MPI_Request[request_counter];
    // statuses = new MPI_Status[request_counter];
    request_marker = new int[request_counter];
@@ -483,6 +502,115 @@ void GroupCommunicator::Finalize()
          }
       }
    }
+
+   FinalizeNeighbors();
+
+   // Allocate the buffer for the largest type, so that it does not move
+   group_buf.SetSize(group_buf_size*sizeof(double));
+}
+
+// Append the rows of the Table src listed in rows[0..n) to row r of dst.
+static void AddRowsInRow(Table &dst, int r, const Table &src, const int *rows,
+                         int n, bool count)
+{
+   for (int i = 0; i < n; i++)
+   {
+      if (count) { dst.AddColumnsInRow(r, src.RowSize(rows[i])); }
+      else { dst.AddConnections(r, src.GetRow(rows[i]), src.RowSize(rows[i])); }
+   }
+}
+
+void GroupCommunicator::FinalizeNeighbors()
+{
+   const int num_nbrs = gtopo.GetNumNeighbors();
+   nbr_send_ldofs.MakeI(num_nbrs);
+   nbr_recv_ldofs.MakeI(num_nbrs);
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int nbr = 1; nbr < num_nbrs; nbr++)
+      {
+         AddRowsInRow(nbr_send_ldofs, nbr, group_ldof,
+                      nbr_send_groups.GetRow(nbr),
+                      nbr_send_groups.RowSize(nbr), pass == 0);
+         AddRowsInRow(nbr_recv_ldofs, nbr, group_ldof,
+                      nbr_recv_groups.GetRow(nbr),
+                      nbr_recv_groups.RowSize(nbr), pass == 0);
+      }
+      if (pass == 0)
+      {
+         nbr_send_ldofs.MakeJ();
+         nbr_recv_ldofs.MakeJ();
+      }
+   }
+   nbr_send_ldofs.ShiftUpI();
+   nbr_recv_ldofs.ShiftUpI();
+
+   num_nbr_requests = 0;
+   nbr_send_counts.SetSize(num_nbrs-1);
+   nbr_recv_counts.SetSize(num_nbrs-1);
+   nbr_send_displs.SetSize(num_nbrs);
+   nbr_recv_displs.SetSize(num_nbrs);
+   nbr_send_displs[0] = nbr_recv_displs[0] = 0;
+   for (int nbr = 1; nbr < num_nbrs; nbr++)
+   {
+      nbr_send_counts[nbr-1] = nbr_send_ldofs.RowSize(nbr);
+      nbr_recv_counts[nbr-1] = nbr_recv_ldofs.RowSize(nbr);
+      nbr_send_displs[nbr] = nbr_send_displs[nbr-1] + nbr_send_counts[nbr-1];
+      nbr_recv_displs[nbr] = nbr_recv_displs[nbr-1] + nbr_recv_counts[nbr-1];
+      num_nbr_requests += (nbr_send_counts[nbr-1] > 0);
+      num_nbr_requests += (nbr_recv_counts[nbr-1] > 0);
+   }
+
+   if (mode == byNeighborCollective)
+   {
+#if MPI_VERSION >= 3
+      // Collective over the communicator of gtopo
+      Array<int> nbr_ranks(num_nbrs-1);
+      for (int nbr = 1; nbr < num_nbrs; nbr++)
+      {
+         nbr_ranks[nbr-1] = gtopo.GetNeighborRank(nbr);
+      }
+      MPI_Dist_graph_create_adjacent(gtopo.GetComm(),
+                                     num_nbrs-1, nbr_ranks, MPI_UNWEIGHTED,
+                                     num_nbrs-1, nbr_ranks, MPI_UNWEIGHTED,
+                                     MPI_INFO_NULL, 0, &nbr_comm);
+#else
+      MFEM_ABORT("mode byNeighborCollective requires MPI-3");
+#endif
+   }
+}
+
+MPI_Request *GroupCommunicator::GetPersistentRequests(int op) const
+{
+   MPI_Request *&preqs = (op == 0) ? bcast_preqs : reduce_preqs;
+   if (preqs) { return preqs; }
+
+   // In Reduce operation: send_groups <--> recv_groups
+   const Table &send_ldofs = (op == 0) ? nbr_send_ldofs : nbr_recv_ldofs;
+   const Table &recv_ldofs = (op == 0) ? nbr_recv_ldofs : nbr_send_ldofs;
+   const int tag = (op == 0) ? 40822 : 43822;
+   preqs = new MPI_Request[num_nbr_requests];
+   // Same buffer layout as in BcastBegin() and ReduceBegin()
+   double *buf = (double *)group_buf.GetData();
+   int request_counter = 0;
+   for (int nbr = 1; nbr < send_ldofs.Size(); nbr++)
+   {
+      const int send_size = send_ldofs.RowSize(nbr);
+      if (send_size > 0)
+      {
+         MPI_Send_init(buf, send_size, MPI_DOUBLE, gtopo.GetNeighborRank(nbr),
+                       tag, gtopo.GetComm(), &preqs[request_counter++]);
+         buf += send_size;
+      }
+      const int recv_size = recv_ldofs.RowSize(nbr);
+      if (recv_size > 0)
+      {
+         MPI_Recv_init(buf, recv_size, MPI_DOUBLE, gtopo.GetNeighborRank(nbr),
+                       tag, gtopo.GetComm(), &preqs[request_counter++]);
+         buf += recv_size;
+      }
+   }
+   return preqs;
 }
 
 void GroupCommunicator::SetLTDofTable(const Array<int> &ldof_ltdof)
@@ -511,6 +639,19 @@ void GroupCommunicator::SetLTDofTable(const Array<int> &ldof_ltdof)
       }
    }
    group_ltdof.ShiftUpI();
+
+   nbr_send_ltdofs.MakeI(nbr_send_groups.Size());
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+      {
+         AddRowsInRow(nbr_send_ltdofs, nbr, group_ltdof,
+                      nbr_send_groups.GetRow(nbr),
+                      nbr_send_groups.RowSize(nbr), pass == 0);
+      }
+      if (pass == 0) { nbr_send_ltdofs.MakeJ(); }
+   }
+   nbr_send_ltdofs.ShiftUpI();
 }
 
 template <class T>
@@ -621,12 +762,105 @@ const T *GroupCommunicator::ReduceGroupFromBuffer(const T *buf, T *ldata,
    return buf + opd.nldofs;
 }
 
+// Messages with at least this many entries are packed and unpacked with
+// threads when an OpenMP backend is allowed by the Device.
+static const int omp_pack_min_size = 4096;
+
+// buf[j] = ldata[ldofs[j]], j = 0..n-1.
+template <class T>
+static void GatherData(T *buf, const T *ldata, const int *ldofs, int n)
+{
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for \
+   if (n >= omp_pack_min_size && Device::Allows(Backend::OMP_MASK))
+#endif
+   for (int j = 0; j < n; j++)
+   {
+      buf[j] = ldata[ldofs[j]];
+   }
+}
+
+// ldata[ldofs[j]] = buf[j], j = 0..n-1; ldofs must have no repeated entries.
+template <class T>
+static void ScatterData(const T *buf, T *ldata, const int *ldofs, int n)
+{
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for \
+   if (n >= omp_pack_min_size && Device::Allows(Backend::OMP_MASK))
+#endif
+   for (int j = 0; j < n; j++)
+   {
+      ldata[ldofs[j]] = buf[j];
+   }
+}
+
+template <class T>
+T *GroupCommunicator::CopyNbrToBuffer(const T *ldata, T *buf, int nbr,
+                                      int layout) const
+{
+   if (layout == 1)
+   {
+      const int *grp_list = nbr_send_groups.GetRow(nbr);
+      for (int i = 0; i < nbr_send_groups.RowSize(nbr); i++)
+      {
+         buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+      }
+      return buf;
+   }
+   MFEM_VERIFY(layout != 2 || nbr_send_ltdofs.Size() == nbr_send_groups.Size(),
+               "'group_ltdof' is not set, use SetLTDofTable()");
+   const Table &nbr_ldofs = (layout == 2) ? nbr_send_ltdofs : nbr_send_ldofs;
+   const int n = nbr_ldofs.RowSize(nbr);
+   GatherData(buf, ldata, nbr_ldofs.GetRow(nbr), n);
+   return buf + n;
+}
+
+template <class T>
+const T *GroupCommunicator::CopyNbrFromBuffer(const T *buf, T *ldata, int nbr,
+                                              int layout) const
+{
+   if (layout != 0)
+   {
+      const int *grp_list = nbr_recv_groups.GetRow(nbr);
+      for (int i = 0; i < nbr_recv_groups.RowSize(nbr); i++)
+      {
+         buf = CopyGroupFromBuffer(buf, ldata, grp_list[i], layout);
+      }
+      return buf;
+   }
+   const int n = nbr_recv_ldofs.RowSize(nbr);
+   ScatterData(buf, ldata, nbr_recv_ldofs.GetRow(nbr), n);
+   return buf + n;
+}
+
+template <class T>
+const T *GroupCommunicator::ReduceNbrFromBuffer(const T *buf, T *ldata,
+                                                int nbr, int layout,
+                                                void (*Op)(OpData<T>)) const
+{
+   MFEM_VERIFY(layout != 1, "layout 1 is not supported");
+   MFEM_VERIFY(layout != 2 || nbr_send_ltdofs.Size() == nbr_send_groups.Size(),
+               "'group_ltdof' is not set, use SetLTDofTable()");
+   // A group is received at most once from each neighbor, so the lists have
+   // no repeated entries
+   const Table &nbr_ldofs = (layout == 2) ? nbr_send_ltdofs : nbr_send_ldofs;
+   OpData<T> opd;
+   opd.ldata = ldata;
+   opd.nldofs = nbr_ldofs.RowSize(nbr);
+   opd.nb = 1;
+   opd.ldofs = nbr_ldofs.GetRow(nbr);
+   opd.buf = const_cast<T*>(buf);
+   Op(opd);
+   return buf + opd.nldofs;
+}
+
 template <class T>
 void GroupCommunicator::BcastBegin(T *ldata, int layout) const
 {
    MFEM_VERIFY(comm_lock == 0, "object is already in use");
 
-   if (group_buf_size == 0) { return; }
+   // The neighborhood collective is called by all processors
+   if (group_buf_size == 0 && mode != byNeighborCollective) { return; }
 
    int request_counter = 0;
    switch (mode)
@@ -698,51 +932,42 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
       {
          group_buf.SetSize(group_buf_size*sizeof(T));
          T *buf = (T *)group_buf.GetData();
+         // Doubles are sent with persistent requests, started below
+         const bool persistent = (MPITypeMap<T>::mpi_type == MPI_DOUBLE);
          for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
          {
-            const int num_send_groups = nbr_send_groups.RowSize(nbr);
-            if (num_send_groups > 0)
+            const int send_size = nbr_send_ldofs.RowSize(nbr);
+            if (send_size > 0)
             {
-               // Possible optimization:
-               //    if (num_send_groups == 1) and (layout == 1) then we do not
-               //    need to copy the data in order to send it.
                T *buf_start = buf;
-               const int *grp_list = nbr_send_groups.GetRow(nbr);
-               for (int i = 0; i < num_send_groups; i++)
+               buf = CopyNbrToBuffer(ldata, buf, nbr, layout);
+               if (!persistent)
                {
-                  buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+                  MPI_Isend(buf_start,
+                            send_size,
+                            MPITypeMap<T>::mpi_type,
+                            gtopo.GetNeighborRank(nbr),
+                            40822,
+                            gtopo.GetComm(),
+                            &requests[request_counter]);
                }
-               MPI_Isend(buf_start,
-                         buf - buf_start,
-                         MPITypeMap<T>::mpi_type,
-                         gtopo.GetNeighborRank(nbr),
-                         40822,
-                         gtopo.GetComm(),
-                         &requests[request_counter]);
                request_marker[request_counter] = -1; // mark as send request
                request_counter++;
             }
 
-            const int num_recv_groups = nbr_recv_groups.RowSize(nbr);
-            if (num_recv_groups > 0)
+            const int recv_size = nbr_recv_ldofs.RowSize(nbr);
+            if (recv_size > 0)
             {
-               // Possible optimization (requires interface change):
-               //    if (num_recv_groups == 1) and the (output layout == 1) then
-               //    we can receive directly in the output buffer; however, at
-               //    this point we do not have that information.
-               const int *grp_list = nbr_recv_groups.GetRow(nbr);
-               int recv_size = 0;
-               for (int i = 0; i < num_recv_groups; i++)
+               if (!persistent)
                {
-                  recv_size += group_ldof.RowSize(grp_list[i]);
+                  MPI_Irecv(buf,
+                            recv_size,
+                            MPITypeMap<T>::mpi_type,
+                            gtopo.GetNeighborRank(nbr),
+                            40822,
+                            gtopo.GetComm(),
+                            &requests[request_counter]);
                }
-               MPI_Irecv(buf,
-                         recv_size,
-                         MPITypeMap<T>::mpi_type,
-                         gtopo.GetNeighborRank(nbr),
-                         40822,
-                         gtopo.GetComm(),
-                         &requests[request_counter]);
                request_marker[request_counter] = nbr;
                request_counter++;
                buf_offsets[nbr] = buf - (T*)group_buf.GetData();
@@ -750,6 +975,33 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
             }
          }
          MFEM_ASSERT(buf - (T*)group_buf.GetData() == group_buf_size, "");
+         MFEM_ASSERT(request_counter == num_nbr_requests, "");
+         if (persistent)
+         {
+            MPI_Startall(request_counter, GetPersistentRequests(0));
+         }
+         break;
+      }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+#if MPI_VERSION >= 3
+         group_buf.SetSize(group_buf_size*sizeof(T));
+         T *send_buf = (T *)group_buf.GetData();
+         T *recv_buf = send_buf + nbr_send_displs.Last();
+         for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+         {
+            CopyNbrToBuffer(ldata, send_buf + nbr_send_displs[nbr-1], nbr,
+                            layout);
+            buf_offsets[nbr] = (recv_buf - send_buf) + nbr_recv_displs[nbr-1];
+         }
+         MPI_Ineighbor_alltoallv(send_buf, nbr_send_counts, nbr_send_displs,
+                                 MPITypeMap<T>::mpi_type,
+                                 recv_buf, nbr_recv_counts, nbr_recv_displs,
+                                 MPITypeMap<T>::mpi_type,
+                                 nbr_comm, &requests[0]);
+         request_counter = 1;
+#endif
          break;
       }
    }
@@ -793,24 +1045,29 @@ void GroupCommunicator::BcastEnd(T *ldata, int layout) const
 
       case byNeighbor: // ***** Communication by neighbors *****
       {
+         MPI_Request *reqs = (MPITypeMap<T>::mpi_type == MPI_DOUBLE) ?
+                             bcast_preqs : requests;
          // copy the received data from the buffer to ldata, as it arrives
          int idx;
-         while (MPI_Waitany(num_requests, requests, &idx, MPI_STATUS_IGNORE),
+         while (MPI_Waitany(num_requests, reqs, &idx, MPI_STATUS_IGNORE),
                 idx != MPI_UNDEFINED)
          {
             int nbr = request_marker[idx];
             if (nbr == -1) { continue; } // skip send requests
 
-            const int num_recv_groups = nbr_recv_groups.RowSize(nbr);
-            if (num_recv_groups > 0)
-            {
-               const int *grp_list = nbr_recv_groups.GetRow(nbr);
-               const T *buf = (T*)group_buf.GetData() + buf_offsets[nbr];
-               for (int i = 0; i < num_recv_groups; i++)
-               {
-                  buf = CopyGroupFromBuffer(buf, ldata, grp_list[i], layout);
-               }
-            }
+            const T *buf = (T*)group_buf.GetData() + buf_offsets[nbr];
+            CopyNbrFromBuffer(buf, ldata, nbr, layout);
+         }
+         break;
+      }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+         MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+         for (int nbr = 1; nbr < nbr_recv_groups.Size(); nbr++)
+         {
+            const T *buf = (T*)group_buf.GetData() + buf_offsets[nbr];
+            CopyNbrFromBuffer(buf, ldata, nbr, layout);
          }
          break;
       }
@@ -825,7 +1082,8 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
 {
    MFEM_VERIFY(comm_lock == 0, "object is already in use");
 
-   if (group_buf_size == 0) { return; }
+   // The neighborhood collective is called by all processors
+   if (group_buf_size == 0 && mode != byNeighborCollective) { return; }
 
    int request_counter = 0;
    group_buf.SetSize(group_buf_size*sizeof(T));
@@ -883,47 +1141,44 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
 
       case byNeighbor: // ***** Communication by neighbors *****
       {
+         // Doubles are sent with persistent requests, started below
+         const bool persistent = (MPITypeMap<T>::mpi_type == MPI_DOUBLE);
          for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
          {
             // In Reduce operation: send_groups <--> recv_groups
-            const int num_send_groups = nbr_recv_groups.RowSize(nbr);
-            if (num_send_groups > 0)
+            const int send_size = nbr_recv_ldofs.RowSize(nbr);
+            if (send_size > 0)
             {
-               T *buf_start = buf;
-               const int *grp_list = nbr_recv_groups.GetRow(nbr);
-               for (int i = 0; i < num_send_groups; i++)
+               GatherData(buf, ldata, nbr_recv_ldofs.GetRow(nbr), send_size);
+               if (!persistent)
                {
-                  const int layout = 0; // ldata is an array on all ldofs
-                  buf = CopyGroupToBuffer(ldata, buf, grp_list[i], layout);
+                  MPI_Isend(buf,
+                            send_size,
+                            MPITypeMap<T>::mpi_type,
+                            gtopo.GetNeighborRank(nbr),
+                            43822,
+                            gtopo.GetComm(),
+                            &requests[request_counter]);
                }
-               MPI_Isend(buf_start,
-                         buf - buf_start,
-                         MPITypeMap<T>::mpi_type,
-                         gtopo.GetNeighborRank(nbr),
-                         43822,
-                         gtopo.GetComm(),
-                         &requests[request_counter]);
                request_marker[request_counter] = -1; // mark as send request
                request_counter++;
+               buf += send_size;
             }
 
             // In Reduce operation: send_groups <--> recv_groups
-            const int num_recv_groups = nbr_send_groups.RowSize(nbr);
-            if (num_recv_groups > 0)
+            const int recv_size = nbr_send_ldofs.RowSize(nbr);
+            if (recv_size > 0)
             {
-               const int *grp_list = nbr_send_groups.GetRow(nbr);
-               int recv_size = 0;
-               for (int i = 0; i < num_recv_groups; i++)
+               if (!persistent)
                {
-                  recv_size += group_ldof.RowSize(grp_list[i]);
+                  MPI_Irecv(buf,
+                            recv_size,
+                            MPITypeMap<T>::mpi_type,
+                            gtopo.GetNeighborRank(nbr),
+                            43822,
+                            gtopo.GetComm(),
+                            &requests[request_counter]);
                }
-               MPI_Irecv(buf,
-                         recv_size,
-                         MPITypeMap<T>::mpi_type,
-                         gtopo.GetNeighborRank(nbr),
-                         43822,
-                         gtopo.GetComm(),
-                         &requests[request_counter]);
                request_marker[request_counter] = nbr;
                request_counter++;
                buf_offsets[nbr] = buf - (T*)group_buf.GetData();
@@ -931,6 +1186,32 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
             }
          }
          MFEM_ASSERT(buf - (T*)group_buf.GetData() == group_buf_size, "");
+         if (persistent)
+         {
+            MPI_Startall(request_counter, GetPersistentRequests(1));
+         }
+         break;
+      }
+
+      case byNeighborCollective: // ***** Neighborhood collective *****
+      {
+#if MPI_VERSION >= 3
+         // In Reduce operation: send <--> receive
+         T *recv_buf = buf + nbr_recv_displs.Last();
+         for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+         {
+            const int send_size = nbr_recv_ldofs.RowSize(nbr);
+            T *send_buf = buf + nbr_recv_displs[nbr-1];
+            GatherData(send_buf, ldata, nbr_recv_ldofs.GetRow(nbr), send_size);
+            buf_offsets[nbr] = (recv_buf - buf) + nbr_send_displs[nbr-1];
+         }
+         MPI_Ineighbor_alltoallv(buf, nbr_recv_counts, nbr_recv_displs,
+                                 MPITypeMap<T>::mpi_type,
+                                 recv_buf, nbr_send_counts, nbr_send_displs,
+                                 MPITypeMap<T>::mpi_type,
+                                 nbr_comm, &requests[0]);
+         request_counter = 1;
+#endif
          break;
       }
    }
@@ -983,22 +1264,20 @@ void GroupCommunicator::ReduceEnd(T *ldata, int layout,
       }
 
       case byNeighbor: // ***** Communication by neighbors *****
+      case byNeighborCollective:
       {
-         MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+         MPI_Request *reqs = (mode == byNeighbor &&
+                              MPITypeMap<T>::mpi_type == MPI_DOUBLE) ?
+                             reduce_preqs : requests;
+         MPI_Waitall(num_requests, reqs, MPI_STATUSES_IGNORE);
 
          for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
          {
             // In Reduce operation: send_groups <--> recv_groups
-            const int num_recv_groups = nbr_send_groups.RowSize(nbr);
-            if (num_recv_groups > 0)
+            if (nbr_send_ldofs.RowSize(nbr) > 0)
             {
-               const int *grp_list = nbr_send_groups.GetRow(nbr);
                const T *buf = (T*)group_buf.GetData() + buf_offsets[nbr];
-               for (int i = 0; i < num_recv_groups; i++)
-               {
-                  buf = ReduceGroupFromBuffer(buf, ldata, grp_list[i],
-                                              layout, Op);
-               }
+               ReduceNbrFromBuffer(buf, ldata, nbr, layout, Op);
             }
          }
          break;
@@ -1014,6 +1293,10 @@ void GroupCommunicator::Sum(OpData<T> opd)
 {
    if (opd.nb == 1)
    {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for \
+      if (opd.nldofs >= omp_pack_min_size && Device::Allows(Backend::OMP_MASK))
+#endif
       for (int i = 0; i < opd.nldofs; i++)
       {
          opd.ldata[opd.ldofs[i]] += opd.buf[i];
@@ -1092,7 +1375,7 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
    int num_sends = 0, num_recvs = 0;
    size_t mem_sends = 0, mem_recvs = 0;
    int num_master_groups = 0, num_empty_groups = 0;
-   int num_active_neighbors = 0; // for mode == byNeighbor
+   int num_active_neighbors = 0; // for mode != byGroup
    switch (mode)
    {
       case byGroup:
@@ -1119,6 +1402,7 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
          break;
 
       case byNeighbor:
+      case byNeighborCollective:
          for (int gr = 1; gr < group_ldof.Size(); gr++)
          {
             const int nldofs = group_ldof.RowSize(gr);
@@ -1173,7 +1457,8 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
    }
    out << "Rank " << myid << ":\n"
        "   mode             = " <<
-       (mode == byGroup ? "byGroup" : "byNeighbor") << "\n"
+       (mode == byGroup ? "byGroup" : mode == byNeighbor ? "byNeighbor" :
+        "byNeighborCollective") << "\n"
        "   number of sends  = " << num_sends <<
        " (" << mem_sends << " bytes)\n"
        "   number of recvs  = " << num_recvs <<
@@ -1183,7 +1468,7 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
        num_master_groups << " + " <<
        group_ldof.Size()-num_master_groups-num_empty_groups << " + " <<
        num_empty_groups << " (master + slave + empty)\n";
-   if (mode == byNeighbor)
+   if (mode != byGroup)
    {
       out <<
           "   num neighbors    = " << nbr_send_groups.Size() << " = " <<
@@ -1205,6 +1490,21 @@ void GroupCommunicator::PrintInfo(std::ostream &out) const
 
 GroupCommunicator::~GroupCommunicator()
 {
+   int mpi_finalized;
+   MPI_Finalized(&mpi_finalized);
+   MPI_Request *preqs[2] = { bcast_preqs, reduce_preqs };
+   for (int op = 0; op < 2; op++)
+   {
+      for (int i = 0; preqs[op] && !mpi_finalized && i < num_nbr_requests; i++)
+      {
+         MPI_Request_free(&preqs[op][i]);
+      }
+      delete [] preqs[op];
+   }
+   if (nbr_comm != MPI_COMM_NULL && !mpi_finalized)
+   {
+      MPI_Comm_free(&nbr_comm);
+   }
    delete [] buf_offsets;
    delete [] request_marker;
    // delete [] statuses;
@@ -32,13 +32,19 @@ namespace mfem
 class MPI_Session
 {
 protected:
-   int world_rank, world_size;
+   int world_rank, world_size, thread_support;
+   void Init(int *argc, char ***argv);
    void GetRankAndSize();
 public:
-   MPI_Session() { MPI_Init(NULL, NULL); GetRankAndSize(); }
-   MPI_Session(int &argc, char **&argv)
-   { MPI_Init(&argc, &argv); GetRankAndSize(); }
+   /** @brief Initialize MPI. With MFEM_USE_OPENMP, MPI is initialized with
+       MPI_Init_thread() requesting MPI_THREAD_FUNNELED, so that the OpenMP
+       backends can be used in hybrid MPI+OpenMP runs. */
+   MPI_Session() { Init(NULL, NULL); }
+   MPI_Session(int &argc, char **&argv) { Init(&argc, &argv); }
    ~MPI_Session() { MPI_Finalize(); }
+   /** @brief Return the level of thread support provided by the MPI library,
+       e.g. MPI_THREAD_SINGLE or MPI_THREAD_FUNNELED. */
+   int ThreadSupport() const { return thread_support; }
    /// Return MPI_COMM_WORLD's rank.
    int WorldRank() const { return world_rank; }
    /// Return MPI_COMM_WORLD's size.
@@ -124,8 +130,11 @@ public:
    enum Mode
    {
       byGroup,    ///< Communications are performed one group at a time.
-      byNeighbor  /**< Communications are performed one neighbor at a time,
+      byNeighbor, /**< Communications are performed one neighbor at a time,
                        aggregating over groups. */
+      byNeighborCollective /**< Same as byNeighbor, but all messages are
+                                exchanged with one MPI-3 neighborhood
+                                collective, MPI_Ineighbor_alltoallv(). */
    };
 
 protected:
@@ -144,6 +153,30 @@ protected:
    int *buf_offsets; // size = max(number of groups, number of neighbors)
    Table nbr_send_groups, nbr_recv_groups; // nbr 0 = me
 
+   // Pack/unpack lists for the communication by neighbors: the ldofs of the
+   // groups in each row of nbr_send_groups and nbr_recv_groups, in message
+   // order. The ltdofs of nbr_send_groups are set by SetLTDofTable().
+   Table nbr_send_ldofs, nbr_recv_ldofs, nbr_send_ltdofs;
+
+   // Persistent requests (mode byNeighbor) used to Bcast and Reduce doubles,
+   // created on first use; the buffer group_buf is allocated in Finalize() and
+   // does not move.
+   mutable MPI_Request *bcast_preqs, *reduce_preqs;
+   int num_nbr_requests;
+
+   // Graph communicator of the neighbors and the message sizes and offsets of
+   // a Bcast (mode byNeighborCollective); a Reduce swaps send and receive.
+   MPI_Comm nbr_comm;
+   Array<int> nbr_send_counts, nbr_send_displs;
+   Array<int> nbr_recv_counts, nbr_recv_displs;
+
+   /// Construct the pack/unpack lists and the neighbor graph communicator.
+   void FinalizeNeighbors();
+
+   /** Return the persistent requests for a Bcast (@a op = 0) or Reduce
+       (@a op = 1) of doubles, creating them if necessary. */
+   MPI_Request *GetPersistentRequests(int op) const;
+
 public:
    /// Construct a GroupCommunicator object.
    /** The object must be initialized before it can be used to perform any
@@ -173,6 +206,17 @@ public:
        data layout 2, see CopyGroupToBuffer() for layout descriptions. */
    void SetLTDofTable(const Array<int> &ldof_ltdof);
 
+   /** @brief Return the ltdofs sent to each neighbor (row nbr, 0 = me) in a
+       broadcast with layout 2, in message order. */
+   /** Requires SetLTDofTable(). In a reduction, the entries received from the
+       neighbors are reduced to the same ltdofs in the same order. */
+   const Table &GetNbrSendLTDofs() const { return nbr_send_ltdofs; }
+
+   /** @brief Return the ldofs received from each neighbor (row nbr, 0 = me) in
+       a broadcast, in message order. */
+   /** In a reduction, these entries are sent to the neighbors. */
+   const Table &GetNbrRecvLDofs() const { return nbr_recv_ldofs; }
+
    /// Get a reference to the associated GroupTopology object
    GroupTopology &GetGroupTopology() { return gtopo; }
 
@@ -220,6 +264,31 @@ public:
    const T *ReduceGroupFromBuffer(const T *buf, T *ldata, int group,
                                   int layout, void (*Op)(OpData<T>)) const;
 
+   /** @brief Copy the entries sent to the neighbor @a nbr in a broadcast from
+       the local array @a ldata to the buffer @a buf. */
+   /** Layouts 0 and 2 use the precomputed lists of all ldofs (or ltdofs) of
+       the groups. For a description of @a layout, see CopyGroupToBuffer().
+       @returns The pointer @a buf plus the number of entries. */
+   template <class T>
+   T *CopyNbrToBuffer(const T *ldata, T *buf, int nbr, int layout) const;
+
+   /** @brief Copy the entries received from the neighbor @a nbr in a
+       broadcast from the buffer @a buf to the local array @a ldata. */
+   /** For a description of @a layout, see CopyGroupToBuffer().
+       @returns The pointer @a buf plus the number of entries. */
+   template <class T>
+   const T *CopyNbrFromBuffer(const T *buf, T *ldata, int nbr,
+                              int layout) const;
+
+   /** @brief Perform the reduction operation @a Op to the entries received
+       from the neighbor @a nbr in a reduction, using the values from the
+       buffer @a buf and the local array @a ldata. */
+   /** For a description of @a layout, see CopyGroupToBuffer().
+       @returns The pointer @a buf plus the number of entries. */
+   template <class T>
+   const T *ReduceNbrFromBuffer(const T *buf, T *ldata, int nbr, int layout,
+                                void (*Op)(OpData<T>)) const;
+
    /// Begin a broadcast within each group where the master is the root.
    /** For a description of @a layout, see CopyGroupToBuffer(). */
    template <class T> void BcastBegin(T *ldata, int layout) const;
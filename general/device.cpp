@@ -16,6 +16,10 @@
 #include <string>
 #include <map>
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -91,9 +95,30 @@ void Device::Print(std::ostream &out)
          out << internal::backend_name[i];
       }
    }
+   if (Get().backends & Backend::OMP_MASK)
+   {
+      out << " (" << GetNumThreads() << " threads)";
+   }
    out << '\n';
 }
 
+void Device::SetNumThreads(int num_threads)
+{
+   MFEM_VERIFY(num_threads > 0, "invalid number of threads: " << num_threads);
+#ifdef MFEM_USE_OPENMP
+   omp_set_num_threads(num_threads);
+#endif
+}
+
+int Device::GetNumThreads()
+{
+#ifdef MFEM_USE_OPENMP
+   return omp_get_max_threads();
+#else
+   return 1;
+#endif
+}
+
 #ifdef MFEM_USE_CUDA
 static void DeviceSetup(const int dev, int &ngpu)
 {
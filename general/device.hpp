@@ -174,6 +174,16 @@ public:
    /// The opposite of IsEnabled().
    static inline bool IsDisabled() { return !IsEnabled(); }
 
+   /// Set the number of threads used by the OpenMP backends on this rank.
+   /** In hybrid MPI+OpenMP runs, e.g. with one rank per socket, this selects the
+       number of threads per rank; by default the OpenMP runtime setting (e.g.
+       OMP_NUM_THREADS) is used. Without MFEM_USE_OPENMP this call is ignored. */
+   static void SetNumThreads(int num_threads);
+
+   /// Return the number of threads used by the OpenMP backends on this rank.
+   /** Returns 1 when MFEM is built without MFEM_USE_OPENMP. */
+   static int GetNumThreads();
+
    /** @brief Return true if any of the backends in the backend mask, @a b_mask,
        are allowed. The allowed backends are all configured backends minus the
        device backends when the Device is disabled. */
@@ -45,7 +45,7 @@ template <typename HBODY>
 void OmpWrap(const int N, HBODY &&h_body)
 {
 #ifdef MFEM_USE_OPENMP
-   #pragma omp parallel for
+   #pragma omp parallel for schedule(static)
    for (int k = 0; k < N; k++)
    {
       h_body(k);
@@ -0,0 +1,379 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "fpcompress.hpp"
+#include "binaryio.hpp"
+#include "error.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace mfem
+{
+
+// Definition of the static member, which is odr-used below
+const int FPCompression::chunk_size;
+
+typedef unsigned char byte;
+typedef std::vector<byte> ByteVector;
+
+static const char fpc_magic[4] = { 'M', 'F', 'P', 'C' };
+
+// Chunk types, stored in the first byte of each chunk
+enum { CHUNK_RAW = 0, CHUNK_SHUFFLE_LZ = 1, CHUNK_QUANT_LZ = 2 };
+
+
+// LZ77 coder. The compressed data is a sequence of (literals, match) pairs,
+// each starting with a token byte: the high 4 bits store the number of
+// literals, the low 4 bits the match length minus 4, with the value 15 meaning
+// that the length continues in the following bytes (255 = add and continue).
+// The token is followed by the literal bytes and the 2-byte match offset. The
+// last pair has no match: it ends at the end of the compressed data.
+
+static const int lz_hash_bits = 13;
+static const int lz_min_match = 4;
+static const int lz_max_offset = 65535;
+
+static inline void lz_put_length(ByteVector &out, int len)
+{
+   for (len -= 15; len >= 255; len -= 255) { out.push_back(255); }
+   out.push_back(byte(len));
+}
+
+static inline void lz_put_sequence(ByteVector &out, const byte *lit,
+                                   int nlit, int offset, int mlen)
+{
+   const int ml = (offset > 0) ? mlen - lz_min_match : 0;
+   out.push_back(byte(((nlit < 15 ? nlit : 15) << 4) | (ml < 15 ? ml : 15)));
+   if (nlit >= 15) { lz_put_length(out, nlit); }
+   out.insert(out.end(), lit, lit + nlit);
+   if (offset > 0)
+   {
+      out.push_back(byte(offset & 0xff));
+      out.push_back(byte(offset >> 8));
+      if (ml >= 15) { lz_put_length(out, ml); }
+   }
+}
+
+static void LZCompress(const byte *in, int n, ByteVector &out)
+{
+   std::vector<int> htable(1 << lz_hash_bits, -1);
+   int anchor = 0, i = 0;
+   while (i + lz_min_match <= n)
+   {
+      unsigned seq;
+      std::memcpy(&seq, in + i, 4);
+      const unsigned h = (seq * 2654435761u) >> (32 - lz_hash_bits);
+      const int ref = htable[h];
+      htable[h] = i;
+
+      if (ref >= 0 && i - ref <= lz_max_offset &&
+          std::memcmp(in + ref, in + i, lz_min_match) == 0)
+      {
+         int len = lz_min_match;
+         while (i + len < n && in[ref + len] == in[i + len]) { len++; }
+
+         lz_put_sequence(out, in + anchor, i - anchor, i - ref, len);
+         i += len;
+         anchor = i;
+      }
+      else
+      {
+         i++;
+      }
+   }
+   lz_put_sequence(out, in + anchor, n - anchor, 0, 0);
+}
+
+static inline bool lz_get_length(const byte *&ip, const byte *end, int &len)
+{
+   if (len < 15) { return true; }
+   for (;;)
+   {
+      if (ip == end) { return false; }
+      const byte b = *ip++;
+      len += b;
+      if (b != 255) { return true; }
+   }
+}
+
+// Return false if the input is corrupted or does not decompress to exactly
+// 'n' bytes.
+static bool LZDecompress(const byte *in, int in_size, byte *out, int n)
+{
+   const byte *ip = in, *end = in + in_size;
+   byte *op = out, *op_end = out + n;
+   for (;;)
+   {
+      if (ip == end) { return false; }
+      const byte token = *ip++;
+
+      int nlit = token >> 4;
+      if (!lz_get_length(ip, end, nlit)) { return false; }
+      if (nlit > end - ip || nlit > op_end - op) { return false; }
+      std::memcpy(op, ip, nlit);
+      ip += nlit;
+      op += nlit;
+
+      if (ip == end) { break; } // last sequence
+
+      if (end - ip < 2) { return false; }
+      const int offset = ip[0] | (ip[1] << 8);
+      ip += 2;
+      int mlen = token & 15;
+      if (!lz_get_length(ip, end, mlen)) { return false; }
+      mlen += lz_min_match;
+
+      if (offset == 0 || offset > op - out || mlen > op_end - op)
+      {
+         return false;
+      }
+      const byte *match = op - offset;
+      for (int k = 0; k < mlen; k++) { op[k] = match[k]; } // may overlap
+      op += mlen;
+   }
+   return op == op_end;
+}
+
+
+// Chunk encoding/decoding
+
+static void EncodeRaw(const double *x, int n, ByteVector &out)
+{
+   out.push_back(CHUNK_RAW);
+   const byte *b = reinterpret_cast<const byte*>(x);
+   out.insert(out.end(), b, b + n*sizeof(double));
+}
+
+static void EncodeLossless(const double *x, int n, ByteVector &out)
+{
+   // byte shuffle: all first bytes, then all second bytes, etc.
+   const int nb = sizeof(double);
+   const byte *b = reinterpret_cast<const byte*>(x);
+   ByteVector shuffled(n*nb);
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = 0; k < nb; k++) { shuffled[k*n + i] = b[i*nb + k]; }
+   }
+
+   out.push_back(CHUNK_SHUFFLE_LZ);
+   LZCompress(shuffled.data(), n*nb, out);
+
+   if (out.size() >= 1 + n*sizeof(double))
+   {
+      out.clear();
+      EncodeRaw(x, n, out);
+   }
+}
+
+// Return false if the error bound cannot be guaranteed for this chunk.
+static bool EncodeLossy(const double *x, int n, double tol, ByteVector &out)
+{
+   const double step = 2.0*tol, max_q = 4e15; // |q| < 2^52
+   ByteVector varints;
+   varints.reserve(2*n);
+
+   long long prev = 0;
+   for (int i = 0; i < n; i++)
+   {
+      const double q = std::floor(x[i]/step + 0.5);
+      if (!(std::fabs(q) < max_q) || !(std::fabs(x[i] - q*step) <= tol))
+      {
+         return false; // NaN, Inf, overflow or rounding error
+      }
+      const long long iq = (long long) q, d = iq - prev;
+      prev = iq;
+
+      // zig-zag encoding of the difference, stored in 7-bit groups
+      unsigned long long z = ((unsigned long long) d << 1) ^
+                             (unsigned long long)(d >> 63);
+      while (z >= 128)
+      {
+         varints.push_back(byte(z | 128));
+         z >>= 7;
+      }
+      varints.push_back(byte(z));
+   }
+
+   const int len = (int) varints.size();
+   out.push_back(CHUNK_QUANT_LZ);
+   const byte *lb = reinterpret_cast<const byte*>(&len);
+   out.insert(out.end(), lb, lb + sizeof(int));
+   LZCompress(varints.data(), len, out);
+   return true;
+}
+
+static void EncodeChunk(const double *x, int n, int codec, double tol,
+                        ByteVector &out)
+{
+   if (codec == FPCompression::LOSSY && EncodeLossy(x, n, tol, out))
+   {
+      return;
+   }
+   out.clear();
+   if (codec != FPCompression::NONE)
+   {
+      EncodeLossless(x, n, out);
+   }
+   else
+   {
+      EncodeRaw(x, n, out);
+   }
+}
+
+static bool DecodeChunk(const byte *in, int in_size, double *x, int n,
+                        double tol)
+{
+   if (in_size < 1) { return false; }
+   const int type = in[0];
+   in++, in_size--;
+
+   const int nb = sizeof(double);
+   if (type == CHUNK_RAW)
+   {
+      if (in_size != n*nb) { return false; }
+      std::memcpy(x, in, n*nb);
+   }
+   else if (type == CHUNK_SHUFFLE_LZ)
+   {
+      ByteVector shuffled(n*nb);
+      if (!LZDecompress(in, in_size, shuffled.data(), n*nb)) { return false; }
+      byte *b = reinterpret_cast<byte*>(x);
+      for (int i = 0; i < n; i++)
+      {
+         for (int k = 0; k < nb; k++) { b[i*nb + k] = shuffled[k*n + i]; }
+      }
+   }
+   else if (type == CHUNK_QUANT_LZ)
+   {
+      int len;
+      if (in_size < (int) sizeof(int)) { return false; }
+      std::memcpy(&len, in, sizeof(int));
+      in += sizeof(int), in_size -= sizeof(int);
+      if (len < n) { return false; }
+
+      ByteVector varints(len);
+      if (!LZDecompress(in, in_size, varints.data(), len)) { return false; }
+
+      const double step = 2.0*tol;
+      const byte *ip = varints.data(), *end = ip + len;
+      long long prev = 0;
+      for (int i = 0; i < n; i++)
+      {
+         unsigned long long z = 0;
+         for (int shift = 0; ; shift += 7)
+         {
+            if (ip == end || shift > 63) { return false; }
+            const byte b = *ip++;
+            z |= (unsigned long long)(b & 127) << shift;
+            if (!(b & 128)) { break; }
+         }
+         const long long d = (long long)(z >> 1) ^ -(long long)(z & 1);
+         prev += d;
+         x[i] = prev*step;
+      }
+      if (ip != end) { return false; }
+   }
+   else
+   {
+      return false;
+   }
+   return true;
+}
+
+
+void FPCompression::Write(std::ostream &out, const double *data, int size,
+                          int codec, double tol)
+{
+   MFEM_VERIFY(codec >= NONE && codec <= LOSSY, "invalid codec: " << codec);
+   MFEM_VERIFY(codec != LOSSY || tol > 0.0,
+               "the LOSSY codec requires a positive tolerance");
+
+   const int num_chunks = (size + chunk_size - 1) / chunk_size;
+   std::vector<ByteVector> chunks(num_chunks);
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(dynamic)
+#endif
+   for (int c = 0; c < num_chunks; c++)
+   {
+      const int begin = c*chunk_size;
+      const int n = std::min(chunk_size, size - begin);
+      EncodeChunk(data + begin, n, codec, tol, chunks[c]);
+   }
+
+   out.write(fpc_magic, sizeof(fpc_magic));
+   bin_io::write<int>(out, codec);
+   bin_io::write<int>(out, size);
+   bin_io::write<int>(out, chunk_size);
+   bin_io::write<double>(out, tol);
+   bin_io::write<int>(out, num_chunks);
+   for (int c = 0; c < num_chunks; c++)
+   {
+      bin_io::write<int>(out, (int) chunks[c].size());
+   }
+   for (int c = 0; c < num_chunks; c++)
+   {
+      out.write((const char*) chunks[c].data(), chunks[c].size());
+   }
+}
+
+void FPCompression::Read(std::istream &in, double *data, int size)
+{
+   char magic[sizeof(fpc_magic)];
+   in.read(magic, sizeof(magic));
+   MFEM_VERIFY(in && std::memcmp(magic, fpc_magic, sizeof(magic)) == 0,
+               "invalid compressed data");
+
+   bin_io::read<int>(in); // codec, not needed for decoding
+   const int stored_size = bin_io::read<int>(in);
+   const int csize = bin_io::read<int>(in);
+   const double tol = bin_io::read<double>(in);
+   const int num_chunks = bin_io::read<int>(in);
+   MFEM_VERIFY(in, "error reading compressed data");
+   MFEM_VERIFY(stored_size == size, "compressed data size " << stored_size
+               << " does not match the expected size " << size);
+   MFEM_VERIFY(csize > 0 && num_chunks == (size + csize - 1) / csize,
+               "invalid compressed data");
+
+   std::vector<int> offsets(num_chunks + 1);
+   offsets[0] = 0;
+   for (int c = 0; c < num_chunks; c++)
+   {
+      const int len = bin_io::read<int>(in);
+      MFEM_VERIFY(in && len > 0, "invalid compressed data");
+      offsets[c+1] = offsets[c] + len;
+   }
+
+   ByteVector buffer(offsets[num_chunks]);
+   in.read((char*) buffer.data(), buffer.size());
+   MFEM_VERIFY(in, "error reading compressed data");
+
+   int errors = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(dynamic) reduction(+:errors)
+#endif
+   for (int c = 0; c < num_chunks; c++)
+   {
+      const int begin = c*csize;
+      const int n = std::min(csize, size - begin);
+      if (!DecodeChunk(buffer.data() + offsets[c], offsets[c+1] - offsets[c],
+                       data + begin, n, tol))
+      {
+         errors++;
+      }
+   }
+   MFEM_VERIFY(errors == 0, "corrupted compressed data");
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_FPCOMPRESS
+#define MFEM_FPCOMPRESS
+
+#include "../config/config.hpp"
+
+#include <iostream>
+
+namespace mfem
+{
+
+/** @brief Compression of arrays of doubles, used for the binary output of
+    GridFunction data, see GridFunction::SaveCompressed().
+
+    The data is split into chunks of #chunk_size values which are compressed
+    independently (in parallel, when MFEM_USE_OPENMP = YES) and written as one
+    binary block that can be read back with Read(). Two codecs are available:
+
+    - LOSSLESS: the bytes of the doubles are shuffled (all first bytes, then
+      all second bytes, etc.) so that the sign/exponent bytes form long runs,
+      and the result is compressed with a simple LZ77 coder. The data is
+      reproduced bit-for-bit.
+
+    - LOSSY: the values are quantized with the step 2*tol, so that the error
+      in each value is at most tol, and the differences of consecutive
+      quantized values are stored as variable-length integers followed by the
+      LZ77 coder. Chunks for which the quantization cannot guarantee the error
+      bound (e.g. non-finite or very large values) are stored losslessly.
+
+    A chunk that does not compress is stored uncompressed. */
+class FPCompression
+{
+public:
+   /// Codecs used by Write().
+   enum Codec
+   {
+      NONE = 0,     ///< Raw binary data, no compression.
+      LOSSLESS = 1, ///< Byte shuffle + LZ77, bit-for-bit reproduction.
+      LOSSY = 2     ///< Quantization with an absolute error bound.
+   };
+
+   /// Number of doubles in one independently compressed chunk.
+   static const int chunk_size = 8192;
+
+   /** @brief Compress the array @a data of length @a size with the given
+       @a codec and write it to @a out as a binary block. The parameter @a tol
+       is the absolute error bound used by the LOSSY codec and must be positive
+       in that case. */
+   static void Write(std::ostream &out, const double *data, int size,
+                     int codec, double tol = 0.0);
+
+   /** @brief Read a block written by Write() into the array @a data which must
+       have length @a size, equal to the size of the written array. */
+   static void Read(std::istream &in, double *data, int size);
+};
+
+}
+
+#endif
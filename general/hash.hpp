@@ -49,7 +49,8 @@ struct Hashed4
  *  different elements using this class. Similarly for faces.
  *
  *  The order of the p1, p2, ... indices is not relevant as they are sorted
- *  each time this class is invoked.
+ *  each time this class is invoked. Triangular faces can be stored by passing
+ *  p4 = -1, in which case only the first three indices are sorted.
  *
  *  There are two main methods this class provides. The Get(...) methods always
  *  return an item given the two or four indices. If the item didn't previously
@@ -117,6 +118,9 @@ public:
    void Reparent(int id, int new_p1, int new_p2);
    void Reparent(int id, int new_p1, int new_p2, int new_p3, int new_p4);
 
+   /// Exchange the contents (items, hash table, free ids) with another table.
+   void Swap(HashTable<T> &other);
+
    /// Return total size of allocated memory (tables plus items), in bytes.
    long MemoryUsage() const;
 
@@ -246,6 +250,18 @@ inline void sort4(int &a, int &b, int &c, int &d)
    sort3(b, c, d);
 }
 
+inline void sort4_ext(int &a, int &b, int &c, int &d)
+{
+   if (d < 0) // support last index == -1 (triangular faces)
+   {
+      sort3(a, b, c);
+   }
+   else
+   {
+      sort4(a, b, c, d);
+   }
+}
+
 } // internal
 
 template<typename T>
@@ -295,7 +311,7 @@ template<typename T>
 int HashTable<T>::GetId(int p1, int p2, int p3, int p4)
 {
    // search for the item in the hashtable
-   internal::sort4(p1, p2, p3, p4);
+   internal::sort4_ext(p1, p2, p3, p4);
    int idx = Hash(p1, p2, p3);
    int id = SearchList(table[idx], p1, p2, p3);
    if (id >= 0) { return id; }
@@ -361,7 +377,7 @@ int HashTable<T>::FindId(int p1, int p2) const
 template<typename T>
 int HashTable<T>::FindId(int p1, int p2, int p3, int p4) const
 {
-   internal::sort4(p1, p2, p3, p4);
+   internal::sort4_ext(p1, p2, p3, p4);
    return SearchList(table[Hash(p1, p2, p3)], p1, p2, p3);
 }
 
@@ -481,7 +497,7 @@ void HashTable<T>::Reparent(int id,
    T& item = Base::At(id);
    Unlink(Hash(item), id);
 
-   internal::sort4(new_p1, new_p2, new_p3, new_p4);
+   internal::sort4_ext(new_p1, new_p2, new_p3, new_p4);
    item.p1 = new_p1;
    item.p2 = new_p2;
    item.p3 = new_p3;
@@ -491,6 +507,15 @@ void HashTable<T>::Reparent(int id,
    Insert(new_idx, id, item);
 }
 
+template<typename T>
+void HashTable<T>::Swap(HashTable<T> &other)
+{
+   Base::Swap(other);
+   std::swap(table, other.table);
+   std::swap(mask, other.mask);
+   mfem::Swap(unused, other.unused);
+}
+
 template<typename T>
 long HashTable<T>::MemoryUsage() const
 {
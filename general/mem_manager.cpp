@@ -360,4 +360,40 @@ void MemoryManager::GetAll(void)
 MemoryManager mm;
 bool MemoryManager::exists = false;
 
+static MemoryPlacement::Type memory_placement = MemoryPlacement::DEFAULT;
+
+void SetMemoryPlacement(MemoryPlacement::Type placement)
+{
+   memory_placement = placement;
+}
+
+MemoryPlacement::Type GetMemoryPlacement() { return memory_placement; }
+
+namespace internal
+{
+
+// Smaller arrays are usually carved from heap memory that has already been
+// touched, so placing them has no effect. This is the default threshold above
+// which glibc's malloc maps new pages.
+static const std::size_t first_touch_min_bytes = 128*1024;
+
+template <class T>
+static inline void ParallelFirstTouch(T *ptr, std::size_t n)
+{
+   if (memory_placement != MemoryPlacement::FIRST_TOUCH ||
+       n*sizeof(T) < first_touch_min_bytes) { return; }
+#ifdef MFEM_USE_OPENMP
+   // Same partitioning as the OmpWrap loops of MFEM_FORALL
+   const int N = n;
+   #pragma omp parallel for schedule(static)
+   for (int i = 0; i < N; i++) { ptr[i] = T(0); }
+#endif
+}
+
+void FirstTouch(double *ptr, std::size_t n) { ParallelFirstTouch(ptr, n); }
+
+void FirstTouch(int *ptr, std::size_t n) { ParallelFirstTouch(ptr, n); }
+
+} // namespace mfem::internal
+
 } // namespace mfem
@@ -141,12 +141,48 @@ public:
 /// The (single) global memory manager object
 extern MemoryManager mm;
 
+/// Placement policy of the host memory allocated by mfem::New.
+struct MemoryPlacement
+{
+   enum Type
+   {
+      /** The memory pages are placed by the operating system where they are
+          first written, e.g. all on the NUMA node of the thread filling them
+          sequentially. */
+      DEFAULT,
+      /** Large arrays of int and double are zeroed in parallel when allocated,
+          with the static partitioning of the OpenMP backend kernels. On NUMA
+          systems, each page is then placed close to the thread that accesses
+          it in the MFEM_FORALL loops. Requires MFEM_USE_OPENMP, otherwise it
+          has the same effect as DEFAULT. */
+      FIRST_TOUCH
+   };
+};
+
+/// Set the placement policy of the host memory allocated by mfem::New.
+/** The policy applies to the allocations that follow the call, e.g. the data
+    of Vector and the CSR arrays of SparseMatrix. */
+void SetMemoryPlacement(MemoryPlacement::Type placement);
+
+/// Return the placement policy of the host memory allocated by mfem::New.
+MemoryPlacement::Type GetMemoryPlacement();
+
+namespace internal
+{
+/// Touch the new array @a ptr of @a n entries according to the placement.
+void FirstTouch(double *ptr, std::size_t n);
+void FirstTouch(int *ptr, std::size_t n);
+/// Arrays of other types are not touched.
+template <class T> inline void FirstTouch(T *, std::size_t) { }
+}
+
 /// Main memory allocation template function. Allocates n*size bytes and returns
 /// a pointer to the allocated memory.
 template<class T>
 inline T *New(const std::size_t n)
 {
    T *ptr = new T[n];
+   internal::FirstTouch(ptr, n);
    if (!MemoryManager::Exists()) { return ptr; }
    return static_cast<T*>(mm.Insert(ptr, n*sizeof(T)));
 }
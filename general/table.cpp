@@ -18,6 +18,8 @@
 #include "../general/forall.hpp"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <vector>
 
 namespace mfem
 {
@@ -555,6 +557,132 @@ Table * Mult (const Table &A, const Table &B)
    return C;
 }
 
+// Breadth-first search from 'root' through the vertices not yet numbered in
+// 'ordering'. Returns the eccentricity of 'root' and, in 'last', a vertex of
+// minimum degree in the last level. Leaves 'dist' reset to -1.
+static int RCM_Levels(const Table &graph, int root, const Array<int> &ordering,
+                      Array<int> &dist, Array<int> &queue, int &last)
+{
+   queue.SetSize(0);
+   queue.Append(root);
+   dist[root] = 0;
+   for (int q = 0; q < queue.Size(); q++)
+   {
+      const int v = queue[q];
+      const int *row = graph.GetRow(v), n = graph.RowSize(v);
+      for (int j = 0; j < n; j++)
+      {
+         const int u = row[j];
+         if (ordering[u] < 0 && dist[u] < 0)
+         {
+            dist[u] = dist[v] + 1;
+            queue.Append(u);
+         }
+      }
+   }
+
+   const int ecc = dist[queue.Last()];
+   last = queue.Last();
+   for (int q = queue.Size()-1; q >= 0 && dist[queue[q]] == ecc; q--)
+   {
+      if (graph.RowSize(queue[q]) < graph.RowSize(last)) { last = queue[q]; }
+   }
+
+   for (int q = 0; q < queue.Size(); q++) { dist[queue[q]] = -1; }
+   return ecc;
+}
+
+void ReverseCuthillMcKee(const Table &graph, Array<int> &ordering)
+{
+   const int n = graph.Size();
+   ordering.SetSize(n);
+   ordering = -1;
+
+   Array<int> dist(n), queue;
+   dist = -1;
+   vector<pair<int, int> > nbr;
+
+   int counter = 0;
+   for (int i = 0; i < n; i++)
+   {
+      if (ordering[i] >= 0) { continue; }
+
+      // find a pseudo-peripheral vertex in the component of 'i'
+      int root = i, last;
+      int ecc = RCM_Levels(graph, root, ordering, dist, queue, last);
+      while (last != root)
+      {
+         int last2, ecc2 = RCM_Levels(graph, last, ordering, dist, queue, last2);
+         if (ecc2 <= ecc) { break; }
+         root = last;
+         ecc = ecc2;
+         last = last2;
+      }
+
+      // Cuthill-McKee: number the vertices in BFS order, the neighbors of
+      // each vertex by increasing degree
+      queue.SetSize(0);
+      queue.Append(root);
+      ordering[root] = counter++;
+      for (int q = 0; q < queue.Size(); q++)
+      {
+         const int v = queue[q];
+         const int *row = graph.GetRow(v), nr = graph.RowSize(v);
+
+         nbr.clear();
+         for (int j = 0; j < nr; j++)
+         {
+            const int u = row[j];
+            if (ordering[u] < 0) { nbr.push_back(make_pair(graph.RowSize(u), u)); }
+         }
+         sort(nbr.begin(), nbr.end());
+
+         for (unsigned j = 0; j < nbr.size(); j++)
+         {
+            const int u = nbr[j].second;
+            if (j && u == nbr[j-1].second) { continue; } // repeated connection
+            ordering[u] = counter++;
+            queue.Append(u);
+         }
+      }
+   }
+
+   // reverse the ordering
+   for (int i = 0; i < n; i++) { ordering[i] = n-1 - ordering[i]; }
+}
+
+long CountCacheMisses(const Table &access, int item_size,
+                      int cache_size, int line_size, int assoc)
+{
+   const int num_sets = std::max(cache_size / (line_size * assoc), 1);
+
+   // line tags in each set, most recently used first
+   Array<long> tags(num_sets * assoc);
+   tags = -1;
+
+   long misses = 0;
+   const int *J = access.GetJ(), nnz = access.Size_of_connections();
+   for (int k = 0; k < nnz; k++)
+   {
+      const long item = (J[k] >= 0) ? J[k] : -1-J[k];
+      const long first = item*item_size / line_size;
+      const long last = (item*item_size + item_size-1) / line_size;
+
+      for (long line = first; line <= last; line++)
+      {
+         long *set = tags.GetData() + (line % num_sets)*assoc;
+
+         int way = 0;
+         while (way < assoc && set[way] != line) { way++; }
+         if (way == assoc) { misses++; way--; }
+
+         for ( ; way > 0; way--) { set[way] = set[way-1]; }
+         set[0] = line;
+      }
+   }
+   return misses;
+}
+
 STable::STable (int dim, int connections_per_row) :
    Table(dim, connections_per_row)
 {}
@@ -181,6 +181,27 @@ void Transpose(const Array<int> &A, Table &At, int _ncols_A = -1);
 void Mult (const Table &A, const Table &B, Table &C);
 Table * Mult (const Table &A, const Table &B);
 
+/** @brief Compute a reverse Cuthill-McKee ordering of the graph given by the
+    symmetric adjacency table @a graph (self-connections are ignored).
+
+    On return, ordering[i] is the new number of vertex i. Each connected
+    component is traversed from a pseudo-peripheral vertex, visiting the
+    neighbors in the order of increasing degree. */
+void ReverseCuthillMcKee(const Table &graph, Array<int> &ordering);
+
+/** @brief Estimate the number of cache misses when the items referenced in the
+    rows of @a access are read row by row, e.g., vertex coordinates or DOF
+    values gathered element by element.
+
+    The items are assumed to be @a item_size bytes long and stored contiguously
+    in the order of their indices (negative indices are interpreted as -1-i).
+    The cache is modeled as @a cache_size bytes, @a assoc-way set associative
+    with @a line_size byte lines and LRU replacement. The result is only a
+    relative measure of the locality of the access pattern. */
+long CountCacheMisses(const Table &access, int item_size,
+                      int cache_size = 32*1024, int line_size = 64,
+                      int assoc = 8);
+
 
 /** Data type STable. STable is similar to Table, but it's for symmetric
     connectivity, i.e. TYPE I is equivalent to TYPE II. In the first
@@ -19,6 +19,7 @@
 #include "dtensor.hpp"
 #include "../general/forall.hpp"
 #include "../general/table.hpp"
+#include "../general/sort_pairs.hpp"
 #include "../general/globals.hpp"
 
 #include <iostream>
@@ -4526,4 +4527,336 @@ DenseTensor &DenseTensor::operator=(double c)
    return *this;
 }
 
+
+// Number of matrices factored together by the batched LU kernels: the entries
+// (i,j) of the matrices of a group are stored contiguously, so the inner loops
+// over the group vectorize.
+static const int batch_lanes = 8;
+
+// LU factorization with partial pivoting, as in LUFactors::Factor(), of the
+// group of batch_lanes interleaved (n x n) matrices A(l,i,j) =
+// A[l+batch_lanes*(i+n*j)]; the pivots are P(l,i) = P[l+batch_lanes*i]. If
+// N > 0 it must be equal to n.
+template <int N>
+static void BatchLUFactorGroup(const int n_, double *A, int *P)
+{
+   const int B = batch_lanes;
+   const int n = N ? N : n_;
+   for (int i = 0; i < n; i++)
+   {
+      // pivoting, independent in each matrix
+      for (int l = 0; l < B; l++)
+      {
+         int piv = i;
+         double a = fabs(A[l+B*(i+n*i)]);
+         for (int j = i+1; j < n; j++)
+         {
+            const double b = fabs(A[l+B*(j+n*i)]);
+            if (b > a)
+            {
+               a = b;
+               piv = j;
+            }
+         }
+         P[l+B*i] = piv;
+         if (piv != i)
+         {
+            for (int j = 0; j < n; j++)
+            {
+               const double tmp = A[l+B*(i+n*j)];
+               A[l+B*(i+n*j)] = A[l+B*(piv+n*j)];
+               A[l+B*(piv+n*j)] = tmp;
+            }
+         }
+      }
+      double a_ii_inv[B];
+      for (int l = 0; l < B; l++)
+      {
+         a_ii_inv[l] = 1.0/A[l+B*(i+n*i)];
+      }
+      for (int j = i+1; j < n; j++)
+      {
+         for (int l = 0; l < B; l++)
+         {
+            A[l+B*(j+n*i)] *= a_ii_inv[l];
+         }
+      }
+      const double *l_i = A + B*n*i;
+      for (int k = i+1; k < n; k++)
+      {
+         double *a_k = A + B*n*k;
+         double a_ik[B];
+         for (int l = 0; l < B; l++)
+         {
+            a_ik[l] = a_k[l+B*i];
+         }
+         for (int j = i+1; j < n; j++)
+         {
+            for (int l = 0; l < B; l++)
+            {
+               a_k[l+B*j] -= a_ik[l] * l_i[l+B*j];
+            }
+         }
+      }
+   }
+}
+
+// The specialized sizes are all sizes up to 8, and the larger numbers of
+// interior DOFs of the H1 elements up to order 8: (p-1)^2 and (p-1)^3 for
+// quadrilaterals and hexahedra, (p-1)(p-2)/2 and (p-1)(p-2)(p-3)/6 for
+// triangles and tetrahedra.
+static void BatchLUFactorGroup(const int n, double *A, int *P)
+{
+   switch (n)
+   {
+      case 1: BatchLUFactorGroup<1>(n, A, P); break;
+      case 2: BatchLUFactorGroup<2>(n, A, P); break;
+      case 3: BatchLUFactorGroup<3>(n, A, P); break;
+      case 4: BatchLUFactorGroup<4>(n, A, P); break;
+      case 5: BatchLUFactorGroup<5>(n, A, P); break;
+      case 6: BatchLUFactorGroup<6>(n, A, P); break;
+      case 7: BatchLUFactorGroup<7>(n, A, P); break;
+      case 8: BatchLUFactorGroup<8>(n, A, P); break;
+      case 9: BatchLUFactorGroup<9>(n, A, P); break;
+      case 10: BatchLUFactorGroup<10>(n, A, P); break;
+      case 12: BatchLUFactorGroup<12>(n, A, P); break;
+      case 15: BatchLUFactorGroup<15>(n, A, P); break;
+      case 16: BatchLUFactorGroup<16>(n, A, P); break;
+      case 20: BatchLUFactorGroup<20>(n, A, P); break;
+      case 21: BatchLUFactorGroup<21>(n, A, P); break;
+      case 25: BatchLUFactorGroup<25>(n, A, P); break;
+      case 27: BatchLUFactorGroup<27>(n, A, P); break;
+      case 28: BatchLUFactorGroup<28>(n, A, P); break;
+      case 35: BatchLUFactorGroup<35>(n, A, P); break;
+      case 36: BatchLUFactorGroup<36>(n, A, P); break;
+      case 49: BatchLUFactorGroup<49>(n, A, P); break;
+      case 56: BatchLUFactorGroup<56>(n, A, P); break;
+      case 64: BatchLUFactorGroup<64>(n, A, P); break;
+      default: BatchLUFactorGroup<0>(n, A, P); break;
+   }
+}
+
+// Given the output of BatchLUFactorGroup(), compute X <- A^{-1} X for the
+// interleaved (n x r) matrices X(l,i,j) = X[l+batch_lanes*(i+n*j)].
+static void BatchLUSolveGroup(const int n, const int r, const double *A,
+                              const int *P, double *X)
+{
+   const int B = batch_lanes;
+   for (int c = 0; c < r; c++)
+   {
+      double *x = X + B*n*c;
+      // X <- P X
+      for (int i = 0; i < n; i++)
+      {
+         for (int l = 0; l < B; l++)
+         {
+            const int piv = P[l+B*i];
+            if (piv != i)
+            {
+               const double tmp = x[l+B*i];
+               x[l+B*i] = x[l+B*piv];
+               x[l+B*piv] = tmp;
+            }
+         }
+      }
+      // X <- L^{-1} X
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = j+1; i < n; i++)
+         {
+            for (int l = 0; l < B; l++)
+            {
+               x[l+B*i] -= A[l+B*(i+n*j)] * x[l+B*j];
+            }
+         }
+      }
+      // X <- U^{-1} X
+      for (int j = n-1; j >= 0; j--)
+      {
+         for (int l = 0; l < B; l++)
+         {
+            x[l+B*j] /= A[l+B*(j+n*j)];
+         }
+         for (int i = 0; i < j; i++)
+         {
+            for (int l = 0; l < B; l++)
+            {
+               x[l+B*i] -= A[l+B*(i+n*j)] * x[l+B*j];
+            }
+         }
+      }
+   }
+}
+
+// Copy the matrices data[k0..k0+nl-1] into the interleaved group A, filling
+// the unused lanes with the identity.
+static void BatchGather(int m, int nl, const double *const *data, double *A)
+{
+   const int B = batch_lanes;
+   for (int l = 0; l < nl; l++)
+   {
+      const double *d = data[l];
+      for (int ij = 0; ij < m*m; ij++)
+      {
+         A[l+B*ij] = d[ij];
+      }
+   }
+   for (int l = nl; l < B; l++)
+   {
+      for (int ij = 0; ij < m*m; ij++)
+      {
+         A[l+B*ij] = 0.0;
+      }
+      for (int i = 0; i < m; i++)
+      {
+         A[l+B*(i+m*i)] = 1.0;
+      }
+   }
+}
+
+static void BatchScatter(int m, int nl, const double *A, double *const *data)
+{
+   const int B = batch_lanes;
+   for (int l = 0; l < nl; l++)
+   {
+      double *d = data[l];
+      for (int ij = 0; ij < m*m; ij++)
+      {
+         d[ij] = A[l+B*ij];
+      }
+   }
+}
+
+void BatchLUFactor(int m, int nb, double *const *data, int *const *ipiv)
+{
+   const int B = batch_lanes;
+   if (m > 64)
+   {
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int k = 0; k < nb; k++)
+      {
+         LUFactors(data[k], ipiv[k]).Factor(m);
+      }
+      return;
+   }
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel if (nb > B)
+#endif
+   {
+      Vector A(B*m*m);
+      Array<int> P(B*m);
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp for
+#endif
+      for (int k0 = 0; k0 < nb; k0 += B)
+      {
+         const int nl = std::min(B, nb - k0);
+         BatchGather(m, nl, data + k0, A.GetData());
+         BatchLUFactorGroup(m, A.GetData(), P.GetData());
+         BatchScatter(m, nl, A.GetData(), data + k0);
+         for (int l = 0; l < nl; l++)
+         {
+            int *piv = ipiv[k0+l];
+            for (int i = 0; i < m; i++)
+            {
+               piv[i] = P[l+B*i] + LUFactors::ipiv_base;
+            }
+         }
+      }
+   }
+}
+
+void BatchLUFactor(const Array<int> &sizes, const Array<double*> &data,
+                   const Array<int*> &ipiv)
+{
+   const int nb = sizes.Size();
+   Array<Pair<int,int> > size_k(nb);
+   for (int k = 0; k < nb; k++)
+   {
+      size_k[k].one = sizes[k];
+      size_k[k].two = k;
+   }
+   SortPairs<int,int>(size_k.GetData(), nb);
+
+   Array<double*> batch_data;
+   Array<int*> batch_ipiv;
+   for (int k0 = 0, k1; k0 < nb; k0 = k1)
+   {
+      batch_data.SetSize(0);
+      batch_ipiv.SetSize(0);
+      for (k1 = k0; k1 < nb && size_k[k1].one == size_k[k0].one; k1++)
+      {
+         batch_data.Append(data[size_k[k1].two]);
+         batch_ipiv.Append(ipiv[size_k[k1].two]);
+      }
+      BatchLUFactor(size_k[k0].one, batch_data.Size(),
+                    batch_data.GetData(), batch_ipiv.GetData());
+   }
+}
+
+void BatchLUFactor(DenseTensor &Mlu, Array<int> &P)
+{
+   const int m = Mlu.SizeI(), nb = Mlu.SizeK();
+   MFEM_VERIFY(Mlu.SizeJ() == m, "the matrices must be square");
+   P.SetSize(m*nb);
+   Array<double *> data(nb);
+   Array<int *> ipiv(nb);
+   for (int k = 0; k < nb; k++)
+   {
+      data[k] = Mlu.GetData(k);
+      ipiv[k] = P.GetData() + k*m;
+   }
+   BatchLUFactor(m, nb, data.GetData(), ipiv.GetData());
+}
+
+void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
+{
+   const int m = Mlu.SizeI(), nb = Mlu.SizeK();
+   MFEM_VERIFY(P.Size() == m*nb && X.Size() == m*nb, "invalid sizes");
+   DenseTensor &LU = const_cast<DenseTensor &>(Mlu);
+   for (int k = 0; k < nb; k++)
+   {
+      LUFactors lu(LU.GetData(k), const_cast<int *>(P.GetData()) + k*m);
+      lu.Solve(m, 1, X.GetData() + k*m);
+   }
+}
+
+void BatchInverse(DenseTensor &A)
+{
+   const int B = batch_lanes;
+   const int m = A.SizeI(), nb = A.SizeK();
+   MFEM_VERIFY(A.SizeJ() == m, "the matrices must be square");
+   if (m > 64)
+   {
+      DenseMatrixInverse inv;
+      DenseMatrix A_inv(m);
+      for (int k = 0; k < nb; k++)
+      {
+         inv.Factor(A(k));
+         inv.GetInverseMatrix(A_inv);
+         A(k) = A_inv;
+      }
+      return;
+   }
+   Vector LU(B*m*m), X(B*m*m);
+   Array<int> P(B*m);
+   Array<double *> data(nb);
+   for (int k = 0; k < nb; k++) { data[k] = A.GetData(k); }
+   for (int k0 = 0; k0 < nb; k0 += B)
+   {
+      const int nl = std::min(B, nb - k0);
+      BatchGather(m, nl, data.GetData() + k0, LU.GetData());
+      BatchLUFactorGroup(m, LU.GetData(), P.GetData());
+      X = 0.0;
+      for (int i = 0; i < m; i++)
+      {
+         for (int l = 0; l < B; l++) { X(l+B*(i+m*i)) = 1.0; }
+      }
+      BatchLUSolveGroup(m, m, LU.GetData(), P.GetData(), X.GetData());
+      BatchScatter(m, nl, X.GetData(), data.GetData() + k0);
+   }
+}
+
 }
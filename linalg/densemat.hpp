@@ -747,6 +747,38 @@ public:
    }
 };
 
+/** @brief Compute the LU factorizations of the @a nb (m x m) matrices @a
+    data[k], overwriting them with their factors, as LUFactors::Factor() with
+    the pivots stored in @a ipiv[k]. */
+/** For m <= 64, the matrices are processed in groups that are interleaved
+    entry by entry, so that the factorization vectorizes across the matrices of
+    a group; all sizes up to 8 and the interior block sizes of the H1
+    elements up to order 8 use size-specialized kernels. Larger matrices are
+    factored one by one with LUFactors::Factor(). With MFEM_USE_LEGACY_OPENMP,
+    the groups are distributed among the threads. */
+void BatchLUFactor(int m, int nb, double *const *data, int *const *ipiv);
+
+/** @brief Compute the LU factorizations of the square matrices @a data[k] of
+    sizes @a sizes[k], see BatchLUFactor(int, int, double *const *, int *const
+    *); the matrices of the same size are factored together. */
+void BatchLUFactor(const Array<int> &sizes, const Array<double*> &data,
+                   const Array<int*> &ipiv);
+
+/** @brief Compute the LU factorizations of all matrices of @a Mlu, see
+    BatchLUFactor(int, int, double *const *, int *const *). */
+/** The pivots of the k-th matrix are stored in @a P, resized to SizeI x SizeK,
+    starting at P[k*SizeI], so that the factors can be used with
+    LUFactors(Mlu.GetData(k), P.GetData() + k*Mlu.SizeI()). */
+void BatchLUFactor(DenseTensor &Mlu, Array<int> &P);
+
+/** @brief Given the output of BatchLUFactor(DenseTensor &, Array<int> &),
+    compute X_k <- A_k^{-1} X_k where X_k is the k-th column of the (SizeI x
+    SizeK) matrix @a X. */
+void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X);
+
+/// Replace all matrices of @a A by their inverses.
+void BatchInverse(DenseTensor &A);
+
 
 // Inline methods
 
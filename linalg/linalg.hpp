@@ -36,6 +36,7 @@
 #ifdef MFEM_USE_MPI
 #include "hypre_parcsr.hpp"
 #include "hypre.hpp"
+#include "psparsemat.hpp"
 
 #ifdef MFEM_USE_PETSC
 #include "petsc.hpp"
@@ -0,0 +1,361 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "psparsemat.hpp"
+
+namespace mfem
+{
+
+ParSparseMatrix::ParSparseMatrix(MPI_Comm comm_, int loc_size, const int *I,
+                                 const long *J, const double *data,
+                                 const Array<int> &nbr_ranks)
+   : Operator(loc_size), comm(comm_)
+{
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+
+   long loc = loc_size;
+   MPI_Scan(&loc, &first_row, 1, MPI_LONG, MPI_SUM, comm);
+   first_row -= loc;
+   MPI_Allreduce(&loc, &glob_size, 1, MPI_LONG, MPI_SUM, comm);
+
+   Init(I, J, data);
+   SetupCommunication(nbr_ranks);
+}
+
+void ParSparseMatrix::Init(const int *I, const long *J, const double *data)
+{
+   const int n = height;
+   const long first = first_row, last = first_row + n;
+
+   // Collect the sorted list of the off-processor columns
+   col_map_offd.SetSize(0);
+   for (int k = 0; k < I[n]; k++)
+   {
+      if (J[k] < first || J[k] >= last) { col_map_offd.Append(J[k]); }
+   }
+   col_map_offd.Sort();
+   col_map_offd.Unique();
+
+   int *d_I = mfem::New<int>(n+1), *o_I = mfem::New<int>(n+1);
+   d_I[0] = o_I[0] = 0;
+   for (int i = 0; i < n; i++)
+   {
+      int d_nnz = 0;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] >= first && J[k] < last) { d_nnz++; }
+      }
+      d_I[i+1] = d_I[i] + d_nnz;
+      o_I[i+1] = o_I[i] + (I[i+1] - I[i] - d_nnz);
+   }
+
+   int *d_J = mfem::New<int>(d_I[n]), *o_J = mfem::New<int>(o_I[n]);
+   double *d_A = mfem::New<double>(d_I[n]), *o_A = mfem::New<double>(o_I[n]);
+   for (int i = 0, d_k = 0, o_k = 0; i < n; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] >= first && J[k] < last)
+         {
+            d_J[d_k] = J[k] - first;
+            d_A[d_k++] = data[k];
+         }
+         else
+         {
+            o_J[o_k] = col_map_offd.FindSorted(J[k]);
+            o_A[o_k++] = data[k];
+         }
+      }
+   }
+
+   SparseMatrix d_mat(d_I, d_J, d_A, n, n);
+   SparseMatrix o_mat(o_I, o_J, o_A, n, col_map_offd.Size());
+   diag.Swap(d_mat);
+   offd.Swap(o_mat);
+}
+
+void ParSparseMatrix::SetupCommunication(const Array<int> &nbr_ranks)
+{
+   // Exchange the row offsets with the neighbors
+   Array<int> nbrs;
+   for (int i = 0; i < nbr_ranks.Size(); i++)
+   {
+      if (nbr_ranks[i] != myid) { nbrs.Append(nbr_ranks[i]); }
+   }
+   nbrs.Sort();
+   nbrs.Unique();
+   const int num_nbrs = nbrs.Size();
+   const long my_rows[2] = { first_row, first_row + height };
+   Array<long> nbr_rows(2*num_nbrs);
+   Array<MPI_Request> setup_requests(2*num_nbrs);
+   for (int i = 0; i < num_nbrs; i++)
+   {
+      MPI_Irecv(&nbr_rows[2*i], 2, MPI_LONG, nbrs[i], 46820, comm,
+                &setup_requests[i]);
+      MPI_Isend((void *) my_rows, 2, MPI_LONG, nbrs[i], 46820, comm,
+                &setup_requests[num_nbrs+i]);
+   }
+   MPI_Waitall(2*num_nbrs, setup_requests.GetData(), MPI_STATUSES_IGNORE);
+
+   // The columns of col_map_offd owned by the same processor are contiguous
+   // since col_map_offd is sorted and the rows are partitioned in the order
+   // of the ranks, which is also the order of nbrs.
+   recv_ranks.SetSize(0);
+   recv_offsets.SetSize(0);
+   Array<int> recv_counts(num_nbrs);
+   recv_counts = 0;
+   for (int j = 0, i = 0; j < col_map_offd.Size(); j++)
+   {
+      while (i < num_nbrs && col_map_offd[j] >= nbr_rows[2*i+1]) { i++; }
+      MFEM_VERIFY(i < num_nbrs && col_map_offd[j] >= nbr_rows[2*i],
+                  "column " << col_map_offd[j] << " is not owned by any of "
+                  "the given neighbors");
+      if (recv_counts[i]++ == 0)
+      {
+         recv_ranks.Append(nbrs[i]);
+         recv_offsets.Append(j);
+      }
+   }
+   recv_offsets.Append(col_map_offd.Size());
+
+   // Tell the neighbors how many of their entries we need
+   Array<int> send_counts(num_nbrs);
+   for (int i = 0; i < num_nbrs; i++)
+   {
+      MPI_Irecv(&send_counts[i], 1, MPI_INT, nbrs[i], 46821, comm,
+                &setup_requests[i]);
+      MPI_Isend(&recv_counts[i], 1, MPI_INT, nbrs[i], 46821, comm,
+                &setup_requests[num_nbrs+i]);
+   }
+   MPI_Waitall(2*num_nbrs, setup_requests.GetData(), MPI_STATUSES_IGNORE);
+
+   send_ranks.SetSize(0);
+   send_offsets.SetSize(0);
+   send_offsets.Append(0);
+   for (int i = 0; i < num_nbrs; i++)
+   {
+      if (send_counts[i] > 0)
+      {
+         send_ranks.Append(nbrs[i]);
+         send_offsets.Append(send_offsets.Last() + send_counts[i]);
+      }
+   }
+
+   // Receive the global indices of the requested entries
+   const int num_send = send_ranks.Size(), num_recv = recv_ranks.Size();
+   const int tag = 46822;
+   Array<long> glob_rows(send_offsets.Last());
+   requests.SetSize(num_send + num_recv);
+   for (int i = 0; i < num_send; i++)
+   {
+      MPI_Irecv(glob_rows.GetData() + send_offsets[i],
+                send_offsets[i+1] - send_offsets[i], MPI_LONG, send_ranks[i],
+                tag, comm, &requests[i]);
+   }
+   for (int i = 0; i < num_recv; i++)
+   {
+      MPI_Isend(col_map_offd.GetData() + recv_offsets[i],
+                recv_offsets[i+1] - recv_offsets[i], MPI_LONG, recv_ranks[i],
+                tag, comm, &requests[num_send+i]);
+   }
+   MPI_Waitall(num_send + num_recv, requests.GetData(), MPI_STATUSES_IGNORE);
+
+   send_rows.SetSize(glob_rows.Size());
+   for (int k = 0; k < glob_rows.Size(); k++)
+   {
+      send_rows[k] = glob_rows[k] - first_row;
+      MFEM_ASSERT(0 <= send_rows[k] && send_rows[k] < height,
+                  "invalid requested row " << glob_rows[k]);
+   }
+
+   send_buf.SetSize(send_rows.Size());
+   x_ext.SetSize(col_map_offd.Size());
+}
+
+void ParSparseMatrix::ExchangeBegin(bool transp) const
+{
+   const int num_send = send_ranks.Size(), num_recv = recv_ranks.Size();
+   const int tag = transp ? 47822 : 46822;
+   MPI_Request *reqs = requests.GetData();
+   for (int i = 0; i < num_recv; i++)
+   {
+      double *buf = x_ext.GetData() + recv_offsets[i];
+      const int size = recv_offsets[i+1] - recv_offsets[i];
+      if (transp)
+      {
+         MPI_Isend(buf, size, MPI_DOUBLE, recv_ranks[i], tag, comm, &reqs[i]);
+      }
+      else
+      {
+         MPI_Irecv(buf, size, MPI_DOUBLE, recv_ranks[i], tag, comm, &reqs[i]);
+      }
+   }
+   for (int i = 0; i < num_send; i++)
+   {
+      double *buf = send_buf.GetData() + send_offsets[i];
+      const int size = send_offsets[i+1] - send_offsets[i];
+      MPI_Request *req = &reqs[num_recv+i];
+      if (transp)
+      {
+         MPI_Irecv(buf, size, MPI_DOUBLE, send_ranks[i], tag, comm, req);
+      }
+      else
+      {
+         MPI_Isend(buf, size, MPI_DOUBLE, send_ranks[i], tag, comm, req);
+      }
+   }
+}
+
+void ParSparseMatrix::ExchangeEnd() const
+{
+   MPI_Waitall(requests.Size(), requests.GetData(), MPI_STATUSES_IGNORE);
+}
+
+long ParSparseMatrix::NNZ() const
+{
+   long loc_nnz = diag.NumNonZeroElems() + offd.NumNonZeroElems(), glob_nnz;
+   MPI_Allreduce(&loc_nnz, &glob_nnz, 1, MPI_LONG, MPI_SUM, comm);
+   return glob_nnz;
+}
+
+void ParSparseMatrix::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == width && y.Size() == height,
+               "invalid input sizes");
+
+   for (int k = 0; k < send_rows.Size(); k++)
+   {
+      send_buf(k) = x(send_rows[k]);
+   }
+   ExchangeBegin(false);
+   diag.Mult(x, y);
+   ExchangeEnd();
+   offd.AddMult(x_ext, y);
+}
+
+void ParSparseMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == height && y.Size() == width,
+               "invalid input sizes");
+
+   offd.MultTranspose(x, x_ext);
+   ExchangeBegin(true);
+   diag.MultTranspose(x, y);
+   ExchangeEnd();
+   for (int k = 0; k < send_rows.Size(); k++)
+   {
+      y(send_rows[k]) += send_buf(k);
+   }
+}
+
+void ParSparseMatrix::EliminateRowsCols(const Array<int> &rows_cols,
+                                        const Vector &X, Vector &B)
+{
+   Vector Xe(height), AXe(height), marker(height);
+   Xe = 0.0;
+   marker = 0.0;
+   for (int i = 0; i < rows_cols.Size(); i++)
+   {
+      const int r = rows_cols[i];
+      Xe(r) = X(r);
+      marker(r) = 1.0;
+   }
+   Mult(Xe, AXe);
+   B -= AXe;
+
+   // Mark the eliminated off-processor columns in x_ext
+   for (int k = 0; k < send_rows.Size(); k++)
+   {
+      send_buf(k) = marker(send_rows[k]);
+   }
+   ExchangeBegin(false);
+   ExchangeEnd();
+
+   const int *d_I = diag.GetI(), *d_J = diag.GetJ();
+   const int *o_I = offd.GetI(), *o_J = offd.GetJ();
+   double *d_A = diag.GetData(), *o_A = offd.GetData();
+   for (int i = 0; i < height; i++)
+   {
+      const bool elim_row = (marker(i) != 0.0);
+      bool diag_found = false;
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         if (elim_row || marker(d_J[k]) != 0.0)
+         {
+            diag_found = diag_found || (d_J[k] == i);
+            d_A[k] = (d_J[k] == i) ? 1.0 : 0.0;
+         }
+      }
+      MFEM_VERIFY(!elim_row || diag_found,
+                  "missing diagonal entry in row " << i);
+      for (int k = o_I[i]; k < o_I[i+1]; k++)
+      {
+         if (elim_row || x_ext(o_J[k]) != 0.0) { o_A[k] = 0.0; }
+      }
+   }
+
+   for (int i = 0; i < rows_cols.Size(); i++)
+   {
+      const int r = rows_cols[i];
+      B(r) = X(r);
+   }
+}
+
+
+void ParDSmoother::SetOperator(const Operator &op)
+{
+   oper = dynamic_cast<const ParSparseMatrix *>(&op);
+   MFEM_VERIFY(oper != NULL, "the operator must be a ParSparseMatrix");
+   height = width = oper->Height();
+
+   oper->GetDiag(dinv);
+   for (int i = 0; i < dinv.Size(); i++)
+   {
+      MFEM_VERIFY(dinv(i) != 0.0, "zero diagonal entry in row " << i);
+      dinv(i) = 1.0/dinv(i);
+   }
+}
+
+void ParDSmoother::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(oper != NULL, "the operator is not set");
+
+   if (!iterative_mode)
+   {
+      y = 0.0;
+   }
+   r.SetSize(height);
+   for (int it = 0; it < iterations; it++)
+   {
+      if (it == 0 && !iterative_mode)
+      {
+         r = x;
+      }
+      else
+      {
+         oper->Mult(y, r);
+         subtract(x, r, r);
+      }
+      for (int i = 0; i < height; i++)
+      {
+         y(i) += scale * dinv(i) * r(i);
+      }
+   }
+}
+
+}
+
+#endif // MFEM_USE_MPI
@@ -0,0 +1,168 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_PSPARSEMAT
+#define MFEM_PSPARSEMAT
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include <mpi.h>
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/** @brief Lightweight distributed sparse matrix that does not depend on hypre.
+
+    The matrix is square and its rows (and the entries of the vectors it acts
+    on) are partitioned in contiguous blocks in the order of the ranks: this
+    processor owns the global rows [FirstRow(), FirstRow()+Height()). The local
+    rows are stored in two SparseMatrix blocks: the "diag" block with the
+    columns owned by this processor, in local numbering, and the "offd" block
+    with the columns owned by other processors, numbered through
+    GetColMapOffd().
+
+    Only the offsets of the neighbor processors are stored, and the setup
+    communicates only with the neighbors given to the constructor, so the
+    memory and the number of messages do not grow with the number of
+    processors. In Mult() the off-processor entries of the input vector are
+    exchanged with point-to-point messages while the diag block is applied.
+    The local products use SparseMatrix::Mult() and SparseMatrix::AddMult()
+    and are threaded when those are. */
+class ParSparseMatrix : public Operator
+{
+protected:
+   MPI_Comm comm;
+   int myid, num_procs;
+
+   /// First global row of this processor and global number of rows.
+   long first_row, glob_size;
+
+   SparseMatrix diag, offd;
+   /// Global column indices of the columns of #offd, sorted.
+   Array<long> col_map_offd;
+
+   /** For each neighbor from which off-processor entries are received: its
+       rank and the range of the entries in #x_ext, see recv_offsets. */
+   Array<int> recv_ranks, recv_offsets;
+   /** For each neighbor to which local entries are sent: its rank and the
+       range of its entries in #send_rows, see send_offsets. */
+   Array<int> send_ranks, send_offsets, send_rows;
+
+   mutable Vector send_buf, x_ext;
+   mutable Array<MPI_Request> requests;
+
+   /// Split the local rows given with global column indices into diag/offd.
+   void Init(const int *I, const long *J, const double *data);
+   /** Set up the exchange of the off-processor entries of the vectors with
+       the neighbors @a nbr_ranks. */
+   void SetupCommunication(const Array<int> &nbr_ranks);
+
+   /** Start sending #send_buf to the processors that need these entries and
+       receiving #x_ext (@a transp = false), or the reverse (@a transp = true),
+       completed by ExchangeEnd(). */
+   void ExchangeBegin(bool transp) const;
+   void ExchangeEnd() const;
+
+private:
+   /// Copy construction is not supported; body is undefined.
+   ParSparseMatrix(const ParSparseMatrix &);
+   /// Copy assignment is not supported; body is undefined.
+   ParSparseMatrix &operator=(const ParSparseMatrix &);
+
+public:
+   /** @brief Construct the matrix from its @a loc_size local rows given in CSR
+       format with global column indices. */
+   /** The local sizes of all processors, in the order of the ranks, define
+       the (row and column) partitioning of the matrix. The input arrays are
+       copied. Repeated column indices in a row are not allowed.
+
+       The array @a nbr_ranks lists the processors this processor exchanges
+       entries with: it must contain the owners of all off-processor columns
+       of the local rows, and the processors with rows that have columns owned
+       by this processor. The relation has to be symmetric, i.e. if q is in
+       the list of p then p is in the list of q; the list may contain more
+       processors than needed. */
+   ParSparseMatrix(MPI_Comm comm, int loc_size, const int *I, const long *J,
+                   const double *data, const Array<int> &nbr_ranks);
+
+   MPI_Comm GetComm() const { return comm; }
+
+   /// Global index of the first row of this processor.
+   long FirstRow() const { return first_row; }
+
+   /// Global number of rows (and columns).
+   long GlobalSize() const { return glob_size; }
+
+   /// The block of the local rows with the columns owned by this processor.
+   SparseMatrix &GetDiag() { return diag; }
+   const SparseMatrix &GetDiag() const { return diag; }
+
+   /// The block of the local rows with the columns owned by other processors.
+   SparseMatrix &GetOffd() { return offd; }
+   const SparseMatrix &GetOffd() const { return offd; }
+
+   /// Global column indices of the columns of GetOffd().
+   const Array<long> &GetColMapOffd() const { return col_map_offd; }
+
+   /// Returns the diagonal of the matrix (the local part).
+   void GetDiag(Vector &d) const { diag.GetDiag(d); }
+
+   /// Global number of nonzero entries, requires global communication.
+   long NNZ() const;
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** @brief Eliminate the local true dofs @a rows_cols from the matrix:
+       @a B -= A X restricted to the other rows, B(rows_cols) = X(rows_cols),
+       and the eliminated rows and columns are set to zero except for a unit
+       diagonal. */
+   void EliminateRowsCols(const Array<int> &rows_cols, const Vector &X,
+                          Vector &B);
+
+   virtual ~ParSparseMatrix() { }
+};
+
+
+/** @brief Damped Jacobi smoother for ParSparseMatrix, y += s D^{-1} (x - A y),
+    applied the given number of iterations. */
+class ParDSmoother : public Solver
+{
+protected:
+   const ParSparseMatrix *oper;
+   double scale;
+   int iterations;
+
+   Vector dinv;
+   mutable Vector r;
+
+public:
+   ParDSmoother(double s = 1.0, int it = 1)
+      : oper(NULL), scale(s), iterations(it) { }
+
+   ParDSmoother(const ParSparseMatrix &A, double s = 1.0, int it = 1)
+      : scale(s), iterations(it) { SetOperator(A); }
+
+   /// Set the operator, which must be a ParSparseMatrix.
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
+}
+
+#endif // MFEM_USE_MPI
+
+#endif
@@ -48,27 +48,23 @@ IterativeSolver::IterativeSolver(MPI_Comm _comm)
 }
 #endif
 
-double IterativeSolver::Dot(const Vector &x, const Vector &y) const
+void IterativeSolver::GlobalSum(double *x, int n) const
 {
-#ifndef MFEM_USE_MPI
-   return (x * y);
-#else
-   if (dot_prod_type == 0)
-   {
-      return (x * y);
-   }
-   else
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
    {
-      double local_dot = (x * y);
-      double global_dot;
-
-      MPI_Allreduce(&local_dot, &global_dot, 1, MPI_DOUBLE, MPI_SUM, comm);
-
-      return global_dot;
+      MPI_Allreduce(MPI_IN_PLACE, x, n, MPI_DOUBLE, MPI_SUM, comm);
    }
 #endif
 }
 
+double IterativeSolver::Dot(const Vector &x, const Vector &y) const
+{
+   double dot = (x * y);
+   GlobalSum(&dot, 1);
+   return dot;
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
 #ifndef MFEM_USE_MPI
@@ -358,17 +354,16 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    for (i = 1; true; )
    {
       alpha = nom/den;
-      add(x,  alpha, d, x);     //  x = x + alpha d
-      add(r, -alpha, z, r);     //  r = r - alpha A d
 
       if (prec)
       {
+         add(r, -alpha, z, r);  //  r = r - alpha A d
          prec->Mult(r, z);      //  z = B r
          betanom = Dot(r, z);
       }
       else
       {
-         betanom = Dot(r, r);
+         betanom = AddAndDot(r, -alpha, z, r); //  r -= alpha A d, (r, r)
       }
       MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
 
@@ -391,23 +386,20 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
          }
          converged = 1;
          final_iter = i;
+         x.Add(alpha, d);       //  x = x + alpha d
          break;
       }
 
       if (++i > max_iter)
       {
+         x.Add(alpha, d);
          break;
       }
 
       beta = betanom/nom;
-      if (prec)
-      {
-         add(z, beta, d, d);   //  d = z + beta d
-      }
-      else
-      {
-         add(r, beta, d, d);
-      }
+      //  x = x + alpha d, then d = z + beta d (d = r + beta d without a
+      //  preconditioner), reading d once
+      d.AddToAndSet(alpha, x, prec ? z : r, beta);
       oper->Mult(d, z);       //  z = A d
       den = Dot(d, z);
       MFEM_ASSERT(IsFinite(den), "den = " << den);
@@ -606,13 +598,16 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
             oper->Mult(*v[i], w);
          }
 
-         for (k = 0; k <= i; k++)
+         // Modified Gram-Schmidt: each update of w is fused with the next
+         // inner product, the last one with the norm of w
+         H(0,i) = Dot(w, *v[0]);     // H(0,i) = w * v[0]
+         for (k = 0; k < i; k++)
          {
-            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
-            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
+            // w -= H(k,i) * v[k], H(k+1,i) = w * v[k+1]
+            H(k+1,i) = AddAndDot(w, -H(k,i), *v[k], *v[k+1]);
          }
-
-         H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
+         // w -= H(i,i) * v[i], H(i+1,i) = ||w||
+         H(i+1,i) = sqrt(AddAndDot(w, -H(i,i), *v[i], w));
          MFEM_ASSERT(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
          if (v[i+1] == NULL) { v[i+1] = new Vector(n); }
          v[i+1]->Set(1.0/H(i+1,i), w); // v[i+1] = w / H(i+1,i)
@@ -952,8 +947,7 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       }
       oper->Mult(phat, v);     //  v = A * phat
       alpha = rho_1 / Dot(rtilde, v);
-      add(r, -alpha, v, s); //  s = r - alpha * v
-      resid = Norm(s);
+      resid = sqrt(SetAndDot(s, 1.0, r, -alpha, v, s)); //  s = r - alpha * v
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
       if (resid < tol_goal)
       {
@@ -978,13 +972,15 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
          shat = s;
       }
       oper->Mult(shat, t);     //  t = A * shat
-      omega = Dot(t, s) / Dot(t, t);
+      const Vector *ts[2] = { &s, &t };
+      double dots[2];
+      Dots(t, 2, ts, dots);    //  (t, s) and (t, t) with one reduction
+      omega = dots[0] / dots[1];
       x.Add(alpha, phat);   //  x += alpha * phat
       x.Add(omega, shat);   //  x += omega * shat
-      add(s, -omega, t, r); //  r = s - omega * t
 
       rho_2 = rho_1;
-      resid = Norm(r);
+      resid = sqrt(SetAndDot(r, 1.0, s, -omega, t, r)); //  r = s - omega * t
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
       if (print_level >= 0)
       {
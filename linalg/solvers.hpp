@@ -48,9 +48,38 @@ protected:
    mutable int final_iter, converged;
    mutable double final_norm;
 
+   /// Sum the @a n local values @a x over 'comm', in place, if global.
+   void GlobalSum(double *x, int n) const;
+
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
 
+   /// v += a x, returns (v, y); see Vector::AddAndDot().
+   double AddAndDot(Vector &v, double a, const Vector &x,
+                    const Vector &y) const
+   {
+      double dot = v.AddAndDot(a, x, y);
+      GlobalSum(&dot, 1);
+      return dot;
+   }
+
+   /// v = a x + b y, returns (v, w); see Vector::SetAndDot().
+   double SetAndDot(Vector &v, double a, const Vector &x, double b,
+                    const Vector &y, const Vector &w) const
+   {
+      double dot = v.SetAndDot(a, x, b, y, w);
+      GlobalSum(&dot, 1);
+      return dot;
+   }
+
+   /// dots[k] = (x, *y[k]) with one global reduction; see Vector::Dots().
+   void Dots(const Vector &x, int n, const Vector *const *y,
+             double *dots) const
+   {
+      x.Dots(n, y, dots);
+      GlobalSum(dots, n);
+   }
+
 public:
    IterativeSolver();
 
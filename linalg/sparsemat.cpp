@@ -2113,6 +2113,78 @@ void SparseMatrix::AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
    }
 }
 
+void SparseMatrix::AddSubMatrices(const Table &elem_dof, const double *elmats,
+                                  const int *elmat_offsets)
+{
+   MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+
+   const int ne = elem_dof.Size();
+   const int *e_I = elem_dof.GetI(), *e_J = elem_dof.GetJ();
+   const int nnz_e = e_I[ne];
+
+   // Transpose of elem_dof: for every row of the matrix, the positions in e_J
+   // where it appears, in increasing order.
+   Array<int> t_I(height+1), t_K(nnz_e), k_elem(nnz_e);
+   t_I = 0;
+   for (int e = 0; e < ne; e++)
+   {
+      for (int k = e_I[e]; k < e_I[e+1]; k++)
+      {
+         const int d = (e_J[k] >= 0) ? e_J[k] : -1-e_J[k];
+         MFEM_VERIFY(d < height, "Trying to insert a row " << d
+                     << " outside the matrix height " << height);
+         t_I[d+1]++;
+         k_elem[k] = e;
+      }
+   }
+   t_I.PartialSum();
+   {
+      Array<int> t_pos;
+      t_I.Copy(t_pos);
+      for (int k = 0; k < nnz_e; k++)
+      {
+         const int d = (e_J[k] >= 0) ? e_J[k] : -1-e_J[k];
+         t_K[t_pos[d]++] = k;
+      }
+   }
+
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel
+#endif
+   {
+      Array<int> col_pos(width);
+      col_pos = -1;
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp for
+#endif
+      for (int i = 0; i < height; i++)
+      {
+         for (int p = I[i]; p < I[i+1]; p++) { col_pos[J[p]] = p; }
+         for (int r = t_I[i]; r < t_I[i+1]; r++)
+         {
+            const int k = t_K[r], e = k_elem[k];
+            const int *dofs = e_J + e_I[e];
+            const int n = e_I[e+1] - e_I[e], li = k - e_I[e];
+            const double *elmat = elmats + elmat_offsets[e];
+            const int s = (dofs[li] >= 0) ? 1 : -1;
+            for (int lj = 0; lj < n; lj++)
+            {
+               int gj = dofs[lj], t = s;
+               if (gj < 0) { gj = -1-gj, t = -s; }
+               MFEM_ASSERT(gj < width, "Trying to insert a column " << gj
+                           << " outside the matrix width " << width);
+               const int p = col_pos[gj];
+               MFEM_ASSERT(p >= 0, "Entry (" << i << "," << gj
+                           << ") is not in the sparsity pattern.");
+               const double a = elmat[li + n*lj];
+               A[p] += (t < 0) ? -a : a;
+            }
+         }
+         for (int p = I[i]; p < I[i+1]; p++) { col_pos[J[p]] = -1; }
+      }
+   }
+}
+
 void SparseMatrix::Set(const int i, const int j, const double A)
 {
    double a = A;
@@ -2530,10 +2602,11 @@ void SparseMatrix::Add(const double a, const SparseMatrix &B)
 SparseMatrix &SparseMatrix::operator=(double a)
 {
    if (Rows == NULL)
-      for (int i = 0, nnz = I[height]; i < nnz; i++)
-      {
-         A[i] = a;
-      }
+   {
+      const int nnz = I[height];
+      DeviceVector d_A(A, nnz);
+      MFEM_FORALL(i, nnz, d_A[i] = a;);
+   }
    else
       for (int i = 0; i < height; i++)
          for (RowNode *node_p = Rows[i]; node_p != NULL;
@@ -407,6 +407,18 @@ public:
    void AddSubMatrix(const Array<int> &rows, const Array<int> &cols,
                      const DenseMatrix &subm, int skip_zeros = 1);
 
+   /** @brief Add the square dense matrices stored at the offsets @a
+       elmat_offsets in @a elmats, with rows and columns given by the rows of
+       @a elem_dof, as AddSubMatrix() with skip_zeros = 0 does for each row of
+       @a elem_dof. */
+   /** The matrix must be finalized and its sparsity pattern must contain all
+       the entries. With MFEM_USE_LEGACY_OPENMP the rows of the matrix are
+       distributed among the threads. The contributions to every entry are
+       added in the order of the rows of @a elem_dof, so the result is the same
+       for any number of threads. */
+   void AddSubMatrices(const Table &elem_dof, const double *elmats,
+                       const int *elmat_offsets);
+
    bool RowIsEmpty(const int row) const;
 
    /// Extract all column indices and values from a given row.
@@ -223,6 +223,124 @@ Vector &Vector::Set(const double a, const Vector &Va)
    return *this;
 }
 
+double Vector::AddAndDot(const double a, const Vector &x, const Vector &y)
+{
+   MFEM_ASSERT(size == x.size && size == y.size, "incompatible Vectors!");
+
+   if (Device::Allows(Backend::CUDA_MASK))
+   {
+      Add(a, x);
+      return (*this) * y;
+   }
+   const double *xp = x.data, *yp = y.data;
+   double *vp = data;
+   const int N = size;
+   double dot = 0.0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for reduction(+:dot) \
+   if (Device::Allows(Backend::OMP_MASK))
+#endif
+   for (int i = 0; i < N; i++)
+   {
+      vp[i] += a * xp[i];
+      dot += vp[i] * yp[i];
+   }
+   return dot;
+}
+
+double Vector::SetAndDot(const double a, const Vector &x, const double b,
+                         const Vector &y, const Vector &w)
+{
+   MFEM_ASSERT(size == x.size && size == y.size && size == w.size,
+               "incompatible Vectors!");
+
+   if (Device::Allows(Backend::CUDA_MASK))
+   {
+      add(a, x, b, y, *this);
+      return (*this) * w;
+   }
+   const double *xp = x.data, *yp = y.data, *wp = w.data;
+   double *vp = data;
+   const int N = size;
+   double dot = 0.0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for reduction(+:dot) \
+   if (Device::Allows(Backend::OMP_MASK))
+#endif
+   for (int i = 0; i < N; i++)
+   {
+      vp[i] = a * xp[i] + b * yp[i];
+      dot += vp[i] * wp[i];
+   }
+   return dot;
+}
+
+void Vector::AddToAndSet(const double a, Vector &y, const Vector &x,
+                         const double b)
+{
+   MFEM_ASSERT(size == x.size && size == y.size, "incompatible Vectors!");
+   MFEM_ASSERT(&x != this && &y != this, "invalid arguments");
+
+   if (Device::Allows(Backend::CUDA_MASK))
+   {
+      y.Add(a, *this);
+      add(x, b, *this, *this);
+      return;
+   }
+   const double *xp = x.data;
+   double *vp = data, *yp = y.data;
+   const int N = size;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for if (Device::Allows(Backend::OMP_MASK))
+#endif
+   for (int i = 0; i < N; i++)
+   {
+      const double vi = vp[i];
+      yp[i] += a * vi;
+      vp[i] = xp[i] + b * vi;
+   }
+}
+
+void Vector::Dots(const int n, const Vector *const *y, double *dots) const
+{
+   if (Device::Allows(Backend::CUDA_MASK))
+   {
+      for (int k = 0; k < n; k++) { dots[k] = (*this) * (*y[k]); }
+      return;
+   }
+   const double *xp = data;
+   const int N = size;
+   // Process the vectors in blocks of four; missing vectors in the last block
+   // are replaced by the first one of the block and their results discarded.
+   for (int k = 0; k < n; k += 4)
+   {
+      const int m = std::min(4, n - k);
+      const double *yp[4];
+      for (int j = 0; j < 4; j++)
+      {
+         const Vector &yj = *y[k + (j < m ? j : 0)];
+         MFEM_ASSERT(yj.size == size, "incompatible Vectors!");
+         yp[j] = yj.data;
+      }
+      const double *y0 = yp[0], *y1 = yp[1], *y2 = yp[2], *y3 = yp[3];
+      double d0 = 0.0, d1 = 0.0, d2 = 0.0, d3 = 0.0;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for reduction(+:d0,d1,d2,d3) \
+      if (Device::Allows(Backend::OMP_MASK))
+#endif
+      for (int i = 0; i < N; i++)
+      {
+         const double xi = xp[i];
+         d0 += xi * y0[i];
+         d1 += xi * y1[i];
+         d2 += xi * y2[i];
+         d3 += xi * y3[i];
+      }
+      const double d[4] = { d0, d1, d2, d3 };
+      for (int j = 0; j < m; j++) { dots[k+j] = d[j]; }
+   }
+}
+
 void Vector::SetVector(const Vector &v, int offset)
 {
    int vs = v.Size();
@@ -939,6 +1057,10 @@ double Min(const int N, const double *x)
 #endif // MFEM_USE_CUDA
    }
    double min = std::numeric_limits<double>::infinity();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for reduction(min:min) \
+   if (Device::Allows(Backend::OMP_MASK))
+#endif
    for (int i = 0; i < N; i++) { min = fmin(min, x[i]); }
    return min;
 }
@@ -954,8 +1076,11 @@ double Dot(const int N, const double *x, const double *y)
 #endif // MFEM_USE_CUDA
    }
    double dot = 0.0;
-#ifdef MFEM_USE_LEGACY_OPENMP
+#if defined(MFEM_USE_LEGACY_OPENMP)
    #pragma omp parallel for reduction(+:dot)
+#elif defined(MFEM_USE_OPENMP)
+   #pragma omp parallel for reduction(+:dot) \
+   if (Device::Allows(Backend::OMP_MASK))
 #endif
    for (int i = 0; i < N; i++) { dot += x[i] * y[i]; }
    return dot;
@@ -199,6 +199,28 @@ public:
    /// (*this) = a * x
    Vector & Set(const double a, const Vector &x);
 
+   /** @brief (*this) += a * x and return the inner product of the updated
+       vector with @a y, in one pass over the data. */
+   /** @a y may be this Vector, in which case its squared norm is returned. */
+   double AddAndDot(const double a, const Vector &x, const Vector &y);
+
+   /** @brief (*this) = a * x + b * y and return the inner product of the
+       updated vector with @a w, in one pass over the data. */
+   /** @a w may be this Vector, in which case its squared norm is returned. */
+   double SetAndDot(const double a, const Vector &x, const double b,
+                    const Vector &y, const Vector &w);
+
+   /** @brief @a y += a * (*this), then (*this) = x + b * (*this), in one pass
+       over the data. */
+   /** This is the update of the solution and of the search direction in CG.
+       Neither @a x nor @a y can be this Vector. */
+   void AddToAndSet(const double a, Vector &y, const Vector &x,
+                    const double b);
+
+   /** @brief Compute the @a n inner products dots[k] = (*this) * (*y[k]),
+       reading this Vector once. */
+   void Dots(const int n, const Vector *const *y, double *dots) const;
+
    void SetVector (const Vector &v, int offset);
 
    /// (*this) = -(*this)
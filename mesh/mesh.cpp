@@ -24,6 +24,8 @@
 #include <cstring>
 #include <ctime>
 #include <functional>
+#include <algorithm>
+#include <vector>
 
 // Include the METIS header, if using version 5. If using METIS 4, the needed
 // declarations are inlined below, i.e. no header is needed.
@@ -331,6 +333,65 @@ FiniteElement *Mesh::GetTransformationFEforElementType(Element::Type ElemType)
    return NULL;
 }
 
+bool Mesh::IsAffineTransformation(const FiniteElement &fe,
+                                  const DenseMatrix &pm)
+{
+   const Geometry::Type geom = fe.GetGeomType();
+   const int dim = Geometry::Dimension[geom];
+   const int nv = Geometry::NumVerts[geom];
+   if (fe.GetOrder() != 1 || fe.GetDof() != nv || pm.Width() != nv ||
+       fe.GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+
+   // The dofs must be located at the reference vertices, in the same order.
+   // Find the vertices at the unit points of the reference axes.
+   const IntegrationRule &nodes = fe.GetNodes();
+   const IntegrationRule &verts = *Geometries.GetVertices(geom);
+   const double tol = 1e-12;
+   int axis[3] = { -1, -1, -1 };
+   double n[3], v[3];
+   for (int j = 0; j < nv; j++)
+   {
+      nodes.IntPoint(j).Get(n, dim);
+      verts.IntPoint(j).Get(v, dim);
+      int nnz = 0, d1 = -1;
+      for (int d = 0; d < dim; d++)
+      {
+         if (std::abs(n[d] - v[d]) > tol) { return false; }
+         if (v[d] != 0.0) { nnz++; d1 = d; }
+      }
+      if (nnz == 1 && v[d1] == 1.0) { axis[d1] = j; }
+   }
+
+   // Compare all vertices with the affine map defined by the vertex 0 (the
+   // origin) and the axis vertices
+   double scale = 0.0;
+   for (int d = 0; d < dim; d++)
+   {
+      MFEM_ASSERT(axis[d] > 0, "invalid reference vertices");
+      for (int k = 0; k < pm.Height(); k++)
+      {
+         scale = std::max(scale, std::abs(pm(k,axis[d]) - pm(k,0)));
+      }
+   }
+   for (int j = 1; j < nv; j++)
+   {
+      verts.IntPoint(j).Get(v, dim);
+      for (int k = 0; k < pm.Height(); k++)
+      {
+         double x = pm(k,0);
+         for (int d = 0; d < dim; d++)
+         {
+            x += v[d]*(pm(k,axis[d]) - pm(k,0));
+         }
+         if (std::abs(pm(k,j) - x) > tol*scale) { return false; }
+      }
+   }
+   return true;
+}
+
 
 void Mesh::GetElementTransformation(int i, IsoparametricTransformation *ElTr)
 {
@@ -359,6 +420,8 @@ void Mesh::GetElementTransformation(int i, IsoparametricTransformation *ElTr)
       ElTr->SetFE(Nodes->FESpace()->GetFE(i));
    }
    ElTr->FinalizeTransformation();
+   ElTr->SetAffine(IsAffineTransformation(*ElTr->GetFE(),
+                                          ElTr->GetPointMat()));
 }
 
 void Mesh::GetElementTransformation(int i, const Vector &nodes,
@@ -400,6 +463,8 @@ void Mesh::GetElementTransformation(int i, const Vector &nodes,
       ElTr->SetFE(Nodes->FESpace()->GetFE(i));
    }
    ElTr->FinalizeTransformation();
+   ElTr->SetAffine(IsAffineTransformation(*ElTr->GetFE(),
+                                          ElTr->GetPointMat()));
 }
 
 ElementTransformation *Mesh::GetElementTransformation(int i)
@@ -512,18 +577,19 @@ void Mesh::GetFaceTransformation(int FaceNo, IsoparametricTransformation *FTr)
          Geometry::Type face_geom = GetFaceGeometryType(FaceNo);
          Element::Type  face_type = GetFaceElementType(FaceNo);
 
+         IntegrationPointTransformation Loc1;
          GetLocalFaceTransformation(face_type,
                                     GetElementType(face_info.Elem1No),
-                                    FaceElemTr.Loc1.Transf, face_info.Elem1Inf);
-         // NOTE: FaceElemTr.Loc1 is overwritten here -- used as a temporary
+                                    Loc1.Transf, face_info.Elem1Inf);
 
          face_el = Nodes->FESpace()->GetTraceElement(face_info.Elem1No,
                                                      face_geom);
 
          IntegrationRule eir(face_el->GetDof());
-         FaceElemTr.Loc1.Transform(face_el->GetNodes(), eir);
-         // 'Transformation' is not used
-         Nodes->GetVectorValues(Transformation, eir, pm);
+         Loc1.Transform(face_el->GetNodes(), eir);
+         IsoparametricTransformation ElTr1;
+         GetElementTransformation(face_info.Elem1No, &ElTr1);
+         Nodes->GetVectorValues(ElTr1, eir, pm);
 
          FTr->SetFE(face_el);
       }
@@ -798,38 +864,47 @@ void Mesh::GetLocalFaceTransformation(
    }
 }
 
-FaceElementTransformations *Mesh::GetFaceElementTransformations(int FaceNo,
-                                                                int mask)
+void Mesh::GetFaceElementTransformations(int FaceNo,
+                                         FaceElementTransformations &FElTr,
+                                         IsoparametricTransformation &ElTr1,
+                                         IsoparametricTransformation &ElTr2,
+                                         IsoparametricTransformation &FTr,
+                                         int mask)
 {
    FaceInfo &face_info = faces_info[FaceNo];
 
-   FaceElemTr.Elem1 = NULL;
-   FaceElemTr.Elem2 = NULL;
+   FElTr.Elem1 = NULL;
+   FElTr.Elem2 = NULL;
 
    // setup the transformation for the first element
-   FaceElemTr.Elem1No = face_info.Elem1No;
+   FElTr.Elem1No = face_info.Elem1No;
    if (mask & 1)
    {
-      GetElementTransformation(FaceElemTr.Elem1No, &Transformation);
-      FaceElemTr.Elem1 = &Transformation;
+      GetElementTransformation(FElTr.Elem1No, &ElTr1);
+      FElTr.Elem1 = &ElTr1;
    }
 
    //  setup the transformation for the second element
    //     return NULL in the Elem2 field if there's no second element, i.e.
    //     the face is on the "boundary"
-   FaceElemTr.Elem2No = face_info.Elem2No;
-   if ((mask & 2) && FaceElemTr.Elem2No >= 0)
+   FElTr.Elem2No = face_info.Elem2No;
+   if ((mask & 2) && FElTr.Elem2No >= 0)
    {
 #ifdef MFEM_DEBUG
       if (NURBSext && (mask & 1)) { MFEM_ABORT("NURBS mesh not supported!"); }
 #endif
-      GetElementTransformation(FaceElemTr.Elem2No, &Transformation2);
-      FaceElemTr.Elem2 = &Transformation2;
+      GetElementTransformation(FElTr.Elem2No, &ElTr2);
+      FElTr.Elem2 = &ElTr2;
    }
 
    // setup the face transformation
-   FaceElemTr.FaceGeom = GetFaceGeometryType(FaceNo);
-   FaceElemTr.Face = (mask & 16) ? GetFaceTransformation(FaceNo) : NULL;
+   FElTr.FaceGeom = GetFaceGeometryType(FaceNo);
+   FElTr.Face = NULL;
+   if (mask & 16)
+   {
+      GetFaceTransformation(FaceNo, &FTr);
+      FElTr.Face = &FTr;
+   }
 
    // setup Loc1 & Loc2
    int face_type = GetFaceElementType(FaceNo);
@@ -837,29 +912,35 @@ FaceElementTransformations *Mesh::GetFaceElementTransformations(int FaceNo,
    {
       int elem_type = GetElementType(face_info.Elem1No);
       GetLocalFaceTransformation(face_type, elem_type,
-                                 FaceElemTr.Loc1.Transf, face_info.Elem1Inf);
+                                 FElTr.Loc1.Transf, face_info.Elem1Inf);
    }
-   if ((mask & 8) && FaceElemTr.Elem2No >= 0)
+   if ((mask & 8) && FElTr.Elem2No >= 0)
    {
       int elem_type = GetElementType(face_info.Elem2No);
       GetLocalFaceTransformation(face_type, elem_type,
-                                 FaceElemTr.Loc2.Transf, face_info.Elem2Inf);
+                                 FElTr.Loc2.Transf, face_info.Elem2Inf);
 
       // NC meshes: prepend slave edge/face transformation to Loc2
       if (Nonconforming() && IsSlaveFace(face_info))
       {
-         ApplyLocalSlaveTransformation(FaceElemTr.Loc2.Transf, face_info);
+         ApplyLocalSlaveTransformation(FElTr.Loc2.Transf, face_info);
 
          if (face_type == Element::SEGMENT)
          {
             // flip Loc2 to match Loc1 and Face
-            DenseMatrix &pm = FaceElemTr.Loc2.Transf.GetPointMat();
+            DenseMatrix &pm = FElTr.Loc2.Transf.GetPointMat();
             std::swap(pm(0,0), pm(0,1));
             std::swap(pm(1,0), pm(1,1));
          }
       }
    }
+}
 
+FaceElementTransformations *Mesh::GetFaceElementTransformations(int FaceNo,
+                                                                int mask)
+{
+   GetFaceElementTransformations(FaceNo, FaceElemTr, Transformation,
+                                 Transformation2, FaceTransformation, mask);
    return &FaceElemTr;
 }
 
@@ -871,20 +952,18 @@ bool Mesh::IsSlaveFace(const FaceInfo &fi) const
 void Mesh::ApplyLocalSlaveTransformation(IsoparametricTransformation &transf,
                                          const FaceInfo &fi)
 {
-#ifdef MFEM_THREAD_SAFE
    DenseMatrix composition;
-#else
-   static DenseMatrix composition;
-#endif
    MFEM_ASSERT(fi.NCFace >= 0, "");
    transf.Transform(*nc_faces_info[fi.NCFace].PointMatrix, composition);
    transf.GetPointMat() = composition;
    transf.FinalizeTransformation();
 }
 
-FaceElementTransformations *Mesh::GetBdrFaceTransformations(int BdrElemNo)
+bool Mesh::GetBdrFaceTransformations(int BdrElemNo,
+                                     FaceElementTransformations &FElTr,
+                                     IsoparametricTransformation &ElTr1,
+                                     IsoparametricTransformation &FTr)
 {
-   FaceElementTransformations *tr;
    int fn;
    if (Dim == 3)
    {
@@ -900,12 +979,23 @@ FaceElementTransformations *Mesh::GetBdrFaceTransformations(int BdrElemNo)
    }
    // Check if the face is interior, shared, or non-conforming.
    if (FaceIsTrueInterior(fn) || faces_info[fn].NCFace >= 0)
+   {
+      return false;
+   }
+   // there is no second element, the 'ElTr1' argument is not used for it
+   GetFaceElementTransformations(fn, FElTr, ElTr1, ElTr1, FTr, 1|4|16);
+   FElTr.Face->Attribute = boundary[BdrElemNo]->GetAttribute();
+   return true;
+}
+
+FaceElementTransformations *Mesh::GetBdrFaceTransformations(int BdrElemNo)
+{
+   if (!GetBdrFaceTransformations(BdrElemNo, FaceElemTr, Transformation,
+                                  FaceTransformation))
    {
       return NULL;
    }
-   tr = GetFaceElementTransformations(fn);
-   tr->Face->Attribute = boundary[BdrElemNo]->GetAttribute();
-   return tr;
+   return &FaceElemTr;
 }
 
 void Mesh::GetFaceElements(int Face, int *Elem1, int *Elem2) const
@@ -1034,6 +1124,115 @@ void Mesh::DeleteLazyTables()
    delete edge_vertex;  edge_vertex = NULL;
 }
 
+void Mesh::FreeConnectivityTables()
+{
+   if (NURBSext) { return; }
+
+   DeleteLazyTables();
+   if (Dim > 1)
+   {
+      // NumOfEdges is kept; be_to_edge (2D) is small and used by the boundary
+      // face transformations, so it is kept too.
+      delete el_to_edge;   el_to_edge = NULL;
+      delete bel_to_edge;  bel_to_edge = NULL;
+   }
+   if (Dim == 3 && !ncmesh)
+   {
+      // In non-conforming meshes the faces are numbered through the NCMesh.
+      delete el_to_face;   el_to_face = NULL;
+   }
+}
+
+void Mesh::RestoreConnectivityTables() const
+{
+   // The tables are rebuilt with the algorithms used to generate them, so the
+   // numbering of the edges and faces does not change.
+   Mesh *mesh = const_cast<Mesh *>(this);
+   if (Dim > 1 && NumOfEdges > 0 && el_to_edge == NULL)
+   {
+      mesh->el_to_edge = new Table;
+      mesh->NumOfEdges = mesh->GetElementToEdgeTable(*mesh->el_to_edge,
+                                                     mesh->be_to_edge);
+   }
+   if (Dim == 3 && NumOfFaces > 0 && el_to_face == NULL && !ncmesh)
+   {
+      mesh->GetElementToFaceTable();
+   }
+}
+
+long Mesh::ElementsMemoryUsage(const Array<Element *> &elems)
+{
+   long mem = elems.MemoryUsage();
+   for (int i = 0; i < elems.Size(); i++)
+   {
+      if (!elems[i]) { continue; }
+      switch (elems[i]->GetType())
+      {
+         case Element::POINT:         mem += sizeof(Point); break;
+         case Element::SEGMENT:       mem += sizeof(Segment); break;
+         case Element::TRIANGLE:      mem += sizeof(Triangle); break;
+         case Element::QUADRILATERAL: mem += sizeof(Quadrilateral); break;
+         case Element::TETRAHEDRON:   mem += sizeof(Tetrahedron); break;
+         case Element::HEXAHEDRON:    mem += sizeof(Hexahedron); break;
+         case Element::WEDGE:         mem += sizeof(Wedge); break;
+      }
+   }
+   return mem;
+}
+
+long Mesh::TableMemoryUsage(const Table *table)
+{
+   return table ? table->MemoryUsage() + (long) sizeof(Table) : 0;
+}
+
+long Mesh::MemoryUsage() const
+{
+   return ElementsMemoryUsage(elements) +
+          vertices.MemoryUsage() +
+          ElementsMemoryUsage(boundary) +
+          ElementsMemoryUsage(faces) +
+          faces_info.MemoryUsage() +
+          nc_faces_info.MemoryUsage() +
+          TableMemoryUsage(el_to_edge) +
+          TableMemoryUsage(el_to_face) +
+          TableMemoryUsage(el_to_el) +
+          be_to_edge.MemoryUsage() +
+          TableMemoryUsage(bel_to_edge) +
+          be_to_face.MemoryUsage() +
+          TableMemoryUsage(face_edge) +
+          TableMemoryUsage(edge_vertex) +
+          attributes.MemoryUsage() +
+          bdr_attributes.MemoryUsage() +
+          ((Nodes && own_nodes) ? Nodes->Size()*(long) sizeof(double) : 0) +
+          (ncmesh ? ncmesh->MemoryUsage() : 0) +
+          sizeof(*this);
+}
+
+void Mesh::PrintMemoryDetail(std::ostream &out) const
+{
+   out << ElementsMemoryUsage(elements) << " elements\n"
+       << vertices.MemoryUsage() << " vertices\n"
+       << ElementsMemoryUsage(boundary) << " boundary\n"
+       << ElementsMemoryUsage(faces) << " faces\n"
+       << faces_info.MemoryUsage() << " faces_info\n"
+       << nc_faces_info.MemoryUsage() << " nc_faces_info\n"
+       << TableMemoryUsage(el_to_edge) << " el_to_edge\n"
+       << TableMemoryUsage(el_to_face) << " el_to_face\n"
+       << TableMemoryUsage(el_to_el) << " el_to_el\n"
+       << be_to_edge.MemoryUsage() << " be_to_edge\n"
+       << TableMemoryUsage(bel_to_edge) << " bel_to_edge\n"
+       << be_to_face.MemoryUsage() << " be_to_face\n"
+       << TableMemoryUsage(face_edge) << " face_edge\n"
+       << TableMemoryUsage(edge_vertex) << " edge_vertex\n"
+       << attributes.MemoryUsage() + bdr_attributes.MemoryUsage()
+       << " attributes\n"
+       << ((Nodes && own_nodes) ? Nodes->Size()*(long) sizeof(double) : 0)
+       << " nodes\n"
+       << (ncmesh ? ncmesh->MemoryUsage() : 0) << " ncmesh\n"
+       << sizeof(*this) << " Mesh\n"
+       << MemoryUsage() << " total" << std::endl;
+}
+
 void Mesh::SetAttributes()
 {
    Array<int> attribs;
@@ -1350,6 +1549,172 @@ void Mesh::GetGeckoElementReordering(Array<int> &ordering,
 }
 #endif
 
+// Hilbert index of the point with integer coordinates X[0..dim-1] of 'bits'
+// bits each, see J. Skilling, "Programming the Hilbert curve", AIP Conference
+// Proceedings 707 (2004), 381-387. X is overwritten.
+static unsigned long long HilbertIndex(unsigned *X, int dim, int bits)
+{
+   const unsigned M = 1u << (bits-1);
+
+   // inverse undo excess work
+   for (unsigned Q = M; Q > 1; Q >>= 1)
+   {
+      const unsigned P = Q - 1;
+      for (int i = 0; i < dim; i++)
+      {
+         if (X[i] & Q) { X[0] ^= P; }
+         else
+         {
+            const unsigned t = (X[0] ^ X[i]) & P;
+            X[0] ^= t;
+            X[i] ^= t;
+         }
+      }
+   }
+
+   // Gray encode
+   for (int i = 1; i < dim; i++) { X[i] ^= X[i-1]; }
+   unsigned t = 0;
+   for (unsigned Q = M; Q > 1; Q >>= 1)
+   {
+      if (X[dim-1] & Q) { t ^= Q - 1; }
+   }
+   for (int i = 0; i < dim; i++) { X[i] ^= t; }
+
+   // interleave the bits of the transposed index
+   unsigned long long index = 0;
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int i = 0; i < dim; i++)
+      {
+         index = (index << 1) | ((X[i] >> b) & 1u);
+      }
+   }
+   return index;
+}
+
+// Morton (Z-order) index: interleave the bits of the coordinates.
+static unsigned long long MortonIndex(const unsigned *X, int dim, int bits)
+{
+   unsigned long long index = 0;
+   for (int b = bits-1; b >= 0; b--)
+   {
+      for (int i = 0; i < dim; i++)
+      {
+         index = (index << 1) | ((X[i] >> b) & 1u);
+      }
+   }
+   return index;
+}
+
+// Order the elements by the Hilbert or Morton index of their centers.
+static void GetSFCElementOrdering(Mesh &mesh, bool hilbert,
+                                  Array<int> &ordering)
+{
+   const int NE = mesh.GetNE(), sdim = mesh.SpaceDimension();
+   const int bits = (sdim > 1) ? 63 / sdim : 32; // fit in 64 bits
+
+   DenseMatrix centers(sdim, NE);
+   Vector min(sdim), max(sdim), center;
+   min = infinity();
+   max = -infinity();
+   for (int i = 0; i < NE; i++)
+   {
+      centers.GetColumnReference(i, center);
+      mesh.GetElementTransformation(i)->Transform(
+         Geometries.GetCenter(mesh.GetElementBaseGeometry(i)), center);
+      for (int d = 0; d < sdim; d++)
+      {
+         min(d) = std::min(min(d), center(d));
+         max(d) = std::max(max(d), center(d));
+      }
+   }
+
+   // quantize the centers to the integer grid [0, 2^bits)
+   const double scale = (double) ((1ull << bits) - 1);
+   std::vector<std::pair<unsigned long long, int> > index(NE);
+   unsigned X[3];
+   for (int i = 0; i < NE; i++)
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         double ext = max(d) - min(d);
+         double x = (ext > 0.0) ? (centers(d, i) - min(d)) / ext : 0.0;
+         X[d] = (unsigned) (x * scale);
+      }
+      // (in 1D both curves reduce to sorting by the coordinate)
+      if (hilbert && sdim > 1) { index[i].first = HilbertIndex(X, sdim, bits); }
+      else { index[i].first = MortonIndex(X, sdim, bits); }
+      index[i].second = i;
+   }
+   std::sort(index.begin(), index.end());
+
+   ordering.SetSize(NE);
+   for (int i = 0; i < NE; i++)
+   {
+      ordering[index[i].second] = i;
+   }
+}
+
+void Mesh::GetHilbertElementOrdering(Array<int> &ordering)
+{
+   GetSFCElementOrdering(*this, true, ordering);
+}
+
+void Mesh::GetMortonElementOrdering(Array<int> &ordering)
+{
+   GetSFCElementOrdering(*this, false, ordering);
+}
+
+void Mesh::GetRCMElementOrdering(Array<int> &ordering)
+{
+   ReverseCuthillMcKee(ElementToElementTable(), ordering);
+}
+
+void Mesh::GetElementOrdering(ElementOrdering method, Array<int> &ordering)
+{
+   switch (method)
+   {
+      case NATIVE_ORDERING:
+         ordering.SetSize(GetNE());
+         for (int i = 0; i < GetNE(); i++) { ordering[i] = i; }
+         break;
+      case HILBERT_ORDERING: GetHilbertElementOrdering(ordering); break;
+      case MORTON_ORDERING: GetMortonElementOrdering(ordering); break;
+      case RCM_ORDERING: GetRCMElementOrdering(ordering); break;
+      default: MFEM_ABORT("invalid element ordering method: " << method);
+   }
+}
+
+void Mesh::GetElementOrderingStats(int &bandwidth, long &cache_misses)
+{
+   const Table &el_to_el = ElementToElementTable();
+   bandwidth = 0;
+   for (int i = 0; i < GetNE(); i++)
+   {
+      const int *row = el_to_el.GetRow(i), n = el_to_el.RowSize(i);
+      for (int j = 0; j < n; j++)
+      {
+         bandwidth = std::max(bandwidth, std::abs(row[j] - i));
+      }
+   }
+
+   Table el_to_vert;
+   el_to_vert.MakeI(GetNE());
+   for (int i = 0; i < GetNE(); i++)
+   {
+      el_to_vert.AddColumnsInRow(i, elements[i]->GetNVertices());
+   }
+   el_to_vert.MakeJ();
+   for (int i = 0; i < GetNE(); i++)
+   {
+      el_to_vert.AddConnections(i, elements[i]->GetVertices(),
+                                elements[i]->GetNVertices());
+   }
+   el_to_vert.ShiftUpI();
+
+   cache_misses = CountCacheMisses(el_to_vert, sizeof(Vertex));
+}
 
 void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
 {
@@ -1502,6 +1867,32 @@ void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
 }
 
 
+void Mesh::ReorderElementsForLocality(ElementOrdering method,
+                                      std::ostream *report)
+{
+   if (method == NATIVE_ORDERING || NURBSext || ncmesh) { return; }
+
+   int bw_before, bw_after;
+   long cm_before, cm_after;
+   if (report) { GetElementOrderingStats(bw_before, cm_before); }
+
+   Array<int> ordering;
+   GetElementOrdering(method, ordering);
+   ReorderElements(ordering);
+
+   if (report)
+   {
+      GetElementOrderingStats(bw_after, cm_after);
+
+      const char *name[] = { "native", "Hilbert", "Morton", "RCM" };
+      *report << "Element reordering (" << name[method] << "), "
+              << GetNE() << " elements:\n"
+              << "   bandwidth:          " << bw_before << " -> " << bw_after
+              << "\n   est. cache misses:  " << cm_before << " -> " << cm_after
+              << std::endl;
+   }
+}
+
 void Mesh::MarkForRefinement()
 {
    if (meshgen & 1)
@@ -1650,6 +2041,9 @@ void Mesh::PrepareNodeReorder(DSTable **old_v_to_v, Table **old_elem_vert)
 
 void Mesh::DoNodeReorder(DSTable *old_v_to_v, Table *old_elem_vert)
 {
+   // the tables below are updated only if they exist
+   RestoreConnectivityTables();
+
    FiniteElementSpace *fes = Nodes->FESpace();
    const FiniteElementCollection *fec = fes->FEColl();
    Array<int> old_dofs, new_dofs;
@@ -2086,6 +2480,11 @@ void Mesh::Finalize(bool refine, bool fix_orientation)
    DSTable *old_v_to_v = NULL;
    Table *old_elem_vert = NULL;
 
+   if (may_change_topology)
+   {
+      RestoreConnectivityTables();
+   }
+
    if (curved && may_change_topology)
    {
       PrepareNodeReorder(&old_v_to_v, &old_elem_vert);
@@ -3428,6 +3827,8 @@ void Mesh::DegreeElevate(int rel_degree, int degree)
 
 void Mesh::UpdateNURBS()
 {
+   RestoreConnectivityTables();
+
    NURBSext->SetKnotsFromPatches();
 
    Dim = NURBSext->Dimension();
@@ -3873,6 +4274,8 @@ int Mesh::GetQuadOrientation(const int *base, const int *test)
 
 int Mesh::CheckBdrElementOrientation(bool fix_it)
 {
+   RestoreConnectivityTables();
+
    int wo = 0; // count wrong orientations
 
    if (Dim == 2)
@@ -4008,6 +4411,7 @@ void Mesh::GetGeometries(int dim, Array<Geometry::Type> &el_geoms) const
 
 void Mesh::GetElementEdges(int i, Array<int> &edges, Array<int> &cor) const
 {
+   RestoreConnectivityTables();
    if (el_to_edge)
    {
       el_to_edge->GetRow(i, edges);
@@ -4040,6 +4444,7 @@ void Mesh::GetBdrElementEdges(int i, Array<int> &edges, Array<int> &cor) const
    }
    else if (Dim == 3)
    {
+      RestoreConnectivityTables();
       if (bel_to_edge)
       {
          bel_to_edge->GetRow(i, edges);
@@ -4227,6 +4632,7 @@ const
 {
    int n, j;
 
+   RestoreConnectivityTables();
    if (el_to_face)
    {
       el_to_face->GetRow(i, fcs);
@@ -4496,6 +4902,7 @@ const Table & Mesh::ElementToElementTable()
 
 const Table & Mesh::ElementToFaceTable() const
 {
+   RestoreConnectivityTables();
    if (el_to_face == NULL)
    {
       mfem_error("Mesh::ElementToFaceTable()");
@@ -4505,6 +4912,7 @@ const Table & Mesh::ElementToFaceTable() const
 
 const Table & Mesh::ElementToEdgeTable() const
 {
+   RestoreConnectivityTables();
    if (el_to_edge == NULL)
    {
       mfem_error("Mesh::ElementToEdgeTable()");
@@ -4888,6 +5296,8 @@ void Mesh::ReorientTetMesh()
       return;
    }
 
+   RestoreConnectivityTables();
+
    DSTable *old_v_to_v = NULL;
    Table *old_elem_vert = NULL;
 
@@ -6608,12 +7018,20 @@ void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
    Array<int> v;
 
    DeleteLazyTables();
+   // el_to_edge and el_to_face are updated below only if they exist
+   RestoreConnectivityTables();
 
    if (ncmesh)
    {
       MFEM_ABORT("Local and nonconforming refinements cannot be mixed.");
    }
 
+   // A negative type indicates uniform refinement, see UniformRefinement()
+   if (type < 0)
+   {
+      type = -type;
+   }
+
    InitRefinementTransforms();
 
    if (Dim == 1) // --------------------------------------------------------
@@ -7110,11 +7528,13 @@ void Mesh::GetElementData(const Array<Element*> &elem_array, int geom,
 
 void Mesh::UniformRefinement(int ref_algo)
 {
+   RestoreConnectivityTables();
+
    if (NURBSext)
    {
       NURBSUniformRefinement();
    }
-   else if (ref_algo == 0 && Dim == 3 && meshgen == 1)
+   else if (ref_algo == 0 && Dim == 3 && meshgen == 1 && !ncmesh)
    {
       UniformRefinement3D();
    }
@@ -7128,9 +7548,9 @@ void Mesh::UniformRefinement(int ref_algo)
 
       if (Conforming())
       {
-         // In parallel we should set the default 2nd argument to -3 to indicate
-         // uniform refinement.
-         LocalRefinement(elem_to_refine);
+         // The negative type indicates uniform refinement, which allows
+         // ParMesh to skip the parallel conformity iterations.
+         LocalRefinement(elem_to_refine, -3);
       }
       else
       {
@@ -7151,12 +7571,15 @@ void Mesh::UniformRefinement(int ref_algo)
 void Mesh::GeneralRefinement(const Array<Refinement> &refinements,
                              int nonconforming, int nc_limit)
 {
+   RestoreConnectivityTables();
+
    if (ncmesh)
    {
       nonconforming = 1;
    }
-   else if (Dim == 1 || (Dim == 3 && (meshgen & 1)))
+   else if (Dim == 1 || (Dim == 3 && (meshgen & 1) && nonconforming < 1))
    {
+      // tetrahedral meshes are only refined nonconformingly on request
       nonconforming = 0;
    }
    else if (nonconforming < 0)
@@ -7216,15 +7639,17 @@ void Mesh::GeneralRefinement(const Array<int> &el_to_refine, int nonconforming,
    GeneralRefinement(refinements, nonconforming, nc_limit);
 }
 
-void Mesh::EnsureNCMesh(bool triangles_nonconforming)
+void Mesh::EnsureNCMesh(bool simplices_nonconforming)
 {
    MFEM_VERIFY(!NURBSext, "Cannot convert a NURBS mesh to an NC mesh. "
                "Project the NURBS to Nodes first.");
 
+   RestoreConnectivityTables();
+
    if (!ncmesh)
    {
       if ((meshgen & 2) /* quads/hexes */ ||
-          (triangles_nonconforming && Dim == 2 && (meshgen & 1)))
+          (simplices_nonconforming && (meshgen & 1))) /* triangles/tets */
       {
          MFEM_VERIFY(GetNumGeometries(Dim) <= 1,
                      "mixed meshes are not supported");
@@ -9196,6 +9621,8 @@ void Mesh::RemoveUnusedVertices()
 {
    if (NURBSext || ncmesh) { return; }
 
+   RestoreConnectivityTables();
+
    Array<int> v2v(GetNV());
    v2v = -1;
    for (int i = 0; i < GetNE(); i++)
@@ -9303,6 +9730,8 @@ void Mesh::RemoveInternalBoundaries()
 {
    if (NURBSext || ncmesh) { return; }
 
+   RestoreConnectivityTables();
+
    int num_bdr_elem = 0;
    int new_bel_to_edge_nnz = 0;
    for (int i = 0; i < GetNBE(); i++)
@@ -182,6 +182,21 @@ public:
    // (true) is set in mesh_readers.cpp.
    static bool remove_unused_vertices;
 
+   /// Methods for computing a cache-friendly element ordering.
+   enum ElementOrdering
+   {
+      NATIVE_ORDERING,  ///< keep the current order of the elements
+      HILBERT_ORDERING, ///< Hilbert curve through the element centers
+      MORTON_ORDERING,  ///< Morton (Z-order) curve through the element centers
+      RCM_ORDERING      ///< reverse Cuthill-McKee on the face-neighbor graph
+   };
+
+   // Global parameters that can be used to reorder the elements of meshes
+   // read by Load(), see ReorderElementsForLocality(). The default values
+   // (NATIVE_ORDERING, false) are set in mesh_readers.cpp.
+   static ElementOrdering load_element_ordering;
+   static bool report_load_ordering;
+
 protected:
    Operation last_operation;
 
@@ -193,6 +208,16 @@ protected:
    void DestroyPointers(); // Delete data specifically allocated by class Mesh.
    void Destroy();         // Delete all owned data.
    void DeleteLazyTables();
+   /** @brief Rebuild the tables deleted by FreeConnectivityTables(), if
+       needed. */
+   /** Methods that update these tables only when they exist must call this
+       first. The rebuild is not thread-safe. */
+   void RestoreConnectivityTables() const;
+
+   /// Memory used by the array @a elems and the elements it points to.
+   static long ElementsMemoryUsage(const Array<Element *> &elems);
+   /// Memory used by the (possibly NULL) @a table.
+   static long TableMemoryUsage(const Table *table);
 
    Element *ReadElementWithoutAttr(std::istream &);
    static void PrintElementWithoutAttr(const Element *, std::ostream &);
@@ -295,7 +320,8 @@ protected:
    /// Refine NURBS mesh.
    virtual void NURBSUniformRefinement();
 
-   /// This function is not public anymore. Use GeneralRefinement instead.
+   /** This function is not public anymore. Use GeneralRefinement instead. A
+       negative @a type indicates that all elements are marked. */
    virtual void LocalRefinement(const Array<int> &marked_el, int type = 3);
 
    /// This function is not public anymore. Use GeneralRefinement instead.
@@ -570,11 +596,43 @@ public:
                                   int period = 1, int seed = 0);
 #endif
 
+   /** Find an element ordering along the Hilbert space-filling curve through
+       the element centers. Unlike GetGeckoElementReordering, this does not
+       require an external library. The output can be used in ReorderElements.
+       @param[out] ordering Output element ordering. */
+   void GetHilbertElementOrdering(Array<int> &ordering);
+
+   /** Find an element ordering along the Morton (Z-order) curve through the
+       element centers. The output can be used in ReorderElements.
+       @param[out] ordering Output element ordering. */
+   void GetMortonElementOrdering(Array<int> &ordering);
+
+   /** Find a reverse Cuthill-McKee ordering of the element face-neighbor
+       graph, which reduces the bandwidth of the element-to-element matrix.
+       The output can be used in ReorderElements.
+       @param[out] ordering Output element ordering. */
+   void GetRCMElementOrdering(Array<int> &ordering);
+
+   /// Compute an element ordering with one of the above methods.
+   void GetElementOrdering(ElementOrdering method, Array<int> &ordering);
+
+   /** Return the bandwidth of the element face-neighbor graph and an estimate
+       of the number of cache misses when the vertex coordinates are gathered
+       element by element (see CountCacheMisses). */
+   void GetElementOrderingStats(int &bandwidth, long &cache_misses);
+
    /** Rebuilds the mesh with a different order of elements.  The ordering
        vector maps the old element number to the new element number.  This also
        reorders the vertices and nodes edges and faces along with the elements. */
    void ReorderElements(const Array<int> &ordering, bool reorder_vertices = true);
 
+   /** Reorder the elements (and vertices) of the mesh with the given method,
+       see GetElementOrdering. If @a report is not NULL, the bandwidth and the
+       estimated cache misses before and after the reordering are printed to
+       it. Non-conforming and NURBS meshes are left unchanged. */
+   void ReorderElementsForLocality(ElementOrdering method,
+                                   std::ostream *report = NULL);
+
    /** Creates mesh for the parallelepiped [0,sx]x[0,sy]x[0,sz], divided into
        nx*ny*nz hexahedra if type=HEXAHEDRON or into 6*nx*ny*nz tetrahedrons if
        type=TETRAHEDRON. If sfc_ordering = true (default), elements are ordered
@@ -647,6 +705,11 @@ public:
    {
       Loader(input, generate_edges);
       Finalize(refine, fix_orientation);
+      if (load_element_ordering != NATIVE_ORDERING)
+      {
+         ReorderElementsForLocality(load_element_ordering,
+                                    report_load_ordering ? &mfem::out : NULL);
+      }
    }
 
    /// Clear the contents of the Mesh.
@@ -855,8 +918,19 @@ public:
 
    static FiniteElement *GetTransformationFEforElementType(Element::Type);
 
+   /** @brief Return true if the transformation defined by the element @a fe
+       and the point matrix @a pm (space-dim x dof) has a constant Jacobian. */
+   /** Only transformations whose dofs are the vertices of the reference
+       element are detected: straight-sided simplices, parallelograms,
+       parallelepipeds and prisms with parallel triangular faces. */
+   static bool IsAffineTransformation(const FiniteElement &fe,
+                                      const DenseMatrix &pm);
+
    /** Builds the transformation defining the i-th element in the user-defined
-       variable. */
+       variable. This method is reentrant, see the reentrant version of
+       GetFaceElementTransformations(). Affine elements are flagged with
+       ElementTransformation::SetAffine(), so that their Jacobian is computed
+       only once. */
    void GetElementTransformation(int i, IsoparametricTransformation *ElTr);
 
    /// Returns the transformation defining the i-th element
@@ -925,6 +999,21 @@ public:
    FaceElementTransformations *GetFaceElementTransformations(int FaceNo,
                                                              int mask = 31);
 
+   /** @brief Reentrant version of GetFaceElementTransformations(int, int):
+       fills the caller-owned structure @a FElTr, with its fields Elem1, Elem2
+       and Face pointing to @a ElTr1, @a ElTr2 and @a FTr, respectively. */
+   /** Unlike the method returning a pointer, this method does not use the
+       transformation objects stored in the Mesh, so it can be called
+       concurrently (e.g. by different threads) with different arguments, as
+       long as the Mesh is not modified and the MFEM_THREAD_SAFE option is
+       enabled. */
+   void GetFaceElementTransformations(int FaceNo,
+                                      FaceElementTransformations &FElTr,
+                                      IsoparametricTransformation &ElTr1,
+                                      IsoparametricTransformation &ElTr2,
+                                      IsoparametricTransformation &FTr,
+                                      int mask = 31);
+
    FaceElementTransformations *GetInteriorFaceTransformations (int FaceNo)
    {
       if (faces_info[FaceNo].Elem2No < 0) { return NULL; }
@@ -933,6 +1022,16 @@ public:
 
    FaceElementTransformations *GetBdrFaceTransformations (int BdrElemNo);
 
+   /** @brief Reentrant version of GetBdrFaceTransformations(int), using the
+       caller-owned transformations @a FElTr, @a ElTr1 and @a FTr, see the
+       reentrant GetFaceElementTransformations(). Returns false (and leaves
+       @a FElTr unchanged) in the cases when the pointer version returns
+       NULL. */
+   bool GetBdrFaceTransformations(int BdrElemNo,
+                                  FaceElementTransformations &FElTr,
+                                  IsoparametricTransformation &ElTr1,
+                                  IsoparametricTransformation &FTr);
+
    /// Return true if the given face is interior. @sa FaceIsTrueInterior().
    bool FaceIsInterior(int FaceNo) const
    {
@@ -1062,9 +1161,10 @@ public:
    /** Refine selected mesh elements. Refinement type can be specified for each
        element. The function can do conforming refinement of triangles and
        tetrahedra and non-conforming refinement (i.e., with hanging-nodes) of
-       triangles, quadrilaterals and hexahedra. If 'nonconforming' = -1,
-       suitable refinement method is selected automatically (namely, conforming
-       refinement for triangles). Use nonconforming = 0/1 to force the method.
+       triangles, quadrilaterals, tetrahedra and hexahedra. If 'nonconforming'
+       = -1, suitable refinement method is selected automatically (namely,
+       conforming refinement for triangles and tetrahedra). Use nonconforming =
+       0/1 to force the method.
        For nonconforming refinements, nc_limit optionally specifies the maximum
        level of hanging nodes (unlimited by default). */
    void GeneralRefinement(const Array<Refinement> &refinements,
@@ -1113,9 +1213,9 @@ public:
    ///@}
 
    /** Make sure that a quad/hex mesh is considered to be non-conforming (i.e.,
-       has an associated NCMesh object). Triangles meshes can be both conforming
-       (default) or non-conforming. */
-   void EnsureNCMesh(bool triangles_nonconforming = false);
+       has an associated NCMesh object). Triangle and tetrahedral meshes can be
+       both conforming (default) or non-conforming. */
+   void EnsureNCMesh(bool simplices_nonconforming = false);
 
    bool Conforming() const { return ncmesh == NULL; }
    bool Nonconforming() const { return ncmesh != NULL; }
@@ -1222,6 +1322,31 @@ public:
       PrintCharacteristics(NULL, NULL, out);
    }
 
+   /** @brief Return the approximate memory used by the mesh in bytes, not
+       including the finite element space of the nodes. */
+   virtual long MemoryUsage() const;
+
+   /// Print the memory used by the components of the mesh, in bytes.
+   virtual void PrintMemoryDetail(std::ostream &out = mfem::out) const;
+
+   /** @brief Free the element-to-edge, boundary-to-edge and (in conforming 3D
+       meshes) element-to-face tables, and the tables constructed on demand:
+       element-to-element, face-to-edge and edge-to-vertex. */
+   /** These tables are needed to construct finite element spaces and to modify
+       the mesh, but not to assemble or apply operators on existing spaces.
+       They are rebuilt, with the same edge and face numbering, by the methods
+       that need them: the element edge/face queries such as GetElementEdges()
+       and ElementToEdgeTable(), the refinement methods, Finalize() and the
+       other methods changing the topology. The faces and the face information
+       used by face integrators are kept. The vertex-to-element table is not
+       stored in the mesh, see GetVertexToElementTable().
+
+       The rebuild modifies the mesh even when called from a const method, so
+       after this call the const queries above are not thread-safe until the
+       tables are rebuilt, e.g. by calling ElementToEdgeTable() before starting
+       the threads. */
+   void FreeConnectivityTables();
+
    void MesquiteSmooth(const int mesquite_option = 0);
 
    /** @brief Find the ids of the elements that contain the given points, and
@@ -26,6 +26,8 @@ namespace mfem
 {
 
 bool Mesh::remove_unused_vertices = true;
+Mesh::ElementOrdering Mesh::load_element_ordering = Mesh::NATIVE_ORDERING;
+bool Mesh::report_load_ordering = false;
 
 void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
 {
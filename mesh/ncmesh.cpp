@@ -150,6 +150,7 @@ NCMesh::GeomInfo NCMesh::GI[Geometry::NumGeom];
 NCMesh::GeomInfo& NCMesh::gi_hex  = NCMesh::GI[Geometry::CUBE];
 NCMesh::GeomInfo& NCMesh::gi_quad = NCMesh::GI[Geometry::SQUARE];
 NCMesh::GeomInfo& NCMesh::gi_tri  = NCMesh::GI[Geometry::TRIANGLE];
+NCMesh::GeomInfo& NCMesh::gi_tet  = NCMesh::GI[Geometry::TETRAHEDRON];
 
 void NCMesh::GeomInfo::Initialize(const mfem::Element* elem)
 {
@@ -172,6 +173,9 @@ void NCMesh::GeomInfo::Initialize(const mfem::Element* elem)
       {
          faces[i][j] = elem->GetFaceVertices(i)[j];
       }
+      // triangular faces: the fourth face vertex points to the unused (-1)
+      // node[7] of the element, so faces can be hashed as (a, b, c, -1)
+      if (nfv == 3) { faces[i][3] = 7; }
    }
 
    // in 2D we pretend to have faces too, so we can use Face::elem[2]
@@ -197,6 +201,7 @@ NCMesh::NCMesh(const Mesh *mesh, std::istream *vertex_parents)
 
    // assume the mesh is anisotropic if we're loading a file
    Iso = vertex_parents ? false : true;
+   auto_compact = true;
 
    // examine elements and reserve the first node IDs for vertices
    // (note: 'mesh' may not have vertices defined yet, e.g., on load)
@@ -241,9 +246,11 @@ NCMesh::NCMesh(const Mesh *mesh, std::istream *vertex_parents)
       Geometry::Type geom = elem->GetGeometryType();
       if (geom != Geometry::TRIANGLE &&
           geom != Geometry::SQUARE &&
-          geom != Geometry::CUBE)
+          geom != Geometry::CUBE &&
+          geom != Geometry::TETRAHEDRON)
       {
-         MFEM_ABORT("only triangles, quads and hexes are supported by NCMesh.");
+         MFEM_ABORT("only triangles, quads, tets and hexes are supported by "
+                    "NCMesh.");
       }
 
       // initialize edge/face tables for this type of element
@@ -280,6 +287,12 @@ NCMesh::NCMesh(const Mesh *mesh, std::istream *vertex_parents)
          MFEM_VERIFY(face, "boundary face not found.");
          face->attribute = be->GetAttribute();
       }
+      else if (be->GetType() == mfem::Element::TRIANGLE)
+      {
+         Face* face = faces.Find(v[0], v[1], v[2], -1);
+         MFEM_VERIFY(face, "boundary face not found.");
+         face->attribute = be->GetAttribute();
+      }
       else if (be->GetType() == mfem::Element::SEGMENT)
       {
          Face* face = faces.Find(v[0], v[0], v[1], v[1]);
@@ -288,7 +301,7 @@ NCMesh::NCMesh(const Mesh *mesh, std::istream *vertex_parents)
       }
       else
       {
-         MFEM_ABORT("only segment and quadrilateral boundary "
+         MFEM_ABORT("only segment, triangle and quadrilateral boundary "
                     "elements are supported by NCMesh.");
       }
    }
@@ -305,6 +318,7 @@ NCMesh::NCMesh(const NCMesh &other)
    : Dim(other.Dim)
    , spaceDim(other.spaceDim)
    , Iso(other.Iso)
+   , auto_compact(other.auto_compact)
    , nodes(other.nodes)
    , faces(other.faces)
    , elements(other.elements)
@@ -591,6 +605,29 @@ int NCMesh::NewHexahedron(int n0, int n1, int n2, int n3,
    return new_id;
 }
 
+int NCMesh::NewTetrahedron(int n0, int n1, int n2, int n3, int attr,
+                           int fattr0, int fattr1, int fattr2, int fattr3)
+{
+   // create new unrefined element, initialize nodes
+   int new_id = AddElement(Element(Geometry::TETRAHEDRON, attr));
+   Element &el = elements[new_id];
+
+   el.node[0] = n0, el.node[1] = n1, el.node[2] = n2, el.node[3] = n3;
+
+   // get faces and assign face attributes
+   Face* f[4];
+   for (int i = 0; i < gi_tet.nf; i++)
+   {
+      const int* fv = gi_tet.faces[i];
+      f[i] = faces.Get(el.node[fv[0]], el.node[fv[1]], el.node[fv[2]], -1);
+   }
+
+   f[0]->attribute = fattr0,  f[1]->attribute = fattr1;
+   f[2]->attribute = fattr2,  f[3]->attribute = fattr3;
+
+   return new_id;
+}
+
 int NCMesh::NewQuadrilateral(int n0, int n1, int n2, int n3,
                              int attr,
                              int eattr0, int eattr1, int eattr2, int eattr3)
@@ -1161,6 +1198,44 @@ void NCMesh::RefineElement(int elem, char ref_type)
       child[2] = NewTriangle(mid20, mid12, no[2], attr, -1, fa[1], fa[2]);
       child[3] = NewTriangle(mid01, mid12, mid20, attr, -1, -1, -1);
    }
+   else if (el.geom == Geometry::TETRAHEDRON)
+   {
+      ref_type = 7; // for consistence
+
+      // isotropic (red) split into 4 corner tets and 4 tets filling the inner
+      // octahedron, which is always cut along its mid02-mid13 diagonal; the
+      // faces are numbered so that face 'i' is opposite to vertex 'i'
+      int mid01 = GetMidEdgeNode(no[0], no[1]);
+      int mid02 = GetMidEdgeNode(no[0], no[2]);
+      int mid03 = GetMidEdgeNode(no[0], no[3]);
+      int mid12 = GetMidEdgeNode(no[1], no[2]);
+      int mid13 = GetMidEdgeNode(no[1], no[3]);
+      int mid23 = GetMidEdgeNode(no[2], no[3]);
+
+      child[0] = NewTetrahedron(no[0], mid01, mid02, mid03, attr,
+                                -1, fa[1], fa[2], fa[3]);
+
+      child[1] = NewTetrahedron(mid01, no[1], mid12, mid13, attr,
+                                fa[0], -1, fa[2], fa[3]);
+
+      child[2] = NewTetrahedron(mid02, mid12, no[2], mid23, attr,
+                                fa[0], fa[1], -1, fa[3]);
+
+      child[3] = NewTetrahedron(mid03, mid13, mid23, no[3], attr,
+                                fa[0], fa[1], fa[2], -1);
+
+      child[4] = NewTetrahedron(mid01, mid02, mid03, mid13, attr,
+                                -1, fa[2], -1, -1);
+
+      child[5] = NewTetrahedron(mid12, mid02, mid01, mid13, attr,
+                                -1, -1, -1, fa[3]);
+
+      child[6] = NewTetrahedron(mid02, mid03, mid13, mid23, attr,
+                                -1, -1, fa[1], -1);
+
+      child[7] = NewTetrahedron(mid13, mid12, mid02, mid23, attr,
+                                -1, -1, fa[0], -1);
+   }
    else
    {
       MFEM_ABORT("Unsupported element geometry.");
@@ -1282,6 +1357,7 @@ int NCMesh::RetrieveNode(const Element &el, int index)
          break;
 
       case Geometry::TRIANGLE:
+      case Geometry::TETRAHEDRON:
          ch = el.child[index];
          break;
 
@@ -1310,6 +1386,10 @@ void NCMesh::DerefineElement(int elem)
       }
    }
 
+   // 'node' shares memory with 'child', clear the unused node slots (the
+   // fourth face node of a tetrahedron is expected to be -1)
+   for (int i = 0; i < 8; i++) { el.node[i] = -1; }
+
    // retrieve original corner nodes and face attributes from the children
    int fa[6];
    if (el.geom == Geometry::CUBE)
@@ -1353,6 +1433,22 @@ void NCMesh::DerefineElement(int elem)
                             ch.node[fv[2]], ch.node[fv[3]])->attribute;
       }
    }
+   else if (el.geom == Geometry::TETRAHEDRON)
+   {
+      for (int i = 0; i < 4; i++)
+      {
+         Element& ch = elements[child[i]];
+         el.node[i] = ch.node[i];
+      }
+      // child 0 touches parent faces 1, 2, 3; child 1 touches face 0
+      for (int i = 0; i < 4; i++)
+      {
+         Element& ch = elements[child[i ? 0 : 1]];
+         const int* fv = gi_tet.faces[i];
+         fa[i] = faces.Find(ch.node[fv[0]], ch.node[fv[1]],
+                            ch.node[fv[2]], -1)->attribute;
+      }
+   }
    else
    {
       MFEM_ABORT("Unsupported element geometry.");
@@ -1496,6 +1592,8 @@ void NCMesh::Derefine(const Array<int> &derefs)
    {
       transforms.embeddings[i].parent = elements[fine_coarse[i]].index;
    }
+
+   AutoCompact();
 }
 
 void NCMesh::InitDerefTransforms()
@@ -1722,6 +1820,7 @@ mfem::Element* NCMesh::NewMeshElement(int geom) const
       case Geometry::CUBE: return new mfem::Hexahedron;
       case Geometry::SQUARE: return new mfem::Quadrilateral;
       case Geometry::TRIANGLE: return new mfem::Triangle;
+      case Geometry::TETRAHEDRON: return new mfem::Tetrahedron;
    }
    MFEM_ABORT("invalid geometry");
    return NULL;
@@ -1816,6 +1915,16 @@ void NCMesh::GetMeshComponents(Array<mfem::Vertex>& mvertices,
                }
                mboundary.Append(quad);
             }
+            else if (nc_elem.geom == Geometry::TETRAHEDRON)
+            {
+               Triangle* tri = new Triangle;
+               tri->SetAttribute(face->attribute);
+               for (int j = 0; j < 3; j++)
+               {
+                  tri->GetVertices()[j] = nodes[node[fv[j]]].vert_index;
+               }
+               mboundary.Append(tri);
+            }
             else
             {
                Segment* segment = new Segment;
@@ -1852,9 +1961,17 @@ void NCMesh::OnMeshUpdated(Mesh *mesh)
       Face* face;
       if (Dim == 3)
       {
-         MFEM_ASSERT(mesh->GetFace(i)->GetNVertices() == 4, "");
-         face = faces.Find(vertex_nodeId[fv[0]], vertex_nodeId[fv[1]],
-                           vertex_nodeId[fv[2]], vertex_nodeId[fv[3]]);
+         if (mesh->GetFace(i)->GetNVertices() == 3) // triangular face
+         {
+            face = faces.Find(vertex_nodeId[fv[0]], vertex_nodeId[fv[1]],
+                              vertex_nodeId[fv[2]], -1);
+         }
+         else
+         {
+            MFEM_ASSERT(mesh->GetFace(i)->GetNVertices() == 4, "");
+            face = faces.Find(vertex_nodeId[fv[0]], vertex_nodeId[fv[1]],
+                              vertex_nodeId[fv[2]], vertex_nodeId[fv[3]]);
+         }
       }
       else
       {
@@ -1943,17 +2060,18 @@ int NCMesh::find_element_edge(const Element &el, int vn0, int vn1)
    return -1;
 }
 
-int NCMesh::find_hex_face(int a, int b, int c)
+int NCMesh::find_local_face(int geom, int a, int b, int c)
 {
-   for (int i = 0; i < 6; i++)
+   GeomInfo &gi = GI[geom];
+   for (int i = 0; i < gi.nf; i++)
    {
-      const int* fv = gi_hex.faces[i];
-      if ((a == fv[0] || a == fv[1] || a == fv[2] || a == fv[3]) &&
-          (b == fv[0] || b == fv[1] || b == fv[2] || b == fv[3]) &&
-          (c == fv[0] || c == fv[1] || c == fv[2] || c == fv[3]))
+      const int* fv = gi.faces[i];
+      int found = 0;
+      for (int j = 0; j < gi.nfv; j++)
       {
-         return i;
+         if (a == fv[j] || b == fv[j] || c == fv[j]) { found++; }
       }
+      if (found == 3) { return i; }
    }
    MFEM_ABORT("Face not found.");
    return -1;
@@ -1965,17 +2083,18 @@ int NCMesh::ReorderFacePointMat(int v0, int v1, int v2, int v3,
    const Element &el = elements[elem];
    int master[4] =
    {
-      find_node(el, v0), find_node(el, v1),
-      find_node(el, v2), find_node(el, v3)
+      find_node(el, v0), find_node(el, v1), find_node(el, v2),
+      (v3 >= 0) ? find_node(el, v3) : -1
    };
+   int nfv = (v3 >= 0) ? 4 : 3;
 
-   int local = find_hex_face(master[0], master[1], master[2]);
-   const int* fv = gi_hex.faces[local];
+   int local = find_local_face(el.geom, master[0], master[1], master[2]);
+   const int* fv = GI[(int) el.geom].faces[local];
 
    DenseMatrix tmp(mat);
-   for (int i = 0, j; i < 4; i++)
+   for (int i = 0, j; i < nfv; i++)
    {
-      for (j = 0; j < 4; j++)
+      for (j = 0; j < nfv; j++)
       {
          if (fv[i] == master[j])
          {
@@ -1987,7 +2106,7 @@ int NCMesh::ReorderFacePointMat(int v0, int v1, int v2, int v3,
             break;
          }
       }
-      MFEM_ASSERT(j != 4, "node not found.");
+      MFEM_ASSERT(j != nfv, "node not found.");
    }
    return local;
 }
@@ -2041,6 +2160,65 @@ void NCMesh::TraverseFace(int vn0, int vn1, int vn2, int vn3,
    }
 }
 
+bool NCMesh::TriFaceSplit(int v1, int v2, int v3, int mid[3]) const
+{
+   int e1 = nodes.FindId(v1, v2);
+   if (e1 < 0 || !nodes[e1].HasVertex()) { return false; }
+
+   int e2 = nodes.FindId(v2, v3);
+   if (e2 < 0 || !nodes[e2].HasVertex()) { return false; }
+
+   int e3 = nodes.FindId(v3, v1);
+   if (e3 < 0 || !nodes[e3].HasVertex()) { return false; }
+
+   if (mid) { mid[0] = e1, mid[1] = e2, mid[2] = e3; }
+
+   // NOTE: triangular faces are always split isotropically into four parts
+   return true;
+}
+
+void NCMesh::TraverseTriFace(int vn0, int vn1, int vn2,
+                             const PointMatrix& pm, int level)
+{
+   if (level > 0)
+   {
+      // check if we made it to a face that is not split further
+      Face* fa = faces.Find(vn0, vn1, vn2, -1);
+      if (fa)
+      {
+         // we have a slave face, add it to the list
+         int elem = fa->GetSingleElement();
+         face_list.slaves.push_back(Slave(fa->index, elem, -1));
+         DenseMatrix &mat = face_list.slaves.back().point_matrix;
+         pm.GetMatrix(mat);
+
+         // reorder the point matrix according to slave face orientation
+         int local = ReorderFacePointMat(vn0, vn1, vn2, -1, elem, mat);
+         face_list.slaves.back().local = local;
+
+         return;
+      }
+   }
+
+   int mid[3];
+   if (TriFaceSplit(vn0, vn1, vn2, mid))
+   {
+      Point mid01(pm(0), pm(1)), mid12(pm(1), pm(2)), mid20(pm(2), pm(0));
+
+      TraverseTriFace(vn0, mid[0], mid[2],
+                      PointMatrix(pm(0), mid01, mid20), level+1);
+
+      TraverseTriFace(mid[0], vn1, mid[1],
+                      PointMatrix(mid01, pm(1), mid12), level+1);
+
+      TraverseTriFace(mid[2], mid[1], vn2,
+                      PointMatrix(mid20, mid12, pm(2)), level+1);
+
+      TraverseTriFace(mid[0], mid[1], mid[2],
+                      PointMatrix(mid01, mid12, mid20), level+1);
+   }
+}
+
 void NCMesh::BuildFaceList()
 {
    face_list.Clear();
@@ -2086,12 +2264,19 @@ void NCMesh::BuildFaceList()
          }
          else
          {
-            PointMatrix pm(Point(0,0), Point(1,0), Point(1,1), Point(0,1));
-
             // this is either a master face or a slave face, but we can't
             // tell until we traverse the face refinement 'tree'...
             int sb = face_list.slaves.size();
-            TraverseFace(node[0], node[1], node[2], node[3], pm, 0);
+            if (gi.nfv == 4)
+            {
+               PointMatrix pm(Point(0,0), Point(1,0), Point(1,1), Point(0,1));
+               TraverseFace(node[0], node[1], node[2], node[3], pm, 0);
+            }
+            else
+            {
+               PointMatrix pm(Point(0,0), Point(1,0), Point(0,1));
+               TraverseTriFace(node[0], node[1], node[2], pm, 0);
+            }
 
             int se = face_list.slaves.size();
             if (sb < se)
@@ -2419,6 +2604,28 @@ void NCMesh::CollectFaceVertices(int v0, int v1, int v2, int v3,
    }
 }
 
+void NCMesh::CollectTriFaceVertices(int v0, int v1, int v2, Array<int> &indices)
+{
+   int mid[3];
+   if (TriFaceSplit(v0, v1, v2, mid))
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         indices.Append(mid[i]);
+      }
+
+      // vertices hanging on the interior edges of the split face
+      CollectEdgeVertices(mid[0], mid[1], indices);
+      CollectEdgeVertices(mid[1], mid[2], indices);
+      CollectEdgeVertices(mid[2], mid[0], indices);
+
+      CollectTriFaceVertices(v0, mid[0], mid[2], indices);
+      CollectTriFaceVertices(mid[0], v1, mid[1], indices);
+      CollectTriFaceVertices(mid[2], mid[1], v2, indices);
+      CollectTriFaceVertices(mid[0], mid[1], mid[2], indices);
+   }
+}
+
 void NCMesh::BuildElementToVertexTable()
 {
    int nrows = leaf_elements.Size();
@@ -2450,8 +2657,16 @@ void NCMesh::BuildElementToVertexTable()
          for (int j = 0; j < gi.nf; j++)
          {
             const int* fv = gi.faces[j];
-            CollectFaceVertices(node[fv[0]], node[fv[1]],
-                                node[fv[2]], node[fv[3]], indices);
+            if (gi.nfv == 4)
+            {
+               CollectFaceVertices(node[fv[0]], node[fv[1]],
+                                   node[fv[2]], node[fv[3]], indices);
+            }
+            else
+            {
+               CollectTriFaceVertices(node[fv[0]], node[fv[1]], node[fv[2]],
+                                      indices);
+            }
          }
       }
 
@@ -2757,6 +2972,9 @@ NCMesh::PointMatrix NCMesh::pm_tri_identity(
 NCMesh::PointMatrix NCMesh::pm_quad_identity(
    Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)
 );
+NCMesh::PointMatrix NCMesh::pm_tet_identity(
+   Point(0, 0, 0), Point(1, 0, 0), Point(0, 1, 0), Point(0, 0, 1)
+);
 NCMesh::PointMatrix NCMesh::pm_hex_identity(
    Point(0, 0, 0), Point(1, 0, 0), Point(1, 1, 0), Point(0, 1, 0),
    Point(0, 0, 1), Point(1, 0, 1), Point(1, 1, 1), Point(0, 1, 1)
@@ -2768,6 +2986,7 @@ const NCMesh::PointMatrix& NCMesh::GetGeomIdentity(int geom)
    {
       case Geometry::TRIANGLE: return pm_tri_identity;
       case Geometry::SQUARE:   return pm_quad_identity;
+      case Geometry::TETRAHEDRON: return pm_tet_identity;
       case Geometry::CUBE:     return pm_hex_identity;
       default:
          MFEM_ABORT("unsupported geometry.");
@@ -3060,6 +3279,45 @@ void NCMesh::GetPointMatrix(int geom, const char* ref_path, DenseMatrix& matrix)
             pm = PointMatrix(mid01, mid12, mid20);
          }
       }
+      else if (geom == Geometry::TETRAHEDRON)
+      {
+         Point mid01(pm(0), pm(1)), mid02(pm(0), pm(2)), mid03(pm(0), pm(3));
+         Point mid12(pm(1), pm(2)), mid13(pm(1), pm(3)), mid23(pm(2), pm(3));
+
+         // see RefineElement for the child numbering
+         if (child == 0)
+         {
+            pm = PointMatrix(pm(0), mid01, mid02, mid03);
+         }
+         else if (child == 1)
+         {
+            pm = PointMatrix(mid01, pm(1), mid12, mid13);
+         }
+         else if (child == 2)
+         {
+            pm = PointMatrix(mid02, mid12, pm(2), mid23);
+         }
+         else if (child == 3)
+         {
+            pm = PointMatrix(mid03, mid13, mid23, pm(3));
+         }
+         else if (child == 4)
+         {
+            pm = PointMatrix(mid01, mid02, mid03, mid13);
+         }
+         else if (child == 5)
+         {
+            pm = PointMatrix(mid12, mid02, mid01, mid13);
+         }
+         else if (child == 6)
+         {
+            pm = PointMatrix(mid02, mid03, mid13, mid23);
+         }
+         else if (child == 7)
+         {
+            pm = PointMatrix(mid13, mid12, mid02, mid23);
+         }
+      }
    }
 
    // write the points to the matrix
@@ -3516,16 +3774,21 @@ void NCMesh::GetFaceVerticesEdges(const MeshId &face_id,
                                   int edge_orientation[4]) const
 {
    const Element &el = elements[face_id.element];
-   const int* fv = GI[(int) el.geom].faces[face_id.local];
+   const GeomInfo &gi = GI[(int) el.geom];
+   const int* fv = gi.faces[face_id.local];
+   const int nfv = gi.nfv;
 
-   for (int i = 0; i < 4; i++)
+   vert_index[3] = edge_index[3] = -1;
+   edge_orientation[3] = 0;
+
+   for (int i = 0; i < nfv; i++)
    {
       vert_index[i] = nodes[el.node[fv[i]]].vert_index;
    }
 
-   for (int i = 0; i < 4; i++)
+   for (int i = 0; i < nfv; i++)
    {
-      int j = (i+1) & 0x3;
+      int j = (i+1) % nfv;
       int n1 = el.node[fv[i]];
       int n2 = el.node[fv[j]];
 
@@ -3602,11 +3865,13 @@ void NCMesh::FindFaceNodes(int face, int node[4])
    MFEM_ASSERT(elem >= 0, "Face has no elements?");
 
    Element &el = elements[elem];
-   int f = find_hex_face(find_node(el, fa.p1),
-                         find_node(el, fa.p2),
-                         find_node(el, fa.p3));
+   int f = find_local_face(el.geom,
+                           find_node(el, fa.p1),
+                           find_node(el, fa.p2),
+                           find_node(el, fa.p3));
 
-   const int* fv = GI[Geometry::CUBE].faces[f];
+   // NOTE: node[3] == -1 for triangular faces
+   const int* fv = GI[(int) el.geom].faces[f];
    for (int i = 0; i < 4; i++)
    {
       node[i] = el.node[fv[i]];
@@ -3630,12 +3895,13 @@ void NCMesh::GetBoundaryClosure(const Array<int> &bdr_attr_is_ess,
          {
             int node[4];
             FindFaceNodes(face, node);
+            int nfv = (node[3] < 0) ? 3 : 4;
 
-            for (int j = 0; j < 4; j++)
+            for (int j = 0; j < nfv; j++)
             {
                bdr_vertices.Append(nodes[node[j]].vert_index);
 
-               int enode = nodes.FindId(node[j], node[(j+1) % 4]);
+               int enode = nodes.FindId(node[j], node[(j+1) % nfv]);
                MFEM_ASSERT(enode >= 0 && nodes[enode].HasEdge(), "Edge not found.");
                bdr_edges.Append(nodes[enode].edge_index);
 
@@ -3754,6 +4020,15 @@ void NCMesh::CountSplits(int elem, int splits[3]) const
       splits[0] = std::max(elevel[0], std::max(elevel[1], elevel[2]));
       splits[1] = splits[0];
    }
+   else if (el.geom == Geometry::TETRAHEDRON)
+   {
+      // tets are only refined isotropically and all their edges are split,
+      // so the faces cannot be split deeper than the edges
+      splits[0] = std::max(std::max(elevel[0], elevel[1]),
+                           std::max(std::max(elevel[2], elevel[3]),
+                                    std::max(elevel[4], elevel[5])));
+      splits[1] = splits[2] = splits[0];
+   }
    else
    {
       MFEM_ABORT("Unsupported element geometry.");
@@ -3937,6 +4212,35 @@ void NCMesh::CopyElements(int elem,
    }
 }
 
+int NCMesh::ReorderElements(Array<int> &index_map)
+{
+   BlockArray<Element> tmp_elements;
+   elements.Swap(tmp_elements);
+   free_element_ids.SetSize(0);
+
+   index_map.SetSize(tmp_elements.Size());
+   index_map = -1;
+
+   // copy roots, they need to be at the beginning of 'elements'
+   int root_count = 0;
+   for (elem_iterator el = tmp_elements.begin(); el != tmp_elements.end(); ++el)
+   {
+      if (el->parent == -1)
+      {
+         int new_id = elements.Append(*el); // same as AddElement()
+         index_map[el.index()] = new_id;
+         root_count++;
+      }
+   }
+
+   // copy the rest of the hierarchy
+   for (int i = 0; i < root_count; i++)
+   {
+      CopyElements(i, tmp_elements, index_map);
+   }
+   return root_count;
+}
+
 void NCMesh::LoadCoarseElements(std::istream &input)
 {
    int ne;
@@ -3982,31 +4286,9 @@ void NCMesh::LoadCoarseElements(std::istream &input)
       }
    }
 
-   // prepare for reordering the elements
-   BlockArray<Element> tmp_elements;
-   elements.Swap(tmp_elements);
-   free_element_ids.SetSize(0);
-
-   Array<int> index_map(tmp_elements.Size());
-   index_map = -1;
-
-   // copy roots, they need to be at the beginning of 'elements'
-   int root_count = 0;
-   for (elem_iterator el = tmp_elements.begin(); el != tmp_elements.end(); ++el)
-   {
-      if (el->parent == -1)
-      {
-         int new_id = elements.Append(*el); // same as AddElement()
-         index_map[el.index()] = new_id;
-         root_count++;
-      }
-   }
-
-   // copy the rest of the hierarchy
-   for (int i = 0; i < root_count; i++)
-   {
-      CopyElements(i, tmp_elements, index_map);
-   }
+   // reorder the elements, the roots need to be at the beginning
+   Array<int> index_map;
+   int root_count = ReorderElements(index_map);
 
    // we also need to renumber element links in Face::elem[]
    for (face_iterator face = faces.begin(); face != faces.end(); ++face)
@@ -4029,6 +4311,190 @@ void NCMesh::LoadCoarseElements(std::istream &input)
    Update();
 }
 
+// return a power of two hash table size for 'n' items (fill factor 2)
+static int compact_hash_size(int n)
+{
+   int size = 1024;
+   while (2*size < n) { size *= 2; }
+   return size;
+}
+
+void NCMesh::Compact()
+{
+   // 1. elements: roots first, then their descendants depth-first
+   Array<int> elem_map;
+   int root_count = ReorderElements(elem_map);
+   MFEM_VERIFY(root_count == root_state.Size(), "invalid refinement tree.");
+
+   // 2. node order: top-level nodes first (normally keeping their IDs), the
+   //    rest are numbered as they are first used by the leaf elements
+   Array<int> node_map(nodes.NumIds()), node_order;
+   node_map = -1;
+   node_order.Reserve(nodes.Size());
+
+   for (node_iterator node = nodes.begin(); node != nodes.end(); ++node)
+   {
+      if (node->p1 == node->p2)
+      {
+         node_map[node.index()] = node_order.Size();
+         node_order.Append(node.index());
+      }
+   }
+   for (elem_iterator el = elements.begin(); el != elements.end(); ++el)
+   {
+      if (el->ref_type) { continue; }
+
+      GeomInfo &gi = GI[(int) el->geom];
+      for (int i = 0; i < gi.nv + gi.ne; i++)
+      {
+         int node;
+         if (i < gi.nv)
+         {
+            node = el->node[i];
+         }
+         else
+         {
+            const int* ev = gi.edges[i - gi.nv];
+            node = nodes.FindId(el->node[ev[0]], el->node[ev[1]]);
+         }
+         if (node >= 0 && node_map[node] < 0)
+         {
+            node_map[node] = node_order.Size();
+            node_order.Append(node);
+         }
+      }
+   }
+   for (node_iterator node = nodes.begin(); node != nodes.end(); ++node)
+   {
+      if (node_map[node.index()] < 0) // e.g., edge nodes with alt. parents
+      {
+         node_map[node.index()] = node_order.Size();
+         node_order.Append(node.index());
+      }
+   }
+
+   // 3. rebuild the faces in the order they are first used by the leaves
+   HashTable<Face> new_faces(16*1024, compact_hash_size(faces.Size()));
+   Array<int> face_map(faces.NumIds());
+   face_map = -1;
+
+   for (elem_iterator el = elements.begin(); el != elements.end(); ++el)
+   {
+      if (el->ref_type) { continue; }
+
+      GeomInfo &gi = GI[(int) el->geom];
+      for (int i = 0; i < gi.nf; i++)
+      {
+         int fn[4];
+         for (int k = 0; k < 4; k++)
+         {
+            fn[k] = el->node[gi.faces[i][k]];
+         }
+
+         int face = faces.FindId(fn[0], fn[1], fn[2], fn[3]);
+         MFEM_ASSERT(face >= 0, "face not found.");
+         if (face_map[face] >= 0) { continue; }
+
+         for (int k = 0; k < 4; k++)
+         {
+            if (fn[k] >= 0) { fn[k] = node_map[fn[k]]; }
+         }
+
+         int new_id = new_faces.GetId(fn[0], fn[1], fn[2], fn[3]);
+         face_map[face] = new_id;
+
+         const Face &fa = faces[face];
+         Face &nf = new_faces[new_id];
+         nf.attribute = fa.attribute;
+         nf.index = fa.index;
+         for (int k = 0; k < 2; k++)
+         {
+            nf.elem[k] = (fa.elem[k] >= 0) ? elem_map[fa.elem[k]] : -1;
+         }
+      }
+   }
+   MFEM_VERIFY(new_faces.Size() == faces.Size(), "unreachable faces found.");
+   faces.Swap(new_faces);
+
+   // 4. rebuild the nodes, reparenting them according to 'node_map'
+   HashTable<Node> new_nodes(16*1024, compact_hash_size(nodes.Size()));
+   for (int i = 0; i < node_order.Size(); i++)
+   {
+      Node &nd = nodes[node_order[i]];
+
+      int p1 = nd.p1, p2 = nd.p2;
+      if (p1 != p2) // top-level nodes are hashed by their vertex numbers
+      {
+         p1 = node_map[p1];
+         p2 = node_map[p2];
+         MFEM_ASSERT(p1 >= 0 && p2 >= 0, "node parent not found.");
+      }
+
+      int new_id = new_nodes.GetId(p1, p2);
+      MFEM_ASSERT(new_id == i, "");
+
+      Node &nn = new_nodes[new_id];
+      nn.vert_refc = nd.vert_refc;
+      nn.edge_refc = nd.edge_refc;
+      nn.vert_index = nd.vert_index;
+      nn.edge_index = nd.edge_index;
+
+      nd.vert_refc = nd.edge_refc = 0; // the old node is discarded
+   }
+   nodes.Swap(new_nodes);
+
+   // 5. update node IDs in the leaf elements and the vertex map
+   for (elem_iterator el = elements.begin(); el != elements.end(); ++el)
+   {
+      if (el->ref_type) { continue; }
+
+      GeomInfo &gi = GI[(int) el->geom];
+      for (int i = 0; i < gi.nv; i++)
+      {
+         el->node[i] = node_map[el->node[i]];
+      }
+   }
+   for (int i = 0; i < vertex_nodeId.Size(); i++)
+   {
+      vertex_nodeId[i] = node_map[vertex_nodeId[i]];
+   }
+
+   RemapElementIds(elem_map);
+}
+
+void NCMesh::AutoCompact()
+{
+   if (!auto_compact) { return; }
+
+   // the transforms and the Mesh numbering refer to element indices, which
+   // are not changed by Compact(), so it can run after any update
+   if (2*free_element_ids.Size() >= elements.Size() ||
+       2*nodes.NumFreeIds() >= nodes.NumIds())
+   {
+      Compact();
+   }
+}
+
+void NCMesh::RemapElementIds(const Array<int> &index_map)
+{
+   for (int i = 0; i < leaf_elements.Size(); i++)
+   {
+      leaf_elements[i] = index_map[leaf_elements[i]];
+   }
+   for (int i = 0; i < coarse_elements.Size(); i++)
+   {
+      coarse_elements[i] = index_map[coarse_elements[i]];
+   }
+
+   // the lists refer to element and face IDs, they will be rebuilt on demand
+   vertex_list.Clear();
+   face_list.Clear();
+   edge_list.Clear();
+
+   boundary_faces.SetSize(0);
+   element_vertex.Clear();
+}
+
 void NCMesh::Trim()
 {
    vertex_list.Clear(true);
@@ -4244,13 +4710,15 @@ void NCMesh::DebugDump(std::ostream &out) const
       MFEM_ASSERT(elem >= 0, "");
       const Element &el = elements[elem];
 
-      int lf = find_hex_face(find_node(el, face->p1),
-                             find_node(el, face->p2),
-                             find_node(el, face->p3));
+      int lf = find_local_face(el.geom,
+                               find_node(el, face->p1),
+                               find_node(el, face->p2),
+                               find_node(el, face->p3));
 
-      out << "4";
-      const int* fv = GI[Geometry::CUBE].faces[lf];
-      for (int i = 0; i < 4; i++)
+      const GeomInfo &gi = GI[(int) el.geom];
+      out << gi.nfv;
+      const int* fv = gi.faces[lf];
+      for (int i = 0; i < gi.nfv; i++)
       {
          out << " " << el.node[fv[i]];
       }
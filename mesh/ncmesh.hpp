@@ -73,7 +73,7 @@ struct CoarseFineTransformations
 
 
 /** \brief A class for non-conforming AMR on higher-order hexahedral,
- *  quadrilateral or triangular meshes.
+ *  tetrahedral, quadrilateral or triangular meshes.
  *
  *  The class is used as follows:
  *
@@ -81,7 +81,8 @@ struct CoarseFineTransformations
  *     are copied and become roots of the refinement hierarchy.
  *
  *  2. Some elements are refined with the Refine() method. Both isotropic and
- *     anisotropic refinements of quads/hexes are supported.
+ *     anisotropic refinements of quads/hexes are supported. Triangles and tets
+ *     are always refined isotropically.
  *
  *  3. A new Mesh is created from NCMesh containing the leaf elements.
  *     This new mesh may have non-conforming (hanging) edges and faces.
@@ -304,7 +305,12 @@ public:
    /// Return the type of elements in the mesh.
    Geometry::Type GetElementGeometry() const { return elements[0].geom; }
 
-   Geometry::Type GetFaceGeometry() const { return Geometry::SQUARE; }
+   /// Return the type of faces in a 3D mesh.
+   Geometry::Type GetFaceGeometry() const
+   {
+      return (GetElementGeometry() == Geometry::TETRAHEDRON)
+             ? Geometry::TRIANGLE : Geometry::SQUARE;
+   }
 
    /// Return the distance of leaf 'i' from the root.
    int GetElementDepth(int i) const;
@@ -328,6 +334,20 @@ public:
    /// Save memory by releasing all non-essential and cached data.
    virtual void Trim();
 
+   /** Rebuild the element, node and face containers so that they contain no
+       free slots and their items are stored in the order of the refinement
+       tree traversal (roots first, then depth-first). Nodes and faces are
+       renumbered in the order they are first used by the leaf elements. This
+       improves memory locality and reduces the memory footprint after many
+       refinement/derefinement cycles. The Mesh numbering of elements,
+       vertices, edges and faces is not changed. */
+   void Compact();
+
+   /** Enable or disable the automatic Compact() at the end of Derefine() and
+       ParNCMesh::Rebalance(), done when at least half of the element or node
+       slots are unused. Enabled by default. */
+   void SetAutoCompact(bool enable) { auto_compact = enable; }
+
    /// Return total number of bytes allocated.
    long MemoryUsage() const;
 
@@ -354,6 +374,7 @@ protected: // implementation
 
    int Dim, spaceDim; ///< dimensions of the elements and the vertex coordinates
    bool Iso; ///< true if the mesh only contains isotropic refinements
+   bool auto_compact; ///< see SetAutoCompact()
 
    /** A Node can hold a vertex, an edge, or both. Elements directly point to
        their corner nodes, but edge nodes also exist and can be accessed using
@@ -520,6 +541,9 @@ protected: // implementation
                      int fattr0, int fattr1, int fattr2,
                      int fattr3, int fattr4, int fattr5);
 
+   int NewTetrahedron(int n0, int n1, int n2, int n3, int attr,
+                      int fattr0, int fattr1, int fattr2, int fattr3);
+
    int NewQuadrilateral(int n0, int n1, int n2, int n3,
                         int attr,
                         int eattr0, int eattr1, int eattr2, int eattr3);
@@ -572,7 +596,7 @@ protected: // implementation
 
    static int find_node(const Element &el, int node);
    static int find_element_edge(const Element &el, int vn0, int vn1);
-   static int find_hex_face(int a, int b, int c);
+   static int find_local_face(int geom, int a, int b, int c);
 
    int ReorderFacePointMat(int v0, int v1, int v2, int v3,
                            int elem, DenseMatrix& mat) const;
@@ -580,6 +604,10 @@ protected: // implementation
    void TraverseFace(int vn0, int vn1, int vn2, int vn3,
                      const PointMatrix& pm, int level);
 
+   bool TriFaceSplit(int v1, int v2, int v3, int mid[3] = NULL) const;
+   void TraverseTriFace(int vn0, int vn1, int vn2,
+                        const PointMatrix& pm, int level);
+
    void TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
                      int level);
 
@@ -624,6 +652,7 @@ protected: // implementation
    void CollectEdgeVertices(int v0, int v1, Array<int> &indices);
    void CollectFaceVertices(int v0, int v1, int v2, int v3,
                             Array<int> &indices);
+   void CollectTriFaceVertices(int v0, int v1, int v2, Array<int> &indices);
    void BuildElementToVertexTable();
 
    void UpdateElementToVertexTable()
@@ -703,6 +732,7 @@ protected: // implementation
 
    static PointMatrix pm_tri_identity;
    static PointMatrix pm_quad_identity;
+   static PointMatrix pm_tet_identity;
    static PointMatrix pm_hex_identity;
 
    static const PointMatrix& GetGeomIdentity(int geom);
@@ -755,10 +785,22 @@ protected: // implementation
    void CopyElements(int elem, const BlockArray<Element> &tmp_elements,
                      Array<int> &index_map);
 
+   /** Reorder 'elements' so that the roots come first, followed by their
+       descendants in depth-first order. Free slots are dropped. Returns the
+       number of roots; 'index_map' maps old element IDs to new ones. */
+   int ReorderElements(Array<int> &index_map);
+
+   /** Called by Compact() to update secondary data that holds element IDs,
+       after the elements were renumbered according to 'index_map'. */
+   virtual void RemapElementIds(const Array<int> &index_map);
+
+   /// Call Compact() if enabled and if the storage has many free slots.
+   void AutoCompact();
+
    // geometry
 
    /** This holds in one place the constants about the geometries we support
-       (triangles, quads, cubes) */
+       (triangles, quads, tets, cubes) */
    struct GeomInfo
    {
       int nv, ne, nf, nfv; // number of: vertices, edges, faces, face vertices
@@ -772,7 +814,7 @@ protected: // implementation
 
    static GeomInfo GI[Geometry::NumGeom];
 
-   static GeomInfo &gi_hex, &gi_quad, &gi_tri;
+   static GeomInfo &gi_hex, &gi_quad, &gi_tri, &gi_tet;
 
 #ifdef MFEM_DEBUG
 public:
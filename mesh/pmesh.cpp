@@ -57,6 +57,7 @@ ParMesh::ParMesh(const ParMesh &pmesh, bool copy_nodes)
 
    // Do not copy face-neighbor data (can be generated if needed)
    have_face_nbr_data = false;
+   entity_offsets_sequence = -1;
 
    // If pmesh has a ParNURBSExtension, it was copied by the Mesh copy ctor, so
    // there is no need to do anything here.
@@ -275,6 +276,7 @@ ParMesh::ParMesh(MPI_Comm comm, Mesh &mesh, int *partitioning_,
    }
 
    have_face_nbr_data = false;
+   entity_offsets_sequence = -1;
 }
 
 
@@ -839,6 +841,7 @@ ParMesh::ParMesh(const ParNCMesh &pncmesh)
    Mesh::InitFromNCMesh(pncmesh);
    ReduceMeshGen();
    have_face_nbr_data = false;
+   entity_offsets_sequence = -1;
 }
 
 void ParMesh::ReduceMeshGen()
@@ -892,6 +895,7 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    MPI_Comm_rank(MyComm, &MyRank);
 
    have_face_nbr_data = false;
+   entity_offsets_sequence = -1;
    pncmesh = NULL;
 
    string ident;
@@ -1062,6 +1066,7 @@ ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
      MyComm(orig_mesh->GetComm()),
      NRanks(orig_mesh->GetNRanks()),
      MyRank(orig_mesh->GetMyRank()),
+     entity_offsets_sequence(-1),
      gtopo(orig_mesh->gtopo),
      have_face_nbr_data(false),
      pncmesh(NULL)
@@ -1579,6 +1584,109 @@ void ParMesh::GenerateOffsets(int N, HYPRE_Int loc_sizes[],
    }
 }
 
+const Array<long> &ParMesh::GetEntityOffsets() const
+{
+   if (entity_offsets_sequence == sequence)
+   {
+      return entity_offsets;
+   }
+
+   // count the local entities and the owned entities of each geometry
+   const int NG = Geometry::NumGeom;
+   Array<long> counts(2*NG), scan(2*NG), total(2*NG);
+   counts = 0;
+   counts[Geometry::POINT] = GetNV();
+   if (Dim > 1)
+   {
+      counts[Geometry::SEGMENT] = GetNEdges();
+   }
+   if (Dim == 3)
+   {
+      for (int i = 0; i < GetNFaces(); i++)
+      {
+         counts[GetFaceBaseGeometry(i)]++;
+      }
+   }
+   for (int i = 0; i < GetNE(); i++)
+   {
+      counts[GetElementBaseGeometry(i)]++;
+   }
+   for (int g = 0; g < NG; g++)
+   {
+      counts[NG+g] = counts[g];
+   }
+   for (int gr = 1; gr < GetNGroups(); gr++)
+   {
+      if (!gtopo.IAmMaster(gr)) // we are not the master
+      {
+         counts[NG+Geometry::POINT] -= group_svert.RowSize(gr-1);
+         counts[NG+Geometry::SEGMENT] -= group_sedge.RowSize(gr-1);
+         counts[NG+Geometry::TRIANGLE] -= group_stria.RowSize(gr-1);
+         counts[NG+Geometry::SQUARE] -= group_squad.RowSize(gr-1);
+      }
+   }
+
+   MPI_Scan(counts.GetData(), scan.GetData(), 2*NG, MPI_LONG, MPI_SUM, MyComm);
+   scan.Copy(total);
+   MPI_Bcast(total.GetData(), 2*NG, MPI_LONG, NRanks-1, MyComm);
+
+   entity_offsets.SetSize(4*NG);
+   for (int g = 0; g < NG; g++)
+   {
+      for (int k = 0; k < 2; k++)
+      {
+         entity_offsets[4*g+2*k] = scan[k*NG+g] - counts[k*NG+g];
+         entity_offsets[4*g+2*k+1] = total[k*NG+g];
+      }
+   }
+   entity_offsets_sequence = sequence;
+   return entity_offsets;
+}
+
+// The number of entities of each geometry (columns) created in the interior of
+// an entity of each geometry (rows) by uniform refinement.
+static const int ref_interior[Geometry::NumGeom][Geometry::NumGeom] =
+{
+   // POINT, SEGMENT, TRIANGLE, SQUARE, TETRAHEDRON, CUBE, PRISM
+   { 0, 0, 0, 0, 0, 0, 0 }, // POINT
+   { 1, 0, 0, 0, 0, 0, 0 }, // SEGMENT
+   { 0, 3, 0, 0, 0, 0, 0 }, // TRIANGLE
+   { 1, 4, 0, 0, 0, 0, 0 }, // SQUARE
+   { 0, 1, 8, 0, 0, 0, 0 }, // TETRAHEDRON
+   { 1, 6, 0, 12, 0, 0, 0 }, // CUBE
+   { 0, 3, 4, 6, 0, 0, 0 } // PRISM
+};
+
+// The number of children of each geometry in uniform refinement.
+static const int ref_children[Geometry::NumGeom] = { 1, 2, 4, 4, 8, 8, 8 };
+
+void ParMesh::UniformRefineEntityOffsets(bool valid)
+{
+   if (!valid)
+   {
+      return;
+   }
+
+   // The new entities belong to the group of their parent, so the same linear
+   // map updates the local and owned offsets and totals.
+   const int NG = Geometry::NumGeom;
+   Array<long> old_offsets;
+   entity_offsets.Copy(old_offsets);
+   for (int h = 0; h < NG; h++)
+   {
+      for (int k = 0; k < 4; k++)
+      {
+         long &off = entity_offsets[4*h+k];
+         off = ref_children[h]*old_offsets[4*h+k];
+         for (int g = 0; g < NG; g++)
+         {
+            off += ref_interior[g][h]*old_offsets[4*g+k];
+         }
+      }
+   }
+   entity_offsets_sequence = sequence;
+}
+
 void ParMesh::GetFaceNbrElementTransformation(
    int i, IsoparametricTransformation *ElTr)
 {
@@ -1629,6 +1737,8 @@ void ParMesh::GetFaceNbrElementTransformation(
       }
    }
    ElTr->FinalizeTransformation();
+   ElTr->SetAffine(IsAffineTransformation(*ElTr->GetFE(),
+                                          ElTr->GetPointMat()));
 }
 
 void ParMesh::DeleteFaceNbrData()
@@ -2476,9 +2586,15 @@ void ParMesh::LocalRefinement(const Array<int> &marked_el, int type)
    }
 
    DeleteFaceNbrData();
+   RestoreConnectivityTables();
 
    InitRefinementTransforms();
 
+   // A negative type indicates uniform refinement of all elements
+   MFEM_ASSERT(type > 0 || marked_el.Size() == GetNE(), "invalid refinement");
+   const bool offsets_valid =
+      (type < 0 && entity_offsets_sequence == sequence);
+
    if (Dim == 3)
    {
       int uniform_refinement = 0;
@@ -2964,6 +3080,8 @@ void ParMesh::LocalRefinement(const Array<int> &marked_el, int type)
    last_operation = Mesh::REFINE;
    sequence++;
 
+   UniformRefineEntityOffsets(offsets_valid);
+
    UpdateNodes();
 
 #ifdef MFEM_DEBUG
@@ -3055,6 +3173,8 @@ bool ParMesh::NonconformingDerefinement(Array<double> &elem_error,
    long glob_size = ReduceInt(derefs.Size());
    if (!glob_size) { return false; }
 
+   DeleteFaceNbrData();
+
    pncmesh->Derefine(derefs);
 
    ParMesh* mesh2 = new ParMesh(*pncmesh);
@@ -3082,7 +3202,7 @@ bool ParMesh::NonconformingDerefinement(Array<double> &elem_error,
    return true;
 }
 
-void ParMesh::Rebalance()
+void ParMesh::Rebalance(const Vector *elem_weights)
 {
    if (Conforming())
    {
@@ -3109,7 +3229,7 @@ void ParMesh::Rebalance()
 
    DeleteFaceNbrData();
 
-   pncmesh->Rebalance();
+   pncmesh->Rebalance(elem_weights);
 
    ParMesh* pmesh2 = new ParMesh(*pncmesh);
    pncmesh->OnMeshUpdated(pmesh2);
@@ -3592,6 +3712,7 @@ void ParMesh::UniformRefinement2D()
    DeleteFaceNbrData();
 
    const int old_nv = NumOfVertices;
+   const bool offsets_valid = (entity_offsets_sequence == sequence);
 
    // call Mesh::UniformRefinement2D so that it won't update the nodes
    {
@@ -3603,6 +3724,7 @@ void ParMesh::UniformRefinement2D()
 
    // update the groups
    UniformRefineGroups2D(old_nv);
+   UniformRefineEntityOffsets(offsets_valid);
 
    UpdateNodes();
 }
@@ -3613,6 +3735,7 @@ void ParMesh::UniformRefinement3D()
 
    const int old_nv = NumOfVertices;
    const int old_nedges = NumOfEdges;
+   const bool offsets_valid = (entity_offsets_sequence == sequence);
 
    DSTable v_to_v(NumOfVertices);
    GetVertexToVertexTable(v_to_v);
@@ -3634,6 +3757,7 @@ void ParMesh::UniformRefinement3D()
    UniformRefineGroups3D(old_nv, old_nedges, v_to_v, *faces_tbl,
                          f2qf.Size() ? &f2qf : NULL);
    delete faces_tbl;
+   UniformRefineEntityOffsets(offsets_valid);
 
    UpdateNodes();
 }
@@ -4959,6 +5083,51 @@ void ParMesh::PrintInfo(std::ostream &out)
    }
 }
 
+long ParMesh::MemoryUsage() const
+{
+   return Mesh::MemoryUsage() +
+          ElementsMemoryUsage(shared_edges) +
+          shared_trias.MemoryUsage() +
+          shared_quads.MemoryUsage() +
+          group_svert.MemoryUsage() +
+          group_sedge.MemoryUsage() +
+          group_stria.MemoryUsage() +
+          group_squad.MemoryUsage() +
+          svert_lvert.MemoryUsage() +
+          sedge_ledge.MemoryUsage() +
+          sface_lface.MemoryUsage() +
+          face_nbr_group.MemoryUsage() +
+          face_nbr_elements_offset.MemoryUsage() +
+          face_nbr_vertices_offset.MemoryUsage() +
+          ElementsMemoryUsage(face_nbr_elements) +
+          face_nbr_vertices.MemoryUsage() +
+          send_face_nbr_elements.MemoryUsage() +
+          send_face_nbr_vertices.MemoryUsage() +
+          (pncmesh ? pncmesh->MemoryUsage(false) : 0) +
+          (sizeof(ParMesh) - sizeof(Mesh));
+}
+
+void ParMesh::PrintMemoryDetail(std::ostream &out) const
+{
+   // The parallel data first, Mesh::PrintMemoryDetail() prints the total
+   out << ElementsMemoryUsage(shared_edges) << " shared_edges\n"
+       << shared_trias.MemoryUsage() + shared_quads.MemoryUsage()
+       << " shared faces\n"
+       << group_svert.MemoryUsage() + group_sedge.MemoryUsage() +
+       group_stria.MemoryUsage() + group_squad.MemoryUsage()
+       << " group_svert/sedge/stria/squad\n"
+       << svert_lvert.MemoryUsage() + sedge_ledge.MemoryUsage() +
+       sface_lface.MemoryUsage() << " svert_lvert/sedge_ledge/sface_lface\n"
+       << ElementsMemoryUsage(face_nbr_elements) +
+       face_nbr_vertices.MemoryUsage() + face_nbr_group.MemoryUsage() +
+       face_nbr_elements_offset.MemoryUsage() +
+       face_nbr_vertices_offset.MemoryUsage() << " face_nbr data\n"
+       << send_face_nbr_elements.MemoryUsage() +
+       send_face_nbr_vertices.MemoryUsage() << " send_face_nbr data\n"
+       << (pncmesh ? pncmesh->MemoryUsage(false) : 0) << " pncmesh\n";
+   Mesh::PrintMemoryDetail(out);
+}
+
 long ParMesh::ReduceInt(int value) const
 {
    long local = value, global;
@@ -33,7 +33,7 @@ class ParMesh : public Mesh
 {
 protected:
    ParMesh() : MyComm(0), NRanks(0), MyRank(-1),
-      have_face_nbr_data(false), pncmesh(NULL) {}
+      entity_offsets_sequence(-1), have_face_nbr_data(false), pncmesh(NULL) {}
 
    MPI_Comm MyComm;
    int NRanks, MyRank;
@@ -78,6 +78,11 @@ protected:
    // sface ids: all triangles first, then all quads
    Array<int> sface_lface;
 
+   /// See GetEntityOffsets().
+   mutable Array<long> entity_offsets;
+   /// The mesh sequence for which #entity_offsets is valid, or -1.
+   mutable long entity_offsets_sequence;
+
    /// Create from a nonconforming mesh.
    ParMesh(const ParNCMesh &pncmesh);
 
@@ -121,6 +126,10 @@ protected:
                               const STable3D &old_faces,
                               Array<int> *f2qf);
 
+   /** Update #entity_offsets after a uniform refinement (of all elements) if
+       they were valid before it, without communication. */
+   void UniformRefineEntityOffsets(bool valid);
+
    void ExchangeFaceNbrData(Table *gr_sface, int *s2l_face);
 
    /// Refine a mixed 2D mesh uniformly.
@@ -141,7 +150,6 @@ protected:
    virtual bool NonconformingDerefinement(Array<double> &elem_error,
                                           double threshold, int nc_limit = 0,
                                           int op = 1);
-   void DeleteFaceNbrData();
 
    bool WantSkipSharedMaster(const NCMesh::Master &master) const;
 
@@ -257,9 +265,33 @@ public:
    void GenerateOffsets(int N, HYPRE_Int loc_sizes[],
                         Array<HYPRE_Int> *offsets[]) const;
 
+   /** @brief Return the global offsets of the numbers of local and owned
+       entities of each geometry, see GetEntityOffset(). */
+   /** The offsets are computed with one MPI_Scan and one MPI_Bcast when first
+       needed. Uniform refinement updates them locally: every new entity
+       belongs to the group of the entity it is created in, so the new counts
+       depend linearly on the old ones on every processor. Thus repeated
+       uniform refinement requires no further global communication. */
+   const Array<long> &GetEntityOffsets() const;
+
+   /** @brief Return an entry of GetEntityOffsets() for the geometry @a geom:
+       the number of @a owned (or all local) entities on the lower ranks if
+       @a total is false, or their global number if @a total is true. */
+   /** When @a owned is false, a shared entity is counted by every processor
+       in its group. */
+   long GetEntityOffset(Geometry::Type geom, bool owned, bool total) const
+   { return GetEntityOffsets()[4*geom + 2*owned + total]; }
+
    void ExchangeFaceNbrData();
    void ExchangeFaceNbrNodes();
 
+   /** @brief Free the face-neighbor elements and vertices created by
+       ExchangeFaceNbrData() to reduce the memory usage of the mesh. */
+   /** The data is rebuilt by the next call to ExchangeFaceNbrData(), which
+       is required e.g. by the face-neighbor methods of ParFiniteElementSpace
+       and by face integrators on shared faces. */
+   void DeleteFaceNbrData();
+
    int GetNFaceNeighbors() const { return face_nbr_group.Size(); }
    int GetFaceNbrGroup(int fn) const { return face_nbr_group[fn]; }
    int GetFaceNbrRank(int fn) const;
@@ -286,8 +318,11 @@ public:
    /// Utility function: sum integers from all processors (Allreduce).
    virtual long ReduceInt(int value) const;
 
-   /// Load balance the mesh. NC meshes only.
-   void Rebalance();
+   /** Load balance the mesh. NC meshes only. Optionally, 'elem_weights' can
+       specify a positive cost for each local element, see
+       ParNCMesh::Rebalance(). The statistics of the new partition can be
+       obtained from ParNCMesh::GetRebalanceStats(). */
+   void Rebalance(const Vector *elem_weights = NULL);
 
    /** Print the part of the mesh in the calling processor adding the interface
        as boundary (for visualization purposes) using the mfem v1.0 format. */
@@ -316,6 +351,12 @@ public:
    /// Print various parallel mesh stats
    virtual void PrintInfo(std::ostream &out = mfem::out);
 
+   /// Return the local memory used by the mesh, including the parallel data.
+   virtual long MemoryUsage() const;
+
+   /// Print the local memory used by the components of the mesh.
+   virtual void PrintMemoryDetail(std::ostream &out = mfem::out) const;
+
    /// Save the mesh in a parallel mesh format.
    void ParPrint(std::ostream &out) const;
 
@@ -18,6 +18,7 @@
 #include "../general/binaryio.hpp"
 
 #include <map>
+#include <algorithm>
 #include <climits> // INT_MIN, INT_MAX
 
 namespace mfem
@@ -27,6 +28,7 @@ using namespace bin_io;
 
 ParNCMesh::ParNCMesh(MPI_Comm comm, const NCMesh &ncmesh)
    : NCMesh(ncmesh)
+   , rebalance_stats()
 {
    MyComm = comm;
    MPI_Comm_size(MyComm, &NRanks);
@@ -52,6 +54,7 @@ ParNCMesh::ParNCMesh(const ParNCMesh &other)
    , MyComm(other.MyComm)
    , NRanks(other.NRanks)
    , MyRank(other.MyRank)
+   , rebalance_stats(other.rebalance_stats)
 {
    Update(); // mark all secondary stuff for recalculation
 }
@@ -89,6 +92,24 @@ void ParNCMesh::Update()
    boundary_layer.SetSize(0);
 }
 
+void ParNCMesh::RemapElementIds(const Array<int> &index_map)
+{
+   NCMesh::RemapElementIds(index_map);
+
+   shared_vertices.Clear();
+   shared_edges.Clear();
+   shared_faces.Clear();
+
+   for (int i = 0; i < ghost_layer.Size(); i++)
+   {
+      ghost_layer[i] = index_map[ghost_layer[i]];
+   }
+   for (int i = 0; i < boundary_layer.Size(); i++)
+   {
+      boundary_layer[i] = index_map[boundary_layer[i]];
+   }
+}
+
 void ParNCMesh::AssignLeafIndices()
 {
    // This is an override of NCMesh::AssignLeafIndices(). The difference is
@@ -603,7 +624,8 @@ void ParNCMesh::CalculatePMatrixGroups()
       AddConnections(2, master_face.index, ranks);
 
       GetFaceVerticesEdges(master_face, v, e, eo);
-      for (int j = 0; j < 4; j++)
+      int nfv = GI[(int) elements[master_face.element].geom].nfv;
+      for (int j = 0; j < nfv; j++)
       {
          AddConnections(0, v[j], ranks);
          AddConnections(1, e[j], ranks);
@@ -635,20 +657,24 @@ int ParNCMesh::get_face_orientation(Face &face, Element &e1, Element &e2,
    {
       // get local face number (remember that p1, p2, p3 are not in order, and
       // p4 is not stored)
-      int lf = find_hex_face(find_node(*e[i], face.p1),
-                             find_node(*e[i], face.p2),
-                             find_node(*e[i], face.p3));
+      int lf = find_local_face(e[i]->geom,
+                               find_node(*e[i], face.p1),
+                               find_node(*e[i], face.p2),
+                               find_node(*e[i], face.p3));
       // optional output
       if (local) { local[i] = lf; }
 
       // get node IDs for the face as seen from e[i]
-      const int* fv = GI[Geometry::CUBE].faces[lf];
-      for (int j = 0; j < 4; j++)
+      const GeomInfo &gi = GI[(int) e[i]->geom];
+      const int* fv = gi.faces[lf];
+      for (int j = 0; j < gi.nfv; j++)
       {
          ids[i][j] = e[i]->node[fv[j]];
       }
    }
-   return Mesh::GetQuadOrientation(ids[0], ids[1]);
+   return (e1.geom == Geometry::TETRAHEDRON)
+          ? Mesh::GetTriOrientation(ids[0], ids[1])
+          : Mesh::GetQuadOrientation(ids[0], ids[1]);
 }
 
 void ParNCMesh::CalcFaceOrientations()
@@ -913,12 +939,17 @@ void ParNCMesh::GetConformingSharedStructures(ParMesh &pmesh)
    int ngroups = pmesh.gtopo.NGroups();
    MakeSharedTable(ngroups, 0, pmesh.svert_lvert, pmesh.group_svert);
    MakeSharedTable(ngroups, 1, pmesh.sedge_ledge, pmesh.group_sedge);
-   MakeSharedTable(ngroups, 2, pmesh.sface_lface, pmesh.group_squad);
 
-   // create an empty group_stria (we currently don't have triangle faces)
-   pmesh.group_stria.MakeI(ngroups-1);
-   pmesh.group_stria.MakeJ();
-   pmesh.group_stria.ShiftUpI();
+   // all shared faces have the same geometry, the other table stays empty
+   bool tri_faces = (Dim == 3 && GetFaceGeometry() == Geometry::TRIANGLE);
+   Table &group_sface = tri_faces ? pmesh.group_stria : pmesh.group_squad;
+   Table &group_empty = tri_faces ? pmesh.group_squad : pmesh.group_stria;
+
+   MakeSharedTable(ngroups, 2, pmesh.sface_lface, group_sface);
+
+   group_empty.MakeI(ngroups-1);
+   group_empty.MakeJ();
+   group_empty.ShiftUpI();
 
    // create shared_edges
    for (int i = 0; i < pmesh.shared_edges.Size(); i++)
@@ -937,14 +968,17 @@ void ParNCMesh::GetConformingSharedStructures(ParMesh &pmesh)
    }
 
    // create shared_faces
-   pmesh.shared_quads.SetSize(pmesh.sface_lface.Size());
-   for (int i = 0; i < pmesh.shared_quads.Size(); i++)
+   pmesh.shared_trias.SetSize(tri_faces ? pmesh.sface_lface.Size() : 0);
+   pmesh.shared_quads.SetSize(tri_faces ? 0 : pmesh.sface_lface.Size());
+   for (int i = 0; i < pmesh.sface_lface.Size(); i++)
    {
       int el_loc = entity_elem_local[2][pmesh.sface_lface[i]];
       MeshId face_id(-1, leaf_elements[(el_loc >> 4)], (el_loc & 0xf));
 
-      int e[4], eo[4];
-      GetFaceVerticesEdges(face_id, pmesh.shared_quads[i].v, e, eo);
+      int v[4], e[4], eo[4];
+      GetFaceVerticesEdges(face_id, v, e, eo);
+      if (tri_faces) { pmesh.shared_trias[i].Set(v); }
+      else { pmesh.shared_quads[i].Set(v); }
    }
 
    // free the arrays, they're not needed anymore (until next mesh update)
@@ -1193,11 +1227,20 @@ void ParNCMesh::GetFaceNeighbors(ParMesh &pmesh)
             {
                // ghost slave in 3D needs flipping orientation
                DenseMatrix* pm2 = new DenseMatrix(*pm);
-               std::swap((*pm2)(0,1), (*pm2)(0,3));
-               std::swap((*pm2)(1,1), (*pm2)(1,3));
+               if (mfe.geom == Geometry::TETRAHEDRON)
+               {
+                  // (0,1,2) -> (0,2,1), i.e., triangle orientation 5
+                  std::swap((*pm2)(0,1), (*pm2)(0,2));
+                  std::swap((*pm2)(1,1), (*pm2)(1,2));
+                  fi.Elem2Inf ^= 5;
+               }
+               else
+               {
+                  std::swap((*pm2)(0,1), (*pm2)(0,3));
+                  std::swap((*pm2)(1,1), (*pm2)(1,3));
+                  fi.Elem2Inf ^= 1;
+               }
                aux_pm_store.Append(pm2);
-
-               fi.Elem2Inf ^= 1;
                pm = pm2;
 
                // The problem is that sf.point_matrix is designed for P matrix
@@ -1563,6 +1606,8 @@ void ParNCMesh::Derefine(const Array<int> &derefs)
 
    // make sure we can delete all send buffers
    NeighborDerefinementMessage::WaitAllSent(send_deref);
+
+   AutoCompact();
 }
 
 
@@ -1705,7 +1750,7 @@ void ParNCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 
 //// Rebalance /////////////////////////////////////////////////////////////////
 
-void ParNCMesh::Rebalance()
+void ParNCMesh::Rebalance(const Vector *elem_weights)
 {
    send_rebalance_dofs.clear();
    recv_rebalance_dofs.clear();
@@ -1713,27 +1758,53 @@ void ParNCMesh::Rebalance()
    Array<int> old_elements;
    leaf_elements.GetSubArray(0, NElements, old_elements);
 
-   // figure out new assignments for Element::rank
-   long local_elems = NElements, total_elems = 0;
-   MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM, MyComm);
-
-   long first_elem_global = 0;
-   MPI_Scan(&local_elems, &first_elem_global, 1, MPI_LONG, MPI_SUM, MyComm);
-   first_elem_global -= local_elems;
-
    Array<int> new_ranks(leaf_elements.Size());
    new_ranks = -1;
 
-   for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
+   // figure out new assignments for Element::rank
+   int target_elements;
+   double target_weight, total_weight;
+   if (elem_weights)
+   {
+      target_elements = WeightedPartition(*elem_weights, new_ranks,
+                                          target_weight, total_weight);
+   }
+   else
    {
-      if (elements[leaf_elements[i]].rank == MyRank)
+      long local_elems = NElements, total_elems = 0;
+      MPI_Allreduce(&local_elems, &total_elems, 1, MPI_LONG, MPI_SUM, MyComm);
+
+      long first_elem_global = 0;
+      MPI_Scan(&local_elems, &first_elem_global, 1, MPI_LONG, MPI_SUM, MyComm);
+      first_elem_global -= local_elems;
+
+      for (int i = 0, j = 0; i < leaf_elements.Size(); i++)
       {
-         new_ranks[i] = Partition(first_elem_global + (j++), total_elems);
+         if (elements[leaf_elements[i]].rank == MyRank)
+         {
+            new_ranks[i] = Partition(first_elem_global + (j++), total_elems);
+         }
       }
+
+      target_elements = PartitionFirstIndex(MyRank+1, total_elems)
+                        - PartitionFirstIndex(MyRank, total_elems);
+
+      target_weight = target_elements;
+      total_weight = total_elems;
    }
 
-   int target_elements = PartitionFirstIndex(MyRank+1, total_elems)
-                         - PartitionFirstIndex(MyRank, total_elems);
+   // gather the statistics of the new partition
+   double loc[4] = { double(target_elements), target_weight,
+                     -double(target_elements), -target_weight
+                   };
+   double glob[4];
+   MPI_Allreduce(loc, glob, 4, MPI_DOUBLE, MPI_MAX, MyComm);
+
+   rebalance_stats.max_elements = long(glob[0]);
+   rebalance_stats.max_weight = glob[1];
+   rebalance_stats.min_elements = long(-glob[2]);
+   rebalance_stats.min_weight = -glob[3];
+   rebalance_stats.avg_weight = total_weight / NRanks;
 
    // assign the new ranks and send elements (plus ghosts) to new owners
    RedistributeElements(new_ranks, target_elements, true);
@@ -1749,6 +1820,58 @@ void ParNCMesh::Rebalance()
 
    // get rid of elements beyond the new ghost layer
    Prune();
+
+   AutoCompact();
+}
+
+int ParNCMesh::WeightedPartition(const Vector &elem_weights,
+                                 Array<int> &new_ranks,
+                                 double &target_weight, double &total_weight)
+{
+   MFEM_VERIFY(elem_weights.Size() == NElements,
+               "expected one weight per local element.");
+
+   double local_weight = 0.0;
+   for (int i = 0; i < NElements; i++)
+   {
+      MFEM_VERIFY(elem_weights(i) > 0.0, "element weights must be positive.");
+      local_weight += elem_weights(i);
+   }
+
+   total_weight = 0.0;
+   MPI_Allreduce(&local_weight, &total_weight, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+
+   double first_weight = 0.0;
+   MPI_Scan(&local_weight, &first_weight, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   first_weight -= local_weight;
+
+   // Each element goes to the rank whose interval [r, r+1)*total/NRanks of the
+   // cumulative weight contains the element's midpoint. The new element counts
+   // and weights per rank are accumulated so that each rank can find out how
+   // many elements it is going to receive (in pairs: count, weight).
+   std::vector<double> rank_load(2*NRanks, 0.0);
+   double prefix = first_weight;
+   for (int i = 0; i < leaf_elements.Size(); i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      if (el.rank != MyRank) { continue; }
+
+      double w = elem_weights(el.index);
+      int rank = (int) ((prefix + 0.5*w) * NRanks / total_weight);
+      rank = std::min(std::max(rank, 0), NRanks-1);
+
+      new_ranks[i] = rank;
+      rank_load[2*rank] += 1.0;
+      rank_load[2*rank + 1] += w;
+      prefix += w;
+   }
+
+   double my_load[2];
+   MPI_Reduce_scatter_block(rank_load.data(), my_load, 2, MPI_DOUBLE, MPI_SUM,
+                            MyComm);
+
+   target_weight = my_load[1];
+   return (int) (my_load[0] + 0.5);
 }
 
 struct CompareRanks // TODO: use lambda when C++11 available
@@ -2240,7 +2363,8 @@ void ParNCMesh::AdjustMeshIds(Array<MeshId> ids[], int rank)
       {
          int v[4], e[4], eo[4], pos, k;
          GetFaceVerticesEdges(face_id, v, e, eo);
-         for (int j = 0; j < 4; j++)
+         int nfv = GI[(int) elements[face_id.element].geom].nfv;
+         for (int j = 0; j < nfv; j++)
          {
             if ((pos = find_v.FindSorted(Pair<int, int>(v[j], 0))) != -1)
             {
@@ -87,8 +87,30 @@ public:
    virtual void Derefine(const Array<int> &derefs);
 
    /** Migrate leaf elements of the global refinement hierarchy (including ghost
-       elements) so that each processor owns the same number of leaves (+-1). */
-   void Rebalance();
+       elements) so that each processor owns the same number of leaves (+-1).
+
+       If 'elem_weights' is given, it should contain a positive weight (cost)
+       for each element owned by this processor. The (space-filling curve
+       ordered) sequence of leaves is then split so that each processor owns
+       approximately the same total weight instead. Note that a processor may
+       end up owning no elements if some weights are extremely large. */
+   void Rebalance(const Vector *elem_weights = NULL);
+
+   /// Load balance statistics computed by the last Rebalance().
+   struct RebalanceStats
+   {
+      long min_elements, max_elements; ///< number of elements per processor
+      double min_weight, max_weight;   ///< total element weight per processor
+      double avg_weight;               ///< global weight / number of ranks
+
+      /// Return the ratio of the maximum and average processor weight.
+      double Imbalance() const
+      { return (avg_weight > 0.0) ? max_weight / avg_weight : 1.0; }
+   };
+
+   /** Return the element counts and weights of the partition created by the
+       last call to Rebalance(). Without weights, each element counts as 1. */
+   const RebalanceStats& GetRebalanceStats() const { return rebalance_stats; }
 
 
    // interface for ParFiniteElementSpace
@@ -101,7 +123,7 @@ public:
    int GetNGhostElements() const { return NGhostElements; }
 
    Geometry::Type GetGhostFaceGeometry(int ghost_face_id) const
-   { return Geometry::SQUARE; }
+   { return GetFaceGeometry(); }
 
    // Return a list of vertices/edges/faces shared by this processor and at
    // least one other processor. These are subsets of NCMesh::<entity>_list. */
@@ -305,6 +327,7 @@ protected: // implementation
    virtual void UpdateVertices();
    virtual void AssignLeafIndices();
    virtual void OnMeshUpdated(Mesh *mesh);
+   virtual void RemapElementIds(const Array<int> &index_map);
 
    virtual void BuildFaceList();
    virtual void BuildEdgeList();
@@ -510,6 +533,16 @@ protected: // implementation
    void RedistributeElements(Array<int> &new_ranks, int target_elements,
                              bool record_comm);
 
+   /** Compute new ranks for the owned leaf elements so that the sequence of
+       leaves is split into parts of approximately equal total weight. Returns
+       the number of elements that will be owned by this processor, their
+       total weight and the global sum of the weights. */
+   int WeightedPartition(const Vector &elem_weights, Array<int> &new_ranks,
+                         double &target_weight, double &total_weight);
+
+   /// Statistics of the last Rebalance(), see GetRebalanceStats().
+   RebalanceStats rebalance_stats;
+
    /** Recorded communication pattern from last Rebalance. Used by
        Send/RecvRebalanceDofs to ship element DOFs. */
    RebalanceDofMessage::Map send_rebalance_dofs;
@@ -0,0 +1,226 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+//
+//         ---------------------------------------------------------
+//         NCMesh Benchmark Miniapp: Nonconforming Mesh Storage Cost
+//         ---------------------------------------------------------
+//
+// This miniapp measures the memory footprint of the nonconforming mesh data
+// structure (NCMesh) and the time of typical adaptive mesh operations, before
+// and after the NCMesh storage is compacted with NCMesh::Compact().
+//
+// A Cartesian mesh is refined towards a sphere whose center moves in each
+// cycle, and the refinements away from the sphere are undone. With the
+// automatic compaction disabled (see NCMesh::SetAutoCompact), this leaves the
+// NCMesh containers fragmented as in a long running adaptive simulation (free
+// slots, elements and nodes scattered in memory). The mesh is then copied, the
+// copy is compacted, and the same sequence of operations is timed on both:
+// building the master/slave lists, refinement (including the update of the
+// Mesh from the NCMesh) and derefinement.
+//
+// Compile with: make ncmesh-bench
+//
+// Sample runs:  ncmesh-bench
+//               ncmesh-bench -d 2 -r 10
+//               ncmesh-bench -d 3 -r 6 -c 4
+//               ncmesh-bench -d 3 -tet -r 4
+
+#include "mfem.hpp"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+using namespace mfem;
+
+// Mark elements whose vertices are on both sides of the sphere |x - c| = r
+// and whose refinement depth is less than 'max_depth'.
+static void MarkSphere(Mesh &mesh, const Vector &c, double r, int max_depth,
+                       Array<int> &marked)
+{
+   marked.SetSize(0);
+   Array<int> v;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      if (mesh.ncmesh->GetElementDepth(i) >= max_depth) { continue; }
+
+      mesh.GetElementVertices(i, v);
+      double dmin = infinity(), dmax = -infinity();
+      for (int j = 0; j < v.Size(); j++)
+      {
+         const double *x = mesh.GetVertex(v[j]);
+         double d = 0.0;
+         for (int k = 0; k < mesh.SpaceDimension(); k++)
+         {
+            d += (x[k] - c(k))*(x[k] - c(k));
+         }
+         d = sqrt(d);
+         dmin = std::min(dmin, d);
+         dmax = std::max(dmax, d);
+      }
+      if (dmin <= r && dmax >= r) { marked.Append(i); }
+   }
+}
+
+// Refine 'levels' times towards the sphere, then derefine everything else.
+static void Adapt(Mesh &mesh, const Vector &c, double r, int levels)
+{
+   Array<int> marked;
+   for (int l = 0; l < levels; l++)
+   {
+      MarkSphere(mesh, c, r, levels, marked);
+      mesh.GeneralRefinement(marked, 1);
+   }
+
+   Vector error;
+   do
+   {
+      MarkSphere(mesh, c, r, levels+1, marked); // all elements on the sphere
+      error.SetSize(mesh.GetNE());
+      error = 0.0;
+      for (int i = 0; i < marked.Size(); i++) { error(marked[i]) = 1.0; }
+   }
+   while (mesh.DerefineByError(error, 0.5));
+}
+
+struct BenchResult
+{
+   long memory;
+   double t_lists, t_refine, t_deref;
+};
+
+static void Benchmark(Mesh &mesh, const Vector &c, double r, int levels,
+                      int nrep, BenchResult &res)
+{
+   StopWatch sw;
+   res.memory = mesh.ncmesh->MemoryUsage();
+
+   // build the master/slave lists from scratch
+   sw.Clear();
+   for (int i = 0; i < nrep; i++)
+   {
+      mesh.ncmesh->Trim();
+      sw.Start();
+      mesh.ncmesh->GetFaceList();
+      mesh.ncmesh->GetEdgeList();
+      mesh.ncmesh->GetVertexList();
+      sw.Stop();
+   }
+   res.t_lists = sw.RealTime() / nrep;
+
+   // one more level of refinement along the sphere, then derefine it
+   Array<int> marked;
+   MarkSphere(mesh, c, r, levels+1, marked);
+
+   sw.Clear();
+   sw.Start();
+   mesh.GeneralRefinement(marked, 1);
+   sw.Stop();
+   res.t_refine = sw.RealTime();
+
+   Vector error(mesh.GetNE());
+   error = 0.0;
+
+   sw.Clear();
+   sw.Start();
+   mesh.DerefineByError(error, 1.0);
+   sw.Stop();
+   res.t_deref = sw.RealTime();
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   int dim = 3;
+   int nxyz = 4;
+   int levels = 4;
+   int cycles = 3;
+   int nrep = 3;
+   bool tet = false;
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&dim, "-d", "--dimension", "Mesh dimension (2 or 3).");
+   args.AddOption(&nxyz, "-n", "--num-elements",
+                  "Number of initial elements in each direction.");
+   args.AddOption(&levels, "-r", "--refine",
+                  "Number of refinement levels towards the sphere.");
+   args.AddOption(&cycles, "-c", "--cycles",
+                  "Number of adaptation cycles (moving sphere).");
+   args.AddOption(&nrep, "-rep", "--repeat",
+                  "Number of repetitions of the list construction.");
+   args.AddOption(&tet, "-tet", "--tetrahedra", "-hex", "--hexahedra",
+                  "Use simplices (triangles/tetrahedra) instead of quads/hexes.");
+   args.Parse();
+   if (!args.Good() || (dim != 2 && dim != 3))
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Create the initial mesh and the fragmented adapted mesh.
+   Mesh *mesh;
+   if (dim == 2)
+   {
+      mesh = new Mesh(nxyz, nxyz, tet ? Element::TRIANGLE
+                      : Element::QUADRILATERAL, true);
+   }
+   else
+   {
+      mesh = new Mesh(nxyz, nxyz, nxyz, tet ? Element::TETRAHEDRON
+                      : Element::HEXAHEDRON, true);
+   }
+   mesh->EnsureNCMesh(true);
+   mesh->ncmesh->SetAutoCompact(false);
+
+   Vector c(dim);
+   const double r = 0.3;
+   for (int i = 0; i < cycles; i++)
+   {
+      c = 0.4 + 0.2*i/std::max(cycles-1, 1);
+      Adapt(*mesh, c, r, levels);
+   }
+
+   cout << "Elements: " << mesh->GetNE() << ", vertices: " << mesh->GetNV()
+        << endl;
+
+   // 3. Benchmark the original and the compacted NCMesh. The two meshes are
+   //    identical, only the internal NCMesh storage differs.
+   Mesh compact(*mesh);
+
+   StopWatch sw;
+   sw.Start();
+   compact.ncmesh->Compact();
+   sw.Stop();
+   double t_compact = sw.RealTime();
+
+   BenchResult orig_res, comp_res;
+   Benchmark(*mesh, c, r, levels, nrep, orig_res);
+   Benchmark(compact, c, r, levels, nrep, comp_res);
+
+   MFEM_VERIFY(mesh->GetNE() == compact.GetNE(), "meshes differ.");
+
+   // 4. Print the results.
+   cout << "\nCompact() time: " << t_compact << " s\n\n"
+        << setw(24) << left << "" << setw(14) << right << "original"
+        << setw(14) << "compacted" << '\n'
+        << setw(24) << left << "NCMesh memory [MB]" << right << setw(14)
+        << orig_res.memory / 1048576.0 << setw(14)
+        << comp_res.memory / 1048576.0 << '\n'
+        << setw(24) << left << "NC lists [s]" << right << setw(14)
+        << orig_res.t_lists << setw(14) << comp_res.t_lists << '\n'
+        << setw(24) << left << "refinement [s]" << right << setw(14)
+        << orig_res.t_refine << setw(14) << comp_res.t_refine << '\n'
+        << setw(24) << left << "derefinement [s]" << right << setw(14)
+        << orig_res.t_deref << setw(14) << comp_res.t_deref << endl;
+
+   delete mesh;
+   return 0;
+}
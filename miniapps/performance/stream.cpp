@@ -0,0 +1,139 @@
+//                  MFEM STREAM Benchmark - Memory Placement
+//
+// Compile with: make stream
+//
+// Sample runs:  stream
+//               stream -d omp -nt 16 -n 40000000
+//               stream -d omp -nt 64 -n 100000000 -it 20
+//
+// Description:  This miniapp measures the memory bandwidth of the Vector
+//               kernels of MFEM with the four STREAM operations: copy,
+//               c = a; scale, b = s c; add, c = a + b; and triad,
+//               a = b + s c. The kernels run on the configured device, e.g.
+//               with the OpenMP backend ('-d omp').
+//
+//               The benchmark is run twice: first with the default memory
+//               placement where the vectors are initialized by one thread,
+//               and then with the MemoryPlacement::FIRST_TOUCH policy, where
+//               the vectors are zeroed in parallel when allocated. On NUMA
+//               systems the second run avoids the remote memory accesses of
+//               the threads that do not run on the socket of the initializing
+//               thread. The vector size should be much larger than the caches.
+
+#include "mfem.hpp"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+using namespace mfem;
+
+// Run the STREAM kernels 'iterations' times and return the best bandwidth of
+// each kernel in GB/s.
+void RunStream(int n, int iterations, bool first_touch, double bw[4])
+{
+   SetMemoryPlacement(first_touch ? MemoryPlacement::FIRST_TOUCH :
+                      MemoryPlacement::DEFAULT);
+   Vector a(n), b(n), c(n);
+   if (first_touch)
+   {
+      // Set the values with the device kernels, i.e. with the partitioning
+      // used for the first touch
+      a = 1.0;
+      b = 2.0;
+      c = 0.0;
+   }
+   else
+   {
+      for (int i = 0; i < n; i++)
+      {
+         a(i) = 1.0;
+         b(i) = 2.0;
+         c(i) = 0.0;
+      }
+   }
+   SetMemoryPlacement(MemoryPlacement::DEFAULT);
+
+   // Number of vectors read and written by each kernel
+   const double words[4] = { 2.0, 2.0, 3.0, 3.0 };
+   const double s = 3.0;
+   double best[4];
+   for (int k = 0; k < 4; k++) { best[k] = infinity(); }
+
+   StopWatch sw;
+   for (int it = 0; it < iterations; it++)
+   {
+      for (int k = 0; k < 4; k++)
+      {
+         sw.Clear();
+         sw.Start();
+         switch (k)
+         {
+            case 0: c.Set(1.0, a); break;
+            case 1: b.Set(s, c); break;
+            case 2: add(a, b, c); break;
+            case 3: add(b, s, c, a); break;
+         }
+         sw.Stop();
+         // The first iteration is not timed, it may include the transfers to
+         // the device
+         if (it > 0) { best[k] = std::min(best[k], sw.RealTime()); }
+      }
+   }
+   a.Pull();
+   MFEM_VERIFY(a.Min() > 0.0, "invalid result");
+
+   for (int k = 0; k < 4; k++)
+   {
+      bw[k] = words[k]*sizeof(double)*n/best[k]/1e9;
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   // 1. Parse command-line options.
+   int n = 10000000;
+   int iterations = 10;
+   int num_threads = 0;
+   const char *device = "cpu";
+
+   OptionsParser args(argc, argv);
+   args.AddOption(&n, "-n", "--size",
+                  "Number of entries of the vectors.");
+   args.AddOption(&iterations, "-it", "--iterations",
+                  "Number of times each kernel is run; the best time is used.");
+   args.AddOption(&num_threads, "-nt", "--num-threads",
+                  "Number of OpenMP threads, 0 = default.");
+   args.AddOption(&device, "-d", "--device",
+                  "Device configuration string, see Device::Configure().");
+   args.Parse();
+   if (!args.Good() || iterations < 2)
+   {
+      args.PrintUsage(cout);
+      return 1;
+   }
+   args.PrintOptions(cout);
+
+   // 2. Configure the device and the number of threads.
+   Device::Configure(device);
+   if (num_threads > 0) { Device::SetNumThreads(num_threads); }
+   Device::Print();
+   Device::Enable();
+
+   // 3. Run the benchmark with both placement policies.
+   double bw[2][4];
+   RunStream(n, iterations, false, bw[0]);
+   RunStream(n, iterations, true, bw[1]);
+
+   const char *name[4] = { "Copy", "Scale", "Add", "Triad" };
+   cout << "\nVector size: " << n << " (" << 3.0*n*sizeof(double)/1e9
+        << " GB for the three vectors)\n\n"
+        << "Bandwidth in GB/s   default    first-touch\n";
+   for (int k = 0; k < 4; k++)
+   {
+      cout << setw(10) << left << name[k] << right << fixed << setprecision(2)
+           << setw(16) << bw[0][k] << setw(15) << bw[1][k] << '\n';
+   }
+   cout << flush;
+
+   return 0;
+}
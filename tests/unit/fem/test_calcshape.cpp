@@ -198,3 +198,75 @@ TEST_CASE("CalcShape for several H1 FiniteElement instances",
    }
 
 }
+
+/**
+ * Tests the shape tables of a FiniteElement against CalcShape and CalcDShape.
+ */
+void TestShapeTable(FiniteElement* fe, const IntegrationRule &ir)
+{
+   const int dof = fe->GetDof(), dim = fe->GetDim();
+   const ShapeTable *table = fe->GetShapeTable(ir);
+   REQUIRE(table != NULL);
+   // The table is computed once per rule
+   REQUIRE(fe->GetShapeTable(ir) == table);
+
+   // Tables are associated with the points of the rules: a copy of the rule
+   // shares the table, and a rule with other points gets a new table
+   IntegrationRule ir2(ir.GetNPoints());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      ir2.IntPoint(i) = ir.IntPoint(i);
+   }
+   REQUIRE(fe->GetShapeTable(ir2) == table);
+   ir2.IntPoint(0).x = 0.25;
+   ir2.IntPoint(0).y = ir2.IntPoint(0).z = 0.1;
+   const ShapeTable *table2 = fe->GetShapeTable(ir2);
+   REQUIRE(table2 != table);
+   REQUIRE(table2->IntRule.IntPoint(0).x == 0.25);
+   REQUIRE(fe->GetShapeTable(ir) == table);
+
+   // The number of tables is bounded, the tables of other rules are not
+   // computed when the cache is full
+   IntegrationRule ir3(1);
+   int num_tables = 0;
+   for (int i = 0; i < ShapeTableCache::MaxTables + 4; i++)
+   {
+      ir3.IntPoint(0).x = ir3.IntPoint(0).y = ir3.IntPoint(0).z = 0.01*i;
+      if (fe->GetShapeTable(ir3)) { num_tables++; }
+   }
+   REQUIRE(num_tables == ShapeTableCache::MaxTables - 2);
+   REQUIRE(fe->GetShapeTable(ir) == table);
+   REQUIRE(fe->GetShapeTable(ir2) == table2);
+
+   Vector shape(dof);
+   DenseMatrix dshape(dof, dim);
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      fe->CalcShape(ir.IntPoint(i), shape);
+      fe->CalcDShape(ir.IntPoint(i), dshape);
+      // Subtract from copies, the table is shared and must not be modified
+      Vector s(dof);
+      DenseMatrix ds(dof, dim);
+      s = table->GetShape(i);
+      ds = table->GetDShape(i);
+      s -= shape;
+      ds -= dshape;
+      REQUIRE(s.Normlinf() == 0.0);
+      REQUIRE(ds.MaxMaxNorm() == 0.0);
+   }
+}
+
+TEST_CASE("Shape tables of FiniteElement instances",
+          "[Lagrange1DFiniteElement]"
+          "[H1_QuadrilateralElement]"
+          "[H1_TetrahedronElement]")
+{
+   Lagrange1DFiniteElement fe1(3);
+   TestShapeTable(&fe1, IntRules.Get(Geometry::SEGMENT, 7));
+
+   H1_QuadrilateralElement fe2(3);
+   TestShapeTable(&fe2, IntRules.Get(Geometry::SQUARE, 7));
+
+   H1_TetrahedronElement fe3(2);
+   TestShapeTable(&fe3, IntRules.Get(Geometry::TETRAHEDRON, 4));
+}
@@ -0,0 +1,180 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace coefficient
+{
+
+static double func(const Vector &x)
+{
+   return 1.0 + x(0)*x(1) + sin(x(0));
+}
+
+static double func3(const Vector3 &x)
+{
+   return 2.0 + x(0) - x(1)*x(1);
+}
+
+static double sq(double v) { return v*v; }
+
+static void skew(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.2*x(1);
+   y(1) += 0.1*x(0)*x(0);
+}
+
+// Create a quad mesh with two element attributes
+static Mesh *MakeMesh()
+{
+   Mesh *mesh = new Mesh(4, 3, Element::QUADRILATERAL, true);
+   for (int i = 0; i < mesh->GetNE(); i++)
+   {
+      mesh->SetAttribute(i, 1 + i%2);
+   }
+   mesh->SetAttributes();
+   mesh->Transform(skew);
+   return mesh;
+}
+
+TEST_CASE("Batched coefficient evaluation", "[Coefficient]")
+{
+   Mesh *mesh = MakeMesh();
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(mesh, &fec);
+   FunctionCoefficient fcoeff(func);
+   GridFunction gf(&fes);
+   gf.ProjectCoefficient(fcoeff);
+
+   Vector pw(2);
+   pw(0) = 3.0;
+   pw(1) = -1.0;
+
+   ConstantCoefficient c1(2.5);
+   PWConstCoefficient c2(pw);
+   FunctionCoefficient c3(func);
+   FunctionCoefficient c4(func3);
+   GridFunctionCoefficient c5(&gf);
+   TransformedCoefficient c6(&c3, sq);
+   Coefficient *coeffs[6] = { &c1, &c2, &c3, &c4, &c5, &c6 };
+
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 5);
+   QuadratureSpace qspace(mesh, 4);
+   QuadratureFunction qf(&qspace);
+
+   for (int c = 0; c < 6; c++)
+   {
+      Coefficient &Q = *coeffs[c];
+
+      Vector qcoeff, vals;
+      Q.Eval(qcoeff, *mesh, ir);
+      REQUIRE(qcoeff.Size() == ir.GetNPoints()*mesh->GetNE());
+
+      Q.Eval(qf);
+
+      for (int e = 0; e < mesh->GetNE(); e++)
+      {
+         ElementTransformation *T = mesh->GetElementTransformation(e);
+         Q.Eval(vals, *T, ir);
+         REQUIRE(vals.Size() == ir.GetNPoints());
+         for (int i = 0; i < ir.GetNPoints(); i++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(i);
+            T->SetIntPoint(&ip);
+            const double v = Q.Eval(*T, ip);
+            REQUIRE(fabs(vals(i) - v) <= 1e-14 * (1.0 + fabs(v)));
+            // The mesh-wide evaluation may use a different algorithm, e.g.
+            // sum factorization for the GridFunctionCoefficient
+            const double qv = qcoeff(i + e*ir.GetNPoints());
+            REQUIRE(fabs(qv - vals(i)) <= 1e-14 * (1.0 + fabs(v)));
+         }
+
+         const IntegrationRule &qir = qspace.GetElementIntRule(e);
+         qf.GetElementValues(e, vals);
+         for (int i = 0; i < qir.GetNPoints(); i++)
+         {
+            const IntegrationPoint &ip = qir.IntPoint(i);
+            T->SetIntPoint(&ip);
+            const double v = Q.Eval(*T, ip);
+            REQUIRE(fabs(vals(i) - v) <= 1e-14 * (1.0 + fabs(v)));
+         }
+      }
+   }
+
+   delete mesh;
+}
+
+TEST_CASE("Partial assembly with variable coefficients", "[Coefficient]")
+{
+   Mesh *mesh = MakeMesh();
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(mesh, &fec);
+   FunctionCoefficient fcoeff(func);
+   GridFunction gf(&fes);
+   gf.ProjectCoefficient(fcoeff);
+
+   Vector pw(2);
+   pw(0) = 3.0;
+   pw(1) = 0.5;
+   PWConstCoefficient pw_coeff(pw);
+   GridFunctionCoefficient gf_coeff(&gf);
+
+   // Use the same tensor product rule for both assembly levels
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 6);
+
+   Vector x(fes.GetVSize()), y_fa(fes.GetVSize()), y_pa(fes.GetVSize());
+   x.Randomize(1);
+
+   for (int i = 0; i < 4; i++)
+   {
+      Coefficient &Q = (i % 2) ? (Coefficient &) gf_coeff : pw_coeff;
+      const bool mass = (i < 2);
+
+      BilinearFormIntegrator *integ_fa, *integ_pa;
+      if (mass)
+      {
+         integ_fa = new MassIntegrator(Q);
+         integ_pa = new MassIntegrator(Q);
+      }
+      else
+      {
+         integ_fa = new DiffusionIntegrator(Q);
+         integ_pa = new DiffusionIntegrator(Q);
+      }
+      integ_fa->SetIntRule(&ir);
+      integ_pa->SetIntRule(&ir);
+
+      BilinearForm a_fa(&fes), a_pa(&fes);
+      a_fa.AddDomainIntegrator(integ_fa);
+      a_pa.AddDomainIntegrator(integ_pa);
+      a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_fa.Assemble();
+      a_pa.Assemble();
+
+      Array<int> ess_tdof_list;
+      OperatorHandle A_fa, A_pa;
+      a_fa.FormSystemMatrix(ess_tdof_list, A_fa);
+      a_pa.FormSystemMatrix(ess_tdof_list, A_pa);
+
+      A_fa->Mult(x, y_fa);
+      A_pa->Mult(x, y_pa);
+      y_pa -= y_fa;
+      REQUIRE(y_pa.Normlinf() < 1e-12 * y_fa.Normlinf());
+   }
+
+   delete mesh;
+}
+
+} // namespace coefficient
@@ -12,6 +12,8 @@
 #include "mfem.hpp"
 #include "catch.hpp"
 #include <stdio.h>
+#include <fstream>
+#include <sstream>
 
 #ifndef _WIN32
 #include <unistd.h> // rmdir
@@ -100,3 +102,110 @@ TEST_CASE("Visit data collection for input and output", "[VisItDataCollection]")
       REQUIRE(rmdir("base_00005") == 0);
    }
 }
+
+static double smooth_func(const Vector &x)
+{
+   return sin(3.0*x(0))*cos(2.0*x(1)) + 1e-3*x(0);
+}
+
+static long file_size(const char *fname)
+{
+   std::ifstream file(fname, std::ios::binary | std::ios::ate);
+   return file ? (long) file.tellg() : -1;
+}
+
+TEST_CASE("Compressed floating-point data", "[FPCompression]")
+{
+   // several chunks, runs of zeros, non-finite and very large values
+   const int n = 3*FPCompression::chunk_size + 123;
+   Vector x(n);
+   for (int i = 0; i < n; i++)
+   {
+      x(i) = (i % 1000 < 300) ? 0.0 : sin(0.001*i) + 1e-6*(i % 7);
+   }
+   x(5) = 1e300;
+   x(n-1) = -1e-300;
+   x(FPCompression::chunk_size + 17) = infinity();
+
+   for (int codec = FPCompression::NONE; codec <= FPCompression::LOSSY;
+        codec++)
+   {
+      const double tol = 1e-5;
+      std::stringstream ss;
+      FPCompression::Write(ss, x.GetData(), n, codec, tol);
+
+      Vector y(n);
+      FPCompression::Read(ss, y.GetData(), n);
+      for (int i = 0; i < n; i++)
+      {
+         if (codec == FPCompression::LOSSY && i > FPCompression::chunk_size+17)
+         {
+            // chunks without non-finite values are quantized
+            REQUIRE(fabs(x(i) - y(i)) <= tol);
+         }
+         else
+         {
+            REQUIRE(x(i) == y(i));
+         }
+      }
+      if (codec != FPCompression::NONE)
+      {
+         REQUIRE(ss.str().size() < n*sizeof(double));
+      }
+   }
+}
+
+TEST_CASE("Visit data collection with compressed fields",
+          "[VisItDataCollection]")
+{
+   Mesh mesh(16, 16, Element::QUADRILATERAL, 0, 1.0, 1.0);
+   H1_FECollection fec(3, 2);
+   FiniteElementSpace fespace(&mesh, &fec);
+   GridFunction u(&fespace);
+   FunctionCoefficient coeff(smooth_func);
+   u.ProjectCoefficient(coeff);
+
+   const double tol = 1e-6;
+   const int codecs[3] =
+   {
+      FPCompression::NONE, FPCompression::LOSSLESS, FPCompression::LOSSY
+   };
+   long sizes[3];
+
+   for (int c = 0; c < 3; c++)
+   {
+      VisItDataCollection dc("compressed", &mesh);
+      dc.RegisterField("u", &u);
+      dc.SetCycle(1);
+      dc.SetPrecision(16);
+      dc.SetCompression(codecs[c], tol);
+      dc.Save();
+      sizes[c] = file_size("compressed_000001/u.000000");
+
+      VisItDataCollection dc_new("compressed");
+      dc_new.Load(1);
+      REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+      GridFunction *u_new = dc_new.GetField("u");
+      REQUIRE(u_new);
+      REQUIRE(u_new->Size() == u.Size());
+
+      Vector diff(*u_new);
+      diff -= u;
+      if (codecs[c] == FPCompression::LOSSLESS)
+      {
+         REQUIRE(diff.Normlinf() == 0.0);
+      }
+      else
+      {
+         REQUIRE(diff.Normlinf() <= tol);
+      }
+
+      REQUIRE(remove("compressed_000001.mfem_root") == 0);
+      REQUIRE(remove("compressed_000001/mesh.000000") == 0);
+      REQUIRE(remove("compressed_000001/u.000000") == 0);
+      REQUIRE(rmdir("compressed_000001") == 0);
+   }
+
+   REQUIRE(sizes[1] < sizes[0]);
+   REQUIRE(5*sizes[2] < sizes[0]);
+}
@@ -14,6 +14,9 @@ using namespace mfem;
 
 #include "catch.hpp"
 
+#include <thread>
+#include <vector>
+
 //You typically want to start by testing things one object at a time.
 TEST_CASE("Integration rule container with no refinement", "[IntegrationRules]")
 {
@@ -85,6 +88,89 @@ TEST_CASE("Integration rule container with no refinement", "[IntegrationRules]")
       }
       REQUIRE(true);
    }
+
+   SECTION("prewarmed intrules are returned without regeneration")
+   {
+      my_intrules.Prewarm(12);
+      const IntegrationRule *ir1 = &my_intrules.Get(Geometry::PRISM, 12);
+      const IntegrationRule *ir2 = &my_intrules.Get(Geometry::PRISM, 12);
+      REQUIRE(ir1 == ir2);
+      REQUIRE(ir1->GetOrder() >= 12);
+
+      double w = 0.0;
+      for (int i = 0; i < ir1->GetNPoints(); i++)
+      {
+         w += ir1->IntPoint(i).weight;
+      }
+      REQUIRE(fabs(w - 0.5) < 1e-12);
+   }
+}
+
+TEST_CASE("Prewarmed 1D bases", "[IntegrationRules]")
+{
+   Poly_1D poly;
+   poly.Prewarm(6);
+   Poly_1D::Basis &b1 = poly.GetBasis(4, BasisType::GaussLobatto);
+   Poly_1D::Basis &b2 = poly.GetBasis(4, BasisType::GaussLobatto);
+   REQUIRE(&b1 == &b2);
+   REQUIRE(poly.GetPoints(3, BasisType::GaussLegendre) ==
+           poly.GetPoints(3, BasisType::GaussLegendre));
+
+   const int *binom = Poly_1D::Binom(6);
+   REQUIRE(binom[0] == 1);
+   REQUIRE(binom[3] == 20);
+   REQUIRE(binom[6] == 1);
+}
+
+TEST_CASE("Concurrent requests of the same rules", "[IntegrationRules]")
+{
+   // All threads request the same rules and bases, in the same order, from
+   // containers where they have not been generated yet
+   const int num_threads = 8, max_order = 16;
+   IntegrationRules my_intrules(0, Quadrature1D::GaussLegendre);
+   Poly_1D poly;
+
+   std::vector<std::vector<const void*> > results(num_threads);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < num_threads; t++)
+   {
+      threads.push_back(std::thread([&, t]()
+      {
+         std::vector<const void*> &res = results[t];
+         for (int order = 0; order <= max_order; order++)
+         {
+            for (int g = 0; g < Geometry::NumGeom; g++)
+            {
+               res.push_back(&my_intrules.Get(g, order));
+            }
+            res.push_back(poly.GetPoints(order, BasisType::GaussLobatto));
+            res.push_back(&poly.GetBasis(order, BasisType::GaussLegendre));
+         }
+      }));
+   }
+   for (int t = 0; t < num_threads; t++) { threads[t].join(); }
+
+   // Every request returned the same object in all threads, and the rules
+   // integrate the constant exactly
+   for (int t = 1; t < num_threads; t++)
+   {
+      REQUIRE(results[t] == results[0]);
+   }
+   const double volume[Geometry::NumGeom] =
+   { 1.0, 1.0, 0.5, 1.0, 1.0/6.0, 1.0, 0.5 };
+   for (int order = 0; order <= max_order; order++)
+   {
+      for (int g = 0; g < Geometry::NumGeom; g++)
+      {
+         const IntegrationRule &ir = my_intrules.Get(g, order);
+         double w = 0.0;
+         for (int i = 0; i < ir.GetNPoints(); i++)
+         {
+            w += ir.IntPoint(i).weight;
+         }
+         REQUIRE(fabs(w - volume[g]) < 1e-12);
+      }
+   }
 }
 
 
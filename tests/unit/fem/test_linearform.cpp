@@ -0,0 +1,100 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace linearform
+{
+
+static double f3(const Vector3 &x)
+{
+   return 1.0 + x(0)*x(0) - 2.0*x(1) + x(0)*x(1);
+}
+
+static void skew(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.3*x(1);
+   y(1) += 0.1*x(0)*x(0);
+}
+
+static void TestPartialAssembly(Mesh &mesh, int order)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+
+   ConstantCoefficient one(2.5);
+   FunctionCoefficient func(f3);
+
+   LinearForm b_full(&fes), b_pa(&fes);
+   b_full.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b_full.AddDomainIntegrator(new DomainLFIntegrator(func));
+   b_pa.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b_pa.AddDomainIntegrator(new DomainLFIntegrator(func));
+   b_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+
+   b_full.Assemble();
+   b_pa.Assemble();
+
+   REQUIRE(b_full.Normlinf() > 0.0);
+   b_pa -= b_full;
+   REQUIRE(b_pa.Normlinf() < 1e-12 * b_full.Normlinf());
+}
+
+TEST_CASE("LinearForm partial assembly", "[LinearForm]")
+{
+   SECTION("2D")
+   {
+      Mesh mesh(5, 4, Element::QUADRILATERAL, true);
+      mesh.Transform(skew);
+      for (int order = 1; order <= 3; order++)
+      {
+         TestPartialAssembly(mesh, order);
+      }
+   }
+
+   SECTION("3D")
+   {
+      Mesh mesh(3, 2, 3, Element::HEXAHEDRON, true);
+      mesh.Transform(skew);
+      for (int order = 1; order <= 3; order++)
+      {
+         TestPartialAssembly(mesh, order);
+      }
+   }
+}
+
+TEST_CASE("LinearForm domain assembly", "[LinearForm]")
+{
+   // The element loop of the domain integrators may run in parallel: the sum
+   // of the entries must still be the integral of the coefficient.
+   Mesh mesh(6, 6, 6, Element::HEXAHEDRON, true);
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+
+   REQUIRE(fabs(b.Sum() - 1.0) < 1e-12);
+
+   // Repeated assembly gives bit-for-bit the same result.
+   Vector b0(b);
+   b.Assemble();
+   b0 -= b;
+   REQUIRE(b0.Normlinf() == 0.0);
+}
+
+} // namespace linearform
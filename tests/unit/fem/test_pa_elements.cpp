@@ -0,0 +1,174 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace pa_elements
+{
+
+static void skew(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.2*x(1);
+   y(1) += 0.1*x(0)*x(0);
+}
+
+// Compare the partially assembled action on element ranges and the restriction
+// on dof subsets, as used to overlap communication and computation in
+// parallel, with the action on all elements.
+static void TestElementRanges(Mesh &mesh, int order, int vdim)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec, vdim, Ordering::byVDIM);
+   ElemRestriction R(fes);
+   const int ne = mesh.GetNE();
+
+   ConstantCoefficient two(2.0);
+   BilinearFormIntegrator *integ[2] =
+   {
+      new DiffusionIntegrator(two), new MassIntegrator()
+   };
+
+   Vector x(fes.GetVSize()), x_e(R.nedofs*R.vdim), y_e(x_e.Size());
+   Vector x_e2(x_e.Size()), y_e2(x_e.Size());
+   x.Randomize(1);
+   R.Mult(x, x_e);
+
+   // Restriction on a subset of the dofs
+   Array<int> dofs;
+   for (int i = 0; i < fes.GetNDofs(); i += 3) { dofs.Append(i); }
+   x_e2 = 0.0;
+   R.MultDofs(dofs, x, x_e2);
+   for (int i = 0; i < dofs.Size(); i++)
+   {
+      for (int j = R.offsets[dofs[i]]; j < R.offsets[dofs[i]+1]; j++)
+      {
+         for (int c = 0; c < vdim; c++)
+         {
+            const int k = c + vdim*R.indices[j];
+            REQUIRE(x_e2(k) == x_e(k));
+            x_e2(k) = 0.0;
+         }
+      }
+   }
+   // The other entries are not set
+   REQUIRE(x_e2.Normlinf() == 0.0);
+
+   Vector y(fes.GetVSize()), y2(fes.GetVSize());
+   R.MultTranspose(x_e, y);
+   y2 = 0.0;
+   R.MultTransposeDofs(dofs, x_e, y2);
+   for (int i = 0; i < dofs.Size(); i++)
+   {
+      for (int c = 0; c < vdim; c++)
+      {
+         const int vdof = fes.DofToVDof(dofs[i], c);
+         REQUIRE(y2(vdof) == y(vdof));
+      }
+   }
+
+   if (vdim > 1) { return; }
+   for (int i = 0; i < 2; i++)
+   {
+      REQUIRE(integ[i]->SupportsElementRanges());
+      integ[i]->Assemble(fes);
+      y_e = 0.0;
+      integ[i]->MultAssembled(x_e, y_e);
+      y_e2 = 0.0;
+      const int ranges[4] = { 0, ne/3, ne/3 + 1, ne };
+      for (int r = 0; r < 3; r++)
+      {
+         integ[i]->MultAssembled(x_e, y_e2, ranges[r], ranges[r+1]);
+      }
+      y_e2 -= y_e;
+      REQUIRE(y_e2.Normlinf() <= 1e-14 * y_e.Normlinf());
+   }
+
+   for (int i = 0; i < 2; i++) { delete integ[i]; }
+}
+
+TEST_CASE("Partial assembly on element ranges", "[PartialAssembly]")
+{
+   SECTION("Quadrilaterals")
+   {
+      Mesh mesh(4, 3, Element::QUADRILATERAL, true);
+      mesh.Transform(skew);
+      TestElementRanges(mesh, 3, 1);
+      TestElementRanges(mesh, 2, 2);
+   }
+
+   SECTION("Hexahedra")
+   {
+      Mesh mesh(2, 3, 2, Element::HEXAHEDRON, true);
+      TestElementRanges(mesh, 2, 1);
+   }
+}
+
+// Compare the diagonals of the partially assembled element matrices with the
+// action of the element matrices on the unit vectors.
+static void TestDiagonal(Mesh &mesh, int order)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   ElemRestriction R(fes);
+   const int ne = mesh.GetNE(), nd = R.dof;
+
+   ConstantCoefficient two(2.0);
+   BilinearFormIntegrator *integ[2] =
+   {
+      new DiffusionIntegrator(two), new MassIntegrator()
+   };
+
+   Vector diag(nd*ne), x_e(nd*ne), y_e(nd*ne);
+   for (int i = 0; i < 2; i++)
+   {
+      REQUIRE(integ[i]->SupportsDiagonalPA());
+      integ[i]->Assemble(fes);
+      diag = 0.0;
+      integ[i]->AssembleDiagonalPA(diag);
+      for (int k = 0; k < nd; k++)
+      {
+         x_e = 0.0;
+         for (int e = 0; e < ne; e++) { x_e(k + nd*e) = 1.0; }
+         y_e = 0.0;
+         integ[i]->MultAssembled(x_e, y_e);
+         for (int e = 0; e < ne; e++)
+         {
+            REQUIRE(fabs(y_e(k + nd*e) - diag(k + nd*e)) <=
+                    1e-12 * diag.Normlinf());
+         }
+      }
+   }
+
+   for (int i = 0; i < 2; i++) { delete integ[i]; }
+}
+
+TEST_CASE("Partial assembly diagonal", "[PartialAssembly]")
+{
+   SECTION("Quadrilaterals")
+   {
+      Mesh mesh(3, 2, Element::QUADRILATERAL, true);
+      mesh.Transform(skew);
+      TestDiagonal(mesh, 4);
+   }
+
+   SECTION("Hexahedra")
+   {
+      Mesh mesh(2, 1, 2, Element::HEXAHEDRON, true);
+      mesh.Transform(skew);
+      TestDiagonal(mesh, 3);
+   }
+}
+
+} // namespace pa_elements
@@ -0,0 +1,177 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace quadinterpolator
+{
+
+static double func(const Vector &x)
+{
+   double r = 1.0 + x(0)*x(1) + sin(x(0));
+   if (x.Size() == 3) { r += x(2)*x(0); }
+   return r;
+}
+
+static void vfunc(const Vector &x, Vector &v)
+{
+   v(0) = func(x);
+   v(1) = x(0) - x(1)*x(1);
+}
+
+static void skew(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.2*x(1);
+   y(1) += 0.1*x(0)*x(0);
+}
+
+// Compare the QuadratureInterpolator with the element-wise evaluation
+static void TestInterpolation(Mesh &mesh, int order, int vdim,
+                              bool expect_tensor)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vdim);
+   GridFunction gf(&fes);
+   if (vdim == 1)
+   {
+      FunctionCoefficient coeff(func);
+      gf.ProjectCoefficient(coeff);
+   }
+   else
+   {
+      VectorFunctionCoefficient coeff(vdim, vfunc);
+      gf.ProjectCoefficient(coeff);
+   }
+
+   const Geometry::Type geom = fes.GetFE(0)->GetGeomType();
+   const IntegrationRule &ir = IntRules.Get(geom, 2*order + 1);
+   REQUIRE(QuadratureInterpolator::Supports(fes));
+   QuadratureInterpolator qi(fes, ir);
+   REQUIRE(qi.UsesTensorProducts() == expect_tensor);
+
+   Vector q_val, q_der, q_det;
+   qi.Values(gf, q_val);
+   qi.PhysDerivatives(gf, q_der);
+   qi.Determinants(q_det);
+
+   const int nq = ir.GetNPoints();
+   DenseMatrix grad;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      ElementTransformation *T = mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T->SetIntPoint(&ip);
+         REQUIRE(fabs(q_det(q + nq*e) - T->Weight()) < 1e-12);
+
+         gf.GetVectorGradient(*T, grad);
+         for (int c = 0; c < vdim; c++)
+         {
+            const double v = gf.GetValue(e, ip, c+1);
+            REQUIRE(fabs(q_val(c + vdim*(q + nq*e)) - v) < 1e-12);
+            for (int j = 0; j < dim; j++)
+            {
+               const double d = q_der(c + vdim*(j + dim*(q + nq*e)));
+               REQUIRE(fabs(d - grad(c,j)) < 1e-10);
+            }
+         }
+      }
+   }
+}
+
+TEST_CASE("Quadrature interpolation", "[QuadratureInterpolator]")
+{
+   SECTION("Quadrilaterals")
+   {
+      Mesh mesh(4, 3, Element::QUADRILATERAL, true);
+      mesh.Transform(skew);
+      for (int order = 1; order <= 4; order++)
+      {
+         TestInterpolation(mesh, order, 1, true);
+      }
+      TestInterpolation(mesh, 2, 2, true);
+   }
+
+   SECTION("Curved quadrilaterals")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+      mesh.SetCurvature(3);
+      mesh.Transform(skew);
+      TestInterpolation(mesh, 2, 1, true);
+   }
+
+   SECTION("Hexahedra")
+   {
+      Mesh mesh(2, 3, 2, Element::HEXAHEDRON, true);
+      mesh.Transform(skew);
+      for (int order = 1; order <= 3; order++)
+      {
+         TestInterpolation(mesh, order, 1, true);
+      }
+   }
+
+   SECTION("Triangles")
+   {
+      Mesh mesh(3, 3, Element::TRIANGLE, true);
+      mesh.Transform(skew);
+      TestInterpolation(mesh, 3, 1, false);
+      TestInterpolation(mesh, 2, 2, false);
+   }
+}
+
+TEST_CASE("Error norms with quadrature interpolation",
+          "[QuadratureInterpolator]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+   mesh.Transform(skew);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction gf(&fes);
+   FunctionCoefficient coeff(func);
+   gf.ProjectCoefficient(coeff);
+
+   // Reference value computed element by element
+   double ref = 0.0;
+   Vector vals;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 5);
+      ElementTransformation *T = mesh.GetElementTransformation(e);
+      gf.GetValues(e, ir, vals);
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T->SetIntPoint(&ip);
+         const double err = vals(q) - coeff.Eval(*T, ip);
+         ref += ip.weight * T->Weight() * err * err;
+      }
+   }
+   ref = sqrt(ref);
+
+   REQUIRE(ref > 0.0);
+   REQUIRE(fabs(gf.ComputeL2Error(coeff) - ref) < 1e-12 * ref);
+
+   L2_FECollection l2_fec(0, 2);
+   FiniteElementSpace l2_fes(&mesh, &l2_fec);
+   GridFunction errors(&l2_fes);
+   gf.ComputeElementL2Errors(coeff, errors);
+   double sum = 0.0;
+   for (int e = 0; e < mesh.GetNE(); e++) { sum += errors(e)*errors(e); }
+   REQUIRE(fabs(sqrt(sum) - ref) < 1e-12 * ref);
+}
+
+} // namespace quadinterpolator
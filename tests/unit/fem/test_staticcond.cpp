@@ -0,0 +1,270 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace staticcond
+{
+
+static double f(const Vector &x)
+{
+   return 1.0 + x(0)*x(1) + sin(2.0*x(0));
+}
+
+static void vf(const Vector &x, Vector &v)
+{
+   v(0) = f(x);
+   v(1) = x(0) - x(1)*x(1);
+}
+
+static void skew(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.2*x(1);
+   y(1) += 0.1*x(0)*x(0);
+}
+
+static void Solve(const SparseMatrix &A, const Vector &B, Vector &X)
+{
+   GSSmoother M(A);
+   X = 0.0;
+   PCG(A, M, B, X, 0, 2000, 1e-24, 0.0);
+}
+
+// Compare the assembly of the static condensation from precomputed element
+// matrices with the element by element assembly, and the recovered solution
+// with the solution of the full system.
+static void TestStaticCondensation(Mesh &mesh, int order, int vdim)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec, vdim);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   FunctionCoefficient coeff(f);
+   VectorFunctionCoefficient vcoeff(vdim, vf);
+   LinearForm b(&fes);
+   if (vdim == 1)
+   {
+      b.AddDomainIntegrator(new DomainLFIntegrator(coeff));
+   }
+   else
+   {
+      b.AddDomainIntegrator(new VectorDomainLFIntegrator(vcoeff));
+   }
+   b.Assemble();
+
+   ConstantCoefficient one(1.0), two(2.0);
+   BilinearForm *a[3];
+   for (int i = 0; i < 3; i++)
+   {
+      a[i] = new BilinearForm(&fes);
+      if (vdim == 1)
+      {
+         a[i]->AddDomainIntegrator(new DiffusionIntegrator(two));
+         a[i]->AddDomainIntegrator(new MassIntegrator(one));
+      }
+      else
+      {
+         a[i]->AddDomainIntegrator(new ElasticityIntegrator(one, two));
+      }
+   }
+   a[1]->EnableStaticCondensation();
+   a[2]->EnableStaticCondensation();
+   a[2]->ComputeElementMatrices();
+
+   GridFunction x[3] = { GridFunction(&fes), GridFunction(&fes),
+                         GridFunction(&fes)
+                       };
+   SparseMatrix A[3];
+   Vector X[3], B[3];
+   for (int i = 0; i < 3; i++)
+   {
+      x[i] = 0.0;
+      a[i]->Assemble();
+      a[i]->FormLinearSystem(ess_tdof_list, x[i], b, A[i], X[i], B[i]);
+   }
+   REQUIRE(A[1].Height() < A[0].Height());
+   REQUIRE(A[2].Height() == A[1].Height());
+   REQUIRE(A[2].NumNonZeroElems() == A[1].NumNonZeroElems());
+
+   SparseMatrix *diff = Add(1.0, A[2], -1.0, A[1]);
+   REQUIRE(diff->MaxNorm() <= 1e-14 * A[1].MaxNorm());
+   delete diff;
+   Vector B_diff(B[2]);
+   B_diff -= B[1];
+   REQUIRE(B_diff.Normlinf() <= 1e-14 * B[1].Normlinf());
+
+   for (int i = 0; i < 3; i++)
+   {
+      Solve(A[i], B[i], X[i]);
+      a[i]->RecoverFEMSolution(X[i], b, x[i]);
+   }
+   for (int i = 1; i < 3; i++)
+   {
+      x[i] -= x[0];
+      REQUIRE(x[i].Normlinf() <= 1e-9 * x[0].Normlinf());
+   }
+
+   for (int i = 0; i < 3; i++) { delete a[i]; }
+}
+
+TEST_CASE("Static condensation", "[StaticCondensation]")
+{
+   SECTION("Scalar H1, quadrilaterals")
+   {
+      Mesh mesh(4, 3, Element::QUADRILATERAL, true);
+      mesh.Transform(skew);
+      TestStaticCondensation(mesh, 3, 1);
+   }
+
+   SECTION("Scalar H1, triangles")
+   {
+      Mesh mesh(3, 3, Element::TRIANGLE, true);
+      TestStaticCondensation(mesh, 4, 1);
+   }
+
+   SECTION("Vector H1, quadrilaterals")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+      mesh.Transform(skew);
+      TestStaticCondensation(mesh, 3, 2);
+   }
+}
+
+// Compare the matrix-free static condensation of a partially assembled form
+// with the solution of the full, partially assembled, system. Assembling the
+// full system instead would dominate the run time at high orders.
+static void TestPAStaticCondensation(Mesh &mesh, int order)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   FunctionCoefficient coeff(f);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(coeff));
+   b.Assemble();
+
+   ConstantCoefficient one(1.0), two(2.0);
+   BilinearForm a_full(&fes), a_sc(&fes);
+   a_full.AddDomainIntegrator(new DiffusionIntegrator(two));
+   a_full.AddDomainIntegrator(new MassIntegrator(one));
+   a_full.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_sc.AddDomainIntegrator(new DiffusionIntegrator(two));
+   a_sc.AddDomainIntegrator(new MassIntegrator(one));
+   a_sc.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_sc.EnableStaticCondensation();
+   REQUIRE(a_sc.StaticCondensationIsEnabled());
+
+   // Use boundary values that are not zero
+   GridFunction x_full(&fes), x_sc(&fes);
+   x_full.ProjectCoefficient(coeff);
+   x_sc = x_full;
+
+   // Use a copy of b, in case it is modified when forming the system
+   OperatorHandle A_full, A_sc;
+   Vector b_full(b), X_full, B_full, X_sc, B_sc;
+   a_full.Assemble();
+   a_full.FormLinearSystem(ess_tdof_list, x_full, b_full, A_full, X_full,
+                           B_full);
+   CG(*A_full, B_full, X_full, 0, 5000, 1e-24, 0.0);
+   a_full.RecoverFEMSolution(X_full, b_full, x_full);
+
+   a_sc.Assemble();
+   a_sc.FormLinearSystem(ess_tdof_list, x_sc, b, A_sc, X_sc, B_sc);
+   REQUIRE(A_sc->Height() < fes.GetVSize());
+   CG(*A_sc, B_sc, X_sc, 0, 2000, 1e-24, 0.0);
+   a_sc.RecoverFEMSolution(X_sc, b, x_sc);
+
+   x_sc -= x_full;
+   REQUIRE(x_sc.Normlinf() <= 1e-9 * x_full.Normlinf());
+}
+
+TEST_CASE("Partial assembly static condensation", "[StaticCondensation]")
+{
+   SECTION("Quadrilaterals")
+   {
+      Mesh mesh(4, 3, Element::QUADRILATERAL, true);
+      mesh.Transform(skew);
+      TestPAStaticCondensation(mesh, 4);
+   }
+
+   SECTION("Hexahedra")
+   {
+      Mesh mesh(2, 2, 3, Element::HEXAHEDRON, true);
+      TestPAStaticCondensation(mesh, 3);
+   }
+
+   SECTION("High order hexahedra")
+   {
+      // 125 interior dofs per element
+      Mesh mesh(2, 1, 2, Element::HEXAHEDRON, true);
+      TestPAStaticCondensation(mesh, 6);
+   }
+}
+
+TEST_CASE("Hybridization", "[Hybridization]")
+{
+   Mesh mesh(4, 3, Element::QUADRILATERAL, true);
+   mesh.Transform(skew);
+   const int dim = mesh.Dimension();
+   const int order = 1;
+
+   RT_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   DG_Interface_FECollection hfec(order, dim);
+   FiniteElementSpace hfes(&mesh, &hfec);
+
+   Array<int> ess_tdof_list;
+
+   VectorFunctionCoefficient coeff(dim, vf);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new VectorFEDomainLFIntegrator(coeff));
+   b.Assemble();
+
+   ConstantCoefficient one(1.0), two(2.0);
+   BilinearForm *a[2];
+   for (int i = 0; i < 2; i++)
+   {
+      a[i] = new BilinearForm(&fes);
+      a[i]->AddDomainIntegrator(new DivDivIntegrator(one));
+      a[i]->AddDomainIntegrator(new VectorFEMassIntegrator(two));
+   }
+   a[1]->EnableHybridization(&hfes, new NormalTraceJumpIntegrator(),
+                             ess_tdof_list);
+
+   GridFunction x[2] = { GridFunction(&fes), GridFunction(&fes) };
+   for (int i = 0; i < 2; i++)
+   {
+      SparseMatrix A;
+      Vector X, B;
+      x[i] = 0.0;
+      a[i]->Assemble();
+      a[i]->FormLinearSystem(ess_tdof_list, x[i], b, A, X, B);
+      Solve(A, B, X);
+      a[i]->RecoverFEMSolution(X, b, x[i]);
+   }
+   x[1] -= x[0];
+   REQUIRE(x[1].Normlinf() <= 1e-9 * x[0].Normlinf());
+
+   for (int i = 0; i < 2; i++) { delete a[i]; }
+}
+
+} // namespace staticcond
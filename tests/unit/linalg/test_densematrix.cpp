@@ -155,3 +155,62 @@ TEST_CASE("DenseMatrix A*B^T methods",
    }
 }
 
+
+TEST_CASE("Batched LU factorization", "[DenseMatrix]")
+{
+   // sizes with a specialized kernel, the generic kernel, a specialized
+   // interior block size and the fallback; 11 matrices do not fill the last
+   // group of the batched kernels
+   const int sizes[5] = { 3, 8, 13, 27, 70 };
+   const int nb = 11;
+   for (int s = 0; s < 5; s++)
+   {
+      const int m = sizes[s];
+      DenseTensor A(m, m, nb);
+      Vector a(A.Data(), m*m*nb);
+      a.Randomize(s+1);
+      // pivoting is required by the zero diagonal of the first matrix
+      for (int i = 0; i < m; i++) { A(i,i,0) = 0.0; }
+      for (int k = 1; k < nb; k++)
+      {
+         for (int i = 0; i < m; i++) { A(i,i,k) += 1.0; }
+      }
+
+      DenseTensor LU(A), A_inv(A);
+      Array<int> P;
+      BatchLUFactor(LU, P);
+      BatchInverse(A_inv);
+      REQUIRE(P.Size() == m*nb);
+
+      Vector X(m*nb), B(m*nb), AX(m);
+      X.Randomize(s+5);
+      B = X;
+      BatchLUSolve(LU, P, B);
+
+      Array<int> ipiv(m);
+      DenseMatrix lu(m), I(m);
+      for (int k = 0; k < nb; k++)
+      {
+         // same factors as LUFactors
+         lu = A(k);
+         LUFactors(lu.Data(), ipiv.GetData()).Factor(m);
+         for (int i = 0; i < m; i++)
+         {
+            REQUIRE(ipiv[i] == P[i+k*m]);
+         }
+         lu -= LU(k);
+         REQUIRE(lu.MaxMaxNorm() < 1e-12);
+
+         // A_k B_k = X_k
+         Vector x(X.GetData() + k*m, m), b(B.GetData() + k*m, m);
+         A(k).Mult(b, AX);
+         AX -= x;
+         REQUIRE(AX.Normlinf() < 1e-10 * (1.0 + b.Normlinf()));
+
+         // A_k A_k^{-1} = I
+         Mult(A(k), A_inv(k), I);
+         for (int i = 0; i < m; i++) { I(i,i) -= 1.0; }
+         REQUIRE(I.MaxMaxNorm() < 1e-10 * (1.0 + A_inv(k).MaxMaxNorm()));
+      }
+   }
+}
@@ -0,0 +1,197 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace vector_tests
+{
+
+// Compare the fused kernels with the separate Vector operations
+TEST_CASE("Fused Vector kernels", "[Solvers]")
+{
+   const int n = 1003;
+   Vector x(n), y(n), w(n), v(n), v_ref(n);
+   x.Randomize(1);
+   y.Randomize(2);
+   w.Randomize(3);
+   const double tol = 1e-12 * n;
+
+   SECTION("AddAndDot")
+   {
+      v.Randomize(4);
+      v_ref = v;
+      const double dot = v.AddAndDot(-0.7, x, y);
+      v_ref.Add(-0.7, x);
+      REQUIRE(fabs(dot - v_ref * y) <= tol);
+      const double nrm2 = v.AddAndDot(0.3, x, v);
+      v_ref.Add(0.3, x);
+      REQUIRE(fabs(nrm2 - v_ref * v_ref) <= tol);
+      v -= v_ref;
+      REQUIRE(v.Normlinf() == 0.0);
+   }
+
+   SECTION("SetAndDot")
+   {
+      const double dot = v.SetAndDot(2.0, x, -0.5, y, w);
+      add(2.0, x, -0.5, y, v_ref);
+      REQUIRE(fabs(dot - v_ref * w) <= tol);
+      const double nrm2 = v.SetAndDot(1.0, v, 0.25, x, v);
+      v_ref.Add(0.25, x);
+      REQUIRE(fabs(nrm2 - v_ref * v_ref) <= tol);
+      v -= v_ref;
+      REQUIRE(v.Normlinf() <= 1e-15);
+   }
+
+   SECTION("AddToAndSet")
+   {
+      Vector u(n), u_ref(n);
+      u.Randomize(5);
+      u_ref = u;
+      v.Randomize(4);
+      v_ref = v;
+      v.AddToAndSet(0.6, u, x, -1.5);
+      u_ref.Add(0.6, v_ref);
+      add(x, -1.5, v_ref, v_ref);
+      u -= u_ref;
+      v -= v_ref;
+      REQUIRE(u.Normlinf() == 0.0);
+      REQUIRE(v.Normlinf() == 0.0);
+   }
+
+   SECTION("Dots")
+   {
+      const Vector *vecs[6] = { &x, &y, &w, &x, &w, &y };
+      for (int m = 1; m <= 6; m++)
+      {
+         double dots[6];
+         x.Dots(m, vecs, dots);
+         for (int k = 0; k < m; k++)
+         {
+            REQUIRE(fabs(dots[k] - x * (*vecs[k])) <= tol);
+         }
+      }
+   }
+}
+
+// The Krylov solvers use the fused kernels
+TEST_CASE("Krylov solvers", "[Solvers]")
+{
+   // 1D Laplacian plus a convection term for the nonsymmetric solvers
+   const int n = 50;
+   SparseMatrix A(n), N(n);
+   for (int i = 0; i < n; i++)
+   {
+      A.Add(i, i, 2.0);
+      N.Add(i, i, 2.0);
+      if (i > 0) { A.Add(i, i-1, -1.0); N.Add(i, i-1, -1.3); }
+      if (i < n-1) { A.Add(i, i+1, -1.0); N.Add(i, i+1, -0.7); }
+   }
+   A.Finalize();
+   N.Finalize();
+
+   Vector b(n), x(n), r(n);
+   b.Randomize(5);
+
+   SECTION("CG")
+   {
+      CGSolver cg;
+      cg.SetOperator(A);
+      cg.SetRelTol(1e-12);
+      cg.SetMaxIter(200);
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(cg.GetConverged());
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() <= 1e-10 * b.Norml2());
+   }
+
+   SECTION("PCG")
+   {
+      DSmoother jacobi(A);
+      CGSolver pcg;
+      pcg.SetOperator(A);
+      pcg.SetPreconditioner(jacobi);
+      pcg.SetRelTol(1e-12);
+      pcg.SetMaxIter(200);
+      x = 0.0;
+      pcg.Mult(b, x);
+      REQUIRE(pcg.GetConverged());
+      A.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() <= 1e-10 * b.Norml2());
+   }
+
+   SECTION("CG stopped by the iteration limit")
+   {
+      const int iters = 5;
+      CGSolver cg;
+      cg.SetOperator(A);
+      cg.SetRelTol(1e-12);
+      cg.SetMaxIter(iters);
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(!cg.GetConverged());
+
+      // The textbook CG iteration, starting from x = 0
+      Vector x_ref(n), d(n), z(n);
+      x_ref = 0.0;
+      r = b;
+      d = r;
+      double nom = r * r;
+      for (int i = 0; i < iters; i++)
+      {
+         A.Mult(d, z);
+         const double alpha = nom / (d * z);
+         x_ref.Add(alpha, d);
+         r.Add(-alpha, z);
+         const double betanom = r * r;
+         add(r, betanom / nom, d, d);
+         nom = betanom;
+      }
+      x_ref -= x;
+      REQUIRE(x_ref.Normlinf() <= 1e-12 * x.Normlinf());
+   }
+
+   SECTION("GMRES")
+   {
+      GMRESSolver gmres;
+      gmres.SetOperator(N);
+      gmres.SetKDim(20);
+      gmres.SetRelTol(1e-12);
+      gmres.SetMaxIter(500);
+      x = 0.0;
+      gmres.Mult(b, x);
+      REQUIRE(gmres.GetConverged());
+      N.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() <= 1e-10 * b.Norml2());
+   }
+
+   SECTION("BiCGSTAB")
+   {
+      BiCGSTABSolver bicgstab;
+      bicgstab.SetOperator(N);
+      bicgstab.SetRelTol(1e-12);
+      bicgstab.SetMaxIter(500);
+      x = 0.0;
+      bicgstab.Mult(b, x);
+      REQUIRE(bicgstab.GetConverged());
+      N.Mult(x, r);
+      r -= b;
+      REQUIRE(r.Norml2() <= 1e-10 * b.Norml2());
+   }
+}
+
+} // namespace vector_tests
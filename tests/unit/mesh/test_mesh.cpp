@@ -95,3 +95,409 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
 }
 
 #endif
+
+static bool IsPermutation(const Array<int> &perm)
+{
+   Array<bool> covered(perm.Size());
+   covered = false;
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      if (perm[i] < 0 || perm[i] >= perm.Size() || covered[perm[i]])
+      {
+         return false;
+      }
+      covered[perm[i]] = true;
+   }
+   return true;
+}
+
+// reorder the elements randomly to destroy the locality of the mesh
+static void ScrambleElements(Mesh &mesh)
+{
+   Array<int> perm(mesh.GetNE());
+   for (int i = 0; i < perm.Size(); i++) { perm[i] = i; }
+   srand(12345);
+   for (int i = perm.Size()-1; i > 0; i--)
+   {
+      std::swap(perm[i], perm[rand() % (i+1)]);
+   }
+   mesh.ReorderElements(perm);
+}
+
+TEST_CASE("Native element orderings", "[Mesh]")
+{
+   Mesh::ElementOrdering methods[3] =
+   {
+      Mesh::HILBERT_ORDERING, Mesh::MORTON_ORDERING, Mesh::RCM_ORDERING
+   };
+
+   Mesh *meshes[3] =
+   {
+      // large enough not to fit in the modeled cache
+      new Mesh(80, 60, Element::QUADRILATERAL),
+      new Mesh(20, 16, 12, Element::HEXAHEDRON),
+      new Mesh(14, 12, 10, Element::TETRAHEDRON)
+   };
+
+   for (int m = 0; m < 3; m++)
+   {
+      Mesh &mesh = *meshes[m];
+      ScrambleElements(mesh);
+
+      int bw0;
+      long cm0;
+      mesh.GetElementOrderingStats(bw0, cm0);
+
+      for (int k = 0; k < 3; k++)
+      {
+         Mesh copy(mesh);
+
+         Array<int> perm;
+         copy.GetElementOrdering(methods[k], perm);
+         REQUIRE(perm.Size() == copy.GetNE());
+         REQUIRE(IsPermutation(perm));
+
+         copy.ReorderElementsForLocality(methods[k]);
+         REQUIRE(copy.GetNE() == mesh.GetNE());
+         REQUIRE(copy.GetNV() == mesh.GetNV());
+
+         double vol = 0.0;
+         for (int i = 0; i < copy.GetNE(); i++)
+         {
+            vol += copy.GetElementVolume(i);
+         }
+         REQUIRE(fabs(vol - 1.0) < 1e-12);
+
+         int bw;
+         long cm;
+         copy.GetElementOrderingStats(bw, cm);
+         REQUIRE(bw < bw0);
+         REQUIRE(cm < cm0);
+      }
+
+      // DOF ordering
+      H1_FECollection fec(2, mesh.Dimension());
+      FiniteElementSpace fes(&mesh, &fec);
+
+      int dof_bw0, dof_bw;
+      long dof_cm0, dof_cm;
+      fes.GetDofOrderingStats(dof_bw0, dof_cm0);
+      fes.ReorderElementToDofTableRCM();
+      fes.GetDofOrderingStats(dof_bw, dof_cm);
+      REQUIRE(dof_bw < dof_bw0);
+
+      const Table &el_dof = fes.GetElementToDofTable();
+      Array<bool> covered(fes.GetNDofs());
+      covered = false;
+      for (int k = 0; k < el_dof.Size_of_connections(); k++)
+      {
+         covered[el_dof.GetJ()[k]] = true;
+      }
+      REQUIRE(covered.Find(false) < 0);
+   }
+
+   SECTION("Ordering on load")
+   {
+      std::stringstream mesh_str;
+      meshes[1]->Print(mesh_str);
+
+      Mesh::load_element_ordering = Mesh::HILBERT_ORDERING;
+      Mesh loaded(mesh_str);
+      Mesh::load_element_ordering = Mesh::NATIVE_ORDERING;
+
+      Array<int> perm;
+      loaded.GetHilbertElementOrdering(perm);
+      for (int i = 0; i < perm.Size(); i++)
+      {
+         REQUIRE(perm[i] == i);
+      }
+   }
+
+   for (int m = 0; m < 3; m++) { delete meshes[m]; }
+}
+
+static void CheckSameTransformation(ElementTransformation &T1,
+                                    ElementTransformation &T2,
+                                    const IntegrationRule &ir)
+{
+   REQUIRE(T1.ElementNo == T2.ElementNo);
+   REQUIRE(T1.Attribute == T2.Attribute);
+   DenseMatrix x1, x2;
+   T1.Transform(ir, x1);
+   T2.Transform(ir, x2);
+   x1 -= x2;
+   REQUIRE(x1.MaxMaxNorm() == 0.0);
+}
+
+TEST_CASE("Reentrant face transformations", "[Mesh]")
+{
+   Mesh mesh(3, 3, 3, Element::HEXAHEDRON, true);
+   mesh.EnsureNCMesh();
+   Array<int> refs;
+   refs.Append(0);
+   refs.Append(13);
+   mesh.GeneralRefinement(refs); // hanging nodes, slave faces
+
+   FaceElementTransformations FElTr;
+   IsoparametricTransformation ElTr1, ElTr2, FTr;
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 3);
+
+   for (int f = 0; f < mesh.GetNumFaces(); f++)
+   {
+      mesh.GetFaceElementTransformations(f, FElTr, ElTr1, ElTr2, FTr);
+      FaceElementTransformations *tr = mesh.GetFaceElementTransformations(f);
+
+      REQUIRE(FElTr.Elem1No == tr->Elem1No);
+      REQUIRE(FElTr.Elem2No == tr->Elem2No);
+      REQUIRE(FElTr.Elem1 == &ElTr1);
+      REQUIRE(FElTr.Face == &FTr);
+      CheckSameTransformation(*FElTr.Face, *tr->Face, ir);
+
+      // the point mapped through both elements must be the same as through
+      // the face, for the reentrant version too
+      for (int j = 0; j < ir.GetNPoints(); j++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(j);
+         IntegrationPoint eip;
+         Vector x(3), y(3);
+         FTr.Transform(ip, x);
+         FElTr.Loc1.Transform(ip, eip);
+         ElTr1.Transform(eip, y);
+         y -= x;
+         REQUIRE(y.Normlinf() < 1e-12);
+         if (FElTr.Elem2No >= 0)
+         {
+            REQUIRE(FElTr.Elem2 == &ElTr2);
+            FElTr.Loc2.Transform(ip, eip);
+            ElTr2.Transform(eip, y);
+            y -= x;
+            REQUIRE(y.Normlinf() < 1e-12);
+         }
+      }
+   }
+
+   for (int b = 0; b < mesh.GetNBE(); b++)
+   {
+      FaceElementTransformations *tr = mesh.GetBdrFaceTransformations(b);
+      bool ok = mesh.GetBdrFaceTransformations(b, FElTr, ElTr1, FTr);
+      REQUIRE(ok == (tr != NULL));
+      if (!ok) { continue; }
+      REQUIRE(FElTr.Elem1No == tr->Elem1No);
+      REQUIRE(FTr.Attribute == mesh.GetBdrAttribute(b));
+      CheckSameTransformation(ElTr1, *tr->Elem1, ir);
+   }
+}
+
+static void bend(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.2*x(1);
+   y(1) += 0.1*x(0)*x(0);
+}
+
+static void shear(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.3*x(1);
+   y(1) -= 0.2*x(x.Size()-1);
+}
+
+// Count the affine elements and check their Jacobians against the general
+// evaluation at every point
+static int CheckAffineTransformations(Mesh &mesh)
+{
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 4);
+   IsoparametricTransformation T_ref;
+   int num_affine = 0;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      ElementTransformation *T = mesh.GetElementTransformation(e);
+      mesh.GetElementTransformation(e, &T_ref);
+      T_ref.SetAffine(false);
+      if (T->IsAffine()) { num_affine++; }
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T->SetIntPoint(&ip);
+         T_ref.SetIntPoint(&ip);
+         DenseMatrix diff(T->Jacobian());
+         diff -= T_ref.Jacobian();
+         REQUIRE(diff.MaxMaxNorm() < 1e-12);
+         REQUIRE(fabs(T->Weight() - T_ref.Weight()) < 1e-12);
+         diff = T->InverseJacobian();
+         diff -= T_ref.InverseJacobian();
+         REQUIRE(diff.MaxMaxNorm() < 1e-10);
+      }
+   }
+   return num_affine;
+}
+
+TEST_CASE("Affine element transformations", "[Mesh]")
+{
+   SECTION("Simplices")
+   {
+      Mesh tri(3, 3, Element::TRIANGLE, true);
+      tri.Transform(bend);
+      REQUIRE(CheckAffineTransformations(tri) == tri.GetNE());
+
+      Mesh tet(2, 2, 2, Element::TETRAHEDRON, true);
+      tet.Transform(shear);
+      REQUIRE(CheckAffineTransformations(tet) == tet.GetNE());
+
+      // Linear nodes do not change the transformations
+      tet.SetCurvature(1);
+      REQUIRE(CheckAffineTransformations(tet) == tet.GetNE());
+   }
+
+   SECTION("Tensor product elements")
+   {
+      Mesh quad(3, 2, Element::QUADRILATERAL, true);
+      quad.Transform(shear);
+      REQUIRE(CheckAffineTransformations(quad) == quad.GetNE());
+      quad.Transform(bend);
+      REQUIRE(CheckAffineTransformations(quad) == 0);
+
+      Mesh hex(2, 2, 2, Element::HEXAHEDRON, true);
+      hex.Transform(shear);
+      hex.SetCurvature(1);
+      REQUIRE(CheckAffineTransformations(hex) == hex.GetNE());
+      hex.Transform(bend);
+      REQUIRE(CheckAffineTransformations(hex) == 0);
+   }
+
+   SECTION("Curved elements")
+   {
+      Mesh tri(3, 3, Element::TRIANGLE, true);
+      tri.SetCurvature(2);
+      REQUIRE(CheckAffineTransformations(tri) == 0);
+   }
+
+   SECTION("Redefined transformations")
+   {
+      Mesh quad(3, 2, Element::QUADRILATERAL, true);
+      IsoparametricTransformation T;
+      quad.GetElementTransformation(0, &T);
+      REQUIRE(T.IsAffine());
+
+      // Moving a vertex and finalizing the transformation again resets the
+      // affine flag and the Jacobian is evaluated at every point
+      T.GetPointMat()(0, 2) += 0.1;
+      T.FinalizeTransformation();
+      REQUIRE(!T.IsAffine());
+
+      IntegrationPoint ip0, ip1;
+      ip0.Set2(0.0, 0.0);
+      ip1.Set2(1.0, 1.0);
+      T.SetIntPoint(&ip0);
+      const double w0 = T.Weight();
+      T.SetIntPoint(&ip1);
+      REQUIRE(fabs(T.Weight() - w0) > 1e-3);
+   }
+}
+
+TEST_CASE("Free connectivity tables", "[Mesh]")
+{
+   Mesh *meshes[2] =
+   {
+      new Mesh(4, 3, Element::TRIANGLE, true),
+      new Mesh(3, 2, 2, Element::TETRAHEDRON, true)
+   };
+
+   for (int m = 0; m < 2; m++)
+   {
+      Mesh &mesh = *meshes[m];
+      const int dim = mesh.Dimension();
+      H1_FECollection fec(3, dim);
+
+      Array<int> edges, faces, cor;
+      FiniteElementSpace fes0(&mesh, &fec);
+      Table el_edge(mesh.ElementToEdgeTable());
+      Table el_face;
+      if (dim == 3) { el_face = mesh.ElementToFaceTable(); }
+
+      const long mem0 = mesh.MemoryUsage();
+      mesh.FreeConnectivityTables();
+      REQUIRE(mesh.MemoryUsage() < mem0);
+
+      // The tables are rebuilt on demand with the same numbering
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         mesh.GetElementEdges(e, edges, cor);
+         REQUIRE(edges.Size() == el_edge.RowSize(e));
+         for (int i = 0; i < edges.Size(); i++)
+         {
+            REQUIRE(edges[i] == el_edge.GetRow(e)[i]);
+         }
+         if (dim == 3)
+         {
+            mesh.GetElementFaces(e, faces, cor);
+            for (int i = 0; i < faces.Size(); i++)
+            {
+               REQUIRE(faces[i] == el_face.GetRow(e)[i]);
+            }
+         }
+      }
+
+      mesh.FreeConnectivityTables();
+      FiniteElementSpace fes1(&mesh, &fec);
+      REQUIRE(fes1.GetVSize() == fes0.GetVSize());
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         Array<int> dofs0, dofs1;
+         fes0.GetElementDofs(e, dofs0);
+         fes1.GetElementDofs(e, dofs1);
+         REQUIRE(dofs0.Size() == dofs1.Size());
+         for (int i = 0; i < dofs0.Size(); i++)
+         {
+            REQUIRE(dofs0[i] == dofs1[i]);
+         }
+      }
+   }
+
+   for (int m = 0; m < 2; m++) { delete meshes[m]; }
+}
+
+TEST_CASE("Refine after freeing the connectivity tables", "[Mesh]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh[2];
+      for (int m = 0; m < 2; m++)
+      {
+         mesh[m] = (dim == 2) ? new Mesh(4, 3, Element::TRIANGLE, true) :
+                   new Mesh(2, 2, 2, Element::TETRAHEDRON, true);
+      }
+      // mesh[0] is refined with the tables freed, mesh[1] as the reference
+      for (int it = 0; it < 2; it++)
+      {
+         Array<int> marked;
+         for (int e = 0; e < mesh[0]->GetNE(); e += 3) { marked.Append(e); }
+         mesh[0]->FreeConnectivityTables();
+         for (int m = 0; m < 2; m++) { mesh[m]->GeneralRefinement(marked); }
+
+         REQUIRE(mesh[0]->GetNE() == mesh[1]->GetNE());
+         REQUIRE(mesh[0]->GetNV() == mesh[1]->GetNV());
+         REQUIRE(mesh[0]->GetNEdges() == mesh[1]->GetNEdges());
+         REQUIRE(mesh[0]->GetNFaces() == mesh[1]->GetNFaces());
+         REQUIRE(mesh[0]->GetNumFaces() == mesh[1]->GetNumFaces());
+
+         Array<int> edges0, edges1, cor;
+         for (int e = 0; e < mesh[0]->GetNE(); e++)
+         {
+            mesh[0]->GetElementEdges(e, edges0, cor);
+            mesh[1]->GetElementEdges(e, edges1, cor);
+            REQUIRE(edges0 == edges1);
+         }
+         for (int f = 0; f < mesh[0]->GetNumFaces(); f++)
+         {
+            int e01, e02, e11, e12;
+            mesh[0]->GetFaceElements(f, &e01, &e02);
+            mesh[1]->GetFaceElements(f, &e11, &e12);
+            REQUIRE(e01 == e11);
+            REQUIRE(e02 == e12);
+         }
+      }
+      for (int m = 0; m < 2; m++) { delete mesh[m]; }
+   }
+}
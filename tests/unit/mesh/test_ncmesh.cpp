@@ -0,0 +1,316 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+
+#include <memory>
+
+namespace ncmesh
+{
+
+// polynomials of degree 1, 2 and 3
+static double poly1(const Vector &x)
+{
+   return 2.0*x(0) - x(1) + 3.0*x(2) + 1.0;
+}
+
+static double poly2(const Vector &x)
+{
+   return x(0)*x(1) - 2.0*x(2)*x(2) + x(0) + 1.0;
+}
+
+static double poly3(const Vector &x)
+{
+   return x(0)*x(0)*x(1) - 2.0*x(1)*x(2)*x(2) + x(0)*x(2) + 1.0;
+}
+
+static double total_volume(Mesh &mesh)
+{
+   double vol = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      vol += mesh.GetElementVolume(i);
+   }
+   return vol;
+}
+
+// refine every other element, twice, to get hanging nodes on two levels
+static void RefineTetMesh(Mesh &mesh)
+{
+   for (int it = 0; it < 2; it++)
+   {
+      Array<int> refs;
+      for (int i = 0; i < mesh.GetNE(); i += 2)
+      {
+         refs.Append(i);
+      }
+      mesh.GeneralRefinement(refs, 1);
+   }
+}
+
+TEST_CASE("NCMesh tetrahedral refinement", "[NCMesh]")
+{
+   Mesh mesh(2, 2, 2, Element::TETRAHEDRON, true);
+   mesh.EnsureNCMesh(true);
+   REQUIRE(mesh.Nonconforming());
+
+   const int ne0 = mesh.GetNE();
+   RefineTetMesh(mesh);
+
+   SECTION("Refinement preserves the domain")
+   {
+      REQUIRE(mesh.GetNE() > ne0);
+      REQUIRE(fabs(total_volume(mesh) - 1.0) < 1e-12);
+
+      for (int i = 0; i < mesh.GetNumFaces(); i++)
+      {
+         REQUIRE(mesh.GetFaceGeometryType(i) == Geometry::TRIANGLE);
+      }
+
+      const NCMesh::NCList &list = mesh.ncmesh->GetFaceList();
+      REQUIRE(list.masters.size() > 0);
+      REQUIRE(list.slaves.size() > 0);
+   }
+
+   SECTION("Conforming interpolation is exact for polynomials")
+   {
+      double (*poly[3])(const Vector &) = { poly1, poly2, poly3 };
+
+      for (int order = 1; order <= 3; order++)
+      {
+         FunctionCoefficient coeff(poly[order-1]);
+
+         H1_FECollection fec(order, 3);
+         FiniteElementSpace fes(&mesh, &fec);
+
+         const SparseMatrix *P = fes.GetConformingProlongation();
+         const SparseMatrix *R = fes.GetConformingRestriction();
+         REQUIRE(P != NULL);
+         REQUIRE(R != NULL);
+
+         // a polynomial from the space is continuous, so the slave DOFs must
+         // be reproduced exactly from the true DOFs
+         GridFunction x(&fes);
+         x.ProjectCoefficient(coeff);
+
+         Vector tx(P->Width()), px(x.Size());
+         R->Mult(x, tx);
+         P->Mult(tx, px);
+
+         px -= x;
+         REQUIRE(px.Normlinf() < 1e-12);
+      }
+   }
+
+   SECTION("Derefinement restores the coarse mesh")
+   {
+      while (mesh.GetNE() > ne0)
+      {
+         const Table &dtable = mesh.ncmesh->GetDerefinementTable();
+         REQUIRE(dtable.Size() > 0);
+
+         Vector error(mesh.GetNE());
+         error = 0.0;
+         REQUIRE(mesh.DerefineByError(error, 1.0));
+      }
+      REQUIRE(mesh.GetNE() == ne0);
+      REQUIRE(fabs(total_volume(mesh) - 1.0) < 1e-12);
+   }
+}
+
+TEST_CASE("NCMesh tetrahedral derefine/refine round trip", "[NCMesh]")
+{
+   // reference: refined once from scratch
+   Mesh fresh(2, 2, 2, Element::TETRAHEDRON, true);
+   fresh.EnsureNCMesh(true);
+   const int ne0 = fresh.GetNE();
+   RefineTetMesh(fresh);
+
+   // refined, derefined back to the coarse mesh and refined again
+   Mesh mesh(2, 2, 2, Element::TETRAHEDRON, true);
+   mesh.EnsureNCMesh(true);
+   RefineTetMesh(mesh);
+   while (mesh.GetNE() > ne0)
+   {
+      Vector error(mesh.GetNE());
+      error = 0.0;
+      REQUIRE(mesh.DerefineByError(error, 1.0));
+   }
+   REQUIRE(mesh.GetNE() == ne0);
+   RefineTetMesh(mesh);
+
+   REQUIRE(mesh.GetNE() == fresh.GetNE());
+   REQUIRE(mesh.GetNV() == fresh.GetNV());
+   REQUIRE(mesh.GetNEdges() == fresh.GetNEdges());
+   REQUIRE(mesh.GetNFaces() == fresh.GetNFaces());
+   REQUIRE(mesh.GetNBE() == fresh.GetNBE());
+   REQUIRE(fabs(total_volume(mesh) - 1.0) < 1e-12);
+
+   // the same nonconforming faces
+   const NCMesh::NCList &l1 = mesh.ncmesh->GetFaceList();
+   const NCMesh::NCList &l2 = fresh.ncmesh->GetFaceList();
+   REQUIRE(l1.conforming.size() == l2.conforming.size());
+   REQUIRE(l1.masters.size() == l2.masters.size());
+   REQUIRE(l1.slaves.size() == l2.slaves.size());
+
+   // the same face neighbors
+   for (int i = 0; i < mesh.GetNumFaces(); i++)
+   {
+      int e1, e2, f1, f2;
+      mesh.GetFaceElements(i, &e1, &e2);
+      fresh.GetFaceElements(i, &f1, &f2);
+      REQUIRE(e1 == f1);
+      REQUIRE(e2 == f2);
+   }
+
+   // the conforming space is the same and reproduces polynomials exactly
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec), fes_fresh(&fresh, &fec);
+   REQUIRE(fes.GetTrueVSize() == fes_fresh.GetTrueVSize());
+
+   FunctionCoefficient coeff(poly2);
+   GridFunction x(&fes);
+   x.ProjectCoefficient(coeff);
+
+   const SparseMatrix *P = fes.GetConformingProlongation();
+   const SparseMatrix *R = fes.GetConformingRestriction();
+   REQUIRE(P != NULL);
+   Vector tx(P->Width()), px(x.Size());
+   R->Mult(x, tx);
+   P->Mult(tx, px);
+   px -= x;
+   REQUIRE(px.Normlinf() < 1e-12);
+}
+
+// refine and partially derefine the mesh to leave free slots in NCMesh
+static void RefineDerefine(Mesh &mesh)
+{
+   for (int it = 0; it < 3; it++)
+   {
+      Array<int> refs;
+      for (int i = 0; i < mesh.GetNE(); i += 3)
+      {
+         refs.Append(i);
+      }
+      mesh.GeneralRefinement(refs, 1);
+   }
+
+   Vector error(mesh.GetNE());
+   for (int i = 0; i < error.Size(); i++)
+   {
+      error(i) = (i % 2) ? 1.0 : 0.0;
+   }
+   mesh.DerefineByError(error, 0.5);
+}
+
+TEST_CASE("NCMesh compaction", "[NCMesh]")
+{
+   Element::Type types[3] =
+   {
+      Element::QUADRILATERAL, Element::HEXAHEDRON, Element::TETRAHEDRON
+   };
+
+   for (int t = 0; t < 3; t++)
+   {
+      std::unique_ptr<Mesh> orig(
+         (types[t] == Element::QUADRILATERAL)
+         ? new Mesh(4, 4, types[t], true)
+         : new Mesh(2, 2, 2, types[t], true));
+      Mesh &mesh = *orig;
+      mesh.EnsureNCMesh(true);
+      mesh.ncmesh->SetAutoCompact(false);
+      RefineDerefine(mesh);
+
+      Mesh compact(mesh);
+      long mem = compact.ncmesh->MemoryUsage();
+      compact.ncmesh->Compact();
+
+      REQUIRE(compact.ncmesh->MemoryUsage() <= mem);
+
+      // the Mesh numbering is not changed by the compaction
+      const NCMesh::NCList &l1 = mesh.ncmesh->GetFaceList();
+      const NCMesh::NCList &l2 = compact.ncmesh->GetFaceList();
+      REQUIRE(l1.conforming.size() == l2.conforming.size());
+      REQUIRE(l1.masters.size() == l2.masters.size());
+      REQUIRE(l1.slaves.size() == l2.slaves.size());
+      for (unsigned i = 0; i < l1.slaves.size(); i++)
+      {
+         REQUIRE(l1.slaves[i].index == l2.slaves[i].index);
+         REQUIRE(l1.slaves[i].master == l2.slaves[i].master);
+      }
+
+      // the compacted mesh can be refined and derefined as before
+      RefineDerefine(mesh);
+      RefineDerefine(compact);
+
+      REQUIRE(mesh.GetNE() == compact.GetNE());
+      REQUIRE(mesh.GetNV() == compact.GetNV());
+      REQUIRE(mesh.GetNEdges() == compact.GetNEdges());
+      REQUIRE(mesh.GetNFaces() == compact.GetNFaces());
+      REQUIRE(fabs(total_volume(compact) - 1.0) < 1e-12);
+
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         REQUIRE(mesh.GetAttribute(i) == compact.GetAttribute(i));
+      }
+      for (int i = 0; i < mesh.GetNBE(); i++)
+      {
+         REQUIRE(mesh.GetBdrAttribute(i) == compact.GetBdrAttribute(i));
+      }
+
+      {
+         H1_FECollection fec(2, mesh.Dimension());
+         FiniteElementSpace fes1(&mesh, &fec), fes2(&compact, &fec);
+         REQUIRE(fes1.GetTrueVSize() == fes2.GetTrueVSize());
+      }
+   }
+}
+
+TEST_CASE("NCMesh automatic compaction", "[NCMesh]")
+{
+   long mem[2];
+   int nv[2];
+   for (int auto_compact = 0; auto_compact <= 1; auto_compact++)
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true);
+      mesh.EnsureNCMesh(true);
+      mesh.ncmesh->SetAutoCompact(auto_compact);
+      const int ne0 = mesh.GetNE();
+
+      // derefining everything leaves most of the element slots unused
+      for (int it = 0; it < 2; it++)
+      {
+         Array<int> refs;
+         for (int i = 0; i < mesh.GetNE(); i++) { refs.Append(i); }
+         mesh.GeneralRefinement(refs, 1);
+      }
+      while (mesh.GetNE() > ne0)
+      {
+         Vector error(mesh.GetNE());
+         error = 0.0;
+         REQUIRE(mesh.DerefineByError(error, 1.0));
+      }
+      REQUIRE(fabs(total_volume(mesh) - 1.0) < 1e-12);
+      mem[auto_compact] = mesh.ncmesh->MemoryUsage();
+
+      // the mesh can be refined again
+      RefineDerefine(mesh);
+      REQUIRE(fabs(total_volume(mesh) - 1.0) < 1e-12);
+      nv[auto_compact] = mesh.GetNV();
+   }
+   REQUIRE(mem[1] < mem[0]);
+   REQUIRE(nv[1] == nv[0]);
+}
+
+} // namespace ncmesh
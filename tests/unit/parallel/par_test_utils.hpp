@@ -0,0 +1,59 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_PAR_TEST_UTILS_HPP
+#define MFEM_PAR_TEST_UTILS_HPP
+
+// Helpers shared by the parallel unit tests
+
+#include "mfem.hpp"
+
+namespace par_test_utils
+{
+
+using namespace mfem;
+
+// Partition the elements in contiguous blocks, this does not require METIS
+inline ParMesh *MakeParMesh(Mesh &mesh)
+{
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   const int ne = mesh.GetNE();
+   int *partitioning = new int[ne];
+   for (int i = 0; i < ne; i++)
+   {
+      partitioning[i] = (int)((long)i * num_procs / ne);
+   }
+   ParMesh *pmesh = new ParMesh(MPI_COMM_WORLD, mesh, partitioning);
+   delete [] partitioning;
+   return pmesh;
+}
+
+// Maximum norm of x over all processors
+inline double GlobalNormlinf(const Vector &x)
+{
+   double loc_norm = x.Normlinf(), glob_norm;
+   MPI_Allreduce(&loc_norm, &glob_norm, 1, MPI_DOUBLE, MPI_MAX,
+                 MPI_COMM_WORLD);
+   return glob_norm;
+}
+
+// Number of errors on all processors
+inline int GlobalErrors(int errors)
+{
+   int glob_errors;
+   MPI_Allreduce(&errors, &glob_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+   return glob_errors;
+}
+
+} // namespace par_test_utils
+
+#endif
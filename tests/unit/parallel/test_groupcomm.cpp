@@ -0,0 +1,199 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+#include "par_test_utils.hpp"
+
+namespace groupcomm
+{
+
+using namespace par_test_utils;
+
+// Value of the dof j of the group with the sorted ranks 'ranks', the same on
+// all processors of the group
+static double GroupValue(const Array<int> &ranks, int j)
+{
+   double v = 0.0;
+   for (int i = 0; i < ranks.Size(); i++) { v = 7*v + ranks[i] + 1; }
+   return 100*v + j;
+}
+
+// Create the groups of the consecutive ranks {q,q+1} and {q,q+1,q+2} that
+// contain this processor; with one processor there are no shared groups
+static void MakeGroups(GroupTopology &gt)
+{
+   int num_procs, rank;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &rank);
+   groups.Insert(group);
+   for (int size = 2; size <= 3; size++)
+   {
+      for (int q = std::max(rank-size+1, 0); q <= rank; q++)
+      {
+         if (q+size > num_procs) { continue; }
+         Array<int> ranks(size);
+         for (int i = 0; i < size; i++) { ranks[i] = q+i; }
+         group.Recreate(size, ranks.GetData());
+         groups.Insert(group);
+      }
+   }
+   gt.Create(groups, 822);
+}
+
+TEST_CASE("GroupCommunicator", "[Parallel][GroupCommunicator]")
+{
+   int rank;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   GroupTopology gt(MPI_COMM_WORLD);
+   MakeGroups(gt);
+
+   // The group g has 4 - (group size) dofs, preceded by a private dof. The
+   // ldofs are numbered in reverse order, so that the dofs of the groups are
+   // not sorted.
+   Array<int> dof_group, dof_j;
+   Array<Array<int> *> group_ranks(gt.NGroups());
+   group_ranks[0] = NULL;
+   dof_group.Append(0);
+   dof_j.Append(0);
+   for (int g = 1; g < gt.NGroups(); g++)
+   {
+      group_ranks[g] = new Array<int>(gt.GetGroupSize(g));
+      for (int i = 0; i < gt.GetGroupSize(g); i++)
+      {
+         (*group_ranks[g])[i] = gt.GetNeighborRank(gt.GetGroup(g)[i]);
+      }
+      group_ranks[g]->Sort();
+      for (int j = 0; j < 4 - gt.GetGroupSize(g); j++)
+      {
+         dof_group.Append(g);
+         dof_j.Append(j);
+      }
+      dof_group.Append(0);
+      dof_j.Append(0);
+   }
+   const int n = dof_group.Size();
+   Array<int> ldof_group(n), ldof_j(n);
+   for (int i = 0; i < n; i++)
+   {
+      ldof_group[i] = dof_group[n-1-i];
+      ldof_j[i] = dof_j[n-1-i];
+   }
+
+   Array<int> ldof_ltdof(n);
+   int ntdofs = 0;
+   for (int i = 0; i < n; i++)
+   {
+      const int g = ldof_group[i];
+      ldof_ltdof[i] = (g == 0 || gt.IAmMaster(g)) ? ntdofs++ : -1;
+   }
+
+#if MPI_VERSION >= 3
+   const int num_modes = 3;
+#else
+   const int num_modes = 2;
+#endif
+   for (int mode = 0; mode < num_modes; mode++)
+   {
+      GroupCommunicator gc(gt, (GroupCommunicator::Mode) mode);
+      gc.Create(ldof_group);
+      gc.SetLTDofTable(ldof_ltdof);
+
+      // repeated calls reuse the buffers and the persistent requests
+      int bcast_errors = 0, reduce_errors = 0;
+      for (int it = 0; it < 3; it++)
+      {
+         // Bcast with layout 0, the masters own the values
+         Array<double> x(n);
+         Array<int> xi(n);
+         for (int i = 0; i < n; i++)
+         {
+            const int g = ldof_group[i];
+            x[i] = -1.0;
+            if (g && gt.IAmMaster(g))
+            {
+               x[i] = GroupValue(*group_ranks[g], ldof_j[i]) + it;
+            }
+            xi[i] = (int) x[i];
+         }
+         gc.Bcast<double>(x.GetData());
+         gc.Bcast(xi);
+         for (int i = 0; i < n; i++)
+         {
+            const int g = ldof_group[i];
+            if (g == 0) { continue; }
+            const double v = GroupValue(*group_ranks[g], ldof_j[i]) + it;
+            if (x[i] != v || xi[i] != (int) v) { bcast_errors++; }
+         }
+
+         // Bcast with layout 2, from the true dofs to the ldofs
+         Array<double> tx(ntdofs), y(n);
+         for (int i = 0; i < n; i++)
+         {
+            if (ldof_ltdof[i] >= 0) { tx[ldof_ltdof[i]] = x[i]; }
+         }
+         y = -5.0;
+         gc.BcastBegin(tx.GetData(), 2);
+         gc.BcastEnd(y.GetData(), 0);
+         for (int i = 0; i < n; i++)
+         {
+            const int g = ldof_group[i];
+            if (g && !gt.IAmMaster(g) && y[i] != x[i]) { bcast_errors++; }
+         }
+
+         // Reduce (sum) with layouts 0 and 2
+         Array<double> z(n), tz(ntdofs);
+         Array<int> zi(n);
+         for (int i = 0; i < n; i++)
+         {
+            z[i] = rank + 1 + it;
+            zi[i] = rank + 1;
+            if (ldof_ltdof[i] >= 0) { tz[ldof_ltdof[i]] = z[i]; }
+         }
+         gc.Reduce<double>(z.GetData(), GroupCommunicator::Sum);
+         gc.Reduce<int>(zi.GetData(), GroupCommunicator::Sum);
+         // the entries of z of the non-masters are not changed by Reduce
+         gc.ReduceBegin(z.GetData());
+         gc.ReduceEnd(tz.GetData(), 2, GroupCommunicator::Sum);
+         for (int i = 0; i < n; i++)
+         {
+            const int g = ldof_group[i];
+            if (g == 0 || !gt.IAmMaster(g)) { continue; }
+            double s = 0.0;
+            int si = 0;
+            for (int k = 0; k < group_ranks[g]->Size(); k++)
+            {
+               s += (*group_ranks[g])[k] + 1 + it;
+               si += (*group_ranks[g])[k] + 1;
+            }
+            // in layout 2, the contributions of the other processors are
+            // added to the true dof of the master
+            if (z[i] != s || zi[i] != si || tz[ldof_ltdof[i]] != s)
+            {
+               reduce_errors++;
+            }
+         }
+      }
+      REQUIRE(GlobalErrors(bcast_errors) == 0);
+      REQUIRE(GlobalErrors(reduce_errors) == 0);
+   }
+
+   for (int g = 1; g < gt.NGroups(); g++) { delete group_ranks[g]; }
+}
+
+} // namespace groupcomm
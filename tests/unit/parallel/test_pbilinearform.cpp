@@ -0,0 +1,152 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+#include "par_test_utils.hpp"
+
+namespace pbilinearform
+{
+
+using namespace par_test_utils;
+
+TEST_CASE("DG TrueAddMult", "[Parallel][ParBilinearForm]")
+{
+   int rank;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   ParMesh *pmesh = MakeParMesh(mesh);
+
+   DG_FECollection fec(2, 2);
+   ParFiniteElementSpace fes(pmesh, &fec);
+
+   ConstantCoefficient one(1.0);
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(one, -1.0, 2.0));
+   a.Assemble();
+   a.Finalize();
+
+   const int n = fes.GetTrueVSize();
+   Vector x(n), y(n), y_ref(n);
+   x.Randomize(rank + 1);
+   y.Randomize(rank + 11);
+   y_ref = y;
+
+   // y += 2 A x, the face-neighbor values are exchanged while the local
+   // columns are multiplied
+   a.TrueAddMult(x, y, 2.0);
+
+   SECTION("Split exchange matches the blocking exchange")
+   {
+      ParGridFunction X(&fes);
+      X.Distribute(&x);
+      X.ExchangeFaceNbrData();
+
+      // mat multiplies the local dofs followed by the face-neighbor dofs
+      const SparseMatrix &A = a.SpMat();
+      const int nbr_size = fes.GetFaceNbrVSize();
+      REQUIRE(A.Width() == X.Size() + nbr_size);
+      Vector X_full(A.Width()), Y(A.Height());
+      for (int i = 0; i < X.Size(); i++) { X_full(i) = X(i); }
+      for (int i = 0; i < nbr_size; i++)
+      {
+         X_full(X.Size() + i) = X.FaceNbrData()(i);
+      }
+      A.Mult(X_full, Y);
+      fes.Dof_TrueDof_Matrix()->MultTranspose(2.0, Y, 1.0, y_ref);
+
+      y_ref -= y;
+      REQUIRE(GlobalNormlinf(y_ref) < 1e-12);
+   }
+
+   SECTION("TrueAddMult matches the assembled operator")
+   {
+      HypreParMatrix *A = a.ParallelAssemble();
+      A->Mult(2.0, x, 1.0, y_ref);
+      delete A;
+
+      y_ref -= y;
+      REQUIRE(GlobalNormlinf(y_ref) < 1e-12*GlobalNormlinf(y));
+   }
+
+   delete pmesh;
+}
+
+TEST_CASE("ParallelAssembleSparse", "[Parallel][ParBilinearForm]")
+{
+   int num_procs, rank;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   // Each processor gets one column of elements, with the ranks ordered as
+   // 0, 2, 1, 4, 3, ... from left to right. The shared dofs are owned by the
+   // lower rank, so e.g. processor 2 couples the dofs owned by 0 and 1, which
+   // are not neighbors.
+   const int nx = num_procs, ny = 2;
+   Mesh mesh(nx, ny, Element::QUADRILATERAL, true);
+   Array<int> partitioning(nx*ny);
+   for (int i = 0; i < nx; i++)
+   {
+      int r = i;
+      if (i % 2 == 1 && i+1 < num_procs) { r = i+1; }
+      else if (i > 0 && i % 2 == 0) { r = i-1; }
+      for (int j = 0; j < ny; j++) { partitioning[j*nx + i] = r; }
+   }
+   ParMesh *pmesh = new ParMesh(MPI_COMM_WORLD, mesh, partitioning);
+
+   H1_FECollection fec(2, 2);
+   ParFiniteElementSpace fes(pmesh, &fec);
+
+   // The convection term makes the matrix nonsymmetric
+   ConstantCoefficient one(1.0);
+   Vector vel(2);
+   vel(0) = 1.0;
+   vel(1) = 2.0;
+   VectorConstantCoefficient velocity(vel);
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new ConvectionIntegrator(velocity));
+   a.Assemble();
+   a.Finalize();
+
+   ParSparseMatrix *A = a.ParallelAssembleSparse();
+   HypreParMatrix *A_ref = a.ParallelAssemble();
+
+   const int n = fes.GetTrueVSize();
+   REQUIRE(A->Height() == n);
+   REQUIRE(A->FirstRow() == fes.GetMyTDofOffset());
+   REQUIRE(A->GlobalSize() == fes.GlobalTrueVSize());
+   REQUIRE(A->NNZ() == A_ref->NNZ());
+
+   Vector x(n), y(n), y_ref(n);
+   x.Randomize(rank + 1);
+
+   A->Mult(x, y);
+   A_ref->Mult(x, y_ref);
+   y_ref -= y;
+   REQUIRE(GlobalNormlinf(y_ref) < 1e-12*GlobalNormlinf(y));
+
+   A->MultTranspose(x, y);
+   A_ref->MultTranspose(x, y_ref);
+   y_ref -= y;
+   REQUIRE(GlobalNormlinf(y_ref) < 1e-12*GlobalNormlinf(y));
+
+   delete A_ref;
+   delete A;
+   delete pmesh;
+}
+
+} // namespace pbilinearform
@@ -0,0 +1,90 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+#include "par_test_utils.hpp"
+
+namespace pfespace
+{
+
+using namespace par_test_utils;
+
+TEST_CASE("DeviceConformingProlongationOperator",
+          "[Parallel][ParFiniteElementSpace]")
+{
+   int rank;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   Mesh *meshes[2] =
+   {
+      new Mesh(6, 5, Element::QUADRILATERAL, true),
+      new Mesh(3, 3, 2, Element::TETRAHEDRON, true)
+   };
+
+   for (int m = 0; m < 2; m++)
+   {
+      ParMesh *pmesh = MakeParMesh(*meshes[m]);
+      const int dim = pmesh->Dimension();
+      H1_FECollection fec(2, dim);
+
+      for (int ordering = Ordering::byNODES; ordering <= Ordering::byVDIM;
+           ordering++)
+      {
+         ParFiniteElementSpace fes(pmesh, &fec, 2, ordering);
+         ConformingProlongationOperator P_ref(fes);
+         DeviceConformingProlongationOperator P(fes);
+
+         const int lsize = fes.GetVSize(), tsize = fes.GetTrueVSize();
+         REQUIRE(P.Height() == lsize);
+         REQUIRE(P.Width() == tsize);
+
+         // repeated calls reuse the buffers and the requests
+         for (int it = 0; it < 2; it++)
+         {
+            Vector x(tsize), y(lsize), y_ref(lsize);
+            x.Randomize(rank + 1 + it);
+            P.Mult(x, y);
+            P_ref.Mult(x, y_ref);
+            y_ref -= y;
+            REQUIRE(GlobalNormlinf(y_ref) == 0.0);
+
+            Vector u(lsize), v(tsize), v_ref(tsize);
+            u.Randomize(rank + 11 + it);
+            P.MultTranspose(u, v);
+            P_ref.MultTranspose(u, v_ref);
+            v_ref -= v;
+            REQUIRE(GlobalNormlinf(v_ref) < 1e-14*GlobalNormlinf(v));
+
+            // the split versions give the same results
+            y = -1.0;
+            P.MultBegin(x, y);
+            P.MultEnd(y);
+            P_ref.Mult(x, y_ref);
+            y_ref -= y;
+            REQUIRE(GlobalNormlinf(y_ref) == 0.0);
+
+            P.MultTransposeBegin(u);
+            P.MultTransposeEnd(u, v);
+            P_ref.MultTranspose(u, v_ref);
+            v_ref -= v;
+            REQUIRE(GlobalNormlinf(v_ref) < 1e-14*GlobalNormlinf(v));
+         }
+      }
+
+      delete pmesh;
+      delete meshes[m];
+   }
+}
+
+} // namespace pfespace
@@ -0,0 +1,118 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+#include "par_test_utils.hpp"
+
+namespace parmesh
+{
+
+using namespace par_test_utils;
+
+// Exclusive prefix sum and total of loc over all processors
+static void ScanSum(long loc, long &offset, long &total)
+{
+   MPI_Scan(&loc, &offset, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+   offset -= loc;
+   MPI_Allreduce(&loc, &total, 1, MPI_LONG, MPI_SUM, MPI_COMM_WORLD);
+}
+
+// Compare the offsets derived from the entity offsets of the mesh with the
+// result of MPI_Scan, return the number of errors on this processor
+static int CheckOffsets(const ParMesh &pmesh, ParFiniteElementSpace &fes)
+{
+   int errors = 0;
+   long offset, total;
+
+   // The elements are not shared, all local elements are owned
+   Array<long> num_elem(Geometry::NumGeom);
+   num_elem = 0;
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      num_elem[pmesh.GetElementBaseGeometry(i)]++;
+   }
+   for (int g = Geometry::SEGMENT; g < Geometry::NumGeom; g++)
+   {
+      if (Geometry::Dimension[g] != pmesh.Dimension()) { continue; }
+      ScanSum(num_elem[g], offset, total);
+      if (total == 0) { continue; }
+      for (int owned = 0; owned <= 1; owned++)
+      {
+         const Geometry::Type geom = Geometry::Type(g);
+         if (pmesh.GetEntityOffset(geom, owned, false) != offset ||
+             pmesh.GetEntityOffset(geom, owned, true) != total) { errors++; }
+      }
+   }
+
+   // The shared vertices are counted by every processor in their group
+   ScanSum(pmesh.GetNV(), offset, total);
+   if (pmesh.GetEntityOffset(Geometry::POINT, false, false) != offset ||
+       pmesh.GetEntityOffset(Geometry::POINT, false, true) != total)
+   {
+      errors++;
+   }
+
+   // The (true) dof offsets of the space
+   ScanSum(fes.GetVSize(), offset, total);
+   if (fes.GetMyDofOffset() != offset || fes.GlobalVSize() != total)
+   {
+      errors++;
+   }
+   ScanSum(fes.GetTrueVSize(), offset, total);
+   if (fes.GetMyTDofOffset() != offset || fes.GlobalTrueVSize() != total)
+   {
+      errors++;
+   }
+   return errors;
+}
+
+TEST_CASE("Entity offsets in uniform refinement", "[Parallel][ParMesh]")
+{
+   if (!HYPRE_AssumedPartitionCheck()) { return; }
+
+   Mesh *meshes[3] =
+   {
+      new Mesh(4, 3, Element::TRIANGLE, true),
+      new Mesh(2, 2, 2, Element::TETRAHEDRON, true),
+      new Mesh(2, 2, 2, Element::HEXAHEDRON, true)
+   };
+
+   for (int m = 0; m < 3; m++)
+   {
+      ParMesh *pmesh = MakeParMesh(*meshes[m]);
+      const int dim = pmesh->Dimension();
+
+      // Order 3 has dofs on the vertices, edges, faces and elements
+      H1_FECollection fec(3, dim);
+      ParFiniteElementSpace fes(pmesh, &fec, 2);
+      REQUIRE(GlobalErrors(CheckOffsets(*pmesh, fes)) == 0);
+
+      // The offsets computed above are updated locally by the refinement
+      for (int it = 0; it < 2; it++)
+      {
+         pmesh->UniformRefinement();
+         fes.Update();
+         REQUIRE(GlobalErrors(CheckOffsets(*pmesh, fes)) == 0);
+
+         // a space created after the refinement uses the same offsets
+         ParFiniteElementSpace fes_new(pmesh, &fec, 2);
+         REQUIRE(GlobalErrors(CheckOffsets(*pmesh, fes_new)) == 0);
+      }
+
+      delete pmesh;
+      delete meshes[m];
+   }
+}
+
+} // namespace parmesh
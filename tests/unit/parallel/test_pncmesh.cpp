@@ -0,0 +1,250 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+#include "par_test_utils.hpp"
+
+namespace pncmesh
+{
+
+using namespace par_test_utils;
+
+// Physical coordinates of the center of the element i
+static void ElementCenter(Mesh &mesh, int i, Vector &c)
+{
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(i);
+   mesh.GetElementTransformation(i)->Transform(Geometries.GetCenter(geom), c);
+}
+
+// Element weight depending on the position of the element, so that it can be
+// computed again after the elements have moved
+static double ElementWeight(ParMesh &pmesh, int i)
+{
+   Vector c;
+   ElementCenter(pmesh, i, c);
+   return (c(0) < 0.5) ? 4.0 : 1.0 + c(1);
+}
+
+// Quadratic function, represented exactly by the Q2 space also on the
+// nonconforming interfaces
+static double QuadraticFunction(const Vector &x)
+{
+   double f = 1.0 + x(0) + 2.0*x(1) + x(0)*x(1);
+   if (x.Size() == 3) { f += 3.0*x(2) - x(1)*x(2); }
+   return f;
+}
+
+// Refine the elements near the origin, creating hanging nodes
+static void RefineCorner(Mesh &mesh)
+{
+   Array<int> refs;
+   Vector c;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      ElementCenter(mesh, i, c);
+      if (c.Norml2() < 0.5) { refs.Append(i); }
+   }
+   mesh.GeneralRefinement(refs, 1);
+}
+
+TEST_CASE("Weighted Rebalance", "[Parallel][ParNCMesh]")
+{
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+   Mesh *meshes[2] =
+   {
+      new Mesh(8, 8, Element::QUADRILATERAL, true),
+      new Mesh(4, 4, 4, Element::HEXAHEDRON, true)
+   };
+
+   for (int m = 0; m < 2; m++)
+   {
+      meshes[m]->EnsureNCMesh();
+      ParMesh *pmesh = MakeParMesh(*meshes[m]);
+      RefineCorner(*pmesh);
+      RefineCorner(*pmesh);
+
+      H1_FECollection fec(2, pmesh->Dimension());
+      ParFiniteElementSpace fes(pmesh, &fec);
+      ParGridFunction x(&fes);
+      FunctionCoefficient f(QuadraticFunction);
+      x.ProjectCoefficient(f);
+
+      Vector weights(pmesh->GetNE());
+      for (int i = 0; i < pmesh->GetNE(); i++)
+      {
+         weights(i) = ElementWeight(*pmesh, i);
+      }
+      const double max_w = 4.0;
+
+      pmesh->Rebalance(&weights);
+      fes.Update();
+      x.Update();
+
+      // The weights of the new partition, from the positions of the elements
+      double loc_weight = 0.0;
+      for (int i = 0; i < pmesh->GetNE(); i++)
+      {
+         loc_weight += ElementWeight(*pmesh, i);
+      }
+      double total_weight;
+      MPI_Allreduce(&loc_weight, &total_weight, 1, MPI_DOUBLE, MPI_SUM,
+                    MPI_COMM_WORLD);
+      const double avg_weight = total_weight / num_procs;
+
+      // Each element goes to the processor whose share of the cumulative
+      // weight contains its midpoint
+      int errors = (fabs(loc_weight - avg_weight) > max_w);
+      REQUIRE(GlobalErrors(errors) == 0);
+
+      // The statistics match the actual partition
+      const ParNCMesh::RebalanceStats &stats =
+         pmesh->pncmesh->GetRebalanceStats();
+      long loc_ne = pmesh->GetNE(), min_ne, max_ne;
+      MPI_Allreduce(&loc_ne, &min_ne, 1, MPI_LONG, MPI_MIN, MPI_COMM_WORLD);
+      MPI_Allreduce(&loc_ne, &max_ne, 1, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+      double min_weight, max_weight;
+      MPI_Allreduce(&loc_weight, &min_weight, 1, MPI_DOUBLE, MPI_MIN,
+                    MPI_COMM_WORLD);
+      MPI_Allreduce(&loc_weight, &max_weight, 1, MPI_DOUBLE, MPI_MAX,
+                    MPI_COMM_WORLD);
+      REQUIRE(stats.min_elements == min_ne);
+      REQUIRE(stats.max_elements == max_ne);
+      REQUIRE(fabs(stats.min_weight - min_weight) <= 1e-12 * total_weight);
+      REQUIRE(fabs(stats.max_weight - max_weight) <= 1e-12 * total_weight);
+      REQUIRE(fabs(stats.avg_weight - avg_weight) <= 1e-12 * total_weight);
+
+      // The dofs migrated by SendRebalanceDofs still represent the function
+      ParGridFunction x_ref(&fes);
+      x_ref.ProjectCoefficient(f);
+      x -= x_ref;
+      REQUIRE(GlobalNormlinf(x) <= 1e-12 * GlobalNormlinf(x_ref));
+
+      delete pmesh;
+      delete meshes[m];
+   }
+}
+
+// Check that the two sides of each shared face map the face points to the
+// same physical points, i.e., that the face orientations agree
+static int CheckSharedFaces(ParMesh &pmesh)
+{
+   pmesh.ExchangeFaceNbrData();
+
+   int errors = 0;
+   Vector eip1, eip2, x1, x2;
+   for (int sf = 0; sf < pmesh.GetNSharedFaces(); sf++)
+   {
+      FaceElementTransformations *T = pmesh.GetSharedFaceTransformations(sf);
+      const IntegrationRule &ir = IntRules.Get(T->FaceGeom, 4);
+      for (int j = 0; j < ir.GetNPoints(); j++)
+      {
+         IntegrationPoint ip1, ip2;
+         T->Loc1.Transform(ir.IntPoint(j), ip1);
+         T->Loc2.Transform(ir.IntPoint(j), ip2);
+         T->Elem1->Transform(ip1, x1);
+         T->Elem2->Transform(ip2, x2);
+         x1 -= x2;
+         if (x1.Normlinf() > 1e-12) { errors++; }
+      }
+   }
+   return errors;
+}
+
+// Coarsen the elements refined by the last RefineCorner, i.e., the leaves at
+// depth 2 in the refinement tree
+static void DerefineCorner(Mesh &mesh)
+{
+   Vector error(mesh.GetNE());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      error(i) = (mesh.ncmesh->GetElementDepth(i) > 1) ? 0.0 : 1.0;
+   }
+   mesh.DerefineByError(error, 0.5, 0, 2);
+}
+
+TEST_CASE("Nonconforming tetrahedra", "[Parallel][ParNCMesh]")
+{
+   Mesh *meshes[2] =
+   {
+      new Mesh(2, 2, 2, Element::TETRAHEDRON, true),
+      new Mesh(2, 2, 2, Element::HEXAHEDRON, true)
+   };
+
+   for (int m = 0; m < 2; m++)
+   {
+      // Refine everywhere first, so that no processor runs out of elements
+      // when the corner is derefined below
+      meshes[m]->EnsureNCMesh(true);
+      meshes[m]->UniformRefinement();
+      ParMesh *pmesh = MakeParMesh(*meshes[m]);
+      RefineCorner(*pmesh);
+      RefineCorner(*meshes[m]);
+
+      REQUIRE(GlobalErrors(CheckSharedFaces(*pmesh)) == 0);
+
+      // cubic elements have dofs in the interior of the triangular faces
+      H1_FECollection fec(3, 3);
+      FiniteElementSpace serial_fes(meshes[m], &fec);
+      ParFiniteElementSpace fes(pmesh, &fec);
+
+      // The shared vertices, edges and faces are identified correctly if the
+      // parallel space has as many true dofs as the serial one
+      REQUIRE(fes.GlobalTrueVSize() == serial_fes.GetTrueVSize());
+
+      // The parallel prolongation is exact for a function in the space
+      FunctionCoefficient f(QuadraticFunction);
+      ParGridFunction x(&fes), x_ref(&fes);
+      x_ref.ProjectCoefficient(f);
+      HypreParVector *tv = x_ref.ParallelProject();
+      x.Distribute(tv);
+      delete tv;
+      x -= x_ref;
+      REQUIRE(GlobalNormlinf(x) <= 1e-12 * GlobalNormlinf(x_ref));
+
+      // Move the elements, the migrated dofs still represent the function
+      pmesh->Rebalance();
+      fes.Update();
+      x.Update();
+      x_ref.Update();
+      REQUIRE(GlobalErrors(CheckSharedFaces(*pmesh)) == 0);
+
+      x.ProjectCoefficient(f);
+      x -= x_ref;
+      REQUIRE(GlobalNormlinf(x) <= 1e-12 * GlobalNormlinf(x_ref));
+
+      // Derefine the corner in serial and in parallel, the interpolated
+      // function is still exact
+      DerefineCorner(*pmesh);
+      DerefineCorner(*meshes[m]);
+      fes.Update();
+      serial_fes.Update();
+      x_ref.Update();
+
+      REQUIRE(pmesh->GetGlobalNE() == meshes[m]->GetNE());
+      REQUIRE(fes.GlobalTrueVSize() == serial_fes.GetTrueVSize());
+      REQUIRE(GlobalErrors(CheckSharedFaces(*pmesh)) == 0);
+
+      x.Update();
+      x.ProjectCoefficient(f);
+      x -= x_ref;
+      REQUIRE(GlobalNormlinf(x) <= 1e-12 * GlobalNormlinf(x_ref));
+
+      delete pmesh;
+      delete meshes[m];
+   }
+}
+
+} // namespace pncmesh
@@ -0,0 +1,22 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Main program of the parallel unit tests, 'punit_tests': the tests in the
+// 'parallel' directory run on all processors of MPI_COMM_WORLD.
+#define CATCH_CONFIG_RUNNER
+#include "mfem.hpp"
+#include "catch.hpp"
+
+int main(int argc, char *argv[])
+{
+   mfem::MPI_Session mpi(argc, argv);
+   return Catch::Session().run(argc, argv);
+}